@@ -0,0 +1,960 @@
+#include<algorithm>
+#include<atomic>
+#include<functional>
+#include<map>
+#include<stdio.h>
+#include<stdlib.h>
+#include<span>
+#include<string>
+#include<thread>
+#include<vector>
+#include<fcntl.h>
+#ifdef _WIN32
+#include<io.h>
+#else
+#include<unistd.h>
+#endif
+
+#include "fcfs.h"
+#include "job.h"
+#include "logger.h"
+#include "priority.h"
+#include "priority_ageing.h"
+#include "random.h"
+#include "round_robin.h"
+#include "simd_kernels.h"
+#include "simulation_clock.h"
+#include "sjf.h"
+#include "srtf.h"
+#include "timing.h"
+
+using namespace std;
+
+//---------------------------------------------------------------------------------------------------
+// Microbenchmarks of the operations done by the schedulers on their job pools, measured in
+// isolation at queue depths from 10 to 10M jobs:
+//
+//   add_to_ready_queue     - ProcessScheduler::addToReadyQueue(), per job
+//   fetch_ready_jobs       - Splice of the whole ready queue into the pending pool, per call
+//   pick_next              - Ordering of the pending pool of each algorithm, per call
+//   job_complete           - ProcessScheduler::JobComplete() of a job anywhere in the pool, per job
+//   ageing_pass            - Ageing of the pending pool by Priority Scheduling with Ageing, i.e.
+//                            the kernel over its PendingJobTable and the update of the jobs
+//                            aged, per call
+//   ageing_list_loop       - Same, with the loop over the pool it had before the SIMD kernels
+//   ageing_kernel_*        - The ageing kernel alone, over arrays filled beforehand, per call,
+//                            at each level the CPU supports (scalar, avx2, avx512)
+//   pick_min_list_loop     - Pick of the job with the least time remaining in the pool, with
+//                            min_element() as SRTF had it before the SIMD kernels, per call
+//   pick_min_kernel_*      - The kernel finding the lowest key alone, over the keys filled
+//                            beforehand, per call, at each level. pick_next of srtf sets the
+//                            keys of all the jobs, as they all just arrived, and runs the
+//                            kernel; later picks only set those of the jobs that arrived or
+//                            ran since.
+//   display_stats          - ProcessScheduler::displayStats(), per call
+//   dispatch               - Pass of PolicyScheduler over a pending pool, i.e. order, dispatch,
+//                            run and complete every job, per job. Its steps are bound at
+//                            compile time for each algorithm.
+//   dispatch_virtual       - Same pass, with the steps called through the virtual table and
+//                            timed by a ScopedPhaseTimer each, as the algorithms did before
+//                            they were policies of PolicyScheduler, per job. Run up to 100K
+//                            jobs, and 1000 for rr and srtf, which look through the pool for
+//                            every job: rr completes jobs behind the preempted ones, and srtf
+//                            picks a single job per pass.
+//   dispatch_untimed       - Same as dispatch, with the phase timers disabled, per job
+//   submit_batch           - Batches of addToReadyQueue() from a producer thread, while the
+//                            scheduler thread keeps fetching the ready queue, per job. Its
+//                            depth is the batch size, from 1 to 4096.
+//
+// Results are written as CSV (benchmark,algorithm,depth,iterations,ns_per_op). The best of a
+// number of runs is kept, as it is the least disturbed by the rest of the system. Results can
+// be compared with a saved baseline, e.g. bench/baseline.csv, and every result slower than
+// the baseline by more than the tolerance is reported as a regression.
+//---------------------------------------------------------------------------------------------------
+
+//---------------------------------------------------------------------------------------------------
+// Enums and structures
+//---------------------------------------------------------------------------------------------------
+typedef struct
+{
+    string                  benchmark;                // Operation measured
+    string                  algorithm;                // Scheduler the operation belongs to, "all" if shared
+    long long               depth;                    // Jobs in the pool
+    long long               iterations;               // Runs the best result was taken from
+    double                  nsPerOp;                  // Time (ns) per operation
+}benchResult_st;
+
+typedef struct
+{
+    long long               minDepth;
+    long long               maxDepth;
+    string                  outputFile;               // Empty for stdout
+    string                  baselineFile;             // Empty to skip comparison
+    double                  tolerance;                // Allowed slow down over the baseline, e.g. 0.25 for 25%
+}benchConfig_st;
+
+//---------------------------------------------------------------------------------------------------
+// Globals
+//---------------------------------------------------------------------------------------------------
+const long long BENCH_OPS_PER_DEPTH     = 1000000;    // Roughly operations timed at each depth
+const long long BENCH_MIN_ITERATIONS    = 3;
+const long long BENCH_MAX_ITERATIONS    = 1000;
+const long long BENCH_COMPLETE_SAMPLE   = 1000;       // Jobs completed in each job_complete run
+const unsigned int BENCH_SEED           = 1;
+const long long BENCH_SUBMIT_JOBS       = 65536;      // Jobs submitted in each submit_batch run
+const size_t BENCH_MAX_BATCH_SIZE       = 4096;
+const long long BENCH_MAX_DISPATCH_DEPTH = 100000;    // Deepest pool dispatched
+const long long BENCH_MAX_SCAN_DEPTH    = 1000;       // Same, for policies that look through the pool for every job
+
+//-------------------------------------------------------------------------------------------------
+// BenchScheduler gives the benchmarks access to the job pools and the protected steps of a
+// scheduler. The jobs in the pools belong to the benchmark, so they are not deleted with it.
+//-------------------------------------------------------------------------------------------------
+template<typename SCHEDULER>
+class BenchScheduler : public SCHEDULER
+{
+public:
+    template<typename... ARGS>
+    BenchScheduler(ARGS... args) : SCHEDULER(args...) {}
+
+    ~BenchScheduler()
+    {
+        this->m_readyJobPool.clear();
+        setPendingJobs({});
+        this->m_completedJobPool.clear();
+    }
+
+    using SCHEDULER::fetchReadyJobs;
+    using SCHEDULER::orderPendingJobs;
+
+    list<Job*> & getReadyJobPool() { return this->m_readyJobPool; }
+    list<Job*> & getPendingJobPool() { return this->m_pendingJobPool; }
+    unordered_map<unsigned long, Job*> & getCompletedJobPool() { return this->m_completedJobPool; }
+
+    // The pending pool is replaced as a whole, so the table of the scheduler is filled again
+    void setPendingJobs(const vector<Job*> & jobs)
+    {
+        this->m_pendingJobPool.assign(jobs.begin(), jobs.end());
+        this->resetPendingJobTable();
+    }
+};
+
+class BenchAgeingScheduler : public BenchScheduler<PriorityAgeingScheduling>
+{
+public:
+    BenchAgeingScheduler(string name, unsigned int ageingRate) : BenchScheduler<PriorityAgeingScheduling>(name, ageingRate) {}
+
+    using PriorityAgeingScheduling::agePendingJobs;
+};
+
+//-------------------------------------------------------------------------------------------------
+// VirtualDispatchScheduler runs the pass of PolicyScheduler::dispatchPendingJobs() the way the
+// algorithms ran it before they were policies: the same steps, each called through the virtual
+// table of the scheduler. It is the reference the devirtualized pass is measured against.
+//-------------------------------------------------------------------------------------------------
+template<typename SCHEDULER, typename POLICY>
+class VirtualDispatchScheduler : public BenchScheduler<SCHEDULER>
+{
+public:
+    template<typename... ARGS>
+    VirtualDispatchScheduler(ARGS... args) : BenchScheduler<SCHEDULER>(args...) {}
+
+    void dispatchPendingJobsVirtually()
+    {
+        if (POLICY::QUEUE != QUEUE_ARRIVAL)
+        {
+            ScopedPhaseTimer timer(this->getPhaseStats(PHASE_ORDER), this->getHardwareCounters());
+            this->orderPendingJobs();
+        }
+
+        auto it = this->m_pendingJobPool.begin();
+        while (it != this->m_pendingJobPool.end())
+        {
+            Job *job = *it;
+            bool jobComplete = false;
+
+            {
+                ScopedPhaseTimer timer(this->getPhaseStats(PHASE_DISPATCH), this->getHardwareCounters());
+                if (!this->assignCpu(job))
+                {
+                    if (POLICY::QUEUE == QUEUE_MIN_FIRST)
+                        return;
+                    it++;
+                    continue;
+                }
+                job->markJobAsStartedExecution();
+            }
+
+            {
+                ScopedPhaseTimer timer(this->getPhaseStats(PHASE_WORK), this->getHardwareCounters());
+                jobComplete = this->DoJob(job);
+            }
+            if (jobComplete)
+            {
+                ScopedPhaseTimer timer(this->getPhaseStats(PHASE_COMPLETE), this->getHardwareCounters());
+                job->markJobAsComplete();
+                it = this->JobComplete(job);
+            }
+            else
+            {
+                ScopedPhaseTimer timer(this->getPhaseStats(PHASE_COMPLETE), this->getHardwareCounters());
+                job->markJobAsPaused(this->m_timeSliceServed);
+                if (POLICY::PREEMPTION == PREEMPT_NONE || job->isIoDue())
+                {
+                    it = this->JobBlocked(job);
+                }
+                else
+                {
+                    if (this->getPendingJobTable())
+                        this->getPendingJobTable()->update(job);
+                    it++;
+                }
+            }
+
+            if (POLICY::QUEUE == QUEUE_MIN_FIRST)
+                return;
+        }
+    }
+};
+
+//******************************************************************************************
+// @name                    : getIterations
+//
+// @description             : Gets the number of runs of a benchmark at a depth, so that
+//                            small depths are run often enough to be measured precisely.
+//
+// @param depth             : Jobs in the pool
+//
+// @returns                 : Number of runs
+//******************************************************************************************
+static long long getIterations(long long depth)
+{
+    return min(BENCH_MAX_ITERATIONS, max(BENCH_MIN_ITERATIONS, BENCH_OPS_PER_DEPTH / depth));
+}
+
+//******************************************************************************************
+// @name                    : measure
+//
+// @description             : Runs a benchmark a number of times and keeps the best time.
+//                            Setup is done before every run and is not timed.
+//
+// @param iterations        : Number of runs
+// @param opsPerRun         : Operations done in each run
+// @param setup             : Prepares a run
+// @param body              : Operations to time
+//
+// @returns                 : Best time (ns) per operation
+//******************************************************************************************
+template<typename SETUP, typename BODY>
+static double measure(long long iterations, long long opsPerRun, SETUP setup, BODY body)
+{
+    double best = -1;
+
+    for (long long i = 0; i < iterations; i++)
+    {
+        setup();
+
+        long long tsStart = getCurrentTimestampInNanoseconds();
+        body();
+        double nsPerOp = (getCurrentTimestampInNanoseconds() - tsStart) / (double)opsPerRun;
+
+        if (best < 0 || nsPerOp < best)
+        {
+            best = nsPerOp;
+        }
+    }
+
+    return best;
+}
+
+//******************************************************************************************
+// @name                    : measureInterleaved
+//
+// @description             : Runs several variants of a benchmark in turn, a run of each in
+//                            every iteration, and keeps the best time of each. Drift of the
+//                            system during the measurement, e.g. of the clock frequency,
+//                            then falls on all of them alike. Setup is done before every run
+//                            and is not timed.
+//
+// @param iterations        : Number of runs of each variant
+// @param opsPerRun         : Operations done in each run
+// @param setup             : Prepares a run
+// @param bodies            : Operations to time, for each variant
+//
+// @returns                 : Best time (ns) per operation of each variant
+//******************************************************************************************
+template<typename SETUP>
+static vector<double> measureInterleaved(long long iterations, long long opsPerRun, SETUP setup, const vector<function<void()>> & bodies)
+{
+    vector<double> best(bodies.size(), -1);
+
+    for (long long i = 0; i < iterations; i++)
+    {
+        for (size_t variant = 0; variant < bodies.size(); variant++)
+        {
+            setup();
+
+            long long tsStart = getCurrentTimestampInNanoseconds();
+            bodies[variant]();
+            double nsPerOp = (getCurrentTimestampInNanoseconds() - tsStart) / (double)opsPerRun;
+
+            if (best[variant] < 0 || nsPerOp < best[variant])
+            {
+                best[variant] = nsPerOp;
+            }
+        }
+    }
+
+    return best;
+}
+
+//******************************************************************************************
+// @name                    : silenceStdout / restoreStdout
+//
+// @description             : Sends stdout to the null device while the stats are being
+//                            displayed, so that only the results are written to it.
+//
+// @returns                 : Saved stdout descriptor / Nothing
+//******************************************************************************************
+static int silenceStdout()
+{
+    fflush(stdout);
+#ifdef _WIN32
+    int saved = _dup(_fileno(stdout));
+    int null = _open("NUL", _O_WRONLY);
+    _dup2(null, _fileno(stdout));
+    _close(null);
+#else
+    int saved = dup(fileno(stdout));
+    int null = open("/dev/null", O_WRONLY);
+    dup2(null, fileno(stdout));
+    close(null);
+#endif
+    return saved;
+}
+
+static void restoreStdout(int saved)
+{
+    fflush(stdout);
+#ifdef _WIN32
+    _dup2(saved, _fileno(stdout));
+    _close(saved);
+#else
+    dup2(saved, fileno(stdout));
+    close(saved);
+#endif
+}
+
+//******************************************************************************************
+// @name                    : benchPickNext
+//
+// @description             : Measures ordering of a pending pool of jobs in their order of
+//                            arrival, after which the next job is at the front of the pool.
+//
+// @param scheduler         : Scheduler to measure
+// @param jobs              : Jobs in their order of arrival
+// @param priorities        : Original priority of each job, restored before every run
+// @param results           : Results to add to
+//
+// @returns                 : Nothing
+//******************************************************************************************
+template<typename SCHEDULER>
+static void benchPickNext(SCHEDULER & scheduler, const string & algorithm, const vector<Job*> & jobs,
+                          const vector<unsigned int> & priorities, vector<benchResult_st> & results)
+{
+    long long depth = (long long)jobs.size();
+    long long iterations = getIterations(depth);
+    Job * volatile next = nullptr;
+
+    double nsPerOp = measure(iterations, 1,
+        [&]() {
+            for (size_t i = 0; i < jobs.size(); i++)
+                jobs[i]->setJobPriority(priorities[i]);
+            scheduler.setPendingJobs(jobs);
+        },
+        [&]() {
+            scheduler.orderPendingJobs();
+            next = scheduler.getPendingJobPool().front();
+        });
+
+    (void)next;
+    results.push_back({ "pick_next", algorithm, depth, iterations, nsPerOp });
+
+    // Leave the memory to the next ones at the deepest levels
+    scheduler.setPendingJobs({});
+}
+
+//******************************************************************************************
+// @name                    : benchKernels
+//
+// @description             : Measures the ageing and pick of the lowest key over a pool of
+//                            jobs, with the loops over the list the schedulers used to have,
+//                            and with the kernels over arrays at each level the CPU supports.
+//
+// @param jobs              : Jobs in their order of arrival
+// @param priorities        : Original priority of each job, restored before every run
+// @param pool              : Pending pool holding the jobs, in the nodes a scheduler left,
+//                            for the loops to pay the same cache misses as its passes
+// @param clock             : Clock of the jobs
+// @param results           : Results to add to
+//
+// @returns                 : Nothing
+//******************************************************************************************
+static void benchKernels(const vector<Job*> & jobs, const vector<unsigned int> & priorities, list<Job*> & pool,
+                         SimulationClock & clock, vector<benchResult_st> & results)
+{
+    long long depth = (long long)jobs.size();
+    long long iterations = getIterations(depth);
+    const unsigned int ageingRate = 1;
+    double nsPerOp = 0;
+
+    // Ageing, as PriorityAgeingScheduling::agePendingJobs() did before the SIMD kernels
+    nsPerOp = measure(iterations, 1,
+        [&]() {
+            for (size_t i = 0; i < jobs.size(); i++)
+                jobs[i]->setJobPriority(priorities[i]);
+        },
+        [&]() {
+            for (auto it = pool.begin(); it != pool.end(); it++)
+            {
+                Job *job = *it;
+                long long currentWaitingTime = clock.now() - job->getJobTimeCreated();
+                if (currentWaitingTime >= job->getJobTimeRequired() && job->getJobPriority() > JOB_PRIORITY_HIGHEST)
+                {
+                    if (job->getJobPriority() > JOB_PRIORITY_HIGHEST + ageingRate)
+                        job->setJobPriority(job->getJobPriority() - ageingRate);
+                    else
+                        job->setJobPriority(JOB_PRIORITY_HIGHEST);
+                }
+            }
+        });
+    results.push_back({ "ageing_list_loop", "priority_ageing", depth, iterations, nsPerOp });
+
+    // Pick of the least time remaining, as ShortestRemainingTimeFirst did before the SIMD kernels
+    Job * volatile next = nullptr;
+    nsPerOp = measure(iterations, 1, [&]() {}, [&]() {
+        next = *min_element(pool.begin(), pool.end(),
+                            [](Job* lhs, Job* rhs) {return lhs->getCpuBurstRemaining() < rhs->getCpuBurstRemaining(); });
+    });
+    results.push_back({ "pick_min_list_loop", "srtf", depth, iterations, nsPerOp });
+    (void)next;
+
+    // The kernels alone, over the arrays
+    vector<unsigned int> agedPriorities(priorities);
+    vector<long long> tsCreated;
+    vector<long long> timeRequired;
+    vector<long long> keys;
+    vector<long long> ranks;
+    vector<size_t> agedJobs(jobs.size());
+    for (auto it = jobs.begin(); it != jobs.end(); it++)
+    {
+        tsCreated.push_back((*it)->getJobTimeCreated());
+        timeRequired.push_back((*it)->getJobTimeRequired());
+        keys.push_back((*it)->getCpuBurstRemaining());
+        ranks.push_back((long long)ranks.size());
+    }
+
+    for (int level = SIMD_SCALAR; level <= getSupportedSimdLevel(); level++)
+    {
+        string name = getSimdLevelName((simdLevel_en)level);
+        volatile size_t lowest = 0;
+
+        nsPerOp = measure(iterations, 1,
+            [&]() { copy(priorities.begin(), priorities.end(), agedPriorities.begin()); },
+            [&]() {
+                agePriorities((simdLevel_en)level, agedPriorities.data(), tsCreated.data(), timeRequired.data(),
+                              agedPriorities.size(), clock.now(), ageingRate, agedJobs.data());
+            });
+        results.push_back({ "ageing_kernel_" + name, "priority_ageing", depth, iterations, nsPerOp });
+
+        nsPerOp = measure(iterations, 1, [&]() {}, [&]() { lowest = findMinKey((simdLevel_en)level, keys.data(), ranks.data(), keys.size()); });
+        results.push_back({ "pick_min_kernel_" + name, "srtf", depth, iterations, nsPerOp });
+        (void)lowest;
+    }
+}
+
+//******************************************************************************************
+// @name                    : benchDepth
+//
+// @description             : Runs all the benchmarks at a depth.
+//
+// @param depth             : Jobs in the pool
+// @param results           : Results to add to
+//
+// @returns                 : Nothing
+//******************************************************************************************
+static void benchDepth(long long depth, vector<benchResult_st> & results)
+{
+    RandomGenerator rng(BENCH_SEED);
+    VirtualClock clock;
+
+    // Jobs of random priority and time required, created at time 0. Half of them are due
+    // for ageing at the time of the ageing pass.
+    vector<Job*> jobs;
+    vector<unsigned int> priorities;
+    jobs.reserve(depth);
+    priorities.reserve(depth);
+    for (long long i = 0; i < depth; i++)
+    {
+        jobSpec_st spec = jobSpec_st();
+        spec.jobId = (unsigned long)(i + 1);
+        spec.priority = rng.generateRandomNumber(JOB_PRIORITY_LOWEST);
+        spec.timeRequired = (rng.generateRandomNumber(MAX_TIME_REQUIRED) + 1) * NANOSECONDS_PER_MILLISECOND;
+        spec.arrivalTime = 0;
+
+        jobs.push_back(new Job(false, spec, 2, &clock));
+        priorities.push_back(spec.priority);
+    }
+
+    clock.sleepFor(MAX_TIME_REQUIRED * NANOSECONDS_PER_MILLISECOND / 2);
+
+    BenchScheduler<FirstComeFirstServed> fcfs("First Come First Served");
+    BenchScheduler<PriorityScheduling> priority("Priority Scheduling");
+    BenchAgeingScheduler ageing("Priority Scheduling with Ageing", 1);
+    BenchScheduler<ShortestJobFirst> sjf("Shortest Job First");
+    BenchScheduler<RoundRobin> rr("Round Robin", 5 * NANOSECONDS_PER_SECOND);
+    BenchScheduler<ShortestRemainingTimeFirst> srtf("Shortest Remaining Time First", 5 * NANOSECONDS_PER_SECOND);
+
+    fcfs.setClock(&clock);
+    priority.setClock(&clock);
+    ageing.setClock(&clock);
+    sjf.setClock(&clock);
+    rr.setClock(&clock);
+    srtf.setClock(&clock);
+
+    long long iterations = getIterations(depth);
+    double nsPerOp = 0;
+
+    // addToReadyQueue
+    nsPerOp = measure(iterations, depth,
+        [&]() { fcfs.getReadyJobPool().clear(); },
+        [&]() {
+            for (auto it = jobs.begin(); it != jobs.end(); it++)
+                fcfs.addToReadyQueue(*it);
+        });
+    results.push_back({ "add_to_ready_queue", "all", depth, iterations, nsPerOp });
+
+    // Splice of the ready queue into the pending pool
+    nsPerOp = measure(iterations, 1,
+        [&]() {
+            fcfs.setPendingJobs({});
+            fcfs.getReadyJobPool().assign(jobs.begin(), jobs.end());
+        },
+        [&]() { fcfs.fetchReadyJobs(); });
+    results.push_back({ "fetch_ready_jobs", "all", depth, iterations, nsPerOp });
+
+    // Pick next job. FCFS and RR run the jobs in their order of arrival.
+    benchPickNext(fcfs, "fcfs", jobs, priorities, results);
+    benchPickNext(priority, "priority", jobs, priorities, results);
+    benchPickNext(ageing, "priority_ageing", jobs, priorities, results);
+    benchPickNext(sjf, "sjf", jobs, priorities, results);
+    benchPickNext(rr, "rr", jobs, priorities, results);
+    benchPickNext(srtf, "srtf", jobs, priorities, results);
+
+    // Ageing pass
+    nsPerOp = measure(iterations, 1,
+        [&]() {
+            for (size_t i = 0; i < jobs.size(); i++)
+                jobs[i]->setJobPriority(priorities[i]);
+            ageing.setPendingJobs(jobs);
+        },
+        [&]() { ageing.agePendingJobs(); });
+    results.push_back({ "ageing_pass", "priority_ageing", depth, iterations, nsPerOp });
+
+    // Ageing and pick of the lowest key, with and without the SIMD kernels
+    ageing.setPendingJobs(jobs);
+    benchKernels(jobs, priorities, ageing.getPendingJobPool(), clock, results);
+
+    // Completion of jobs anywhere in the pending pool
+    vector<Job*> sample;
+    long long sampleSize = min(depth, BENCH_COMPLETE_SAMPLE);
+    for (long long i = 0; i < sampleSize; i++)
+    {
+        Job *job = jobs[rng.generateRandomNumber((unsigned int)depth)];
+        if (find(sample.begin(), sample.end(), job) == sample.end())
+        {
+            job->setWaitingTime(0);
+            job->setResponseTime(job->getJobTimeRequired());
+            sample.push_back(job);
+        }
+    }
+
+    nsPerOp = measure(iterations, (long long)sample.size(),
+        [&]() {
+            fcfs.getCompletedJobPool().clear();
+            fcfs.setPendingJobs(jobs);
+        },
+        [&]() {
+            for (auto it = sample.begin(); it != sample.end(); it++)
+                fcfs.JobComplete(*it);
+        });
+    results.push_back({ "job_complete", "all", depth, iterations, nsPerOp });
+
+    // Stats display
+    int savedStdout = silenceStdout();
+    nsPerOp = measure(iterations, 1, [&]() {}, [&]() { fcfs.displayStats(); });
+    restoreStdout(savedStdout);
+    results.push_back({ "display_stats", "all", depth, iterations, nsPerOp });
+
+    // The jobs belong to the benchmark
+    fcfs.getReadyJobPool().clear();
+    for (auto it = jobs.begin(); it != jobs.end(); it++)
+    {
+        delete *it;
+    }
+}
+
+//******************************************************************************************
+// @name                    : benchDispatch
+//
+// @description             : Measures passes over a pending pool of new jobs of random
+//                            priority and time required, till all of them have been run
+//                            once, by the devirtualized pass of the algorithm and by the
+//                            virtual one, and by the devirtualized pass with the phases
+//                            not timed. They are run in turn on the same jobs, created
+//                            afresh before every run.
+//
+// @param algorithm         : Name of the algorithm in the results
+// @param depth             : Jobs in the pool
+// @param args              : Arguments of the constructor of the scheduler
+// @param results           : Results to add to
+//
+// @returns                 : Nothing
+//******************************************************************************************
+template<typename SCHEDULER, typename POLICY, typename... ARGS>
+static void benchDispatch(const string & algorithm, long long depth, vector<benchResult_st> & results, ARGS... args)
+{
+    long long iterations = getIterations(depth);
+    VirtualClock clock;
+    vector<Job*> jobs;
+
+    VirtualDispatchScheduler<SCHEDULER, POLICY> scheduler("Bench", args...);
+    scheduler.setClock(&clock);
+
+    auto setup = [&]() {
+        for (auto it = jobs.begin(); it != jobs.end(); it++)
+            delete *it;
+        jobs.clear();
+        scheduler.setPendingJobs({});
+        scheduler.getCompletedJobPool().clear();
+
+        RandomGenerator rng(BENCH_SEED);
+        for (long long i = 0; i < depth; i++)
+        {
+            jobSpec_st spec = jobSpec_st();
+            spec.jobId = (unsigned long)(i + 1);
+            spec.priority = rng.generateRandomNumber(JOB_PRIORITY_LOWEST);
+            spec.timeRequired = (rng.generateRandomNumber(MAX_TIME_REQUIRED) + 1) * NANOSECONDS_PER_MILLISECOND;
+            spec.arrivalTime = clock.now();
+
+            jobs.push_back(new Job(false, spec, 2, &clock));
+            scheduler.addToReadyQueue(jobs.back());
+        }
+        scheduler.fetchReadyJobs();
+    };
+
+    // Every job is dispatched once by a pass, or by each pass with QUEUE_MIN_FIRST
+    auto dispatch = [&]() {
+        for (long long pass = 0; pass < depth && scheduler.getPendingJobPool().size(); pass++)
+        {
+            scheduler.dispatchPendingJobs();
+            if (POLICY::QUEUE != QUEUE_MIN_FIRST)
+                break;
+        }
+    };
+    auto dispatchVirtually = [&]() {
+        for (long long pass = 0; pass < depth && scheduler.getPendingJobPool().size(); pass++)
+        {
+            scheduler.dispatchPendingJobsVirtually();
+            if (POLICY::QUEUE != QUEUE_MIN_FIRST)
+                break;
+        }
+    };
+    auto dispatchUntimed = [&]() {
+        scheduler.setPhaseTimersEnabled(false);
+        dispatch();
+        scheduler.setPhaseTimersEnabled(true);
+    };
+
+    vector<double> nsPerOp = measureInterleaved(iterations, depth, setup, { dispatch, dispatchVirtually, dispatchUntimed });
+    results.push_back({ "dispatch", algorithm, depth, iterations, nsPerOp[0] });
+    results.push_back({ "dispatch_virtual", algorithm, depth, iterations, nsPerOp[1] });
+    results.push_back({ "dispatch_untimed", algorithm, depth, iterations, nsPerOp[2] });
+
+    scheduler.setPendingJobs({});
+    for (auto it = jobs.begin(); it != jobs.end(); it++)
+    {
+        delete *it;
+    }
+}
+
+//******************************************************************************************
+// @name                    : benchSubmitBatch
+//
+// @description             : Measures the throughput of a producer thread adding jobs to
+//                            the ready queue in batches of 1 to 4096 jobs, while a scheduler
+//                            thread contends for the ready queue by fetching it in a loop.
+//
+// @param results           : Results to add to
+//
+// @returns                 : Nothing
+//******************************************************************************************
+static void benchSubmitBatch(vector<benchResult_st> & results)
+{
+    RandomGenerator rng(BENCH_SEED);
+    VirtualClock clock;
+
+    vector<Job*> jobs;
+    jobs.reserve(BENCH_SUBMIT_JOBS);
+    for (long long i = 0; i < BENCH_SUBMIT_JOBS; i++)
+    {
+        jobSpec_st spec = jobSpec_st();
+        spec.jobId = (unsigned long)(i + 1);
+        spec.priority = rng.generateRandomNumber(JOB_PRIORITY_LOWEST);
+        spec.timeRequired = (rng.generateRandomNumber(MAX_TIME_REQUIRED) + 1) * NANOSECONDS_PER_MILLISECOND;
+        spec.arrivalTime = 0;
+
+        jobs.push_back(new Job(false, spec, 2, &clock));
+    }
+
+    long long iterations = getIterations(BENCH_SUBMIT_JOBS);
+    for (size_t batchSize = 1; batchSize <= BENCH_MAX_BATCH_SIZE; batchSize *= 2)
+    {
+        BenchScheduler<FirstComeFirstServed> fcfs("First Come First Served");
+        fcfs.setClock(&clock);
+        vector<Job*> shedJobs;
+
+        double nsPerOp = measure(iterations, BENCH_SUBMIT_JOBS,
+            [&]() {
+                fcfs.getReadyJobPool().clear();
+                fcfs.setPendingJobs({});
+            },
+            [&]() {
+                atomic<bool> submitted(false);
+                thread schedulerThread([&]() {
+                    while (!submitted.load())
+                        fcfs.fetchReadyJobs();
+                });
+
+                for (size_t first = 0; first < jobs.size(); first += batchSize)
+                {
+                    size_t count = min(batchSize, jobs.size() - first);
+                    fcfs.addToReadyQueue(span<Job* const>(jobs.data() + first, count), shedJobs);
+                }
+
+                submitted = true;
+                schedulerThread.join();
+            });
+        results.push_back({ "submit_batch", "all", (long long)batchSize, iterations, nsPerOp });
+    }
+
+    for (auto it = jobs.begin(); it != jobs.end(); it++)
+    {
+        delete *it;
+    }
+}
+
+//******************************************************************************************
+// @name                    : writeResults
+//
+// @description             : Writes the results as CSV.
+//
+// @param file              : File to write to
+// @param results           : Results
+//
+// @returns                 : Nothing
+//******************************************************************************************
+static void writeResults(FILE *file, const vector<benchResult_st> & results)
+{
+    fprintf(file, "benchmark,algorithm,depth,iterations,ns_per_op\n");
+    for (auto it = results.begin(); it != results.end(); it++)
+    {
+        fprintf(file, "%s,%s,%lld,%lld,%.3lf\n", it->benchmark.c_str(), it->algorithm.c_str(), it->depth, it->iterations, it->nsPerOp);
+    }
+}
+
+//******************************************************************************************
+// @name                    : readResults
+//
+// @description             : Reads results written by writeResults().
+//
+// @param fileName          : Name of the file
+// @param results           : Results read, by benchmark, algorithm and depth
+//
+// @returns                 : true if the file could be read,
+//                            false otherwise
+//******************************************************************************************
+static bool readResults(const string & fileName, map<string, double> & results)
+{
+    FILE *file = fopen(fileName.c_str(), "r");
+    if (!file)
+    {
+        fprintf(stderr, "ERROR: Unable to open baseline '%s'\n", fileName.c_str());
+        return false;
+    }
+
+    char benchmark[64];
+    char algorithm[64];
+    long long depth = 0;
+    long long iterations = 0;
+    double nsPerOp = 0;
+
+    // Skip the header
+    fscanf(file, "%*[^\n]\n");
+    while (fscanf(file, "%63[^,],%63[^,],%lld,%lld,%lf\n", benchmark, algorithm, &depth, &iterations, &nsPerOp) == 5)
+    {
+        results[string(benchmark) + "," + algorithm + "," + to_string(depth)] = nsPerOp;
+    }
+
+    fclose(file);
+    return true;
+}
+
+//******************************************************************************************
+// @name                    : compareWithBaseline
+//
+// @description             : Reports the results that are slower than the baseline by more
+//                            than the tolerance.
+//
+// @param results           : Results of this run
+// @param config            : Configuration of the benchmark
+//
+// @returns                 : Number of regressions, -1 if the baseline could not be read
+//******************************************************************************************
+static int compareWithBaseline(const vector<benchResult_st> & results, const benchConfig_st & config)
+{
+    map<string, double> baseline;
+    if (!readResults(config.baselineFile, baseline))
+    {
+        return -1;
+    }
+
+    int regressions = 0;
+    for (auto it = results.begin(); it != results.end(); it++)
+    {
+        auto base = baseline.find(it->benchmark + "," + it->algorithm + "," + to_string(it->depth));
+        if (base == baseline.end() || base->second <= 0)
+        {
+            continue;
+        }
+
+        double change = (it->nsPerOp - base->second) / base->second;
+        if (change > config.tolerance)
+        {
+            fprintf(stderr, "REGRESSION: %s/%s at depth %lld: %.3lf ns -> %.3lf ns (+%.1lf %%)\n",
+                    it->benchmark.c_str(), it->algorithm.c_str(), it->depth, base->second, it->nsPerOp, change * 100);
+            regressions++;
+        }
+    }
+
+    fprintf(stderr, "%d regression(s) over %.0lf %% against '%s'\n", regressions, config.tolerance * 100, config.baselineFile.c_str());
+    return regressions;
+}
+
+//******************************************************************************************
+// @name                    : parseArguments
+//
+// @description             : Reads the command line, of the form --name=value or
+//                            --name value.
+//
+// @param config            : Configuration of the benchmark
+//
+// @returns                 : true if all the arguments were valid,
+//                            false otherwise
+//******************************************************************************************
+static bool parseArguments(int argc, char *argv[], benchConfig_st & config)
+{
+    for (int i = 1; i < argc; i++)
+    {
+        string name = argv[i];
+        string value;
+        size_t separator = name.find('=');
+        if (separator != string::npos)
+        {
+            value = name.substr(separator + 1);
+            name = name.substr(0, separator);
+        }
+        else if (i + 1 < argc)
+        {
+            value = argv[++i];
+        }
+
+        if (name == "--min_depth")          config.minDepth = atoll(value.c_str());
+        else if (name == "--max_depth")     config.maxDepth = atoll(value.c_str());
+        else if (name == "--output")        config.outputFile = value;
+        else if (name == "--baseline")      config.baselineFile = value;
+        else if (name == "--tolerance")     config.tolerance = atof(value.c_str());
+        else
+        {
+            fprintf(stderr, "Usage: %s [--min_depth N] [--max_depth N] [--output FILE] [--baseline FILE] [--tolerance FRACTION]\n", argv[0]);
+            return false;
+        }
+    }
+
+    return (config.minDepth > 0 && config.maxDepth >= config.minDepth && config.tolerance >= 0);
+}
+
+/*-----------------------------------------------------------------------------------------------------
+M A I N
+--------
+Runs the benchmarks at depths 10, 100, ... up to the max depth, and writes the results. Exits with
+status 1 if there is any regression against the baseline, 2 on invalid arguments.
+-----------------------------------------------------------------------------------------------------*/
+int main(int argc, char *argv[])
+{
+    benchConfig_st config;
+    config.minDepth = 10;
+    config.maxDepth = 10000000;
+    config.tolerance = 0.25;
+
+    if (!parseArguments(argc, argv, config))
+    {
+        return 2;
+    }
+
+    // Keep the scheduler banners out of the way
+    Logger::getInstance().setLevel(LOG_LEVEL_WARNING);
+
+    vector<benchResult_st> results;
+    for (long long depth = config.minDepth; depth <= config.maxDepth; depth *= 10)
+    {
+        fprintf(stderr, "Benchmarking depth %lld...\n", depth);
+        benchDepth(depth, results);
+
+        if (depth <= BENCH_MAX_DISPATCH_DEPTH)
+        {
+            benchDispatch<FirstComeFirstServed, FcfsPolicy>("fcfs", depth, results);
+            benchDispatch<PriorityScheduling, PriorityPolicy>("priority", depth, results);
+            benchDispatch<PriorityAgeingScheduling, PriorityAgeingPolicy>("priority_ageing", depth, results, 1u);
+            benchDispatch<ShortestJobFirst, SjfPolicy>("sjf", depth, results);
+        }
+        if (depth <= BENCH_MAX_SCAN_DEPTH)
+        {
+            benchDispatch<RoundRobin, RoundRobinPolicy>("rr", depth, results, 5 * NANOSECONDS_PER_SECOND);
+            benchDispatch<ShortestRemainingTimeFirst, SrtfPolicy>("srtf", depth, results, 5 * NANOSECONDS_PER_SECOND);
+        }
+    }
+
+    fprintf(stderr, "Benchmarking batch submission...\n");
+    benchSubmitBatch(results);
+
+    FILE *file = config.outputFile.empty() ? stdout : fopen(config.outputFile.c_str(), "w");
+    if (!file)
+    {
+        fprintf(stderr, "ERROR: Unable to create '%s'\n", config.outputFile.c_str());
+        return 2;
+    }
+
+    writeResults(file, results);
+    if (file != stdout)
+    {
+        fclose(file);
+    }
+
+    if (config.baselineFile.size() && compareWithBaseline(results, config) != 0)
+    {
+        return 1;
+    }
+
+    return 0;
+}
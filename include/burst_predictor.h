@@ -0,0 +1,101 @@
+#ifndef _BURST_PREDICTOR_H_
+#define _BURST_PREDICTOR_H_
+
+#include<string>
+#include<vector>
+#include "checkpoint.h"
+#include "job.h"
+
+using namespace std;
+
+//---------------------------------------------------------------------------------------------------
+// Globals
+//---------------------------------------------------------------------------------------------------
+const unsigned int BURST_CLASS_PRIORITY_LEVELS = 64;  // Priority levels in a job class
+
+//---------------------------------------------------------------------------------------------------
+// Enums and structures
+//---------------------------------------------------------------------------------------------------
+typedef enum
+{
+    BURST_ESTIMATOR_EXPONENTIAL,                      // Exponential average of the previous bursts
+    BURST_ESTIMATOR_LAST,                             // Previous burst
+    BURST_ESTIMATOR_MEAN                              // Mean of all the previous bursts
+}burstEstimator_en;
+
+//-------------------------------------------------------------------------------------------------
+// BurstEstimator updates an estimate of the next CPU burst with a burst that has been observed.
+// Implement it to plug another estimator into a BurstPredictor.
+//-------------------------------------------------------------------------------------------------
+class BurstEstimator
+{
+public:
+    virtual ~BurstEstimator() {}
+    virtual const char* getName() = 0;
+    virtual void update(burstEstimate_st & estimate, long long burst) = 0;
+};
+
+//-------------------------------------------------------------------------------------------------
+// Exponential averaging: tau(n+1) = alpha * t(n) + (1 - alpha) * tau(n), where t(n) is the burst
+// just observed and tau(n) the estimate it was predicted with. A high alpha follows the recent
+// bursts, a low one the history.
+//-------------------------------------------------------------------------------------------------
+class ExponentialAverageEstimator : public BurstEstimator
+{
+private:
+    double                                  m_alpha;                      // Weight of the last burst, in (0, 1]
+
+public:
+    ExponentialAverageEstimator(double alpha) { m_alpha = alpha; }
+    const char* getName() { return "exponential average"; }
+    void update(burstEstimate_st & estimate, long long burst);
+};
+
+class LastBurstEstimator : public BurstEstimator
+{
+public:
+    const char* getName() { return "last burst"; }
+    void update(burstEstimate_st & estimate, long long burst);
+};
+
+class MeanBurstEstimator : public BurstEstimator
+{
+public:
+    const char* getName() { return "mean burst"; }
+    void update(burstEstimate_st & estimate, long long burst);
+};
+
+//-------------------------------------------------------------------------------------------------
+// BurstPredictor predicts the next CPU burst of jobs, for schedulers that cannot know it (e.g.
+// SJF in practice). A job that has done CPU bursts before is predicted from its own history.
+// A new job, or one that does a single burst, is predicted from the history of its class, i.e.
+// of the jobs within the same BURST_CLASS_PRIORITY_LEVELS priority levels, and from the initial
+// estimate if none of its class has completed a burst yet. The prediction of a burst is made
+// once, when it is first asked for, and kept till the burst is observed, so the error measured
+// is the one of the prediction the scheduler used. Used by the scheduler thread only.
+//-------------------------------------------------------------------------------------------------
+class BurstPredictor
+{
+private:
+    BurstEstimator*                         m_estimator;                  // Owned
+    long long                               m_initialEstimate;            // Prediction (ns) while nothing is known
+    vector<burstEstimate_st>                m_classEstimates;             // Indexed by job class
+
+    burstEstimate_st & getClassEstimate(Job *job);
+
+public:
+    BurstPredictor(BurstEstimator *estimator, long long initialEstimate);
+    ~BurstPredictor();
+
+    const char* getEstimatorName() { return m_estimator->getName(); }
+    long long predict(Job *job);
+    long long observe(Job *job);
+
+    void saveCheckpoint(CheckpointWriter & writer);
+    bool restoreCheckpoint(CheckpointReader & reader);
+
+    static BurstPredictor* create(burstEstimator_en kind, double alpha, long long initialEstimate);
+    static bool parseEstimator(const string & name, burstEstimator_en & kind);
+};
+
+#endif
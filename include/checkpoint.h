@@ -0,0 +1,76 @@
+#ifndef _CHECKPOINT_H_
+#define _CHECKPOINT_H_
+
+#include<stdio.h>
+#include<string>
+#include<type_traits>
+
+using namespace std;
+
+//-------------------------------------------------------------------------------------------------
+// CheckpointWriter writes the state of a simulation to a compact binary checkpoint file. Values
+// are written as they are in memory, so a checkpoint can only be restored by a build of the
+// same program on the same kind of machine. The checkpoint is written to a temporary file,
+// which replaces the checkpoint file only once it is complete, so an interrupted write never
+// loses the previous checkpoint.
+//-------------------------------------------------------------------------------------------------
+class CheckpointWriter
+{
+private:
+    FILE*                                   m_file;
+    string                                  m_fileName;                   // Checkpoint file
+    string                                  m_tempFileName;               // File being written
+    bool                                    m_failed;                     // A write has failed
+
+public:
+    CheckpointWriter();
+    ~CheckpointWriter();
+
+    bool open(const string & fileName);
+    bool commit();
+    bool hasFailed() { return m_failed; }
+
+    void writeBytes(const void *data, size_t size);
+    void writeString(const string & value);
+
+    template<typename T>
+    void write(const T & value)
+    {
+        static_assert(is_trivially_copyable<T>::value, "Only plain values can be written as they are");
+        writeBytes(&value, sizeof(T));
+    }
+};
+
+//-------------------------------------------------------------------------------------------------
+// CheckpointReader reads back a checkpoint file written by CheckpointWriter, in the same order.
+// Reading past the end of the file, or a size that does not match, marks the reader as failed;
+// the values read from then on are zero.
+//-------------------------------------------------------------------------------------------------
+class CheckpointReader
+{
+private:
+    FILE*                                   m_file;
+    bool                                    m_failed;                     // A read has failed
+
+public:
+    CheckpointReader();
+    ~CheckpointReader();
+
+    bool open(const string & fileName);
+    bool hasFailed() { return m_failed; }
+    void setFailed() { m_failed = true; }
+
+    void readBytes(void *data, size_t size);
+    string readString();
+
+    template<typename T>
+    T read()
+    {
+        static_assert(is_trivially_copyable<T>::value, "Only plain values can be read as they are");
+        T value;
+        readBytes(&value, sizeof(T));
+        return value;
+    }
+};
+
+#endif
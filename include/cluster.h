@@ -0,0 +1,151 @@
+#ifndef _CLUSTER_H_
+#define _CLUSTER_H_
+
+#include<map>
+#include<string>
+#include<utility>
+#include<vector>
+#include "process_scheduler.h"
+#include "random.h"
+#include "simulation_clock.h"
+#include "workload.h"
+
+using namespace std;
+
+class Cluster;
+
+//---------------------------------------------------------------------------------------------------
+// Enums and structures
+//---------------------------------------------------------------------------------------------------
+
+// How the dispatcher of a cluster places an arriving job on a node
+typedef enum
+{
+    LOAD_BALANCING_RANDOM,                            // Any node, at random
+    LOAD_BALANCING_ROUND_ROBIN,                       // Each node in turn
+    LOAD_BALANCING_JSQ,                               // Node with the fewest jobs (join the shortest queue)
+    LOAD_BALANCING_POWER_OF_TWO,                      // Node with the fewer jobs of two at random
+
+    // This should be last
+    LOAD_BALANCING_MAX
+}loadBalancing_en;
+
+// Setup of a cluster
+typedef struct
+{
+    unsigned int            nodes;                    // Nodes, each a scheduler on a single CPU
+    loadBalancing_en        balancing;                // Placement of the arriving jobs
+    long long               networkDelay;             // Time (ns) a job takes to reach its node
+    long long               networkJitter;            // Max time (ns) a job may take on top of the delay
+    double                  load;                     // Load of each node the arrivals are scaled to, 0 to keep them
+    unsigned int            seed;                     // Seed of the placements and jitter, 0 for random
+}clusterSetup_st;
+
+typedef struct
+{
+    string                  schedulerName;            // Scheduling algorithm of the nodes
+    string                  balancingName;            // Placement of the arriving jobs
+    unsigned int            nodes;                    // Nodes of the cluster
+    size_t                  completedJobs;            // Jobs completed by all the nodes
+    size_t                  shedJobs;                 // Jobs rejected by the nodes on arrival
+    double                  avgWaitingTime;           // Average waiting time (ns), network delay included
+    double                  avgResponseTime;          // Average response time (ns), network delay included
+    long long               p50ResponseTime;          // Median response time (ns)
+    long long               p99ResponseTime;          // 99th percentile of the response time (ns)
+    long long               p999ResponseTime;         // 99.9th percentile of the response time (ns)
+    long long               maxResponseTime;          // Max response time (ns)
+    double                  cpuUtilization;           // %age of the time the CPUs of the nodes were executing jobs
+    double                  loadImbalance;            // Jobs placed on the busiest node / average jobs per node
+    long long               simulatedTime;            // Time (ns) elapsed on the clock of the cluster
+    long long               wallTime;                 // Time (ms) taken by this simulation
+}clusterResult_st;
+
+//-------------------------------------------------------------------------------------------------
+// ClusterNodeLink carries the jobs placed on a node by the dispatcher of a cluster over the
+// network, and feeds them to the node once they reach it. The next arrival of a node is only
+// known once the dispatcher has placed a job on it, so an idle node waits till it is woken.
+// Nodes of a cluster are not checkpointed.
+//-------------------------------------------------------------------------------------------------
+class ClusterNodeLink : public JobFeeder
+{
+private:
+    Cluster*                                m_cluster;                    // Cluster of the node
+    SimulationClock*                        m_clock;                      // Clock of the cluster
+    map<pair<long long, unsigned long long>, Job*> m_inFlight;           // Jobs by (delivery time, order of sending)
+    unsigned long long                      m_sentJobs;                   // Jobs sent to the node so far
+    vector<Job*>                            m_dueJobs;                    // Jobs being delivered, kept to reuse its memory
+    vector<Job*>                            m_shedJobs;                   // Jobs shed by the node
+
+public:
+    ClusterNodeLink(Cluster *cluster, SimulationClock *clock);
+    ~ClusterNodeLink();
+
+    void send(Job *job, long long tsDelivery);
+    unsigned long long getSentJobs() { return m_sentJobs; }
+    size_t getInFlightJobs() { return m_inFlight.size(); }
+
+    bool isExhausted();
+    long long getNextArrivalTime();
+    bool areArrivalsKnown() { return false; }
+    void releaseDueJobs(ProcessScheduler *scheduler);
+
+    void saveCheckpoint(CheckpointWriter & writer);
+    bool restoreCheckpoint(CheckpointReader & reader);
+};
+
+//-------------------------------------------------------------------------------------------------
+// Cluster simulates many machines in one process: each node is a scheduler of its own, on a
+// single CPU, and a dispatcher places every job of a workload on a node as it arrives, as per
+// a load balancing policy. A job reaches its node after the network delay, plus a random jitter,
+// and counts as waiting from its arrival at the dispatcher.
+//
+// The dispatcher and the nodes each run on a thread of their own, taking turns on a single
+// LockstepClock over a VirtualClock, so the cluster runs as fast as its events can be processed
+// and a run is repeatable. An idle node waits till the dispatcher wakes it, at the delivery of
+// the next job placed on it, so idle nodes cost nothing and a cluster scales to thousands of
+// nodes. Join the shortest queue counts the jobs placed on a node that are not complete yet,
+// including those still on their way, as the dispatcher of a real cluster would.
+//-------------------------------------------------------------------------------------------------
+class Cluster
+{
+private:
+    const Workload &                        m_workload;                   // Jobs to be dispatched
+    clusterSetup_st                         m_setup;                      // Setup of the cluster
+    bool                                    m_showJobStatus;              // Show details of job running status
+    int                                     m_responseTimeThreshold;      // Threshold for job response time
+    vector<ProcessScheduler*>               m_nodes;                      // Scheduler of each node
+    vector<ClusterNodeLink*>                m_links;                      // Link to each node
+    RandomGenerator                         m_rng;                        // Draws the placements
+    RandomGenerator                         m_networkRng;                 // Draws the jitter, the same whatever the placements
+    unsigned int                            m_nextNode;                   // Next node of round robin
+    double                                  m_arrivalScale;               // Factor applied to the arrival times
+    LockstepClock*                          m_clock;                      // Clock of the cluster while it runs
+    bool                                    m_dispatchComplete;           // All the jobs have been dispatched
+    long long                               m_simulatedTime;              // Time (ns) the last run took on its clock
+    long long                               m_wallTime;                   // Time (ms) the last run took
+
+    void dispatchJobs();
+    void runNode(unsigned int node);
+    unsigned int selectNode();
+    unsigned long long getQueueLength(unsigned int node);
+    long long drawNetworkDelay();
+    void setArrivalScale();
+
+    static long long getPercentile(const vector<long long> & sortedTimes, double percentile);
+
+public:
+    Cluster(const Workload & workload, const clusterSetup_st & setup, bool showJobStatus, int responseTimeThreshold);
+    ~Cluster();
+
+    void addNode(ProcessScheduler *scheduler);
+    size_t getNodeCount() { return m_nodes.size(); }
+    bool isDispatchComplete() { return m_dispatchComplete; }
+    bool run();
+    void getResult(clusterResult_st & result);
+
+    static bool parseLoadBalancing(const string & name, loadBalancing_en & balancing);
+    static const char* getLoadBalancingName(loadBalancing_en balancing);
+    static void displayResults(const vector<clusterResult_st> & results);
+};
+
+#endif
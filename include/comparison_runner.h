@@ -0,0 +1,51 @@
+#ifndef _COMPARISON_RUNNER_H_
+#define _COMPARISON_RUNNER_H_
+
+#include<string>
+#include<vector>
+#include "process_scheduler.h"
+#include "workload.h"
+
+using namespace std;
+
+//-------------------------------------------------------------------------------------------------
+// ComparisonRunner simulates several schedulers at the same time. Every scheduler runs on its
+// own thread and is fed from its own feeder thread, but all the feeders read the same shared
+// Workload, so every scheduler sees exactly the same jobs arriving at the same instants.
+// The wall time of a comparison is therefore that of the slowest scheduler, rather than the
+// sum of all of them. With a virtual clock, each scheduler is fed from its own thread instead.
+//-------------------------------------------------------------------------------------------------
+class ComparisonRunner
+{
+private:
+    const Workload &                        m_workload;                   // Jobs fed to every scheduler
+    bool                                    m_showJobStatus;              // Show details of job running status
+    int                                     m_responseTimeThreshold;      // Threshold for job response time
+    bool                                    m_useVirtualClock;            // Simulate each scheduler on its own virtual clock
+    size_t                                  m_submitBatchSize;            // Jobs the feeder threads add at once
+    long long                               m_submitBatchWindow;          // Max time (ns) the feeder threads hold a job back
+    vector<ProcessScheduler*>               m_schedulers;                 // Schedulers being compared, owned by the runner
+    vector<simulationResult_st>             m_results;                    // Result of each scheduler, same order as m_schedulers
+    long long                               m_wallTime;                   // Time (ms) taken by the whole comparison
+
+    void runScheduler(ProcessScheduler *scheduler, simulationResult_st *result);
+    void feedWorkload(ProcessScheduler *scheduler);
+    void displayPredictionResults();
+    void displayCpuResults();
+    void displayGangResults();
+    void displayTenantResults();
+
+public:
+    ComparisonRunner(const Workload & workload, bool showJobStatus, int responseTimeThreshold, bool useVirtualClock);
+    ~ComparisonRunner();
+
+    void addScheduler(ProcessScheduler *scheduler);
+    void setSubmitBatching(size_t batchSize, long long batchWindow);
+    size_t getSchedulerCount() { return m_schedulers.size(); }
+    bool run();
+    void displayResults();
+    bool saveStatsSeries(const string & fileName);
+    const vector<simulationResult_st> & getResults() { return m_results; }
+};
+
+#endif
@@ -0,0 +1,235 @@
+#ifndef _CONFIG_H_
+#define _CONFIG_H_
+
+#include<string>
+#include<vector>
+#include "burst_predictor.h"
+#include "cluster.h"
+#include "logger.h"
+#include "process_scheduler.h"
+#include "simd_kernels.h"
+#include "worker_pool.h"
+#include "workload.h"
+
+using namespace std;
+
+//---------------------------------------------------------------------------------------------------
+// Enums and structures
+//---------------------------------------------------------------------------------------------------
+
+// CONFIGURATIONS - Alter to vary simulation results. Defaults are set by setDefaultConfig() and
+// can be overridden from a config file and the command line. See displayUsage() for the names.
+typedef struct
+{
+    // Scheduling algorithm to use. Name of a scheduler in the SchedulerRegistry.
+    string                  schedulingAlgorithm;
+
+    // Simulate all the algorithms.
+    bool                    simulateAll;
+
+    // When simulating all the algorithms, run them at the same time on independent
+    // threads, all fed from the same pre-generated workload.
+    bool                    simulateInParallel;
+
+    // Time quantum (in nanoseconds) to be used. This is used in case of Round-Robin scheduling
+    // algorithm. This is the maximum time window a job will be allocated for execution.
+    // Given in milliseconds (fractions allowed) in config files and on the command line.
+    // Shortest Remaining Time First also preempts jobs after it to check for arrivals, when
+    // they are not known in advance.
+    long long               timeQuantum;
+
+    // Priority levels gained by a job in each ageing pass, once it has waited as long
+    // as its time required. Used in case of Priority Scheduling with Ageing.
+    unsigned int            ageingRate;
+
+    // Estimator of the CPU bursts used by the predicted variants of SJF and SRTF
+    // (exponential, last or mean), the weight of the last burst for exponential averaging,
+    // and the prediction (in ns, given in ms) of a job class with no history.
+    burstEstimator_en       burstEstimator;
+    double                  burstAlpha;
+    long long               burstInitialEstimate;
+
+    // Number of jobs for which simulation has to be done.
+    // use '-1' to create jobs continuously.
+    long int                jobsToCreate;
+
+    // This parameter identifies the jobs whose response time period exceeds the 
+    // permissible value in comparison to its time required for completion.
+    int                     responseTimeThreshold;
+
+    // Show details of job running status
+    bool                    showJobStatus;
+
+    // Admission control: shed arriving jobs once admission_max_jobs jobs are in the
+    // scheduler, once the estimated wait exceeds admission_max_wait (in ns, given in ms),
+    // or if they are estimated to exceed their response time threshold. Use 0 (false)
+    // for no limit.
+    unsigned int            admissionMaxJobs;
+    long long               admissionMaxWait;
+    bool                    admissionRejectLate;
+
+    // Jobs created by a job creation thread are added to the ready queue in batches of
+    // submit_batch_size jobs, or of the jobs created within submit_batch_window (in ns,
+    // given in ms) of the first one, whichever is smaller. Use 1 (and 0) to add every
+    // job as soon as it is created.
+    unsigned int            submitBatchSize;
+    long long               submitBatchWindow;
+
+    // Use random sleep duration for creation thread
+    bool                    useRandomJobCreationSleep;
+
+    // Seconds to wait before displaying statistics
+    // Use -1 to display the stats only at the end of simulation.
+    int                     statsDisplayInterval;
+
+    // Sample the state of each scheduler every stats_sample_interval (in ns, given in ms) of
+    // its clock, and show the rates over the last stats_window (in ns, given in seconds) with
+    // the stats. Use 0 not to sample. The latest stats_series_size samples are written to the
+    // CSV file stats_series_file at the end of the simulations, if set.
+    long long               statsSampleInterval;
+    long long               statsWindow;
+    string                  statsSeriesFile;
+    unsigned int            statsSeriesSize;
+
+    // Max time duration (ms) before proceeding to create another job.
+    int                     jobCreationSleepMax;
+
+    // Milliseconds before proceeding to create another job
+    int                     jobCreationSleepConst;
+
+    // Simulate on a virtual clock. Time moves ahead instantly instead of sleeping,
+    // so a simulation takes milliseconds instead of hours.
+    bool                    useVirtualClock;
+
+    // CPUs of each scheduler, sharing its pools (see ProcessScheduler). With cpu_affinity,
+    // a CPU only takes a job that last ran on another CPU when it has nothing else to run.
+    // A migrated job warms up for migration_cost (in ns, given in ms) of the CPU it
+    // migrates to. Needs a virtual clock when more than 1.
+    unsigned int            cpus;
+    bool                    cpuAffinity;
+    long long               migrationCost;
+
+    // Mean cost (in ns, given in ms) of switching a CPU to another job, and the distribution
+    // it is drawn from (fixed, uniform or exponential). Charged whenever the job dispatched
+    // on a CPU is not the one it ran last. Use 0 for free context switches.
+    long long               contextSwitchCost;
+    switchCostDistribution_en contextSwitchDistribution;
+
+    // Seed of the generated workload. Use 0 for a random seed.
+    unsigned int            seed;
+
+    // Save a checkpoint of the simulation to checkpoint_file every checkpoint_interval
+    // of simulated time (in ns, given in s), and resume a simulation from the checkpoint
+    // in restore_checkpoint. Needs a virtual clock, and the same seed and workload options
+    // to restore. Leave the files empty to disable.
+    string                  checkpointFile;
+    long long               checkpointInterval;
+    string                  restoreCheckpointFile;
+
+    // PARAMETER SWEEP - Every combination of the values below is simulated for every
+    // algorithm, on a virtual clock and in parallel on all the cores.
+    bool                    runParameterSweep;
+    vector<long long>       sweepTimeQuanta;              // In ns, given in ms like timeQuantum
+    vector<int>             sweepResponseTimeThresholds;
+    vector<double>          sweepLoadFactors;             // Avg time required by job / avg time between arrivals
+    vector<unsigned int>    sweepAgeingRates;
+    vector<unsigned int>    sweepSeeds;
+    long int                sweepJobsPerRun;
+    string                  sweepResultsFile;
+
+    // Worker threads used by the parameter sweep. Use 0 to use all the cores.
+    unsigned int            threads;
+
+    // Binary file to record the scheduling events of all the schedulers to. Leave
+    // empty to disable tracing.
+    string                  traceFile;
+
+    // Chrome trace JSON file the trace is exported to at the end. Leave empty to
+    // keep only the binary trace.
+    string                  chromeTraceFile;
+
+    // Lowest severity of the log records written (debug, info, warning, error or none).
+    logLevel_en             logLevel;
+
+    // File the log is written to. Leave empty to log to stderr.
+    string                  logFile;
+
+    // Time each phase of the schedulers (fetch, order, dispatch, work, complete) and
+    // show the split in the stats.
+    bool                    usePhaseTimers;
+
+    // Also count CPU cycles and cache misses of each phase. Needs perf_event_open.
+    bool                    useHardwareCounters;
+
+    // Instruction set of the kernels of the schedulers (ageing, pick of the lowest key):
+    // scalar, avx2 or avx512. Defaults to the best one the CPU supports.
+    simdLevel_en            simdLevel;
+
+    // Real execution mode: run a CPU bound kernel (spin, sort or matmul) as the work of
+    // each job instead of sleeping. Use none to simulate the work.
+    payloadKernel_en        payloadKernel;
+
+    // CPU time of a job's kernel per unit of its time required, e.g. 0.001 runs a job
+    // requiring 5 s for 5 ms of CPU time.
+    double                  payloadScale;
+
+    // Run the kernels as coroutines, which Round Robin preempts at the end of each time
+    // quantum, instead of running them to completion.
+    bool                    payloadPreemptible;
+
+    // Worker threads running the kernels, shared by all the schedulers. Use 0 to run
+    // them on the scheduler threads.
+    unsigned int            workers;
+
+    // Fraction of the jobs alternating between CPU and I/O bursts, up to io_bursts_max
+    // I/O bursts of up to io_burst_time_max (ms) each, on one of io_devices devices.
+    // Use 0 for pure CPU jobs.
+    double                  ioJobRatio;
+    unsigned int            ioBurstsMax;
+    long long               ioBurstTimeMax;               // In ns, given in ms
+    unsigned int            ioDevices;
+
+    // Fraction of the parallel jobs, which run on 2 to job_width_max CPUs at once, each
+    // for their time required. Only the gang schedulers run them on several CPUs; the
+    // other algorithms run every job as a single thread. Use 0 for single thread jobs.
+    double                  parallelJobRatio;
+    unsigned int            jobWidthMax;
+
+    // TENANT GROUPS - Share the CPUs between tenant groups, as a comma separated list of
+    // path:weight[:quota[:jobs]], parents first, e.g. "web:3,batch:1:0.5,batch/etl:1::2".
+    // Sibling groups share the CPU time of their parent by weight. A quota caps a group, its
+    // subgroups included, at so many CPUs' worth of time per tenant_quota_period (in ns,
+    // given in ms). Jobs are submitted to the groups without subgroups, in proportion of
+    // their share of the jobs (1 by default). Leave empty for a single tenant.
+    vector<tenantGroupSetup_st> tenantGroups;
+    long long               tenantQuotaPeriod;
+
+    // CLUSTER - Simulate each algorithm on cluster_nodes single CPU nodes behind a dispatcher,
+    // which places every arriving job on a node as per load_balancing (random, round_robin,
+    // jsq, power_of_two, or all to compare them). A job reaches its node network_delay (in ns,
+    // given in ms) after it arrives, plus up to network_jitter. With cluster_load, arrivals are
+    // scaled so that each node gets that load. Needs a virtual clock. Use 0 nodes to simulate
+    // a single machine.
+    unsigned int            clusterNodes;
+    loadBalancing_en        loadBalancing;                // LOAD_BALANCING_MAX for all of them
+    long long               networkDelay;
+    long long               networkJitter;
+    double                  clusterLoad;
+}simulationConfig_st;
+
+//---------------------------------------------------------------------------------------------------
+// Functions
+//---------------------------------------------------------------------------------------------------
+void setDefaultConfig(simulationConfig_st & config);
+void getIoProfile(const simulationConfig_st & config, ioProfile_st & profile);
+void getParallelProfile(const simulationConfig_st & config, parallelProfile_st & profile);
+void getAdmissionPolicy(const simulationConfig_st & config, admissionPolicy_st & policy);
+void getContextSwitchCost(const simulationConfig_st & config, contextSwitchCost_st & cost);
+void getClusterSetup(const simulationConfig_st & config, clusterSetup_st & setup);
+void getTenantProfile(const simulationConfig_st & config, tenantProfile_st & profile);
+bool setConfigOption(const string & name, const string & value, simulationConfig_st & config);
+bool loadConfigFile(const string & fileName, simulationConfig_st & config);
+bool parseCommandLine(int argc, char *argv[], simulationConfig_st & config, bool & showHelp);
+void displayUsage(const char *programName);
+
+#endif
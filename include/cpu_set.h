@@ -0,0 +1,97 @@
+#ifndef _CPU_SET_H_
+#define _CPU_SET_H_
+
+#include<string>
+#include<vector>
+#include "job.h"
+#include "simulation_clock.h"
+
+using namespace std;
+
+//---------------------------------------------------------------------------------------------------
+// Enums and structures
+//---------------------------------------------------------------------------------------------------
+
+// Distribution of the cost of a context switch
+typedef enum
+{
+    SWITCH_COST_FIXED,                                // Every switch costs the mean
+    SWITCH_COST_UNIFORM,                              // Uniform between 0 and twice the mean
+    SWITCH_COST_EXPONENTIAL,                          // Exponential with the mean, i.e. mostly cheap with a long tail
+
+    // This should be last
+    SWITCH_COST_MAX
+}switchCostDistribution_en;
+
+// Cost of switching a CPU from one job to another, i.e. of saving the state of the job it ran
+// last and loading that of the job dispatched. The CPU does no useful work in the meantime.
+typedef struct
+{
+    long long               meanCost;                 // Mean time (ns) of a context switch, 0 for free switches
+    switchCostDistribution_en distribution;           // Distribution the cost of each switch is drawn from
+    unsigned int            seed;                     // Seed of the costs drawn
+}contextSwitchCost_st;
+
+// State of a CPU of a scheduler
+typedef struct
+{
+    long long               tsBusyUntil;              // timestamp when the job running on it is due to stop, -1 if idle
+    long long               overheadTime;             // Time (ns) it spends switching to the job dispatched on it first
+    unsigned long           lastJobId;                // Job last dispatched on it, 0 if none
+    bool                    hasAffineJob;             // A pending job could run on it without migrating, as of its last fetch
+    int                     tenantGroup;              // Tenant group whose jobs it runs next, -1 if none may run
+    bool                    tenantGroupPicked;        // tenantGroup is up to date
+}cpuState_st;
+
+//-------------------------------------------------------------------------------------------------
+// CpuSet holds the CPUs of a scheduler and what it costs to run jobs on them. On a virtual clock,
+// several CPUs share the pools of the scheduler, each running ProcessJobs() on a thread of its
+// own, on a LockstepClock, so only one CPU runs at a time. A job dispatched on another CPU than
+// the one it last ran on has to warm up the caches of its new CPU first, which takes the
+// migration cost off that CPU. With CPU affinity, a CPU only takes such a job when it has nothing
+// else to run.
+//
+// Whenever the job dispatched on a CPU is not the one it ran last, the CPU first spends the cost
+// of a context switch, drawn from the distribution set, before the time slice of the job. The
+// costs are a function of the number of the switch, so a run restored from a checkpoint draws
+// the same costs.
+//
+// Used by the scheduler thread only, i.e. by the CPU running.
+//-------------------------------------------------------------------------------------------------
+class CpuSet
+{
+private:
+    unsigned int                            m_count;                      // CPUs sharing the pools
+    bool                                    m_affinity;                   // Migrate jobs only when a CPU has nothing else to run
+    long long                               m_migrationCost;              // Time (ns) a job takes to warm up on another CPU
+    contextSwitchCost_st                    m_switchCost;                 // Cost of switching a CPU to another job
+    LockstepClock*                          m_lockstepClock;              // Clock shared by the CPUs while they run, if several
+    vector<cpuState_st>                     m_cpus;                       // State of each CPU
+
+public:
+    CpuSet();
+
+    void setup(unsigned int count, bool affinity, long long migrationCost);
+    void setContextSwitchCost(const contextSwitchCost_st & cost) { m_switchCost = cost; }
+    unsigned int getCount() const { return m_count; }
+    bool hasAffinity() const { return m_affinity; }
+    long long getMigrationCost() const { return m_migrationCost; }
+
+    void attachLockstepClock(LockstepClock *clock);                       // The CPUs start running, each on a thread of its own
+    void detachLockstepClock() { m_lockstepClock = nullptr; }
+    LockstepClock* getLockstepClock() { return m_lockstepClock; }         // nullptr unless several CPUs are running
+    unsigned int getCurrent() { return m_lockstepClock ? m_lockstepClock->getRunningParticipant() : 0; }
+    cpuState_st & getState(unsigned int cpu) { return m_cpus[cpu]; }
+    cpuState_st & getCurrentState() { return m_cpus[getCurrent()]; }
+
+    bool isMigration(Job *job);                                           // Running the job on the calling CPU would migrate it
+    long long drawSwitchCost(unsigned long long switchNumber) const;
+    long long takeOverhead();                                             // Time the calling CPU spends before its time slice
+    long long getNextStopTime() const;                                    // When the first of the busy CPUs stops
+    void repickTenantGroups();                                            // Every CPU has to pick a tenant group again
+
+    static bool parseSwitchCostDistribution(const string & name, switchCostDistribution_en & distribution);
+    static const char* getSwitchCostDistributionName(switchCostDistribution_en distribution);
+};
+
+#endif
@@ -0,0 +1,180 @@
+#ifndef _EVENT_TRACE_H_
+#define _EVENT_TRACE_H_
+
+#include<atomic>
+#include<condition_variable>
+#include<mutex>
+#include<stdio.h>
+#include<string>
+#include<thread>
+#include<vector>
+
+using namespace std;
+
+//---------------------------------------------------------------------------------------------------
+// Enums and structures
+//---------------------------------------------------------------------------------------------------
+typedef enum
+{
+    TRACE_EVENT_ARRIVE,                               // Job added to the ready queue
+    TRACE_EVENT_DISPATCH,                             // Job started executing on a CPU
+    TRACE_EVENT_PREEMPT,                              // Job stopped executing before completion
+    TRACE_EVENT_COMPLETE,                             // Job completed
+    TRACE_EVENT_BLOCK,                                // Job started an I/O burst
+    TRACE_EVENT_WAKE,                                 // I/O burst of the job completed
+    TRACE_EVENT_END                                   // End of events in a trace file
+}traceEventType_en;
+
+// Fixed size record of a trace file
+typedef struct
+{
+    long long               timestamp;                // Time (ns) on the clock of the job
+    unsigned long long      jobId;                    // Job the event is about. Track count for TRACE_EVENT_END.
+    unsigned int            trackId;                  // Scheduler that recorded the event
+    unsigned short          cpuId;                    // CPU the job is executing on
+    unsigned char           type;                     // traceEventType_en
+    unsigned char           reserved;
+}traceEvent_st;
+
+// Name of a track, written after the TRACE_EVENT_END record
+typedef struct
+{
+    unsigned int            trackId;
+    char                    name[60];
+}traceTrack_st;
+
+//-------------------------------------------------------------------------------------------------
+// TraceBuffer is a ring buffer of trace events, written by a single thread and drained by the
+// flush thread of the EventTracer. Neither side ever blocks: events recorded while the buffer
+// is full are dropped and counted.
+//-------------------------------------------------------------------------------------------------
+class TraceBuffer
+{
+private:
+    static const size_t CAPACITY = 1 << 16;                               // Must be a power of 2
+
+    traceEvent_st                           m_events[CAPACITY];
+    alignas(64) atomic<size_t>              m_head;                       // Next event to write, moved by the writer
+    alignas(64) atomic<size_t>              m_tail;                       // Next event to drain, moved by the flush thread
+    atomic<unsigned long long>              m_dropped;                    // Events lost as the buffer was full
+
+public:
+    TraceBuffer() : m_head(0), m_tail(0), m_dropped(0) {}
+
+    //******************************************************************************************
+    // @name                    : push
+    //
+    // @description             : Records an event. Called only from the owning thread.
+    //
+    // @param event             : Event to record
+    //
+    // @returns                 : Nothing
+    //******************************************************************************************
+    void push(const traceEvent_st & event)
+    {
+        size_t head = m_head.load(memory_order_relaxed);
+        if (head - m_tail.load(memory_order_acquire) == CAPACITY)
+        {
+            m_dropped.fetch_add(1, memory_order_relaxed);
+            return;
+        }
+
+        m_events[head & (CAPACITY - 1)] = event;
+        m_head.store(head + 1, memory_order_release);
+    }
+
+    size_t drain(FILE *file);
+    unsigned long long getDroppedEvents() { return m_dropped.load(memory_order_relaxed); }
+};
+
+//-------------------------------------------------------------------------------------------------
+// EventTracer records scheduling events of all the threads to a binary trace file. Each thread
+// writes to a TraceBuffer of its own, so recording an event is just a copy to memory; a
+// background thread flushes all the buffers to the file. When tracing is not started,
+// recording is a single relaxed load.
+//
+// Events are recorded against a track, one per scheduler. A trace file can be converted to
+// Chrome trace JSON (chrome://tracing or ui.perfetto.dev) with exportChromeTrace().
+//-------------------------------------------------------------------------------------------------
+class EventTracer
+{
+private:
+    atomic<bool>                            m_enabled;                    // Events are recorded only when enabled
+    mutex                                   m_bufferMutex;                // Guards m_buffers and m_file
+    vector<TraceBuffer*>                    m_buffers;                    // Buffer of each thread that recorded an event
+    FILE*                                   m_file;                       // Trace file being written
+    unsigned long long                      m_eventsWritten;
+    mutex                                   m_trackMutex;                 // Guards m_trackNames
+    vector<string>                          m_trackNames;                 // Indexed by track id
+    mutex                                   m_flushMutex;
+    condition_variable                      m_stopEvent;                  // Wakes up the flush thread when stopped
+    bool                                    m_stopRequested;
+    thread                                  m_flushThread;
+
+    EventTracer();
+    ~EventTracer();
+    TraceBuffer* registerThreadBuffer();
+    void flush();
+    void flushAtInterval();
+
+    //******************************************************************************************
+    // @name                    : getThreadBuffer
+    //
+    // @description             : Fetches the trace buffer of the calling thread, creating it
+    //                            on the first event of the thread.
+    //
+    // @returns                 : Trace buffer
+    //******************************************************************************************
+    TraceBuffer* getThreadBuffer()
+    {
+        static thread_local TraceBuffer *buffer = nullptr;
+        if (!buffer)
+        {
+            buffer = registerThreadBuffer();
+        }
+
+        return buffer;
+    }
+
+public:
+    static EventTracer & getInstance();
+
+    bool start(const string & fileName);
+    void stop();
+    bool isEnabled() { return m_enabled.load(memory_order_relaxed); }
+    unsigned int registerTrack(const string & name);
+
+    //******************************************************************************************
+    // @name                    : record
+    //
+    // @description             : Records a scheduling event, if tracing is started.
+    //
+    // @param type              : Type of the event
+    // @param trackId           : Track of the scheduler
+    // @param cpuId             : CPU the job is executing on
+    // @param jobId             : Job the event is about
+    // @param timestamp         : Time (ns) of the event
+    //
+    // @returns                 : Nothing
+    //******************************************************************************************
+    void record(traceEventType_en type, unsigned int trackId, unsigned short cpuId, unsigned long long jobId, long long timestamp)
+    {
+        if (!isEnabled())
+        {
+            return;
+        }
+
+        traceEvent_st event;
+        event.timestamp = timestamp;
+        event.jobId = jobId;
+        event.trackId = trackId;
+        event.cpuId = cpuId;
+        event.type = (unsigned char)type;
+        event.reserved = 0;
+        getThreadBuffer()->push(event);
+    }
+
+    static bool exportChromeTrace(const string & traceFileName, const string & jsonFileName);
+};
+
+#endif
@@ -2,19 +2,26 @@
 #define _FCFS_H_
 
 #include<string>
-#include "process_scheduler.h"
+#include "policy_scheduler.h"
 
 using namespace std;
 
-class FirstComeFirstServed: public ProcessScheduler
+//-------------------------------------------------------------------------------------------------
+// First in, first out (FIFO), also known as first come, first served (FCFS), is the simplest
+// scheduling algorithm. FIFO simply queues processes in the order that they arrive in the ready
+// queue, and runs each of them till it completes or needs I/O.
+//-------------------------------------------------------------------------------------------------
+struct FcfsPolicy
 {
-private:
+    static const policyQueue_en QUEUE = QUEUE_ARRIVAL;
+    static const policyPreemption_en PREEMPTION = PREEMPT_NONE;
+};
 
+class FirstComeFirstServed: public PolicyScheduler<FcfsPolicy>
+{
 public:
     FirstComeFirstServed(string name);
     ~FirstComeFirstServed();
-    void setSchedulerName(string name);
-    void ProcessJobs();
 };
 
 #endif
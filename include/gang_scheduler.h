@@ -0,0 +1,73 @@
+#ifndef _GANG_SCHEDULER_H_
+#define _GANG_SCHEDULER_H_
+
+#include "process_scheduler.h"
+#include<string>
+#include<vector>
+
+using namespace std;
+
+//---------------------------------------------------------------------------------------------------
+// Enums and structures
+//---------------------------------------------------------------------------------------------------
+
+// How the waiting jobs are packed on the idle CPUs
+typedef enum
+{
+    GANG_PACKING_FCFS,                                // In order of arrival, the first job that does not fit waits for CPUs
+    GANG_PACKING_FIRST_FIT,                           // Any job that fits, in order of arrival. Wide jobs may starve.
+    GANG_PACKING_BACKFILL,                            // In order of arrival, and later jobs that do not delay the first waiting one (EASY)
+
+    // This should be last
+    GANG_PACKING_MAX
+}gangPacking_en;
+
+// Gang of a job running on the CPUs
+typedef struct
+{
+    Job*                    job;                      // Job running
+    long long               tsEnd;                    // timestamp when its CPU burst is over
+    long long               timeSlice;                // Time (ns) it runs for on each of its CPUs
+}gang_st;
+
+//-------------------------------------------------------------------------------------------------
+// Gang scheduling runs all the threads of a parallel job at the same time, each on a CPU of its
+// own, as a batch cluster scheduler does: a job of width k waits till k CPUs are idle, holds them
+// for the whole of its CPU burst and releases them together. Jobs are not preempted.
+//
+// As the CPUs of a gang have to start and stop together, the scheduler drives all of its CPUs
+// itself, from a single thread, instead of running a thread per CPU: it starts the jobs that fit
+// on the idle CPUs, sleeps till the next gang is over or the next job arrives, and starts again.
+// How the waiting jobs are packed on the idle CPUs is the packing policy. With backfilling, the
+// first waiting job gets a reservation at the earliest time enough CPUs will be idle for it, and
+// later jobs may only jump ahead if they are done by then, or leave it enough CPUs.
+//-------------------------------------------------------------------------------------------------
+class GangScheduler : public ProcessScheduler
+{
+private:
+    gangPacking_en          m_packing;                // Packing policy
+    vector<gang_st>         m_gangs;                  // Gangs running, in the order they started
+    vector<Job*>            m_cpuJobs;                // Job running on each CPU, nullptr if idle
+    unsigned int            m_idleCpus;               // CPUs not running any gang
+    unsigned int            m_fragmentedCpus;         // Idle CPUs while jobs were waiting, as of the last dispatch
+    long long               m_tsLastDispatch;         // timestamp of the last dispatch
+
+    void dispatchJobs();
+    bool startGang(Job *job);
+    long long getReservation(unsigned int width, unsigned int & spareCpus);
+    void waitForNextEvent();
+    void completeGangs();
+    void endCpuBurst(Job *job, bool jobComplete);
+    unsigned int getWidth(Job *job);
+
+protected:
+    bool schedulesAllCpus() { return true; }
+
+public:
+    GangScheduler(string name, gangPacking_en packing);
+    ~GangScheduler();
+    void setSchedulerName(string name);
+    void ProcessJobs();
+};
+
+#endif
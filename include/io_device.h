@@ -0,0 +1,86 @@
+#ifndef _IO_DEVICE_H_
+#define _IO_DEVICE_H_
+
+#include<list>
+#include<queue>
+#include<vector>
+#include "checkpoint.h"
+#include "job.h"
+
+using namespace std;
+
+//---------------------------------------------------------------------------------------------------
+// Enums and structures
+//---------------------------------------------------------------------------------------------------
+
+// Completion of the I/O burst of a blocked job
+typedef struct
+{
+    long long               tsComplete;               // timestamp (ns) at which the I/O burst completes
+    Job*                    job;                      // Job blocked on the I/O burst
+}ioEvent_st;
+
+//-------------------------------------------------------------------------------------------------
+// IoDevice serves the I/O bursts of jobs one at a time, in the order they are submitted. As the
+// service time of a burst is known when it is submitted, the device only needs to know till
+// when it is busy to tell when a new burst will be complete: its service queue is implicit.
+//-------------------------------------------------------------------------------------------------
+class IoDevice
+{
+private:
+    long long                               m_tsBusyUntil;                // timestamp (ns) till which the submitted bursts keep it busy
+    long long                               m_busyTime;                   // Time (ns) spent serving bursts
+    long long                               m_queueingDelay;              // Time (ns) bursts waited for the device
+    unsigned long long                      m_requests;                   // Bursts submitted
+
+public:
+    IoDevice();
+
+    long long submit(long long tsNow, long long serviceTime);
+    long long getBusyTime() { return m_busyTime; }
+    long long getQueueingDelay() { return m_queueingDelay; }
+    unsigned long long getRequests() { return m_requests; }
+};
+
+//-------------------------------------------------------------------------------------------------
+// IoController holds the blocked pool of a scheduler: the jobs waiting for an I/O burst to
+// complete on one of its devices. Rather than polling the blocked jobs, it keeps an event per
+// job, ordered by completion time, so the scheduler can wake exactly the jobs whose I/O is
+// complete and knows when the next one is due. Used by the scheduler thread only.
+//-------------------------------------------------------------------------------------------------
+class IoController
+{
+private:
+    struct ioEventLater
+    {
+        bool operator()(const ioEvent_st & a, const ioEvent_st & b) const { return a.tsComplete > b.tsComplete; }
+    };
+
+    // Gives access to the heap of events, so that it can be saved and restored as it is:
+    // rebuilding it could wake jobs whose I/O completes at the same time in another order.
+    struct ioEventQueue : public priority_queue<ioEvent_st, vector<ioEvent_st>, ioEventLater>
+    {
+        vector<ioEvent_st> & getEvents() { return c; }
+    };
+
+    vector<IoDevice>                        m_devices;
+    ioEventQueue                            m_blockedJobs;                // Earliest completion on top
+
+public:
+    IoController();
+
+    void setDeviceCount(unsigned int count);
+    unsigned int getDeviceCount() { return (unsigned int)m_devices.size(); }
+    IoDevice & getDevice(unsigned int deviceId) { return m_devices[deviceId]; }
+
+    void submit(Job *job, long long tsNow);
+    size_t getBlockedJobCount() { return m_blockedJobs.size(); }
+    long long getNextCompletionTime();
+    void releaseCompletedJobs(long long tsNow, list<Job*> & pool);
+    void takeBlockedJobs(list<Job*> & pool);
+
+    void saveCheckpoint(CheckpointWriter & writer);
+    bool restoreCheckpoint(CheckpointReader & reader, SimulationClock *clock, list<Job*> & restoredJobs);
+};
+
+#endif
@@ -1,7 +1,13 @@
 #ifndef _JOB_H_
 #define _JOB_H_
 
+#include "checkpoint.h"
+#include "event_trace.h"
+#include "job_coroutine.h"
 #include "random.h"
+#include "simulation_clock.h"
+#include "timing.h"
+#include<functional>
 #include<mutex>
 
 using namespace std;
@@ -12,7 +18,6 @@ using namespace std;
 const int JOB_PRIORITY_LOWEST      = 512;       // Lowest priority
 const int JOB_PRIORITY_HIGHEST     = 0;         // Highest priority
 const long long MAX_TIME_REQUIRED = 10000;      // Maximum time (ms) that a task can need to complete
-long long getCurrentTimestampInMilliseconds();
 //---------------------------------------------------------------------------------------------------
 // Enums and structures
 //---------------------------------------------------------------------------------------------------
@@ -29,6 +34,32 @@ typedef enum
     STATE_MAX
 }jobState_en;
 
+// Description of a job that is yet to be created. A pre-generated list of these
+// (see Workload) lets several schedulers be fed exactly the same jobs.
+typedef struct
+{
+    unsigned long           jobId;                    // Unique Job ID
+    unsigned int            priority;                 // Priority of this job, lower is highest priority
+    long long               timeRequired;             // Time required (in ns) by this job to complete.
+    long long               arrivalTime;              // Time (in ns) from start of simulation when this job arrives
+    unsigned int            ioBursts;                 // I/O bursts in between the CPU bursts of this job, 0 for none
+    long long               ioBurstTime;              // Time (in ns) a device takes to serve each I/O burst
+    unsigned int            ioDevice;                 // Device the I/O bursts are served by
+    unsigned int            width;                    // CPUs the job runs on at once, 1 for a single thread
+    unsigned int            tenantGroup;              // Tenant group the job is submitted to, 0 without groups
+}jobSpec_st;
+
+// Prediction of the CPU bursts of a job, from the bursts it has done so far (see BurstPredictor)
+typedef struct
+{
+    long long               predicted;                // Predicted time (ns) of the current CPU burst, -1 if not predicted yet
+    unsigned int            samples;                  // CPU bursts observed so far
+}burstEstimate_st;
+
+// Real work of a job, for real execution mode. It is run to completion, and its CPU time is
+// taken as the time required by the job.
+typedef function<void()> jobPayload_fn;
+
 
 //---------------------------------------------------------------------------------------------------
 // Job/Task class
@@ -41,24 +72,61 @@ private:
     unsigned long           m_jobId;                  // Unique Job ID
     unsigned int            m_priority;               // Priority of this job, lower is highest priority
     jobState_en             m_state;                  // Current state of the job
-    long long               m_timeRequired;           // Time required (in ms) by this job to complete.
-    long long               m_timeServed;             // Time (in ms) for which this job has executed.
-    long long               m_tsCreated;              // timestamp value when this job was created.
-    long long               m_tsExecutionStart;       // timestamp value when this job got completed.
-    long long               m_tsExecutionEnd;         // timestamp value when this job got completed.
-    long long               m_waitingTime;            // Waiting time of this job
-    long long               m_responseTime;           // Response time of this job
+    long long               m_timeRequired;           // Time required (in ns) by this job to complete.
+    long long               m_timeServed;             // Time (in ns) for which this job has executed.
+    long long               m_tsCreated;              // timestamp value (ns) when this job was created.
+    long long               m_tsExecutionStart;       // timestamp value (ns) when this job started execution.
+    long long               m_tsExecutionEnd;         // timestamp value (ns) when this job got completed.
+    long long               m_waitingTime;            // Waiting time (ns) of this job
+    long long               m_responseTime;           // Response time (ns) of this job
     int                     m_responseTimeThreshold;  // Threshold for job response time
+    SimulationClock*        m_clock;                  // Clock used for timestamps of this job
+    unsigned int            m_traceTrack;             // Trace track of the scheduler running this job
+    unsigned short          m_cpuId;                  // CPU this job is executing on, or last ran on
+    size_t                  m_pendingSlot;            // Slot of its fields in the PendingJobTable of the scheduler, while pending
+    jobPayload_fn           m_payload;                // Real work of this job, empty if it is simulated
+    JobCoroutine            m_coroutine;              // Real work of this job that can be preempted, if any
+    long long               m_cpuBurst;               // CPU time (ns) in between two I/O bursts
+    long long               m_burstTimeServed;        // Time (ns) served in the current CPU burst
+    unsigned int            m_ioBurstsRemaining;      // I/O bursts yet to be done
+    long long               m_ioBurstTime;            // Time (ns) a device takes to serve each I/O burst
+    unsigned int            m_ioDevice;               // Device the I/O bursts are served by
+    unsigned int            m_width;                  // CPUs it runs on at once, 1 for a single thread
+    unsigned int            m_tenantGroup;            // Tenant group it is submitted to
+    burstEstimate_st        m_burstEstimate;          // Prediction of its CPU bursts, if the scheduler predicts them
+
+    void traceEvent(traceEventType_en type, long long timestamp);
 
 public:
     Job(bool showJobStatus, unsigned long jobId, unsigned int priority, int responseTimeThreshold);
+    Job(bool showJobStatus, const jobSpec_st & spec, int responseTimeThreshold, SimulationClock *clock);
+    Job(CheckpointReader & reader, SimulationClock *clock);
     ~Job();
 
+    void saveCheckpoint(CheckpointWriter & writer);
+
     bool isDebugEnabled() { return m_showJobStatus; }
 
     unsigned long getJobId() {return m_jobId;}
 
+    void setTraceTrack(unsigned int trackId) { m_traceTrack = trackId; }
+
+    unsigned short getCpuId() { return m_cpuId; }
+    void setCpuId(unsigned short cpuId) { m_cpuId = cpuId; }
+
+    size_t getPendingSlot() { return m_pendingSlot; }
+    void setPendingSlot(size_t slot) { m_pendingSlot = slot; }
+
+    bool hasPayload() { return (bool)m_payload; }
+    const jobPayload_fn & getPayload() { return m_payload; }
+    void setPayload(const jobPayload_fn & payload) { m_payload = payload; }
+
+    bool hasCoroutine() { return m_coroutine.isValid(); }
+    JobCoroutine & getCoroutine() { return m_coroutine; }
+    void setCoroutine(JobCoroutine && coroutine) { m_coroutine = std::move(coroutine); }
+
     long long getJobTimeCreated() { return m_tsCreated; }
+    void setJobTimeCreated(long long tsCreated) { m_tsCreated = tsCreated; }
 
     unsigned int getJobPriority() { return m_priority; }
     void setJobPriority(unsigned int priority) { m_priority = priority; }
@@ -67,13 +135,29 @@ public:
     void setJobState(jobState_en state) { m_state = state; }
 
     long long getJobTimeRemaining();
+    long long getJobTimeServed() { return m_timeServed; }
 
     long long getJobTimeRequired();
     void setJobTimeRequired(long long timeRequired) { m_timeRequired = timeRequired; }
 
     bool isJobComplete() { return (m_state == STATE_COMPLETED); }
+
+    void setIoBursts(unsigned int ioBursts, long long ioBurstTime, unsigned int ioDevice);
+    unsigned int getIoDevice() { return m_ioDevice; }
+    long long getIoBurstTime() { return m_ioBurstTime; }
+    long long getCpuBurstRemaining();
+    long long getCpuBurstServed() { return m_burstTimeServed; }
+    burstEstimate_st & getBurstEstimate() { return m_burstEstimate; }
+    bool isLastCpuBurst() { return (m_ioBurstsRemaining == 0); }
+    bool isIoDue() { return (m_ioBurstsRemaining > 0) && (m_burstTimeServed >= m_cpuBurst); }
     bool isResponseThresholdReached();
 
+    unsigned int getWidth() { return m_width; }
+    void setWidth(unsigned int width) { m_width = (width > 0) ? width : 1; }
+    unsigned int getTenantGroup() { return m_tenantGroup; }
+    void setTenantGroup(unsigned int group) { m_tenantGroup = group; }
+    long long getResponseTimeLimit() { return m_responseTimeThreshold * m_timeRequired; }
+
     void displayJobDetails();
     long long getWaitingTime();
     void setWaitingTime(long long waitingTime);
@@ -81,6 +165,8 @@ public:
     long long getResponseTime();
     void markJobAsStartedExecution();
     void markJobAsPaused(long long timeServed);
+    void markJobAsBlocked();
+    void markJobAsUnblocked(long long tsWake);
     void markJobAsComplete();
 };
 
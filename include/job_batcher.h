@@ -0,0 +1,46 @@
+#ifndef _JOB_BATCHER_H_
+#define _JOB_BATCHER_H_
+
+#include<vector>
+#include "job.h"
+#include "process_scheduler.h"
+
+using namespace std;
+
+//-------------------------------------------------------------------------------------------------
+// JobBatcher collects the jobs of a producer thread (e.g. a job creation thread) and adds them to
+// the ready queue of a scheduler a batch at a time, so that the producer takes the lock of the
+// ready queue once per batch instead of once per job. A batch is added once it has batch size
+// jobs, or once its first job has been held back for the batch window, whichever comes first.
+// A batch size of 1 adds every job on its own, as addToReadyQueue() would.
+//
+// A job held back in a batch has arrived already, so the time it is held back counts as waiting
+// time: batching trades some latency for less overhead at high arrival rates. The batcher takes
+// ownership of the jobs added to it, and deletes the ones shed by the scheduler. Used by the
+// producer thread only, on the real time clock.
+//-------------------------------------------------------------------------------------------------
+class JobBatcher
+{
+private:
+    ProcessScheduler*                       m_scheduler;                  // Scheduler the jobs are added to
+    size_t                                  m_batchSize;                  // Jobs in a full batch
+    long long                               m_batchWindow;                // Max time (ns) a job is held back, 0 for no limit
+    vector<Job*>                            m_batch;                      // Jobs held back
+    vector<Job*>                            m_shedJobs;                   // Jobs shed from the last batch
+    long long                               m_tsFirstJob;                 // timestamp the first job of the batch was added at
+    unsigned long long                      m_batches;                    // Batches added so far
+
+    long long getDeadline();
+
+public:
+    JobBatcher(ProcessScheduler *scheduler, size_t batchSize, long long batchWindow);
+    ~JobBatcher();
+
+    void add(Job *job);
+    void flush();
+    void waitFor(long long duration);
+    void waitUntil(long long timestamp);
+    unsigned long long getBatches() { return m_batches; }
+};
+
+#endif
@@ -0,0 +1,85 @@
+#ifndef _JOB_COROUTINE_H_
+#define _JOB_COROUTINE_H_
+
+#include<coroutine>
+#include "timing.h"
+
+using namespace std;
+
+//---------------------------------------------------------------------------------------------------
+// Enums and structures
+//---------------------------------------------------------------------------------------------------
+
+// Awaited by the work of a job at the points where it can be preempted: co_await JOB_CHECKPOINT;
+typedef struct
+{
+}jobCheckpoint_st;
+
+const jobCheckpoint_st JOB_CHECKPOINT = {};
+
+//-------------------------------------------------------------------------------------------------
+// JobCoroutine is the real work of a job written as a C++20 coroutine, so that the job can be
+// paused and resumed like a process, without an OS thread of its own. The work awaits
+// JOB_CHECKPOINT every now and then: it carries on if its time slice has not expired, and is
+// suspended otherwise, to be resumed where it left off the next time the job is dispatched.
+// Preemption is therefore cooperative: a time slice is enforced at the first checkpoint after
+// it expires, so checkpoints should be a few microseconds of work apart. Each check reads the
+// monotonic clock, which costs a few tens of nanoseconds.
+//
+// The coroutine does not run till it is first resumed, and owns its frame, which is destroyed
+// along with it.
+//-------------------------------------------------------------------------------------------------
+class JobCoroutine
+{
+public:
+    class promise_type
+    {
+    private:
+        long long                           m_deadline;                   // timestamp (ns) at which to suspend, -1 for never
+
+    public:
+        promise_type() { m_deadline = -1; }
+
+        JobCoroutine get_return_object() { return JobCoroutine(coroutine_handle<promise_type>::from_promise(*this)); }
+        suspend_always initial_suspend() noexcept { return {}; }
+        suspend_always final_suspend() noexcept { return {}; }
+        void return_void() {}
+        void unhandled_exception();
+
+        void setDeadline(long long deadline) { m_deadline = deadline; }
+
+        // Suspends the coroutine at a checkpoint only once its time slice has expired
+        class CheckpointAwaiter
+        {
+        private:
+            long long                       m_deadline;
+
+        public:
+            CheckpointAwaiter(long long deadline) { m_deadline = deadline; }
+            bool await_ready() { return (m_deadline < 0) || (getCurrentTimestampInNanoseconds() < m_deadline); }
+            void await_suspend(coroutine_handle<>) {}
+            void await_resume() {}
+        };
+
+        CheckpointAwaiter await_transform(const jobCheckpoint_st &) { return CheckpointAwaiter(m_deadline); }
+    };
+
+private:
+    coroutine_handle<promise_type>          m_handle;
+
+    JobCoroutine(coroutine_handle<promise_type> handle) { m_handle = handle; }
+
+public:
+    JobCoroutine() { m_handle = nullptr; }
+    JobCoroutine(JobCoroutine && other) noexcept { m_handle = other.m_handle; other.m_handle = nullptr; }
+    JobCoroutine & operator=(JobCoroutine && other) noexcept;
+    JobCoroutine(const JobCoroutine &) = delete;
+    JobCoroutine & operator=(const JobCoroutine &) = delete;
+    ~JobCoroutine();
+
+    bool isValid() { return (bool)m_handle; }
+    bool isDone() { return !m_handle || m_handle.done(); }
+    bool resume(long long timeSlice);
+};
+
+#endif
@@ -0,0 +1,120 @@
+#ifndef _LOGGER_H_
+#define _LOGGER_H_
+
+#include<atomic>
+#include<condition_variable>
+#include<memory>
+#include<mutex>
+#include<stdarg.h>
+#include<stdio.h>
+#include<string>
+#include<thread>
+
+using namespace std;
+
+//---------------------------------------------------------------------------------------------------
+// Enums and structures
+//---------------------------------------------------------------------------------------------------
+typedef enum
+{
+    LOG_LEVEL_DEBUG,
+    LOG_LEVEL_INFO,
+    LOG_LEVEL_WARNING,
+    LOG_LEVEL_ERROR,
+    LOG_LEVEL_NONE                                    // Nothing is logged
+}logLevel_en;
+
+// Log calls below this level are compiled out. Set from the LOG_LEVEL CMake option.
+#ifndef LOG_COMPILE_LEVEL
+#define LOG_COMPILE_LEVEL           LOG_LEVEL_DEBUG
+#endif
+
+#ifdef __GNUC__
+#define LOG_PRINTF_FORMAT(fmt, args)    __attribute__((format(printf, fmt, args)))
+#else
+#define LOG_PRINTF_FORMAT(fmt, args)
+#endif
+
+const size_t LOG_MESSAGE_SIZE = 232;                  // Longer messages are truncated
+
+typedef struct
+{
+    long long               timestamp;                // Time (ns) since the logger was created
+    unsigned int            threadId;                 // Small id of the logging thread
+    unsigned int            level;                    // logLevel_en
+    char                    message[LOG_MESSAGE_SIZE];
+}logRecord_st;
+
+//---------------------------------------------------------------------------------------------------
+// Macros
+//---------------------------------------------------------------------------------------------------
+#define LOG_AT_LEVEL(level, ...)                                                                    \
+    do                                                                                              \
+    {                                                                                               \
+        if constexpr ((level) >= LOG_COMPILE_LEVEL)                                                 \
+        {                                                                                           \
+            if (Logger::getInstance().isEnabled(level))                                             \
+                Logger::getInstance().log((level), __VA_ARGS__);                                    \
+        }                                                                                           \
+    } while (0)
+
+#define LOG_DEBUG(...)              LOG_AT_LEVEL(LOG_LEVEL_DEBUG, __VA_ARGS__)
+#define LOG_INFO(...)               LOG_AT_LEVEL(LOG_LEVEL_INFO, __VA_ARGS__)
+#define LOG_WARNING(...)            LOG_AT_LEVEL(LOG_LEVEL_WARNING, __VA_ARGS__)
+#define LOG_ERROR(...)              LOG_AT_LEVEL(LOG_LEVEL_ERROR, __VA_ARGS__)
+
+//-------------------------------------------------------------------------------------------------
+// Logger writes log records from a thread of its own, so that logging never waits for console
+// or file I/O. A log call formats its message straight into a slot of a bounded lock-free
+// queue, which the writer thread drains in batches, with a single write per batch. If the
+// queue is full the record is dropped and counted, rather than blocking the caller.
+//
+// Each record is written as "[seconds] LEVEL [thread] message", to stderr by default so that
+// it does not mix with the results on stdout. Use the LOG_* macros rather than log(): levels
+// below LOG_COMPILE_LEVEL are compiled out, and the runtime level is checked before the
+// message is formatted.
+//-------------------------------------------------------------------------------------------------
+class Logger
+{
+private:
+    static const size_t QUEUE_CAPACITY = 8192;                            // Must be a power of 2
+
+    typedef struct
+    {
+        atomic<size_t>      sequence;                 // Queue position this slot is ready for
+        logRecord_st        record;
+    }logSlot_st;
+
+    atomic<int>                             m_level;                      // Records below this level are not logged
+    unique_ptr<logSlot_st[]>                m_slots;
+    alignas(64) atomic<size_t>              m_enqueuePos;                 // Next position to be claimed by a log call
+    alignas(64) atomic<size_t>              m_dequeuePos;                 // Next position to be written, moved by the writer
+    atomic<unsigned long long>              m_dropped;                    // Records lost as the queue was full
+    atomic<unsigned int>                    m_threadCount;                // Used to give small ids to threads
+    long long                               m_tsCreated;                  // timestamp value (ns) when the logger was created
+    mutex                                   m_fileMutex;                  // Guards m_file
+    FILE*                                   m_file;                       // Destination of the records
+    mutex                                   m_writerMutex;
+    condition_variable                      m_writerEvent;                // Wakes up the writer thread
+    bool                                    m_stopRequested;
+    thread                                  m_writerThread;
+
+    Logger();
+    ~Logger();
+    bool writeBatch();
+    void writeAtInterval();
+
+public:
+    static Logger & getInstance();
+
+    bool isEnabled(logLevel_en level) { return level >= m_level.load(memory_order_relaxed); }
+    void setLevel(logLevel_en level) { m_level.store(level, memory_order_relaxed); }
+    bool setOutputFile(const string & fileName);
+    void log(logLevel_en level, const char *format, ...) LOG_PRINTF_FORMAT(3, 4);
+    void flush();
+    unsigned long long getDroppedRecords() { return m_dropped.load(memory_order_relaxed); }
+
+    static bool parseLevel(const string & name, logLevel_en & level);
+};
+
+#endif
@@ -0,0 +1,62 @@
+#ifndef _PARAMETER_SWEEP_H_
+#define _PARAMETER_SWEEP_H_
+
+#include<atomic>
+#include<string>
+#include<vector>
+#include "process_scheduler.h"
+#include "config.h"
+#include "workload.h"
+
+using namespace std;
+
+//---------------------------------------------------------------------------------------------------
+// Enums and structures
+//---------------------------------------------------------------------------------------------------
+
+// One combination of the parameters and its result.
+typedef struct
+{
+    string                          algorithm;                // Name of the scheduler in the SchedulerRegistry
+    long long                       timeQuantum;
+    int                             responseTimeThreshold;
+    double                          loadFactor;
+    unsigned int                    ageingRate;
+    unsigned int                    seed;
+    size_t                          workloadIndex;            // Workload generated for this load factor and seed
+    bool                            simulated;                // false if no scheduler exists for the algorithm
+    simulationResult_st             result;
+}sweepPoint_st;
+
+//-------------------------------------------------------------------------------------------------
+// ParameterSweep simulates the cartesian product of the sweep parameters of a configuration:
+// configurations x algorithms x seeds. Each run is done on a VirtualClock, so it takes milliseconds instead of
+// hours, and runs are spread over all the cores. A workload is generated once per load factor
+// and seed, and shared by all the runs using it, so configurations are compared like for like.
+//-------------------------------------------------------------------------------------------------
+class ParameterSweep
+{
+private:
+    simulationConfig_st                     m_config;                     // Values to be tried, and all the other configurations
+    vector<string>                          m_algorithms;                 // Scheduling algorithms to simulate
+    vector<Workload>                        m_workloads;                  // One per load factor and seed
+    vector<sweepPoint_st>                   m_points;                     // All the combinations
+    atomic<size_t>                          m_nextPoint;                  // Next combination to be simulated
+    long long                               m_wallTime;                   // Time (ms) taken by the whole sweep
+
+    void generateWorkloads();
+    void buildPoints();
+    void simulatePoint(sweepPoint_st & point);
+    void workerThread();
+
+public:
+    ParameterSweep(const simulationConfig_st & config, const vector<string> & algorithms);
+    ~ParameterSweep();
+
+    size_t getPointCount() { return m_points.size(); }
+    bool run(unsigned int threadCount);
+    bool writeResults(const string & fileName);
+    void displayBestResults();
+};
+
+#endif
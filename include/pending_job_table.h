@@ -0,0 +1,80 @@
+#ifndef _PENDING_JOB_TABLE_H_
+#define _PENDING_JOB_TABLE_H_
+
+#include<list>
+#include<stddef.h>
+#include<vector>
+#include "job.h"
+
+using namespace std;
+
+//-------------------------------------------------------------------------------------------------
+// PendingJobTable keeps the fields of the jobs of a pending pool that the kernels run over (see
+// simd_kernels.h) in arrays, indexed by the slot of each job (see Job::getPendingSlot()). The
+// scheduler adds the jobs that enter the pool and removes those that leave it, so the arrays are
+// not gathered again on every pass. Removing a job moves another one into its slot, so the slots
+// are always the first ones.
+//
+// Each slot also holds the node of its job in the pool, so it can be moved or erased without a
+// search, and its rank, which goes up in the order of the pool, to break ties between keys as
+// the pool would. The key of a slot is set by the scheduler; the keys of the jobs added since,
+// or whose key changed, are kept after all the others, till they are set again.
+//
+// Used by the scheduler thread only, like the pending pool.
+//-------------------------------------------------------------------------------------------------
+class PendingJobTable
+{
+private:
+    vector<Job*>                            m_jobs;                       // Job in each slot
+    vector<list<Job*>::iterator>            m_nodes;                      // Its node in the pending pool
+    vector<long long>                       m_ranks;                      // Its place in the pending pool, lowest at the front
+    vector<long long>                       m_keys;                       // Its key, as set by the scheduler
+    vector<unsigned int>                    m_priorities;                 // Its priority
+    vector<long long>                       m_tsCreated;                  // Its creation timestamp
+    vector<long long>                       m_timeRequired;               // Its time required (ns)
+    size_t                                  m_keyedSlots;                 // Slots whose key is set, the first ones
+    long long                               m_frontRank;                  // Lowest rank given, at most that of the front job
+    long long                               m_backRank;                   // Highest rank given, at least that of the back job
+
+    void swapSlots(size_t lhs, size_t rhs);
+
+public:
+    PendingJobTable();
+
+    void clear();
+    void reserve(size_t count);                                           // Room for so many jobs, e.g. before filling
+    void add(list<Job*>::iterator node);                                  // Job appended to the pool
+    list<Job*>::iterator remove(Job *job);                                // Job leaving the pool, returns its node
+    void update(Job *job);                                                // Fields of a job changed, e.g. once it ran
+    void moveToFront(size_t slot);                                        // Job spliced to the front of the pool
+    void setRanks(const size_t *slots, size_t count);                     // Pool reordered as listed
+
+    size_t size() { return m_jobs.size(); }
+    Job* getJob(size_t slot) { return m_jobs[slot]; }
+    list<Job*>::iterator getNode(size_t slot) { return m_nodes[slot]; }
+    const long long* getRanks() { return m_ranks.data(); }
+    const long long* getKeys() { return m_keys.data(); }
+    unsigned int* getPriorities() { return m_priorities.data(); }
+    const long long* getTsCreated() { return m_tsCreated.data(); }
+    const long long* getTimeRequired() { return m_timeRequired.data(); }
+
+    //******************************************************************************************
+    // @name                    : updateKeys
+    //
+    // @description             : Sets the keys of the slots whose key is not set.
+    //
+    // @param getKey            : Gives the key of a job
+    //
+    // @returns                 : Nothing
+    //******************************************************************************************
+    template<typename GET_KEY>
+    void updateKeys(GET_KEY getKey)
+    {
+        for (; m_keyedSlots < m_jobs.size(); m_keyedSlots++)
+        {
+            m_keys[m_keyedSlots] = getKey(m_jobs[m_keyedSlots]);
+        }
+    }
+};
+
+#endif
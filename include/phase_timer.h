@@ -0,0 +1,185 @@
+#ifndef _PHASE_TIMER_H_
+#define _PHASE_TIMER_H_
+
+#include<atomic>
+#include "timing.h"
+
+using namespace std;
+
+//---------------------------------------------------------------------------------------------------
+// Enums and structures
+//---------------------------------------------------------------------------------------------------
+typedef enum
+{
+    PHASE_FETCH,                                      // Moving jobs from ready queue to pending pool
+    PHASE_ORDER,                                      // Ordering the pending pool (sorting, ageing)
+    PHASE_DISPATCH,                                   // Marking a job as started
+    PHASE_WORK,                                       // Simulated work of a job (DoJob)
+    PHASE_COMPLETE,                                   // Marking a job as paused or complete
+    PHASE_MAX
+}schedulerPhase_en;
+
+typedef struct
+{
+    unsigned long long      cycles;                   // CPU cycles
+    unsigned long long      cacheMisses;              // Last level cache misses
+}hardwareCounts_st;
+
+//-------------------------------------------------------------------------------------------------
+// HardwareCounters reads the CPU cycles and cache misses of the calling thread, through
+// perf_event_open. It must be opened on the thread to be measured. Only available on Linux,
+// and only if the kernel allows it (see /proc/sys/kernel/perf_event_paranoid).
+//-------------------------------------------------------------------------------------------------
+class HardwareCounters
+{
+private:
+    int                                     m_groupFd;                    // Cycles, leader of the group
+    int                                     m_cacheMissesFd;
+
+public:
+    HardwareCounters();
+    ~HardwareCounters();
+
+    bool open();
+    bool isOpen() { return m_groupFd >= 0; }
+    bool read(hardwareCounts_st & counts);
+};
+
+//-------------------------------------------------------------------------------------------------
+// PhaseStats accumulates the time spent by a scheduler in one of its phases, with a histogram
+// of the durations in power of 2 buckets of nanoseconds. It is written by the scheduler thread
+// only, and can be read from any thread.
+//-------------------------------------------------------------------------------------------------
+class PhaseStats
+{
+public:
+    static const int HISTOGRAM_BUCKETS = 48;                              // Bucket i holds [2^i, 2^(i+1)) ns
+
+private:
+    atomic<unsigned long long>              m_count;
+    atomic<long long>                       m_totalTime;                  // ns
+    atomic<long long>                       m_maxTime;                    // ns
+    atomic<unsigned long long>              m_totalCycles;
+    atomic<unsigned long long>              m_totalCacheMisses;
+    atomic<unsigned long long>              m_histogram[HISTOGRAM_BUCKETS];
+
+public:
+    PhaseStats();
+
+    void add(long long duration, const hardwareCounts_st *counts);
+    unsigned long long getCount() { return m_count.load(memory_order_relaxed); }
+    long long getTotalTime() { return m_totalTime.load(memory_order_relaxed); }
+    long long getMaxTime() { return m_maxTime.load(memory_order_relaxed); }
+    unsigned long long getTotalCycles() { return m_totalCycles.load(memory_order_relaxed); }
+    unsigned long long getTotalCacheMisses() { return m_totalCacheMisses.load(memory_order_relaxed); }
+    long long getPercentile(double percentile);
+
+    static const char* getPhaseName(schedulerPhase_en phase);
+};
+
+//-------------------------------------------------------------------------------------------------
+// ScopedPhaseTimer adds the time from its creation to its destruction to the stats of a phase,
+// along with the hardware counts if counters are given. Does nothing if the stats are null.
+//-------------------------------------------------------------------------------------------------
+class ScopedPhaseTimer
+{
+private:
+    PhaseStats*                             m_stats;
+    HardwareCounters*                       m_counters;
+    hardwareCounts_st                       m_countsStart;
+    long long                               m_tsStart;
+
+public:
+    ScopedPhaseTimer(PhaseStats *stats, HardwareCounters *counters)
+    {
+        m_stats = stats;
+        m_counters = (stats && counters && counters->isOpen() && counters->read(m_countsStart)) ? counters : nullptr;
+        m_tsStart = stats ? getCurrentTimestampInNanoseconds() : 0;
+    }
+
+    ~ScopedPhaseTimer()
+    {
+        if (!m_stats)
+        {
+            return;
+        }
+
+        long long duration = getCurrentTimestampInNanoseconds() - m_tsStart;
+        hardwareCounts_st countsEnd;
+        if (m_counters && m_counters->read(countsEnd))
+        {
+            countsEnd.cycles -= m_countsStart.cycles;
+            countsEnd.cacheMisses -= m_countsStart.cacheMisses;
+            m_stats->add(duration, &countsEnd);
+        }
+        else
+        {
+            m_stats->add(duration, nullptr);
+        }
+    }
+};
+
+//-------------------------------------------------------------------------------------------------
+// PhaseTimeline times phases that follow one another, e.g. the steps of a job in a pass of the
+// scheduler. Entering a phase ends the one before it, with a single read of the clock and of the
+// counters for both, where a ScopedPhaseTimer per phase would read them twice. The last phase
+// ends with the timeline. A phase entered with no stats is not timed.
+//-------------------------------------------------------------------------------------------------
+class PhaseTimeline
+{
+private:
+    PhaseStats*                             m_stats;                      // Phase being timed, nullptr if none
+    HardwareCounters*                       m_counters;
+    hardwareCounts_st                       m_countsStart;
+    bool                                    m_countsStarted;
+    long long                               m_tsStart;
+
+public:
+    PhaseTimeline(HardwareCounters *counters)
+    {
+        m_stats = nullptr;
+        m_counters = (counters && counters->isOpen()) ? counters : nullptr;
+        m_countsStart = hardwareCounts_st();
+        m_countsStarted = false;
+        m_tsStart = 0;
+    }
+
+    ~PhaseTimeline()
+    {
+        enter(nullptr);
+    }
+
+    void enter(PhaseStats *stats)
+    {
+        if (!m_stats && !stats)
+        {
+            return;
+        }
+
+        long long tsNow = getCurrentTimestampInNanoseconds();
+        hardwareCounts_st countsNow = hardwareCounts_st();
+        bool countsRead = m_counters && m_counters->read(countsNow);
+
+        if (m_stats)
+        {
+            if (countsRead && m_countsStarted)
+            {
+                hardwareCounts_st counts;
+                counts.cycles = countsNow.cycles - m_countsStart.cycles;
+                counts.cacheMisses = countsNow.cacheMisses - m_countsStart.cacheMisses;
+                m_stats->add(tsNow - m_tsStart, &counts);
+            }
+            else
+            {
+                m_stats->add(tsNow - m_tsStart, nullptr);
+            }
+        }
+
+        m_stats = stats;
+        m_tsStart = tsNow;
+        m_countsStart = countsNow;
+        m_countsStarted = countsRead;
+    }
+};
+
+#endif
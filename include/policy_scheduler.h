@@ -0,0 +1,337 @@
+#ifndef _POLICY_SCHEDULER_H_
+#define _POLICY_SCHEDULER_H_
+
+#include<algorithm>
+#include<string>
+#include<vector>
+#include "job.h"
+#include "process_scheduler.h"
+#include "simd_kernels.h"
+
+using namespace std;
+
+//---------------------------------------------------------------------------------------------------
+// Enums and structures
+//---------------------------------------------------------------------------------------------------
+
+// How the pending pool is kept
+typedef enum
+{
+    QUEUE_ARRIVAL,                                    // In order of arrival, never reordered
+    QUEUE_SORTED,                                     // Sorted on the key of the policy before every pass
+    QUEUE_MIN_FIRST,                                  // Job of the lowest key moved to the front before every pick
+    QUEUE_CUSTOM,                                     // Ordered by the scheduler's own orderPendingJobs() before every pass
+    POLICY_QUEUE_MAX
+}policyQueue_en;
+
+// When a running job gives up its CPU before the end of its CPU burst
+typedef enum
+{
+    PREEMPT_NONE,                                     // Never
+    PREEMPT_QUANTUM,                                  // After a time quantum, to take its turn again after the others
+    PREEMPT_NEXT_EVENT,                               // At the next arrival or I/O completion, to compete with the new jobs
+    POLICY_PREEMPTION_MAX
+}policyPreemption_en;
+
+//-------------------------------------------------------------------------------------------------
+// PolicyScheduler is the core shared by the algorithms that run one job at a time in an order of
+// their own: the loop that fetches, orders and dispatches the jobs is written once, and each
+// algorithm is a policy that sets, at compile time:
+//
+//   QUEUE                  - How the pending pool is kept (policyQueue_en)
+//   PREEMPTION             - When a running job is preempted (policyPreemption_en)
+//   getKey(scheduler, job) - Ordering key of a job, the lowest running first. Not needed
+//                            with QUEUE_ARRIVAL or QUEUE_CUSTOM.
+//
+// The loop is instantiated for each policy, with its steps bound at compile time: the ordering
+// key is inlined in the sort, and DoJob(), JobComplete() and JobBlocked() are called without
+// going through the virtual table, so a class derived from an algorithm cannot override them.
+// Only with QUEUE_CUSTOM is orderPendingJobs() called through it, once per pass, for an ordering
+// that does not come down to a key per job, e.g. ageing.
+// The policy is a friend of its scheduler, so its key may use the protected members, e.g. the
+// predicted CPU bursts.
+//
+// The time slice given to the constructor is the time quantum with PREEMPT_QUANTUM, and the
+// interval at which arrivals that are not known in advance are checked for with
+// PREEMPT_NEXT_EVENT.
+//-------------------------------------------------------------------------------------------------
+template<typename POLICY>
+class PolicyScheduler : public ProcessScheduler
+{
+    friend POLICY;
+
+    static_assert(POLICY::QUEUE < POLICY_QUEUE_MAX, "Unknown queue structure");
+    static_assert(POLICY::PREEMPTION < POLICY_PREEMPTION_MAX, "Unknown preemption rule");
+
+private:
+    long long                               m_timeSlice;                  // Time quantum, or preemption interval (ns), as per the policy
+
+protected:
+    //******************************************************************************************
+    // @name                    : orderPendingJobs
+    //
+    // @description             : Orders the pending pool as per the queue structure of the
+    //                            policy. With QUEUE_MIN_FIRST, only the job of the lowest key
+    //                            is moved to the front. On a tie, the job ahead in the pool is
+    //                            kept, so a running job is not preempted by a job just as
+    //                            short. On several CPUs, or with tenant groups, the jobs that
+    //                            cannot run on the calling CPU are passed over; otherwise, the
+    //                            keys are kept in the PendingJobTable, set only for the jobs
+    //                            that arrived or ran since the last pick, and the lowest is
+    //                            found by the SIMD kernel.
+    //
+    // @returns                 : Nothing
+    //******************************************************************************************
+    void orderPendingJobs()
+    {
+        if constexpr (POLICY::QUEUE == QUEUE_SORTED)
+        {
+            m_pendingJobPool.sort([this](Job* lhs, Job* rhs) {return POLICY::getKey(*this, lhs) < POLICY::getKey(*this, rhs); });
+        }
+        else if constexpr (POLICY::QUEUE == QUEUE_MIN_FIRST)
+        {
+            if (m_pendingJobPool.empty())
+            {
+                return;
+            }
+
+            PendingJobTable *table = getPendingJobTable();
+            auto lowest = m_pendingJobPool.begin();
+
+            if (getCpuCount() == 1 && !hasTenantGroups())
+            {
+                table->updateKeys([this](Job *job) { return POLICY::getKey(*this, job); });
+                lowest = table->getNode(findMinKey(table->getKeys(), table->getRanks(), table->size()));
+            }
+            else
+            {
+                // Only the jobs that may run on this CPU, or of the group picked, compete
+                lowest = min_element(m_pendingJobPool.begin(), m_pendingJobPool.end(), [this](Job* lhs, Job* rhs) {
+                    bool lhsDispatchable = isDispatchable(lhs);
+                    if (lhsDispatchable != isDispatchable(rhs))
+                        return lhsDispatchable;
+                    return POLICY::getKey(*this, lhs) < POLICY::getKey(*this, rhs);
+                });
+            }
+
+            m_pendingJobPool.splice(m_pendingJobPool.begin(), m_pendingJobPool, lowest);
+            table->moveToFront((*lowest)->getPendingSlot());
+        }
+    }
+
+    bool rotatesJobs() { return POLICY::PREEMPTION == PREEMPT_QUANTUM; }
+
+    //******************************************************************************************
+    // @name                    : getTimeSlice
+    //
+    // @description             : Calculates how long the next job may run before it is
+    //                            preempted. With PREEMPT_NEXT_EVENT, this is till the next
+    //                            arrival or I/O completion. Arrivals from a job creation
+    //                            thread, or from the dispatcher of a cluster, are not known in
+    //                            advance, so they are checked every time slice as well.
+    //
+    // @param job               : Job to run, nullptr for the time slice of any job
+    //
+    // @returns                 : Time slice (ns), -1 to run till the end of the CPU burst
+    //******************************************************************************************
+    long long getTimeSlice(Job *job = nullptr)
+    {
+        if constexpr (POLICY::PREEMPTION == PREEMPT_NONE)
+        {
+            return -1;
+        }
+        else if constexpr (POLICY::PREEMPTION == PREEMPT_QUANTUM)
+        {
+            return m_timeSlice;
+        }
+        else
+        {
+            long long timeSlice = areArrivalsKnown() ? -1 : m_timeSlice;
+            long long tsNextEvent = getNextEventTime(job);
+
+            if (tsNextEvent >= 0)
+            {
+                long long timeToEvent = std::max(tsNextEvent - m_clock->now(), 1LL);
+                timeSlice = (timeSlice < 0) ? timeToEvent : std::min(timeSlice, timeToEvent);
+            }
+
+            return timeSlice;
+        }
+    }
+
+public:
+    PolicyScheduler(string name, long long timeSlice = -1) : ProcessScheduler(name)
+    {
+        m_timeSlice = timeSlice;
+
+        if constexpr (POLICY::QUEUE == QUEUE_MIN_FIRST)
+        {
+            keepPendingJobTable();
+        }
+    }
+
+    void setSchedulerName(string name) { m_schedulerName = name; }
+
+    //******************************************************************************************
+    // @name                    : DoJob
+    //
+    // @description             : Simulate execution of a job till the end of its CPU burst or
+    //                            of its time slice, whichever comes first.
+    //
+    //                            A payload cannot be preempted, so a job with a payload runs to
+    //                            completion. A job coroutine is resumed for the time slice, and
+    //                            suspended at its next checkpoint.
+    //
+    // @param job               : Job to execute
+    //
+    // @returns                 : true on job completion,
+    //                            false otherwise
+    //******************************************************************************************
+    bool DoJob(Job *job)
+    {
+        bool isJobCompleted = false;
+        long long timeSlice = getTimeSlice(job);
+
+        if (job->hasPayload())
+        {
+            return executePayload(job);
+        }
+
+        if (job->hasCoroutine())
+        {
+            return executeCoroutine(job, timeSlice);
+        }
+
+        if (timeSlice < 0 || job->getCpuBurstRemaining() <= timeSlice)
+        {
+            // We can finish the CPU burst in this time slice. The job is complete
+            // unless it needs I/O then.
+            accountTimeSlice(job, job->getCpuBurstRemaining());
+            isJobCompleted = job->isLastCpuBurst();
+        }
+        else
+        {
+            accountTimeSlice(job, timeSlice);
+        }
+
+        serveTimeSlice();
+
+        return isJobCompleted;
+    }
+
+    //******************************************************************************************
+    // @name                    : dispatchPendingJobs
+    //
+    // @description             : Orders the pending pool and runs its jobs in that order,
+    //                            passing over those that cannot run on the calling CPU. A job
+    //                            that is done, or needs I/O, leaves the pool; a preempted one
+    //                            stays where it is. With QUEUE_MIN_FIRST, a single job is
+    //                            run, as a shorter one may have arrived by the time it stops.
+    //
+    //                            The steps of each job follow one another, so they are timed
+    //                            on a PhaseTimeline, which reads the clock once between two
+    //                            steps.
+    //
+    // @returns                 : Nothing
+    //******************************************************************************************
+    void dispatchPendingJobs()
+    {
+        PhaseTimeline timeline(getHardwareCounters());
+
+        if constexpr (POLICY::QUEUE == QUEUE_CUSTOM)
+        {
+            timeline.enter(getPhaseStats(PHASE_ORDER));
+            orderPendingJobs();
+        }
+        else if constexpr (POLICY::QUEUE != QUEUE_ARRIVAL)
+        {
+            timeline.enter(getPhaseStats(PHASE_ORDER));
+            PolicyScheduler::orderPendingJobs();
+        }
+
+        auto it = m_pendingJobPool.begin();
+        while (it != m_pendingJobPool.end())
+        {
+            Job *job = *it;
+
+            timeline.enter(getPhaseStats(PHASE_DISPATCH));
+            if (!assignCpu(job))
+            {
+                if constexpr (POLICY::QUEUE == QUEUE_MIN_FIRST)
+                {
+                    // All the jobs are running on other CPUs, or left to them
+                    return;
+                }
+
+                // Running on another CPU, or left to it
+                it++;
+                continue;
+            }
+            job->markJobAsStartedExecution();
+
+            timeline.enter(getPhaseStats(PHASE_WORK));
+            bool jobComplete = PolicyScheduler::DoJob(job);
+
+            timeline.enter(getPhaseStats(PHASE_COMPLETE));
+            if (jobComplete)
+            {
+                job->markJobAsComplete();
+
+                // This will remove job from pending list. use
+                // the modified "it" value
+                it = ProcessScheduler::JobComplete(job);
+            }
+            else
+            {
+                // Store the progress of the job, and move it to the blocked pool if its
+                // CPU burst is over. Without preemption, it always is.
+                job->markJobAsPaused(m_timeSliceServed);
+
+                if (POLICY::PREEMPTION == PREEMPT_NONE || job->isIoDue())
+                {
+                    it = ProcessScheduler::JobBlocked(job);
+                }
+                else
+                {
+                    // Its key has changed, as it ran
+                    if (getPendingJobTable())
+                        getPendingJobTable()->update(job);
+                    it++;
+                }
+            }
+
+            if constexpr (POLICY::QUEUE == QUEUE_MIN_FIRST)
+            {
+                return;
+            }
+        }// Reached end of Pending Job pool
+    }
+
+    //******************************************************************************************
+    // @name                    : ProcessJobs
+    //
+    // @description             : Fetches the jobs of the ready queue and dispatches the pending
+    //                            pool till the simulation is complete.
+    //
+    // @returns                 : Nothing
+    //******************************************************************************************
+    void ProcessJobs()
+    {
+        // Process jobs in pending queue continuously
+        while (!isSimulationComplete())
+        {
+            // Move all the jobs in ready queue to pending job pool.
+            {
+                ScopedPhaseTimer timer(getPhaseStats(PHASE_FETCH), getHardwareCounters());
+                fetchReadyJobs();
+            }
+
+            if (m_pendingJobPool.size())
+            {
+                dispatchPendingJobs();
+            }
+        }
+    }
+};
+
+#endif
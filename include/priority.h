@@ -1,22 +1,31 @@
 #ifndef _PRIORITY_SCHEDULING_H_
 #define _PRIORITY_SCHEDULING_H_
 
-#include "process_scheduler.h"
-#include<set>
+#include "policy_scheduler.h"
 #include<string>
 
 
 using namespace std;
 
-class PriorityScheduling : public ProcessScheduler
+//-------------------------------------------------------------------------------------------------
+// Selects for execution the waiting process with the highest priority, i.e. the lowest priority
+// value, and runs it till it completes or needs I/O. Jobs of the same priority run in their
+// order of arrival.
+//-------------------------------------------------------------------------------------------------
+struct PriorityPolicy
 {
-private:
+    static const policyQueue_en QUEUE = QUEUE_SORTED;
+    static const policyPreemption_en PREEMPTION = PREEMPT_NONE;
 
+    template<typename SCHEDULER>
+    static long long getKey(SCHEDULER &, Job *job) { return job->getJobPriority(); }
+};
+
+class PriorityScheduling : public PolicyScheduler<PriorityPolicy>
+{
 public:
     PriorityScheduling(string name);
     ~PriorityScheduling();
-    void setSchedulerName(string name);
-    void ProcessJobs();
 };
 
 #endif
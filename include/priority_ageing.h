@@ -1,22 +1,42 @@
 #ifndef _PRIORITY_AGEING_H_
 #define _PRIORITY_AGEING_H_
 
-#include "process_scheduler.h"
+#include "policy_scheduler.h"
 #include<set>
 #include<string>
+#include<vector>
 
 
 using namespace std;
 
-class PriorityAgeingScheduling : public ProcessScheduler
+//-------------------------------------------------------------------------------------------------
+// Selects for execution the waiting process with the highest priority, like Priority Scheduling,
+// and raises the priority of the jobs that waited too long before every pass. The ageing and
+// ordering are done by the scheduler itself, as they change the priorities as they go.
+//-------------------------------------------------------------------------------------------------
+struct PriorityAgeingPolicy
+{
+    static const policyQueue_en QUEUE = QUEUE_CUSTOM;
+    static const policyPreemption_en PREEMPTION = PREEMPT_NONE;
+};
+
+class PriorityAgeingScheduling : public PolicyScheduler<PriorityAgeingPolicy>
 {
 private:
+    unsigned int            m_ageingRate;             // Priority levels gained by a job in each ageing pass
+    vector<size_t>          m_agedJobs;               // Slots of the jobs aged by the last pass
+    vector<unsigned long long> m_ageingOrder;         // Aged priority and rank of each job, to sort on
+    vector<size_t>          m_slotOfRank;             // Slot of the job of each rank
+    vector<size_t>          m_orderedSlots;           // Slots of the jobs in their new order
+
+protected:
+    void agePendingJobs();
+    void orderPendingJobs();
 
 public:
-    PriorityAgeingScheduling(string name);
+    PriorityAgeingScheduling(string name, unsigned int ageingRate);
     ~PriorityAgeingScheduling();
-    void setSchedulerName(string name);
-    void ProcessJobs();
+    unsigned int getAgeingRate() { return m_ageingRate; }
 };
 
 #endif
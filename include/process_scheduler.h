@@ -1,14 +1,114 @@
 #ifndef _PROCESS_SCHEDULER_H_
 #define _PROCESS_SCHEDULER_H_
 
+#include<atomic>
 #include<list>
 #include<mutex>
+#include<span>
 #include<string>
 #include<unordered_map>
+#include<vector>
+#include "burst_predictor.h"
+#include "checkpoint.h"
+#include "cpu_set.h"
+#include "io_device.h"
 #include "job.h"
+#include "pending_job_table.h"
+#include "phase_timer.h"
+#include "seqlock.h"
+#include "simulation_clock.h"
+#include "stats_series.h"
+#include "tenant_groups.h"
+#include "worker_pool.h"
 
 using namespace std;
 
+class JobFeeder;
+
+//---------------------------------------------------------------------------------------------------
+// Enums and structures
+//---------------------------------------------------------------------------------------------------
+
+// Outcome of adding a job to the ready queue
+typedef enum
+{
+    ADMISSION_ACCEPTED,                               // Job added to the ready queue
+    ADMISSION_REJECTED_QUEUE_FULL,                    // Too many jobs in the scheduler
+    ADMISSION_REJECTED_WAIT,                          // Job estimated to wait too long for the CPU
+    ADMISSION_REJECTED_DEADLINE,                      // Job estimated to exceed its response time threshold
+
+    // This should be last
+    ADMISSION_MAX
+}admissionStatus_en;
+
+// Admission control of a scheduler. A job is shed, i.e. rejected on arrival, if admitting it
+// would break any of the limits that are set.
+typedef struct
+{
+    unsigned long long      maxJobs;                  // Max jobs in the scheduler (ready, pending or blocked), 0 for no limit
+    long long               maxEstimatedWait;         // Max time (ns) a job is estimated to wait for the CPU, 0 for no limit
+    bool                    rejectLateJobs;           // Reject jobs estimated to exceed their response time threshold
+}admissionPolicy_st;
+
+typedef struct
+{
+    string                  schedulerName;            // name of the scheduling alogorithm used
+    size_t                  completedJobs;            // Jobs completed by the scheduler
+    size_t                  shedJobs;                 // Jobs rejected on arrival by admission control
+    double                  avgTimeRequired;          // Avg time required (ns) by job to complete
+    double                  avgWaitingTime;           // Average waiting time (ns)
+    double                  avgResponseTime;          // Average response time (ns)
+    double                  thresholdExceeded;        // %age of jobs whose response time exceeded threshold
+    double                  throughput;               // Jobs completed per second
+    double                  cpuUtilization;           // %age of the time the CPUs were executing jobs
+    unsigned int            cpus;                     // CPUs the jobs were run on
+    unsigned long long      migrations;               // Jobs dispatched on another CPU than the one they last ran on
+    double                  migrationOverhead;        // %age of the time of the CPUs lost to migrations
+    unsigned long long      contextSwitches;          // Times a CPU was switched to another job
+    double                  contextSwitchOverhead;    // %age of the time of the CPUs lost to context switches
+    double                  cpuEfficiency;            // %age of the time the CPUs were not idle spent on useful work
+    double                  fragmentation;            // %age of the time of the CPUs left idle while jobs waited for them, -1 if not measured
+    unsigned long long      backfilledJobs;           // Jobs started ahead of an earlier job that did not fit
+    double                  avgPredictionError;       // Avg absolute error (ns) of the predicted CPU bursts, -1 if not predicted
+    double                  avgPredictionBias;        // Avg error (ns) of the predicted CPU bursts, predicted - actual
+    string                  oracleSchedulerName;      // Same algorithm on the actual CPU bursts, empty if not predicted
+    vector<tenantResult_st> tenantGroups;             // Result of each tenant group, empty without tenant groups
+    long long               simulatedTime;            // Time (ns) elapsed on the scheduler's clock
+    long long               wallTime;                 // Time (ms) taken by this simulation
+}simulationResult_st;
+
+// Counters of a scheduler, published by the scheduler thread and readable from any thread.
+typedef struct
+{
+    long long               timeElapsed;              // Time (ns) on the scheduler's clock when published
+    unsigned long long      totalJobsInflow;          // Jobs added to the ready queue
+    unsigned long long      rejectedJobs[ADMISSION_MAX];  // Jobs shed on arrival, by reason (ADMISSION_ACCEPTED is unused)
+    unsigned long long      pendingJobs;              // Jobs in the pending pool
+    unsigned long long      completedJobs;            // Jobs completed by the scheduler
+    unsigned long long      thresholdExceededJobs;    // Completed jobs whose response time exceeded threshold
+    long long               totalTimeRequired;        // Sum of time required (ns) by the completed jobs
+    long long               totalWaitingTime;         // Sum of waiting time (ns) of the completed jobs
+    long long               totalResponseTime;        // Sum of response time (ns) of the completed jobs
+    unsigned long long      blockedJobs;              // Jobs in the blocked pool, waiting for I/O
+    long long               cpuBusyTime;              // Time (ns) the CPUs spent executing jobs
+    unsigned long long      migrations;               // Jobs dispatched on another CPU than the one they last ran on
+    long long               migrationTime;            // Time (ns) the CPUs spent warming up for migrated jobs
+    unsigned long long      contextSwitches;          // Times a CPU was switched to another job
+    long long               contextSwitchTime;        // Time (ns) the CPUs spent switching between jobs
+    long long               fragmentedTime;           // Time (ns) of the CPUs left idle while jobs waited for them
+    unsigned long long      backfilledJobs;           // Jobs started ahead of an earlier job that did not fit
+    long long               ioWaitTime;               // Time (ns) the CPU was idle while jobs were blocked on I/O
+    unsigned long long      ioRequests;               // I/O bursts submitted to the devices
+    long long               ioBusyTime;               // Time (ns) the devices spent serving I/O bursts
+    unsigned long long      predictedBursts;          // CPU bursts done whose time was predicted
+    long long               totalPredictionError;     // Sum of absolute errors (ns) of the predicted bursts
+    long long               totalPredictionBias;      // Sum of errors (ns) of the predicted bursts, predicted - actual
+    long long               recentTimeSpan;           // Time (ns) the recent rates are taken over, 0 till the first sample
+    double                  recentThroughput;         // Jobs completed per second over the recent window
+    double                  recentInflowRate;         // Jobs added to the ready queue per second over the recent window
+    double                  recentCpuUtilization;     // %age of the time the CPUs were executing jobs over the recent window
+}schedulerStats_st;
+
 //-------------------------------------------------------------------------------------------------
 // Scheduling is the method by which work specified by some means is assigned to resources that 
 // complete the work. A scheduler is what carries out the scheduling activity. Schedulers are 
@@ -39,8 +139,24 @@ using namespace std;
 // 2) Pending list - Jobs that are to be executed are present in this pool. If any modification is
 //                   is required before execution, then it is done in this pool.
 // 3) Complete map - This stores all the jobs that were completed.
+// 4) Blocked pool - Jobs waiting for an I/O burst to complete on one of the devices of the
+//                   scheduler (see IoController). A job that needs I/O at the end of its CPU
+//                   burst is moved here, and back to the pending pool once its I/O is complete.
+//
+// All the timestamps are read from the scheduler's SimulationClock. With a VirtualClock, jobs are
+// released by a JobFeeder, and the whole simulation runs on the thread calling ProcessJobs().
+//
+// The optional parts of a simulation are held in components of their own: a BurstPredictor for
+// the CPU bursts SJF and SRTF order jobs on, a WorkerPool running the real work of jobs, the
+// CpuSet the jobs run on, TenantGroups sharing the CPUs between tenants, and a StatsSeries of
+// samples of the scheduler over time. Algorithms that co-schedule the parallel jobs as gangs
+// drive all the CPUs themselves (see schedulesAllCpus()).
 //
-// It also has APIs for monitoring important parameters of a process scheduling. 
+// addToReadyQueue() sheds the jobs that would break the admission policy. A simulation driven
+// by a WorkloadFeeder can be saved with saveCheckpoint() and resumed with restoreCheckpoint().
+//
+// It also has APIs for monitoring important parameters of a process scheduling. The counters are
+// published as a snapshot after every change to the pools, readable from any thread.
 // 
 //-------------------------------------------------------------------------------------------------
 class ProcessScheduler
@@ -48,46 +164,155 @@ class ProcessScheduler
 private:
     long long                               m_tsCreated;                  // timestamp value when this scheduler was created
     int                                     m_displayInterval;            // Interval after which stats for scheduler will be displayed
-    bool                                    m_simulationComplete;         // Mark end of simulation
+    atomic<bool>                            m_simulationComplete;         // Mark end of simulation
+    JobFeeder*                              m_feeder;                     // Releases jobs from the scheduler's own thread, if any
+    schedulerStats_st                       m_stats;                      // Counters, updated by the scheduler thread only
+    SeqLock<schedulerStats_st>              m_statsSnapshot;              // Last published copy of m_stats
+    PhaseStats                              m_phaseStats[PHASE_MAX];      // Wall time spent in each phase of ProcessJobs
+    bool                                    m_phaseTimersEnabled;         // Time the phases of ProcessJobs
+    bool                                    m_hardwareCountersEnabled;    // Count cycles and cache misses of the phases
+    bool                                    m_hardwareCountersOpened;     // Opening of the counters has been tried
+    HardwareCounters                        m_hardwareCounters;           // Counters of the scheduler thread
+    WorkerPool*                             m_workerPool;                 // Runs the payloads of jobs, if set
+    payloadKernel_en                        m_payloadKernel;              // Payload given to jobs that have none
+    double                                  m_payloadScale;               // CPU time of a payload per ns of time required
+    bool                                    m_payloadPreemptible;         // Give the payload as a coroutine
+    long long                               m_tsIoWaitStart;              // timestamp since when the CPU is idle waiting for I/O, -1 if it is not
+    BurstPredictor*                         m_burstPredictor;             // Predicts the CPU bursts of jobs, nullptr to use the actual ones
+    string                                  m_oracleSchedulerName;        // Same algorithm on the actual CPU bursts
+    admissionPolicy_st                      m_admissionPolicy;            // Limits on the jobs admitted
+    atomic<unsigned long long>              m_jobsInSystem;               // Admitted jobs that are not complete yet
+    atomic<long long>                       m_backlogTime;                // CPU time (ns) left of the admitted jobs
+    atomic<unsigned long long>              m_rejectedJobs[ADMISSION_MAX];// Jobs shed on arrival, by reason
+    string                                  m_checkpointFile;             // File the periodic checkpoints are saved to
+    long long                               m_checkpointInterval;         // Simulated time (ns) between two checkpoints, 0 for none
+    long long                               m_tsNextCheckpoint;           // timestamp of the next checkpoint, -1 if not scheduled yet
+    CpuSet                                  m_cpuSet;                     // CPUs the jobs run on
+    TenantGroups*                           m_tenantGroups;               // Shares the CPUs between tenant groups, nullptr for a single tenant
+    StatsSeries                             m_statsSeries;                // Samples of the state of the scheduler over time
+    PendingJobTable*                        m_pendingJobTable;            // Fields of the pending jobs for the kernels, nullptr if not kept
+
+    long long runOnWorker(const jobPayload_fn & payload);
+    admissionStatus_en admitJob(Job *job, unsigned long long jobsInSystem, long long backlogTime);
+    void prepareJob(Job *job);
+    admissionStatus_en checkAdmission(Job *job, unsigned long long jobsInSystem, long long backlogTime);
+    void setMeasuredTimeRequired(Job *job, long long timeRequired);
+    void observeCpuBurst(Job *job);
+    bool canCheckpoint();
+    void runCpu(unsigned int cpu);
+    bool hasDispatchableJob();
+    bool hasAffineJob();
+    bool mayRunOnCpu(Job *job);
+    int getTenantGroupPick();
+    void sampleStats();
+
+    static void saveJobs(CheckpointWriter & writer, list<Job*> & pool);
+    static bool restoreJobs(CheckpointReader & reader, SimulationClock *clock, list<Job*> & pool);
+    static double getAverage(long long total, unsigned long long count, double defaultValue);
+    static double getRate(unsigned long long count, long long timeElapsed);
 
 protected:
     mutex                                   m_schedulerMutex;
-    unsigned long long                      m_totalJobsInflow;
+    SimulationClock*                        m_clock;                      // Source of time of this scheduler
+    unsigned int                            m_traceTrack;                 // Track on which events of this scheduler are traced
+    long long                               m_timeSliceServed;            // Time (ns) for which DoJob() ran the last job
+    atomic<unsigned long long>              m_totalJobsInflow;
     string                                  m_schedulerName;              // name of the scheduling alogorithm used
     list<Job*>                              m_readyJobPool  ;             // List of jobs currently present in Ready queue
     list<Job*>                              m_pendingJobPool;             // List of all the pending jobs
     unordered_map<unsigned long, Job*>      m_completedJobPool;           // Using map as this can be huge.
+    IoController                            m_ioController;               // Devices, and the blocked pool
+
+    void fetchReadyJobs();                                                // Moves jobs from Ready queue to pending pool
+    void keepPendingJobTable();                                           // Keep the fields of the pending jobs in a PendingJobTable
+    PendingJobTable* getPendingJobTable() { return m_pendingJobTable; }   // nullptr if not kept
+    void resetPendingJobTable();                                          // Fills the table again, after the pending pool was replaced
+    void publishStats();                                                  // Publishes the counters to other threads
+    virtual void orderPendingJobs();                                      // Orders pending pool in which jobs are to be run
+    PhaseStats* getPhaseStats(schedulerPhase_en phase);                   // Stats to time a phase with, if enabled
+    HardwareCounters* getHardwareCounters();                              // Counters of the calling thread, if enabled
+    bool executePayload(Job *job);                                        // Runs the real work of a job
+    bool executeCoroutine(Job *job, long long timeSlice);                 // Resumes the real work of a job for a time slice
+    void accountTimeSlice(Job *job, long long timeServed, unsigned int cpus = 1);   // Records the time DoJob() ran a job for
+    void accountFragmentation(long long idleCpuTime) { m_stats.fragmentedTime += idleCpuTime; }
+    void accountBackfill() { m_stats.backfilledJobs++; }
+    void serveTimeSlice();                                                // Lets the time slice accounted for pass
+    bool isDispatchable(Job *job);                                        // Job may run on the calling CPU
+    bool assignCpu(Job *job);                                             // Dispatches a job on the calling CPU, if it may run there
+    long long switchCpu(unsigned int cpu, Job *job);                      // Switches a CPU to a job, returning the time it takes
+    virtual bool schedulesAllCpus() { return false; }                     // ProcessJobs() runs all the CPUs itself, on one thread
+    virtual bool rotatesJobs() { return false; }                          // Jobs take turns through the pending pool, rather than in its order
+    bool hasTenantGroups() { return m_tenantGroups != nullptr; }
+    void repickTenantGroups() { m_cpuSet.repickTenantGroups(); }          // The tenant group to run next has to be picked again
+    long long getNextEventTime(Job *runningJob = nullptr);                // Next known arrival or I/O completion
+    bool areArrivalsKnown();                                              // Arrival times are known in advance
+    long long getPredictedBurstRemaining(Job *job);                       // CPU time a job is expected to run for
 
 public:
     ProcessScheduler(string name);
-    ~ProcessScheduler();
+    virtual ~ProcessScheduler();
     virtual void setSchedulerName(string name) = 0;                       // This needs to be implemented by inheriting classes
     string getSchedulerName();
+    void setClock(SimulationClock *clock);
+    SimulationClock* getClock() { return m_clock; }
+    void setWorkloadFeeder(JobFeeder *feeder) { m_feeder = feeder; }
+    void setWorkerPool(WorkerPool *pool) { m_workerPool = pool; }
+    void setPayloadKernel(payloadKernel_en kernel, double scale, bool preemptible);
+    void setIoDeviceCount(unsigned int count) { m_ioController.setDeviceCount(count); }
+    void setBurstPredictor(BurstPredictor *predictor, const string & oracleName);
+    bool setCheckpointInterval(const string & fileName, long long interval);
+    bool saveCheckpoint(const string & fileName);
+    bool restoreCheckpoint(const string & fileName);
+    void setCpuCount(unsigned int count, bool affinity, long long migrationCost) { m_cpuSet.setup(count, affinity, migrationCost); }
+    unsigned int getCpuCount() { return m_cpuSet.getCount(); }
+    void setContextSwitchCost(const contextSwitchCost_st & cost) { m_cpuSet.setContextSwitchCost(cost); }
+    void setTenantGroups(TenantGroups *groups);
+    void runOnCpus();                                                     // Runs ProcessJobs() on every CPU
     virtual bool DoJob(Job *job);
     virtual list<Job*>::iterator JobComplete(Job *job);
+    virtual list<Job*>::iterator JobBlocked(Job *job);
     virtual void ProcessJobs() = 0;                                       // This needs to be implemented by inheriting classes.
                                                                           // It contains the main algorithm being implemented by the
                                                                           // scheduling algorithm.
 
-    virtual bool addToReadyQueue(Job* job);                               // This can be overridden depending on how the algorithm
+    virtual admissionStatus_en addToReadyQueue(Job* job);                 // This can be overridden depending on how the algorithm
                                                                           // adds the job to its queue.
+    virtual size_t addToReadyQueue(span<Job* const> jobs, vector<Job*> & shedJobs);
+                                                                          // Adds a batch of jobs under a single lock. Override
+                                                                          // it along with the above.
+    void setAdmissionPolicy(const admissionPolicy_st & policy) { m_admissionPolicy = policy; }
+    unsigned long long getShedJobs();
+    static const char* getAdmissionStatusName(admissionStatus_en status);
     void setDisplayInterval(int interval);
     int getDisplayInterval();
 
-    bool isSimulationComplete() { return m_simulationComplete; }
+    bool isSimulationComplete() { return m_simulationComplete.load(); }
     void setSimulationComplete(bool val);
 
-    void displayStatsAtInterval(time_t & t1, time_t & t2);
+    schedulerStats_st getStatsSnapshot() const { return m_statsSnapshot.read(); }
     void displayStats();
+    void displayPhaseStats();
+    void setPhaseTimersEnabled(bool enabled) { m_phaseTimersEnabled = enabled; }
+    void setHardwareCountersEnabled(bool enabled) { m_hardwareCountersEnabled = enabled; }
 
     double getJobInflowRate();
+    double getRecentJobInflowRate();
     double getAverageTimeRequired();
     double getAverageWaitingTime();
     double getAverageResponseTime();
     double getThroughput();
+    double getRecentThroughput();
+    void setStatsSampling(long long interval, long long window, size_t keptSamples);
+    bool saveStatsSeries(const string & fileName, bool append);
+    double getCpuUtilization();
+    double getCpuEfficiency();
 
-    size_t getCompletedJobs() { return m_completedJobPool.size(); }
+    size_t getCompletedJobs() { return (size_t)getStatsSnapshot().completedJobs; }
+    unsigned long long getJobsInSystem() { return m_jobsInSystem.load(); }   // Admitted jobs not complete yet
+    void getResponseTimes(vector<long long> & responseTimes);             // Of the completed jobs, once the simulation is over
+    void displayTenantStats();                                            // Once the simulation is over
     double getResponseThresholdExceededJobs();
+    void getSimulationResult(simulationResult_st & result);
 };
 
 #endif
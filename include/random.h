@@ -4,18 +4,22 @@
 #include<time.h>
 #include <stdlib.h>
 #include<string.h>
+#include<random>
 using namespace std;
 
 class RandomGenerator
 {
 private:
     bool m_bIsSeedGenerated;
+    mt19937 m_engine;           // Each generator has its own state, so it can be seeded
+                                // and used independently of the others (and other threads).
 
     /* Private functions */
     void generateSeed();
 
 public:
     RandomGenerator();
+    RandomGenerator(unsigned int seed);
     ~RandomGenerator();
 
     unsigned int generateRandomNumber(unsigned int range);
@@ -1,24 +1,46 @@
 #ifndef _ROUND_ROBIN_H_
 #define _ROUND_ROBIN_H_
 
-#include "process_scheduler.h"
-#include<set>
+#include "policy_scheduler.h"
 #include<string>
 
 using namespace std;
 
-class RoundRobin : public ProcessScheduler
+//-------------------------------------------------------------------------------------------------
+// The scheduler assigns a fixed time unit per process, and cycles
+// through them. If process completes within that time-slice it gets
+// terminated otherwise it is rescheduled after giving a chance
+// to all other processes.
+//  RR scheduling involves extensive overhead, especially with
+//   a small time unit.
+//  Balanced throughput between FCFS / FIFO and SJF / SRTF,
+//   shorter jobs are completed faster than in FIFO and longer
+//   processes are completed faster than in SJF.
+//  Good average response time, waiting time is dependent on
+//   number of processes, and not average process length.
+//  Because of high waiting times, deadlines are rarely met in a
+//   pure RR system.
+//  Starvation can never occur, since no priority is given.
+//   Order of time unit allocation is based upon process arrival time,
+//   similar to FIFO.
+//  If Time - Slice is large it becomes FCFS / FIFO or if it is
+//   short then it becomes SJF / SRTF.
+//
+// A payload cannot be preempted, so a job with a payload runs to completion whatever the time
+// quantum. A job coroutine is resumed for a time quantum, and suspended at its next checkpoint.
+//-------------------------------------------------------------------------------------------------
+struct RoundRobinPolicy
 {
-private:
-    long long               m_timeQuantum;
+    static const policyQueue_en QUEUE = QUEUE_ARRIVAL;
+    static const policyPreemption_en PREEMPTION = PREEMPT_QUANTUM;
+};
 
+class RoundRobin : public PolicyScheduler<RoundRobinPolicy>
+{
 public:
     RoundRobin(string name, long long timeQuantum);
     ~RoundRobin();
-    void setSchedulerName(string name);
-    void ProcessJobs();
-    virtual bool DoJob(Job *job);
-    long long getTimeQuantum() { return m_timeQuantum; }
+    long long getTimeQuantum() { return getTimeSlice(); }
 };
 
 #endif
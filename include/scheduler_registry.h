@@ -0,0 +1,49 @@
+#ifndef _SCHEDULER_REGISTRY_H_
+#define _SCHEDULER_REGISTRY_H_
+
+#include<string>
+#include<vector>
+#include "config.h"
+#include "process_scheduler.h"
+
+using namespace std;
+
+//---------------------------------------------------------------------------------------------------
+// Enums and structures
+//---------------------------------------------------------------------------------------------------
+
+// Creates a scheduler from the configuration. Caller owns the returned scheduler.
+typedef ProcessScheduler* (*schedulerFactory_fn)(const simulationConfig_st & config);
+
+typedef struct
+{
+    string                  name;                     // Name used in configurations, e.g. "rr"
+    string                  description;              // Name of the scheduling algorithm
+    schedulerFactory_fn     factory;                  // Creates the scheduler
+}schedulerRegistryEntry_st;
+
+//-------------------------------------------------------------------------------------------------
+// SchedulerRegistry maps the name of a scheduling algorithm to the function creating its
+// scheduler. All the schedulers of this project are registered when the registry is first used.
+// A new scheduling algorithm only needs to be registered to be usable from the configuration,
+// the comparison runner and the parameter sweep.
+//-------------------------------------------------------------------------------------------------
+class SchedulerRegistry
+{
+private:
+    vector<schedulerRegistryEntry_st>       m_entries;                    // Registered schedulers, in order of registration
+
+    SchedulerRegistry();
+    void registerBuiltinSchedulers();
+
+public:
+    static SchedulerRegistry & getInstance();
+
+    bool registerScheduler(const string & name, const string & description, schedulerFactory_fn factory);
+    bool isRegistered(const string & name);
+    ProcessScheduler* createScheduler(const string & name, const simulationConfig_st & config);
+    vector<string> getSchedulerNames();
+    void displaySchedulers();
+};
+
+#endif
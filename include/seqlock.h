@@ -0,0 +1,100 @@
+#ifndef _SEQLOCK_H_
+#define _SEQLOCK_H_
+
+#include<atomic>
+#include<cstring>
+#include<type_traits>
+
+using namespace std;
+
+//-------------------------------------------------------------------------------------------------
+// SeqLock publishes a value from a writer to any number of reader threads, without any of them
+// ever blocking the other.
+//
+// The writer makes the sequence number odd, stores the value and makes it even again. A reader
+// copies the value and retries if the sequence number was odd or changed meanwhile, so it always
+// gets a consistent copy of one of the published values. The value is stored as relaxed atomic
+// words so that the racing reads are well defined.
+//
+// Only trivially copyable types can be published. Writes must never overlap: write() is called
+// from a single thread, or from threads that take turns, each write ordered after the previous
+// one by the lock they hand over, e.g. the CPUs of a scheduler on a LockstepClock. The
+// sequence number is not updated atomically against another writer.
+//-------------------------------------------------------------------------------------------------
+template<typename T>
+class SeqLock
+{
+    static_assert(is_trivially_copyable<T>::value, "SeqLock needs a trivially copyable type");
+
+private:
+    static const size_t WORD_COUNT = (sizeof(T) + sizeof(unsigned long long) - 1) / sizeof(unsigned long long);
+
+    atomic<unsigned long long>              m_sequence;                   // Odd while a write is in progress
+    atomic<unsigned long long>              m_words[WORD_COUNT];          // Published value
+
+public:
+    SeqLock()
+    {
+        m_sequence.store(0, memory_order_relaxed);
+        write(T());
+    }
+
+    //******************************************************************************************
+    // @name                    : write
+    //
+    // @description             : Publishes a new value. Never blocks.
+    //
+    // @param value             : Value to publish
+    //
+    // @returns                 : Nothing
+    //******************************************************************************************
+    void write(const T & value)
+    {
+        unsigned long long words[WORD_COUNT] = {};
+        memcpy(words, &value, sizeof(T));
+
+        unsigned long long sequence = m_sequence.load(memory_order_relaxed);
+        m_sequence.store(sequence + 1, memory_order_relaxed);
+        atomic_thread_fence(memory_order_release);
+
+        for (size_t i = 0; i < WORD_COUNT; i++)
+        {
+            m_words[i].store(words[i], memory_order_relaxed);
+        }
+
+        m_sequence.store(sequence + 2, memory_order_release);
+    }
+
+    //******************************************************************************************
+    // @name                    : read
+    //
+    // @description             : Fetches a copy of the last published value. Retries only
+    //                            while a write is in progress.
+    //
+    // @returns                 : Published value
+    //******************************************************************************************
+    T read() const
+    {
+        unsigned long long words[WORD_COUNT];
+        unsigned long long sequenceBefore;
+        unsigned long long sequenceAfter;
+
+        do
+        {
+            sequenceBefore = m_sequence.load(memory_order_acquire);
+            for (size_t i = 0; i < WORD_COUNT; i++)
+            {
+                words[i] = m_words[i].load(memory_order_relaxed);
+            }
+
+            atomic_thread_fence(memory_order_acquire);
+            sequenceAfter = m_sequence.load(memory_order_relaxed);
+        } while ((sequenceBefore & 1) || sequenceBefore != sequenceAfter);
+
+        T value;
+        memcpy(&value, words, sizeof(T));
+        return value;
+    }
+};
+
+#endif
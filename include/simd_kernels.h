@@ -0,0 +1,48 @@
+#ifndef _SIMD_KERNELS_H_
+#define _SIMD_KERNELS_H_
+
+#include<stddef.h>
+#include<string>
+
+using namespace std;
+
+//---------------------------------------------------------------------------------------------------
+// Enums and structures
+//---------------------------------------------------------------------------------------------------
+
+// Instruction set the kernels run with
+typedef enum
+{
+    SIMD_SCALAR,                                      // Plain C++, on any CPU
+    SIMD_AVX2,                                        // 256 bit vectors, x86 CPUs with AVX2
+    SIMD_AVX512,                                      // 512 bit vectors, x86 CPUs with AVX-512F
+    SIMD_LEVEL_MAX
+}simdLevel_en;
+
+//---------------------------------------------------------------------------------------------------
+// Functions
+//
+// Data parallel kernels of the schedulers, over contiguous arrays of the fields of the jobs of a
+// pool (see PendingJobTable), in a scalar version and in AVX2 and AVX-512 versions for x86 CPUs
+// built with GCC or Clang. The best level the CPU supports is detected once and used by all the
+// schedulers, unless a lower one is set, e.g. to compare them. All the levels give the same
+// results.
+//---------------------------------------------------------------------------------------------------
+simdLevel_en getSupportedSimdLevel();             // Best level of the CPU and the build
+simdLevel_en getSimdLevel();                      // Level the kernels run with
+bool setSimdLevel(simdLevel_en level);            // Fails if the level is not supported
+bool parseSimdLevel(const string & name, simdLevel_en & level);
+const char* getSimdLevelName(simdLevel_en level);
+
+// Ages the priorities of the jobs that have waited as long as their time required, and lists
+// the jobs whose priority changed
+size_t agePriorities(unsigned int *priorities, const long long *tsCreated, const long long *timeRequired,
+                     size_t count, long long tsNow, unsigned int ageingRate, size_t *agedJobs);
+size_t agePriorities(simdLevel_en level, unsigned int *priorities, const long long *tsCreated, const long long *timeRequired,
+                     size_t count, long long tsNow, unsigned int ageingRate, size_t *agedJobs);
+
+// Index of the lowest key, of the lowest rank on a tie
+size_t findMinKey(const long long *keys, const long long *ranks, size_t count);
+size_t findMinKey(simdLevel_en level, const long long *keys, const long long *ranks, size_t count);
+
+#endif
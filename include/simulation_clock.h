@@ -0,0 +1,87 @@
+#ifndef _SIMULATION_CLOCK_H_
+#define _SIMULATION_CLOCK_H_
+
+#include<climits>
+#include<condition_variable>
+#include<map>
+#include<memory>
+#include<mutex>
+#include<utility>
+
+using namespace std;
+
+//-------------------------------------------------------------------------------------------------
+// SimulationClock is the source of time for a scheduler and its jobs. All timestamps and
+// durations are in nanoseconds. Simulated work is done by sleeping on the clock.
+// 1) RealTimeClock - Wall clock time. Sleeping actually blocks the calling thread, so a
+//                    simulation takes as long as the work it simulates.
+// 2) VirtualClock  - Time only moves when somebody sleeps on the clock, and sleeping just
+//                    moves the time ahead. A simulation runs as fast as the CPU allows,
+//                    but must be driven by a single thread.
+// 3) LockstepClock - Lets several threads (e.g. the CPUs of a scheduler) share the time of
+//                    a VirtualClock, by letting only one of them run at a time: the one due
+//                    first. A thread sleeping on it hands over to the next one due, and the
+//                    time of the shared clock moves ahead to when that one wakes up. Threads
+//                    due at the same time run in the order they went to sleep, so a run is
+//                    as repeatable as on a single thread. A thread waiting for something to
+//                    happen (waitFor) can be woken earlier by the running one (wake), and one
+//                    waiting till LLONG_MAX only runs again once it is woken.
+//-------------------------------------------------------------------------------------------------
+class SimulationClock
+{
+public:
+    virtual ~SimulationClock() {}
+    virtual long long now() = 0;                                          // Current timestamp in ns
+    virtual void sleepFor(long long duration) = 0;                        // Let duration (ns) of time pass
+    virtual void waitFor(long long duration) { sleepFor(duration); }      // Wait up to duration (ns) for something to happen
+};
+
+class RealTimeClock : public SimulationClock
+{
+public:
+    long long now();
+    void sleepFor(long long duration);
+};
+
+class VirtualClock : public SimulationClock
+{
+private:
+    long long               m_now;                    // Current virtual timestamp in ns
+
+public:
+    VirtualClock();
+    long long now() { return m_now; }
+    void sleepFor(long long duration);
+};
+
+class LockstepClock : public SimulationClock
+{
+private:
+    SimulationClock*                        m_baseClock;                  // Clock whose time is shared
+    mutex                                   m_mutex;
+    unique_ptr<condition_variable[]>        m_turns;                      // Signalled when a participant may run
+    map<pair<long long, unsigned long long>, unsigned int> m_sleepers;    // Participants by (wake up time, order of sleeping)
+    unsigned long long                      m_sleeps;                     // Sleeps so far, to order the participants due together
+    unique_ptr<pair<long long, unsigned long long>[]> m_waits;            // Sleep of each participant waiting in waitFor(), (-1, 0) if not waiting
+    unsigned int                            m_running;                    // Participant allowed to run, NO_PARTICIPANT if none
+
+    void handOver();
+    void sleepUntil(long long tsWake, bool wakeable);
+
+public:
+    static const unsigned int NO_PARTICIPANT = UINT_MAX;
+
+    LockstepClock(SimulationClock *baseClock, unsigned int participants);
+    long long now() { return m_baseClock->now(); }
+    void sleepFor(long long duration);
+    void waitFor(long long duration);
+    void wake(unsigned int participant, long long tsWake);
+    void enter(unsigned int participant);
+    void leave();
+    unsigned int getRunningParticipant() { return m_running; }
+    bool hasTurn();                                                       // The calling thread is the running participant
+};
+
+SimulationClock* getRealTimeClock();
+
+#endif
@@ -1,22 +1,40 @@
 #ifndef _SJF_H_
 #define _SJF_H_
 
-#include "process_scheduler.h"
-#include<set>
+#include "policy_scheduler.h"
 #include<string>
 
 
 using namespace std;
 
-class ShortestJobFirst : public ProcessScheduler
+//-------------------------------------------------------------------------------------------------
+// Selects for execution the waiting process with the smallest execution time. SJN is a
+// non-preemptive algorithm. It is advantageous because of its simplicity and because it minimizes
+// the average amount of time each process has to wait until its execution is complete.
+//
+// However, it has the potential for process starvation for processes which will require a long
+// time to complete if short processes are continually added. Highest response ratio next is
+// similar but provides a solution to this problem using a technique called ageing.
+//
+// Another disadvantage of using SJF is that the total execution time of a job must be known
+// before execution. While it is impossible to predict execution time perfectly, several methods
+// can be used to estimate it, such as a weighted average of previous execution times. With a
+// burst predictor, jobs are ordered on their predicted time.
+//-------------------------------------------------------------------------------------------------
+struct SjfPolicy
 {
-private:
+    static const policyQueue_en QUEUE = QUEUE_SORTED;
+    static const policyPreemption_en PREEMPTION = PREEMPT_NONE;
 
+    template<typename SCHEDULER>
+    static long long getKey(SCHEDULER & scheduler, Job *job) { return scheduler.getPredictedBurstRemaining(job); }
+};
+
+class ShortestJobFirst : public PolicyScheduler<SjfPolicy>
+{
 public:
     ShortestJobFirst(string name);
     ~ShortestJobFirst();
-    void setSchedulerName(string name);
-    void ProcessJobs();
 };
 
 #endif
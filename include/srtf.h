@@ -0,0 +1,35 @@
+#ifndef _SRTF_H_
+#define _SRTF_H_
+
+#include "policy_scheduler.h"
+#include<string>
+
+using namespace std;
+
+//-------------------------------------------------------------------------------------------------
+// Preemptive version of Shortest Job First. The job with the least time remaining in its CPU
+// burst (or predicted to remain) runs till it completes, needs I/O, or a job arrives (or is back
+// from I/O), when the scheduler picks the job with the least time remaining again. So a new job
+// that is shorter than what is left of the running job preempts it.
+//
+// It minimizes the average waiting time even more than SJF, at the cost of more context
+// switches, and has the same potential for starvation of long jobs. Like SJF, it needs to know
+// the time remaining of jobs, which has to be predicted in practice.
+//-------------------------------------------------------------------------------------------------
+struct SrtfPolicy
+{
+    static const policyQueue_en QUEUE = QUEUE_MIN_FIRST;
+    static const policyPreemption_en PREEMPTION = PREEMPT_NEXT_EVENT;
+
+    template<typename SCHEDULER>
+    static long long getKey(SCHEDULER & scheduler, Job *job) { return scheduler.getPredictedBurstRemaining(job); }
+};
+
+class ShortestRemainingTimeFirst : public PolicyScheduler<SrtfPolicy>
+{
+public:
+    ShortestRemainingTimeFirst(string name, long long preemptionInterval);
+    ~ShortestRemainingTimeFirst();
+};
+
+#endif
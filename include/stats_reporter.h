@@ -0,0 +1,37 @@
+#ifndef _STATS_REPORTER_H_
+#define _STATS_REPORTER_H_
+
+#include<condition_variable>
+#include<mutex>
+#include<thread>
+#include "process_scheduler.h"
+
+using namespace std;
+
+//-------------------------------------------------------------------------------------------------
+// StatsReporter displays the statistics of a scheduler at a regular interval from a thread of
+// its own. It only reads the snapshot published by the scheduler, so monitoring never adds
+// any latency to ProcessJobs(). The interval is in seconds of real time, whatever the clock
+// of the scheduler is. No stats are displayed if the interval is < 0.
+//-------------------------------------------------------------------------------------------------
+class StatsReporter
+{
+private:
+    ProcessScheduler*                       m_scheduler;                  // Scheduler being monitored
+    int                                     m_interval;                   // Interval (seconds) between two reports
+    bool                                    m_stopRequested;              // Set to stop the reporter thread
+    mutex                                   m_mutex;
+    condition_variable                      m_stopEvent;                  // Wakes up the reporter thread when stopped
+    thread                                  m_thread;
+
+    void reportAtInterval();
+
+public:
+    StatsReporter(ProcessScheduler *scheduler, int interval);
+    ~StatsReporter();
+
+    void start();
+    void stop();
+};
+
+#endif
@@ -0,0 +1,83 @@
+#ifndef _STATS_SERIES_H_
+#define _STATS_SERIES_H_
+
+#include "checkpoint.h"
+#include<stdio.h>
+#include<string>
+#include<vector>
+
+using namespace std;
+
+//---------------------------------------------------------------------------------------------------
+// Enums and structures
+//---------------------------------------------------------------------------------------------------
+
+// State of a scheduler at an instant. The totals are those since the scheduler was created,
+// so that the rates over any window are the difference between two samples.
+typedef struct
+{
+    long long               timestamp;                // Time (ns) since the scheduler was created
+    unsigned long long      readyJobs;                // Jobs in the ready queue, not fetched by the scheduler yet
+    unsigned long long      pendingJobs;              // Jobs in the pending pool, running ones included
+    unsigned long long      blockedJobs;              // Jobs in the blocked pool, waiting for I/O
+    unsigned long long      jobsInSystem;             // Admitted jobs that are not complete yet, i.e. in flight
+    unsigned long long      totalJobsInflow;          // Jobs added to the ready queue
+    unsigned long long      completedJobs;            // Jobs completed
+    long long               cpuBusyTime;              // Time (ns) the CPUs spent executing jobs
+    long long               totalResponseTime;        // Sum of response time (ns) of the completed jobs
+}statsSample_st;
+
+// Rates of a scheduler over the window that ends at a sample
+typedef struct
+{
+    long long               timeSpan;                 // Time (ns) covered, shorter than the window early on
+    double                  throughput;               // Jobs completed per second
+    double                  inflowRate;               // Jobs added to the ready queue per second
+    double                  cpuUtilization;           // %age of the time the CPUs were executing jobs
+    double                  avgResponseTime;          // Average response time (ns) of the jobs completed, -1 if none
+}windowedRates_st;
+
+//-------------------------------------------------------------------------------------------------
+// StatsSeries keeps the samples of the state of a scheduler taken at a regular interval of its
+// clock, in a ring of a fixed size allocated up front, so sampling never allocates and a long
+// run keeps its latest samples. The rates over a sliding window are taken from the difference
+// between the last sample and the one a window before it, so they follow the transients that
+// the rates since the start of a simulation hide. With a virtual clock, time may jump over
+// several intervals at once, so samples are taken at the first instant at or past each one.
+// Used by the scheduler thread only, and read once the simulation is over. Saved with the
+// checkpoints of the scheduler, so a restored run goes on with the samples taken before.
+//-------------------------------------------------------------------------------------------------
+class StatsSeries
+{
+private:
+    vector<statsSample_st>                  m_samples;                    // Ring of the samples
+    size_t                                  m_first;                      // Index of the oldest sample
+    size_t                                  m_count;                      // Samples in the ring
+    unsigned long long                      m_recorded;                   // Samples taken, overwritten ones included
+    long long                               m_interval;                   // Time (ns) between two samples
+    long long                               m_window;                     // Time (ns) the rates are taken over
+    long long                               m_tsNextSample;               // Time (ns) since creation the next sample is due at
+
+    void push(const statsSample_st & sample);
+    const statsSample_st & getBaseline(size_t index, statsSample_st & origin) const;
+
+public:
+    StatsSeries();
+    ~StatsSeries();
+
+    void setup(long long interval, long long window, size_t keptSamples);
+    long long getWindow() const { return m_window; }
+    bool isDue(long long timestamp) const { return (m_interval > 0 && timestamp >= m_tsNextSample); }
+    void record(const statsSample_st & sample);
+    size_t size() const { return m_count; }
+    const statsSample_st & at(size_t index) const { return m_samples[(m_first + index) % m_samples.size()]; }
+    void getRates(size_t index, unsigned int cpus, windowedRates_st & rates) const;
+
+    void saveCheckpoint(CheckpointWriter & writer);
+    bool restoreCheckpoint(CheckpointReader & reader);
+
+    void writeCsv(FILE *file, const string & schedulerName, unsigned int cpus) const;
+    static void writeCsvHeader(FILE *file);
+};
+
+#endif
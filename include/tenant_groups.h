@@ -0,0 +1,108 @@
+#ifndef _TENANT_GROUPS_H_
+#define _TENANT_GROUPS_H_
+
+#include<string>
+#include<vector>
+#include "checkpoint.h"
+
+using namespace std;
+
+//---------------------------------------------------------------------------------------------------
+// Enums and structures
+//---------------------------------------------------------------------------------------------------
+
+// Setup of a tenant group
+typedef struct
+{
+    string                  name;                     // Path of the group from the top, e.g. "batch/etl"
+    double                  weight;                   // Share of the CPU time relative to its sibling groups
+    double                  quota;                    // CPUs' worth of time it may use per quota period, 0 for no limit
+    double                  jobShare;                 // Share of the jobs submitted to it, -1 till set by completeSetup()
+}tenantGroupSetup_st;
+
+// State of a tenant group. The CPU time and jobs of a group include those of its subgroups.
+typedef struct
+{
+    long long               cpuTime;                  // CPU time (ns) used by its jobs
+    double                  virtualTime;              // CPU time (ns) used per unit of weight, the lowest runs next
+    long long               tokens;                   // CPU time (ns) left in its bucket, throttled once not positive
+    long long               tsRefill;                 // timestamp up to which the bucket has been refilled, -1 if never
+    long long               throttledTime;            // Time (ns) it had jobs to run but had used up its quota
+    unsigned long long      completedJobs;            // Jobs completed
+    long long               totalWaitingTime;         // Sum of waiting time (ns) of the completed jobs
+    long long               totalResponseTime;        // Sum of response time (ns) of the completed jobs
+    bool                    active;                   // Had jobs to run at the last pick
+}tenantGroupState_st;
+
+typedef struct
+{
+    string                  name;                     // Path of the group
+    double                  weight;                   // Share of the CPU time relative to its sibling groups
+    double                  quota;                    // CPUs' worth of time it may use per quota period, 0 for no limit
+    size_t                  completedJobs;            // Jobs completed
+    double                  throughput;               // Jobs completed per second
+    double                  cpuShare;                 // %age of the CPU time used by all the groups
+    double                  entitledShare;            // %age of the CPU time its weights entitle it to when all the groups are busy
+    double                  avgWaitingTime;           // Average waiting time (ns)
+    double                  avgResponseTime;          // Average response time (ns)
+    long long               throttledTime;            // Time (ns) it had jobs to run but had used up its quota
+}tenantResult_st;
+
+//-------------------------------------------------------------------------------------------------
+// TenantGroups shares the CPUs of a scheduler between tenants, as cgroups do: every job belongs
+// to a group, groups nest in a hierarchy, and the CPU time of a group is split between its
+// subgroups in proportion of their weights. A group may also have a quota, i.e. a bandwidth of
+// so many CPUs' worth of time per quota period, enforced with a token bucket that holds a period
+// of its quota: the CPU time its jobs run for is taken out of the bucket, and the group is
+// throttled till the bucket refills once it is empty.
+//
+// The scheduler asks which group is to run next, and the group of the lowest virtual time (CPU
+// time per unit of weight) that has jobs to run and is not throttled is picked at each level of
+// the hierarchy, down to a group with jobs of its own. A group that had nothing to run catches
+// up with the virtual time of its busy siblings, so it does not get the CPU time it left unused
+// back in a burst. The scheduling algorithm then picks the job to run among those of that group,
+// so any algorithm works inside the groups, passing over the jobs of the other groups as if they
+// were running elsewhere. Each CPU of the scheduler picks again whenever a job has run or the
+// pools have changed. A job only stops at the end of its time slice, so a group running long
+// jobs without preemption overdraws its quota, and is throttled till it has paid the debt back.
+// Used by the scheduler threads only.
+//-------------------------------------------------------------------------------------------------
+class TenantGroups
+{
+private:
+    vector<tenantGroupSetup_st>             m_setup;                      // Setup of each group, parents first
+    vector<int>                             m_parents;                    // Parent of each group, -1 at the top
+    vector<vector<unsigned int>>            m_children;                   // Subgroups of each group, the top ones first
+    vector<tenantGroupState_st>             m_groups;                     // State of each group
+    vector<double>                          m_floorVirtualTimes;          // Lowest virtual time of the busy subgroups of each group, the top first
+    vector<unsigned long long>              m_runnableJobs;               // Jobs of each group (subgroups excluded) that may run now
+    vector<unsigned long long>              m_busyJobs;                   // Same, subgroups included
+    vector<bool>                            m_eligible;                   // Group may be picked, as of the last pick
+    long long                               m_quotaPeriod;                // Time (ns) a quota is given for
+
+    void refill(unsigned int group, long long tsNow);
+    bool isThrottled(unsigned int group) { return m_setup[group].quota > 0 && m_groups[group].tokens <= 0; }
+    bool isPickedOver(unsigned int group, unsigned int other);
+    double getEntitledShare(unsigned int group);
+
+public:
+    TenantGroups(const vector<tenantGroupSetup_st> & setup, long long quotaPeriod);
+    ~TenantGroups();
+
+    size_t getGroupCount() { return m_setup.size(); }
+    void clearRunnableJobs();
+    void addRunnableJob(unsigned int group);
+    int pick(long long tsNow);
+    void charge(unsigned int group, long long cpuTime, long long tsEnd);
+    void accountCompletion(unsigned int group, long long waitingTime, long long responseTime);
+    long long getNextUnthrottleTime(int runningGroup);
+    void getResults(vector<tenantResult_st> & results, long long timeElapsed);
+
+    void saveCheckpoint(CheckpointWriter & writer);
+    bool restoreCheckpoint(CheckpointReader & reader);
+
+    static bool completeSetup(vector<tenantGroupSetup_st> & setup);
+    static int findParent(const vector<tenantGroupSetup_st> & setup, unsigned int group);
+};
+
+#endif
@@ -0,0 +1,51 @@
+#ifndef _TIMING_H_
+#define _TIMING_H_
+
+#include<chrono>
+
+using namespace std;
+
+//---------------------------------------------------------------------------------------------------
+// Globals
+//---------------------------------------------------------------------------------------------------
+
+const long long NANOSECONDS_PER_MICROSECOND = 1000;
+const long long NANOSECONDS_PER_MILLISECOND = 1000000;
+const long long NANOSECONDS_PER_SECOND      = 1000000000;
+
+// If a thread has not slept for this long past its last deadline, it has been busy doing
+// something else, and its next sleep starts from now instead of from the last deadline.
+const chrono::milliseconds MAX_SLEEP_CATCH_UP(2);
+
+//-------------------------------------------------------------------------------------------------
+// DeadlineSleeper sleeps till absolute deadlines rather than for relative durations. Each sleep
+// ends at the previous deadline plus the new duration, so the few microseconds by which a thread
+// always oversleeps are taken back on the next sleep instead of adding up over millions of sleeps.
+// A sleeper must only be used by one thread.
+//-------------------------------------------------------------------------------------------------
+class DeadlineSleeper
+{
+private:
+    chrono::steady_clock::time_point        m_deadline;                   // End of the last sleep
+    bool                                    m_hasDeadline;                // false till the first sleep
+
+public:
+    DeadlineSleeper();
+    ~DeadlineSleeper();
+
+    void sleepFor(chrono::nanoseconds duration);
+    void sleepUntil(chrono::steady_clock::time_point deadline);
+    void reset() { m_hasDeadline = false; }
+};
+
+//---------------------------------------------------------------------------------------------------
+// Functions
+//---------------------------------------------------------------------------------------------------
+long long getCurrentTimestampInMilliseconds();    // Monotonic, for measuring wall time
+long long getCurrentTimestampInNanoseconds();     // Monotonic, for timestamps of jobs
+long long getThreadCpuTimeInNanoseconds();        // CPU time used by the calling thread
+void sleepForMilliseconds(long long duration);    // Portable Sleep(), using a deadline sleeper per thread
+void sleepForNanoseconds(long long duration);
+void sleepUntilNanoseconds(long long timestamp);  // Till a timestamp of getCurrentTimestampInNanoseconds()
+
+#endif
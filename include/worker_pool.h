@@ -0,0 +1,64 @@
+#ifndef _WORKER_POOL_H_
+#define _WORKER_POOL_H_
+
+#include<condition_variable>
+#include<deque>
+#include<mutex>
+#include<thread>
+#include<vector>
+#include "job.h"
+
+using namespace std;
+
+//---------------------------------------------------------------------------------------------------
+// Enums and structures
+//---------------------------------------------------------------------------------------------------
+typedef enum
+{
+    PAYLOAD_KERNEL_NONE,                              // Work is simulated by sleeping on the clock
+    PAYLOAD_KERNEL_SPIN,                              // Integer arithmetic in registers
+    PAYLOAD_KERNEL_SORT,                              // Sorting of an array that fits in L2 cache
+    PAYLOAD_KERNEL_MATMUL                             // Floating point matrix multiplication
+}payloadKernel_en;
+
+//-------------------------------------------------------------------------------------------------
+// WorkerPool runs the payloads of jobs on a fixed set of worker threads. A scheduler hands over
+// the payload of the job it dispatches and waits till it has run, so the scheduling policies
+// decide the order as usual, while the work itself is real. Several schedulers can share a
+// pool, which then bounds the number of payloads running at the same time. The CPU time of a
+// payload is measured on the worker that runs it. A job coroutine is resumed on a worker
+// the same way, by a payload resuming it.
+//-------------------------------------------------------------------------------------------------
+class WorkerPool
+{
+private:
+    typedef struct
+    {
+        const jobPayload_fn*    payload;              // Payload to be run
+        long long               cpuTime;              // CPU time (ns) taken by the payload
+        bool                    done;                 // Set by the worker once the payload has run
+    }workerTask_st;
+
+    vector<thread>                          m_workers;
+    mutex                                   m_mutex;                      // Guards m_tasks and the tasks in it
+    condition_variable                      m_taskEvent;                  // Wakes up a worker when a task is queued
+    condition_variable                      m_doneEvent;                  // Wakes up the callers when a task is done
+    deque<workerTask_st*>                   m_tasks;                      // Tasks waiting for a worker
+    bool                                    m_stopRequested;
+
+    void runTasks();
+
+public:
+    WorkerPool(unsigned int workerCount);
+    ~WorkerPool();
+
+    unsigned int getWorkerCount() { return (unsigned int)m_workers.size(); }
+    long long execute(const jobPayload_fn & payload);
+
+    static long long runPayload(const jobPayload_fn & payload);
+    static jobPayload_fn createPayload(payloadKernel_en kernel, long long cpuTime);
+    static JobCoroutine createCoroutine(payloadKernel_en kernel, long long cpuTime);
+    static bool parseKernel(const string & name, payloadKernel_en & kernel);
+};
+
+#endif
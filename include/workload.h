@@ -0,0 +1,121 @@
+#ifndef _WORKLOAD_H_
+#define _WORKLOAD_H_
+
+#include<vector>
+#include "checkpoint.h"
+#include "job.h"
+#include "simulation_clock.h"
+
+using namespace std;
+
+class ProcessScheduler;
+
+//---------------------------------------------------------------------------------------------------
+// Enums and structures
+//---------------------------------------------------------------------------------------------------
+
+// How many of the generated jobs do I/O, and how much
+typedef struct
+{
+    double                  jobRatio;                 // Fraction of the jobs doing I/O, 0 for none
+    unsigned int            maxBursts;                // Max I/O bursts of a job
+    long long               maxBurstTime;             // Max time (ns) a device takes to serve an I/O burst
+    unsigned int            devices;                  // Devices the I/O bursts are spread over
+}ioProfile_st;
+
+// How many of the generated jobs are parallel, and how wide
+typedef struct
+{
+    double                  jobRatio;                 // Fraction of the jobs that are parallel, 0 for none
+    unsigned int            maxWidth;                 // Max CPUs a parallel job runs on at once
+}parallelProfile_st;
+
+// How the generated jobs are spread over the tenant groups
+typedef struct
+{
+    vector<double>          jobShares;                // Share of the jobs of each group, empty for a single tenant
+}tenantProfile_st;
+
+//-------------------------------------------------------------------------------------------------
+// Workload is a pre-generated, immutable list of job specifications ordered by arrival time.
+// Once generated it is only read, so the same workload can be fed to several schedulers
+// (even concurrently, from different threads) and their results compared like for like.
+// With an I/O profile, some of the jobs alternate between CPU and I/O bursts. The I/O is drawn
+// from an RNG of its own, so the arrivals and CPU times are the same with or without it.
+// Likewise with a parallel profile, some of the jobs run on several CPUs at once, each for
+// their time required, and with a tenant profile, the jobs are submitted to tenant groups.
+//-------------------------------------------------------------------------------------------------
+class Workload
+{
+private:
+    vector<jobSpec_st>      m_jobs;                       // Jobs in the order of their arrival
+    ioProfile_st            m_ioProfile;                  // I/O of the jobs to generate
+    parallelProfile_st      m_parallelProfile;            // Widths of the jobs to generate
+    tenantProfile_st        m_tenantProfile;              // Tenant groups of the jobs to generate
+
+public:
+    Workload();
+    ~Workload();
+
+    void setIoProfile(const ioProfile_st & profile) { m_ioProfile = profile; }
+    static void generateIoBursts(jobSpec_st & spec, const ioProfile_st & profile, RandomGenerator & rng);
+    void setParallelProfile(const parallelProfile_st & profile) { m_parallelProfile = profile; }
+    static void generateWidth(jobSpec_st & spec, const parallelProfile_st & profile, RandomGenerator & rng);
+    void setTenantProfile(const tenantProfile_st & profile) { m_tenantProfile = profile; }
+    static void generateTenantGroup(jobSpec_st & spec, const tenantProfile_st & profile, RandomGenerator & rng);
+
+    void generate(long int jobCount, int creationSleepMax);
+    void generate(long int jobCount, int creationSleepMax, RandomGenerator & rng);
+    size_t size() const { return m_jobs.size(); }
+    const jobSpec_st & at(size_t index) const { return m_jobs[index]; }
+    unsigned long long getSignature() const;
+};
+
+//-------------------------------------------------------------------------------------------------
+// JobFeeder releases jobs into a scheduler from the scheduler's own thread, instead of a separate
+// job creation thread. This is what drives a scheduler running on a VirtualClock: the scheduler
+// asks the feeder for the jobs that have arrived by now, and when it has nothing left to do,
+// waits on its clock till the next arrival. A feeder that does not know its next arrival yet
+// returns LLONG_MAX, and wakes the scheduler on its clock once it does (see ClusterNodeLink).
+//-------------------------------------------------------------------------------------------------
+class JobFeeder
+{
+public:
+    virtual ~JobFeeder() {}
+    virtual bool isExhausted() = 0;                                       // All the jobs have been released
+    virtual long long getNextArrivalTime() = 0;                           // timestamp of the next arrival, -1 if none
+    virtual bool areArrivalsKnown() { return true; }                      // Arrival times are known before they are due
+    virtual void releaseDueJobs(ProcessScheduler *scheduler) = 0;         // Adds the jobs arrived by now to the scheduler
+
+    virtual void saveCheckpoint(CheckpointWriter & writer) = 0;
+    virtual bool restoreCheckpoint(CheckpointReader & reader) = 0;
+};
+
+//-------------------------------------------------------------------------------------------------
+// WorkloadFeeder feeds the jobs of a workload to a scheduler at their arrival times.
+//-------------------------------------------------------------------------------------------------
+class WorkloadFeeder : public JobFeeder
+{
+private:
+    const Workload &        m_workload;                   // Jobs to be released
+    size_t                  m_nextJob;                    // Index of next job to be released
+    bool                    m_showJobStatus;              // Show details of job running status
+    int                     m_responseTimeThreshold;      // Threshold for job response time
+    SimulationClock*        m_clock;                      // Clock of the scheduler being fed
+    long long               m_tsStart;                    // timestamp value when feeding started
+    vector<Job*>            m_dueJobs;                    // Jobs being released, kept to reuse its memory
+    vector<Job*>            m_shedJobs;                   // Jobs shed by the scheduler
+
+public:
+    WorkloadFeeder(const Workload & workload, bool showJobStatus, int responseTimeThreshold, SimulationClock *clock);
+    ~WorkloadFeeder();
+
+    bool isExhausted() { return (m_nextJob >= m_workload.size()); }
+    long long getNextArrivalTime();
+    void releaseDueJobs(ProcessScheduler *scheduler);
+
+    void saveCheckpoint(CheckpointWriter & writer);
+    bool restoreCheckpoint(CheckpointReader & reader);
+};
+
+#endif
@@ -0,0 +1,252 @@
+#include "burst_predictor.h"
+
+//******************************************************************************************
+// @name                    : update
+//
+// @description             : Blends a burst that has been observed into the estimate. The
+//                            first burst of a history with no estimate becomes the estimate.
+//
+// @param estimate          : Estimate to update
+// @param burst             : CPU burst (ns) observed
+//
+// @returns                 : Nothing
+//******************************************************************************************
+void ExponentialAverageEstimator::update(burstEstimate_st & estimate, long long burst)
+{
+    if (estimate.predicted < 0)
+        estimate.predicted = burst;
+    else
+        estimate.predicted = (long long)(m_alpha * burst + (1 - m_alpha) * estimate.predicted);
+
+    estimate.samples++;
+}
+
+//******************************************************************************************
+// @name                    : update
+//
+// @description             : Takes the burst that has been observed as the next estimate.
+//
+// @param estimate          : Estimate to update
+// @param burst             : CPU burst (ns) observed
+//
+// @returns                 : Nothing
+//******************************************************************************************
+void LastBurstEstimator::update(burstEstimate_st & estimate, long long burst)
+{
+    estimate.predicted = burst;
+    estimate.samples++;
+}
+
+//******************************************************************************************
+// @name                    : update
+//
+// @description             : Adds the burst that has been observed to the running mean of
+//                            the bursts observed so far.
+//
+// @param estimate          : Estimate to update
+// @param burst             : CPU burst (ns) observed
+//
+// @returns                 : Nothing
+//******************************************************************************************
+void MeanBurstEstimator::update(burstEstimate_st & estimate, long long burst)
+{
+    if (estimate.samples == 0)
+        estimate.predicted = burst;
+    else
+        estimate.predicted += (burst - estimate.predicted) / (long long)(estimate.samples + 1);
+
+    estimate.samples++;
+}
+
+//******************************************************************************************
+// @name                    : BurstPredictor
+//
+// @description             : Constructor
+//
+// @param estimator         : Estimator to update the predictions with. It is deleted by the
+//                            predictor.
+// @param initialEstimate   : Prediction (ns) of the bursts of a class with no history
+//
+// @returns                 : Nothing
+//******************************************************************************************
+BurstPredictor::BurstPredictor(BurstEstimator *estimator, long long initialEstimate)
+{
+    m_estimator = estimator;
+    m_initialEstimate = initialEstimate;
+}
+
+//******************************************************************************************
+// @name                    : ~BurstPredictor
+//
+// @description             : Destructor
+//
+// @returns                 : Nothing
+//******************************************************************************************
+BurstPredictor::~BurstPredictor()
+{
+    delete m_estimator;
+}
+
+//******************************************************************************************
+// @name                    : getClassEstimate
+//
+// @description             : Fetches the estimate of the class of a job.
+//
+// @param job               : Job
+//
+// @returns                 : Estimate of its class
+//******************************************************************************************
+burstEstimate_st & BurstPredictor::getClassEstimate(Job *job)
+{
+    size_t jobClass = job->getJobPriority() / BURST_CLASS_PRIORITY_LEVELS;
+
+    if (jobClass >= m_classEstimates.size())
+    {
+        burstEstimate_st noEstimate;
+        noEstimate.predicted = -1;
+        noEstimate.samples = 0;
+        m_classEstimates.resize(jobClass + 1, noEstimate);
+    }
+
+    return m_classEstimates[jobClass];
+}
+
+//******************************************************************************************
+// @name                    : predict
+//
+// @description             : Predicts the time of the current CPU burst of a job.
+//
+// @param job               : Job
+//
+// @returns                 : Predicted time (ns) of the whole burst
+//******************************************************************************************
+long long BurstPredictor::predict(Job *job)
+{
+    burstEstimate_st & estimate = job->getBurstEstimate();
+
+    if (estimate.predicted < 0)
+    {
+        burstEstimate_st & classEstimate = getClassEstimate(job);
+        estimate.predicted = (classEstimate.predicted < 0) ? m_initialEstimate : classEstimate.predicted;
+    }
+
+    return estimate.predicted;
+}
+
+//******************************************************************************************
+// @name                    : observe
+//
+// @description             : Learns from a CPU burst of a job that has just ended, i.e. the
+//                            job has completed or is blocked on I/O. Its next burst and the
+//                            bursts of its class are predicted from it thereafter.
+//
+// @param job               : Job, whose burst time served is the time of the burst
+//
+// @returns                 : Error (ns) of the prediction of the burst, predicted - actual
+//******************************************************************************************
+long long BurstPredictor::observe(Job *job)
+{
+    long long burst = job->getCpuBurstServed();
+    long long error = predict(job) - burst;
+
+    m_estimator->update(job->getBurstEstimate(), burst);
+    m_estimator->update(getClassEstimate(job), burst);
+
+    return error;
+}
+
+//******************************************************************************************
+// @name                    : saveCheckpoint
+//
+// @description             : Saves the estimates of the job classes. The estimates of the
+//                            jobs are saved with the jobs.
+//
+// @param writer            : Checkpoint
+//
+// @returns                 : Nothing
+//******************************************************************************************
+void BurstPredictor::saveCheckpoint(CheckpointWriter & writer)
+{
+    writer.write((unsigned long long)m_classEstimates.size());
+    for (burstEstimate_st & estimate : m_classEstimates)
+    {
+        writer.write(estimate);
+    }
+}
+
+//******************************************************************************************
+// @name                    : restoreCheckpoint
+//
+// @description             : Restores the estimates of the job classes saved in a
+//                            checkpoint.
+//
+// @param reader            : Checkpoint
+//
+// @returns                 : true if the checkpoint could be read,
+//                            false otherwise
+//******************************************************************************************
+bool BurstPredictor::restoreCheckpoint(CheckpointReader & reader)
+{
+    unsigned long long classCount = reader.read<unsigned long long>();
+    if (reader.hasFailed() || classCount > JOB_PRIORITY_LOWEST / BURST_CLASS_PRIORITY_LEVELS + 1)
+    {
+        reader.setFailed();
+        return false;
+    }
+
+    m_classEstimates.resize((size_t)classCount);
+    for (burstEstimate_st & estimate : m_classEstimates)
+    {
+        estimate = reader.read<burstEstimate_st>();
+    }
+
+    return !reader.hasFailed();
+}
+
+//******************************************************************************************
+// @name                    : create
+//
+// @description             : Creates a predictor using one of the built-in estimators.
+//
+// @param kind              : Estimator
+// @param alpha             : Weight of the last burst, for exponential averaging
+// @param initialEstimate   : Prediction (ns) of the bursts of a class with no history
+//
+// @returns                 : Predictor
+//******************************************************************************************
+BurstPredictor* BurstPredictor::create(burstEstimator_en kind, double alpha, long long initialEstimate)
+{
+    BurstEstimator *estimator = nullptr;
+
+    switch (kind)
+    {
+    case BURST_ESTIMATOR_LAST:      estimator = new LastBurstEstimator(); break;
+    case BURST_ESTIMATOR_MEAN:      estimator = new MeanBurstEstimator(); break;
+    default:                        estimator = new ExponentialAverageEstimator(alpha); break;
+    }
+
+    return new BurstPredictor(estimator, initialEstimate);
+}
+
+//******************************************************************************************
+// @name                    : parseEstimator
+//
+// @description             : Converts the name of an estimator (exponential, last or mean)
+//                            to the estimator.
+//
+// @param name              : Name of the estimator
+// @param kind              : Estimator
+//
+// @returns                 : true if the name is valid,
+//                            false otherwise
+//******************************************************************************************
+bool BurstPredictor::parseEstimator(const string & name, burstEstimator_en & kind)
+{
+    if (name == "exponential")      kind = BURST_ESTIMATOR_EXPONENTIAL;
+    else if (name == "last")        kind = BURST_ESTIMATOR_LAST;
+    else if (name == "mean")        kind = BURST_ESTIMATOR_MEAN;
+    else
+        return false;
+
+    return true;
+}
@@ -0,0 +1,251 @@
+#include "checkpoint.h"
+#include<stdio.h>
+#include<string.h>
+
+//---------------------------------------------------------------------------------------------------
+// Globals
+//---------------------------------------------------------------------------------------------------
+const char          CHECKPOINT_FILE_MAGIC[8]    = { 'P', 'S', 'S', 'C', 'H', 'K', 'P', 'T' };
+const unsigned int  CHECKPOINT_FILE_VERSION     = 4;
+const unsigned int  CHECKPOINT_MAX_STRING       = 4096;               // Longest string in a valid checkpoint
+
+// Header of a checkpoint file
+typedef struct
+{
+    char                    magic[8];
+    unsigned int            version;
+    unsigned int            pointerSize;              // sizeof(void*) of the writer, as a check of the layout
+}checkpointFileHeader_st;
+
+//******************************************************************************************
+// @name                    : CheckpointWriter
+//
+// @description             : Constructor
+//
+// @returns                 : Nothing
+//******************************************************************************************
+CheckpointWriter::CheckpointWriter()
+{
+    m_file = nullptr;
+    m_failed = false;
+}
+
+//******************************************************************************************
+// @name                    : ~CheckpointWriter
+//
+// @description             : Destructor. A checkpoint that was not committed is discarded.
+//
+// @returns                 : Nothing
+//******************************************************************************************
+CheckpointWriter::~CheckpointWriter()
+{
+    if (m_file)
+    {
+        fclose(m_file);
+        remove(m_tempFileName.c_str());
+    }
+}
+
+//******************************************************************************************
+// @name                    : open
+//
+// @description             : Starts writing a checkpoint, beginning with its header.
+//
+// @param fileName          : Name of the checkpoint file
+//
+// @returns                 : true if the checkpoint could be created,
+//                            false otherwise
+//******************************************************************************************
+bool CheckpointWriter::open(const string & fileName)
+{
+    m_fileName = fileName;
+    m_tempFileName = fileName + ".tmp";
+    m_failed = false;
+
+    m_file = fopen(m_tempFileName.c_str(), "wb");
+    if (!m_file)
+    {
+        printf("ERROR: Unable to create checkpoint file '%s'\n", m_tempFileName.c_str());
+        m_failed = true;
+        return false;
+    }
+
+    checkpointFileHeader_st header;
+    memcpy(header.magic, CHECKPOINT_FILE_MAGIC, sizeof(header.magic));
+    header.version = CHECKPOINT_FILE_VERSION;
+    header.pointerSize = sizeof(void*);
+    write(header);
+
+    return !m_failed;
+}
+
+//******************************************************************************************
+// @name                    : commit
+//
+// @description             : Completes the checkpoint, replacing the previous checkpoint
+//                            file if any.
+//
+// @returns                 : true if the checkpoint was written,
+//                            false otherwise
+//******************************************************************************************
+bool CheckpointWriter::commit()
+{
+    if (!m_file)
+    {
+        return false;
+    }
+
+    m_failed = (fclose(m_file) != 0) || m_failed;
+    m_file = nullptr;
+
+    if (m_failed || rename(m_tempFileName.c_str(), m_fileName.c_str()) != 0)
+    {
+        printf("ERROR: Unable to write checkpoint file '%s'\n", m_fileName.c_str());
+        remove(m_tempFileName.c_str());
+        return false;
+    }
+
+    return true;
+}
+
+//******************************************************************************************
+// @name                    : writeBytes
+//
+// @description             : Writes raw bytes to the checkpoint.
+//
+// @param data              : Bytes to write
+// @param size              : Number of bytes
+//
+// @returns                 : Nothing
+//******************************************************************************************
+void CheckpointWriter::writeBytes(const void *data, size_t size)
+{
+    if (!m_file || m_failed)
+    {
+        m_failed = true;
+        return;
+    }
+
+    if (size && fwrite(data, size, 1, m_file) != 1)
+    {
+        m_failed = true;
+    }
+}
+
+//******************************************************************************************
+// @name                    : writeString
+//
+// @description             : Writes a string, preceded by its length.
+//
+// @param value             : String to write
+//
+// @returns                 : Nothing
+//******************************************************************************************
+void CheckpointWriter::writeString(const string & value)
+{
+    write((unsigned int)value.size());
+    writeBytes(value.data(), value.size());
+}
+
+//******************************************************************************************
+// @name                    : CheckpointReader
+//
+// @description             : Constructor
+//
+// @returns                 : Nothing
+//******************************************************************************************
+CheckpointReader::CheckpointReader()
+{
+    m_file = nullptr;
+    m_failed = false;
+}
+
+//******************************************************************************************
+// @name                    : ~CheckpointReader
+//
+// @description             : Destructor
+//
+// @returns                 : Nothing
+//******************************************************************************************
+CheckpointReader::~CheckpointReader()
+{
+    if (m_file)
+    {
+        fclose(m_file);
+    }
+}
+
+//******************************************************************************************
+// @name                    : open
+//
+// @description             : Opens a checkpoint file and checks its header.
+//
+// @param fileName          : Name of the checkpoint file
+//
+// @returns                 : true if it is a checkpoint this build can read,
+//                            false otherwise
+//******************************************************************************************
+bool CheckpointReader::open(const string & fileName)
+{
+    m_failed = false;
+    m_file = fopen(fileName.c_str(), "rb");
+    if (!m_file)
+    {
+        printf("ERROR: Unable to open checkpoint file '%s'\n", fileName.c_str());
+        m_failed = true;
+        return false;
+    }
+
+    checkpointFileHeader_st header = read<checkpointFileHeader_st>();
+    if (m_failed ||
+        memcmp(header.magic, CHECKPOINT_FILE_MAGIC, sizeof(header.magic)) != 0 ||
+        header.version != CHECKPOINT_FILE_VERSION || header.pointerSize != sizeof(void*))
+    {
+        printf("ERROR: '%s' is not a checkpoint file of this version\n", fileName.c_str());
+        m_failed = true;
+        return false;
+    }
+
+    return true;
+}
+
+//******************************************************************************************
+// @name                    : readBytes
+//
+// @description             : Reads raw bytes from the checkpoint. They are zeroed if they
+//                            cannot be read.
+//
+// @param data              : Buffer to read into
+// @param size              : Number of bytes
+//
+// @returns                 : Nothing
+//******************************************************************************************
+void CheckpointReader::readBytes(void *data, size_t size)
+{
+    if (!m_file || m_failed || (size && fread(data, size, 1, m_file) != 1))
+    {
+        m_failed = true;
+        memset(data, 0, size);
+    }
+}
+
+//******************************************************************************************
+// @name                    : readString
+//
+// @description             : Reads a string written by CheckpointWriter::writeString().
+//
+// @returns                 : String, empty if it cannot be read
+//******************************************************************************************
+string CheckpointReader::readString()
+{
+    unsigned int length = read<unsigned int>();
+    if (m_failed || length > CHECKPOINT_MAX_STRING)
+    {
+        m_failed = true;
+        return "";
+    }
+
+    string value(length, '\0');
+    readBytes(&value[0], length);
+    return m_failed ? "" : value;
+}
@@ -0,0 +1,629 @@
+#include "cluster.h"
+#include "job.h"
+#include "timing.h"
+#include<algorithm>
+#include<climits>
+#include<math.h>
+#include<stdio.h>
+#include<thread>
+
+//******************************************************************************************
+// @name                    : ClusterNodeLink
+//
+// @description             : Constructor
+//
+// @param cluster           : Cluster of the node
+// @param clock             : Clock of the cluster
+//
+// @returns                 : Nothing
+//******************************************************************************************
+ClusterNodeLink::ClusterNodeLink(Cluster *cluster, SimulationClock *clock)
+{
+    m_cluster = cluster;
+    m_clock = clock;
+    m_sentJobs = 0;
+}
+
+//******************************************************************************************
+// @name                    : ~ClusterNodeLink
+//
+// @description             : Destructor. Deletes the jobs that never reached the node.
+//
+// @returns                 : Nothing
+//******************************************************************************************
+ClusterNodeLink::~ClusterNodeLink()
+{
+    for (auto it = m_inFlight.begin(); it != m_inFlight.end(); it++)
+    {
+        delete it->second;
+    }
+
+    m_inFlight.clear();
+}
+
+//******************************************************************************************
+// @name                    : send
+//
+// @description             : Sends a job to the node. The link takes ownership of the job
+//                            till it is delivered.
+//
+// @param job               : Job placed on the node
+// @param tsDelivery        : timestamp when the job reaches the node
+//
+// @returns                 : Nothing
+//******************************************************************************************
+void ClusterNodeLink::send(Job *job, long long tsDelivery)
+{
+    m_inFlight[make_pair(tsDelivery, m_sentJobs++)] = job;
+}
+
+//******************************************************************************************
+// @name                    : isExhausted
+//
+// @description             : Checks whether the node has been delivered all of its jobs,
+//                            i.e. the dispatcher is done and nothing is on its way.
+//
+// @returns                 : true if no more jobs will reach the node,
+//                            false otherwise
+//******************************************************************************************
+bool ClusterNodeLink::isExhausted()
+{
+    return (m_cluster->isDispatchComplete() && m_inFlight.empty());
+}
+
+//******************************************************************************************
+// @name                    : getNextArrivalTime
+//
+// @description             : Fetches the timestamp at which the next job reaches the node.
+//
+// @returns                 : Timestamp of the next delivery, LLONG_MAX if no job is on its
+//                            way yet, -1 if no more jobs will reach the node.
+//******************************************************************************************
+long long ClusterNodeLink::getNextArrivalTime()
+{
+    if (!m_inFlight.empty())
+    {
+        return m_inFlight.begin()->first.first;
+    }
+
+    return isExhausted() ? -1 : LLONG_MAX;
+}
+
+//******************************************************************************************
+// @name                    : releaseDueJobs
+//
+// @description             : Adds all the jobs that have reached the node by now to its
+//                            ready queue, as a single batch.
+//
+// @param scheduler         : Scheduler of the node
+//
+// @returns                 : Nothing
+//******************************************************************************************
+void ClusterNodeLink::releaseDueJobs(ProcessScheduler *scheduler)
+{
+    long long currentTimestamp = m_clock->now();
+
+    while (!m_inFlight.empty() && m_inFlight.begin()->first.first <= currentTimestamp)
+    {
+        m_dueJobs.push_back(m_inFlight.begin()->second);
+        m_inFlight.erase(m_inFlight.begin());
+    }
+
+    if (m_dueJobs.empty())
+    {
+        return;
+    }
+
+    scheduler->addToReadyQueue(m_dueJobs, m_shedJobs);
+    for (Job *job : m_shedJobs)
+    {
+        delete job;
+    }
+
+    m_dueJobs.clear();
+    m_shedJobs.clear();
+}
+
+//******************************************************************************************
+// @name                    : saveCheckpoint
+//
+// @description             : Nodes of a cluster are not checkpointed, so nothing is saved.
+//                            Only there as every JobFeeder must be able to checkpoint; the
+//                            config checks never let a cluster save one.
+//
+// @returns                 : Nothing
+//******************************************************************************************
+void ClusterNodeLink::saveCheckpoint(CheckpointWriter &)
+{
+
+}
+
+//******************************************************************************************
+// @name                    : restoreCheckpoint
+//
+// @description             : Nodes of a cluster are not checkpointed, and the config checks
+//                            never let a cluster be restored from one.
+//
+// @returns                 : false
+//******************************************************************************************
+bool ClusterNodeLink::restoreCheckpoint(CheckpointReader &)
+{
+    printf("ERROR: Nodes of a cluster can't be restored from a checkpoint!\n");
+    return false;
+}
+
+//******************************************************************************************
+// @name                    : Cluster
+//
+// @description             : Constructor
+//
+// @param workload          : Jobs to be dispatched. Must outlive the cluster.
+// @param setup             : Setup of the cluster
+// @param showJobStatus     : Show details of job running status
+// @param responseTimeThreshold : Threshold for job response time
+//
+// @returns                 : Nothing
+//******************************************************************************************
+Cluster::Cluster(const Workload & workload, const clusterSetup_st & setup, bool showJobStatus, int responseTimeThreshold)
+    : m_workload(workload),
+      m_rng(setup.seed ? RandomGenerator(setup.seed) : RandomGenerator()),
+      m_networkRng(setup.seed ? RandomGenerator(setup.seed + 1) : RandomGenerator())
+{
+    m_setup = setup;
+    m_showJobStatus = showJobStatus;
+    m_responseTimeThreshold = responseTimeThreshold;
+    m_nextNode = 0;
+    m_arrivalScale = 1;
+    m_clock = nullptr;
+    m_dispatchComplete = false;
+    m_simulatedTime = 0;
+    m_wallTime = 0;
+}
+
+//******************************************************************************************
+// @name                    : ~Cluster
+//
+// @description             : Destroys the schedulers of all the nodes.
+//
+// @returns                 : Nothing
+//******************************************************************************************
+Cluster::~Cluster()
+{
+    for (auto it = m_nodes.begin(); it != m_nodes.end(); it++)
+    {
+        delete *it;
+    }
+
+    for (auto it = m_links.begin(); it != m_links.end(); it++)
+    {
+        delete *it;
+    }
+
+    m_nodes.clear();
+    m_links.clear();
+}
+
+//******************************************************************************************
+// @name                    : addNode
+//
+// @description             : Adds a node to the cluster. The cluster takes ownership of its
+//                            scheduler, which must run on a single CPU.
+//
+// @param scheduler         : Scheduler of the node
+//
+// @returns                 : Nothing
+//******************************************************************************************
+void Cluster::addNode(ProcessScheduler *scheduler)
+{
+    if (scheduler)
+    {
+        m_nodes.push_back(scheduler);
+    }
+}
+
+//******************************************************************************************
+// @name                    : run
+//
+// @description             : Simulates the cluster till all the jobs of the workload are
+//                            complete or shed. The calling thread is the dispatcher, and
+//                            each node runs on a thread of its own.
+//
+// @returns                 : true if simulation executed successfully,
+//                            false otherwise
+//********************************************************************************************
+bool Cluster::run()
+{
+    if (m_nodes.empty() || m_workload.size() == 0)
+    {
+        printf("ERROR: Nothing to simulate on the cluster!\n");
+        return false;
+    }
+
+    long long tsStart = getCurrentTimestampInMilliseconds();
+    VirtualClock baseClock;
+    LockstepClock clock(&baseClock, (unsigned int)m_nodes.size() + 1);
+    vector<thread> nodeThreads;
+
+    m_clock = &clock;
+    m_dispatchComplete = false;
+    m_nextNode = 0;
+    setArrivalScale();
+
+    for (auto it = m_links.begin(); it != m_links.end(); it++)
+    {
+        delete *it;
+    }
+
+    m_links.clear();
+    for (size_t node = 0; node < m_nodes.size(); node++)
+    {
+        m_links.push_back(new ClusterNodeLink(this, &clock));
+        m_nodes[node]->setClock(&clock);
+        m_nodes[node]->setWorkloadFeeder(m_links[node]);
+    }
+
+    for (unsigned int node = 0; node < m_nodes.size(); node++)
+    {
+        nodeThreads.push_back(thread(&Cluster::runNode, this, node));
+    }
+
+    clock.enter(0);
+    dispatchJobs();
+    clock.leave();
+
+    for (auto it = nodeThreads.begin(); it != nodeThreads.end(); it++)
+    {
+        it->join();
+    }
+
+    // The clock goes out of scope now
+    for (auto it = m_nodes.begin(); it != m_nodes.end(); it++)
+    {
+        (*it)->setWorkloadFeeder(nullptr);
+        (*it)->setClock(getRealTimeClock());
+    }
+
+    m_clock = nullptr;
+    m_simulatedTime = baseClock.now();
+    m_wallTime = getCurrentTimestampInMilliseconds() - tsStart;
+    return true;
+}
+
+//******************************************************************************************
+// @name                    : dispatchJobs
+//
+// @description             : Dispatcher of the cluster. Places every job of the workload on
+//                            a node at its arrival time, and wakes the node for when the job
+//                            reaches it. Once all the jobs are placed, wakes all the nodes,
+//                            so the idle ones find out that they are done.
+//
+// @returns                 : Nothing
+//********************************************************************************************
+void Cluster::dispatchJobs()
+{
+    long long tsStart = m_clock->now();
+
+    for (size_t i = 0; i < m_workload.size(); i++)
+    {
+        const jobSpec_st & spec = m_workload.at(i);
+        long long tsArrival = tsStart + (long long)(spec.arrivalTime * m_arrivalScale);
+        m_clock->sleepFor(tsArrival - m_clock->now());
+
+        Job *job = new Job(m_showJobStatus, spec, m_responseTimeThreshold, m_clock);
+        job->setJobTimeCreated(tsArrival);
+
+        unsigned int node = selectNode();
+        long long tsDelivery = tsArrival + drawNetworkDelay();
+        m_links[node]->send(job, tsDelivery);
+        m_clock->wake(node + 1, tsDelivery);
+    }
+
+    m_dispatchComplete = true;
+    for (unsigned int node = 0; node < m_nodes.size(); node++)
+    {
+        m_clock->wake(node + 1, m_clock->now());
+    }
+}
+
+//******************************************************************************************
+// @name                    : runNode
+//
+// @description             : Runs the simulation of a node.
+//
+// @param node              : Node of the calling thread
+//
+// @returns                 : Nothing
+//********************************************************************************************
+void Cluster::runNode(unsigned int node)
+{
+    m_clock->enter(node + 1);
+    m_nodes[node]->runOnCpus();
+    m_clock->leave();
+}
+
+//******************************************************************************************
+// @name                    : selectNode
+//
+// @description             : Picks the node an arriving job is placed on, as per the load
+//                            balancing policy. Ties between the shortest queues are broken
+//                            at random.
+//
+// @returns                 : Node
+//********************************************************************************************
+unsigned int Cluster::selectNode()
+{
+    unsigned int nodes = (unsigned int)m_nodes.size();
+    unsigned int node = 0;
+
+    switch (m_setup.balancing)
+    {
+        case LOAD_BALANCING_ROUND_ROBIN:
+            node = m_nextNode;
+            m_nextNode = (m_nextNode + 1) % nodes;
+            break;
+
+        case LOAD_BALANCING_JSQ:
+        {
+            // Scan from a random node, so ties do not always go to the same nodes
+            unsigned int first = m_rng.generateRandomNumber(nodes);
+            unsigned long long shortest = ULLONG_MAX;
+            for (unsigned int i = 0; i < nodes && shortest > 0; i++)
+            {
+                unsigned int candidate = (first + i) % nodes;
+                unsigned long long length = getQueueLength(candidate);
+                if (length < shortest)
+                {
+                    shortest = length;
+                    node = candidate;
+                }
+            }
+            break;
+        }
+
+        case LOAD_BALANCING_POWER_OF_TWO:
+        {
+            node = m_rng.generateRandomNumber(nodes);
+            if (nodes > 1)
+            {
+                unsigned int other = m_rng.generateRandomNumber(nodes - 1);
+                other = (other >= node) ? other + 1 : other;
+                node = (getQueueLength(other) < getQueueLength(node)) ? other : node;
+            }
+            break;
+        }
+
+        case LOAD_BALANCING_RANDOM:
+        default:
+            node = m_rng.generateRandomNumber(nodes);
+            break;
+    }
+
+    return node;
+}
+
+//******************************************************************************************
+// @name                    : getQueueLength
+//
+// @description             : Counts the jobs placed on a node that are not complete yet,
+//                            i.e. on their way to it or admitted by it.
+//
+// @param node              : Node
+//
+// @returns                 : Number of jobs
+//********************************************************************************************
+unsigned long long Cluster::getQueueLength(unsigned int node)
+{
+    return m_links[node]->getInFlightJobs() + m_nodes[node]->getJobsInSystem();
+}
+
+//******************************************************************************************
+// @name                    : drawNetworkDelay
+//
+// @description             : Draws the time a job takes to reach its node: the network
+//                            delay, plus a uniform jitter of up to the max jitter.
+//
+// @returns                 : Delay (ns)
+//********************************************************************************************
+long long Cluster::drawNetworkDelay()
+{
+    if (m_setup.networkJitter <= 0)
+    {
+        return m_setup.networkDelay;
+    }
+
+    return m_setup.networkDelay + (long long)(m_setup.networkJitter * (m_networkRng.generateRandomNumber(UINT_MAX) / (double)UINT_MAX));
+}
+
+//******************************************************************************************
+// @name                    : setArrivalScale
+//
+// @description             : Scales the arrival times of the workload so that each node
+//                            gets the load of the setup, i.e. the CPU time required by the
+//                            jobs is that share of the time of all the nodes till the last
+//                            arrival. Arrivals are left as they are without a load.
+//
+// @returns                 : Nothing
+//********************************************************************************************
+void Cluster::setArrivalScale()
+{
+    long long lastArrival = m_workload.at(m_workload.size() - 1).arrivalTime;
+    double timeRequired = 0;
+
+    m_arrivalScale = 1;
+    if (m_setup.load <= 0 || lastArrival <= 0)
+    {
+        return;
+    }
+
+    for (size_t i = 0; i < m_workload.size(); i++)
+    {
+        timeRequired += (double)m_workload.at(i).timeRequired;
+    }
+
+    m_arrivalScale = timeRequired / ((double)lastArrival * m_nodes.size() * m_setup.load);
+}
+
+//******************************************************************************************
+// @name                    : getPercentile
+//
+// @description             : Fetches a percentile of sorted times, by nearest rank.
+//
+// @param sortedTimes       : Times, in increasing order
+// @param percentile        : Percentile, 0 to 100
+//
+// @returns                 : Time, 0 if there are none
+//********************************************************************************************
+long long Cluster::getPercentile(const vector<long long> & sortedTimes, double percentile)
+{
+    if (sortedTimes.empty())
+    {
+        return 0;
+    }
+
+    size_t rank = (size_t)ceil(percentile / 100 * sortedTimes.size());
+    return sortedTimes[(rank > 0) ? rank - 1 : 0];
+}
+
+//******************************************************************************************
+// @name                    : getResult
+//
+// @description             : Fetches the result of the last run of the cluster, over the
+//                            jobs of all its nodes.
+//
+// @param result            : Result of the simulation
+//
+// @returns                 : Nothing
+//********************************************************************************************
+void Cluster::getResult(clusterResult_st & result)
+{
+    vector<long long> responseTimes;
+    long long totalWaitingTime = 0;
+    long long cpuBusyTime = 0;
+    unsigned long long maxSentJobs = 0;
+    unsigned long long sentJobs = 0;
+
+    result.schedulerName = m_nodes.empty() ? "" : m_nodes[0]->getSchedulerName();
+    result.balancingName = getLoadBalancingName(m_setup.balancing);
+    result.nodes = (unsigned int)m_nodes.size();
+    result.completedJobs = 0;
+    result.shedJobs = 0;
+
+    for (size_t node = 0; node < m_nodes.size(); node++)
+    {
+        schedulerStats_st stats = m_nodes[node]->getStatsSnapshot();
+        result.completedJobs += (size_t)stats.completedJobs;
+        result.shedJobs += (size_t)m_nodes[node]->getShedJobs();
+        totalWaitingTime += stats.totalWaitingTime;
+        cpuBusyTime += stats.cpuBusyTime;
+        m_nodes[node]->getResponseTimes(responseTimes);
+
+        sentJobs += m_links[node]->getSentJobs();
+        maxSentJobs = max(maxSentJobs, m_links[node]->getSentJobs());
+    }
+
+    sort(responseTimes.begin(), responseTimes.end());
+
+    double avgResponseTime = 0;
+    for (auto it = responseTimes.begin(); it != responseTimes.end(); it++)
+    {
+        avgResponseTime += (double)*it;
+    }
+
+    result.avgWaitingTime = result.completedJobs ? (double)totalWaitingTime / result.completedJobs : 0;
+    result.avgResponseTime = responseTimes.empty() ? 0 : avgResponseTime / responseTimes.size();
+    result.p50ResponseTime = getPercentile(responseTimes, 50);
+    result.p99ResponseTime = getPercentile(responseTimes, 99);
+    result.p999ResponseTime = getPercentile(responseTimes, 99.9);
+    result.maxResponseTime = responseTimes.empty() ? 0 : responseTimes.back();
+    result.cpuUtilization = (m_simulatedTime > 0 && !m_nodes.empty()) ? (double)cpuBusyTime * 100 / ((double)m_simulatedTime * m_nodes.size()) : 0;
+    result.loadImbalance = sentJobs ? (double)maxSentJobs * m_nodes.size() / sentJobs : 0;
+    result.simulatedTime = m_simulatedTime;
+    result.wallTime = m_wallTime;
+}
+
+//******************************************************************************************
+// @name                    : parseLoadBalancing
+//
+// @description             : Parses the name of a load balancing policy.
+//
+// @param name              : random, round_robin, jsq, power_of_two, or all for
+//                            LOAD_BALANCING_MAX, i.e. every policy in turn
+// @param balancing         : Parsed policy
+//
+// @returns                 : true if the name is valid,
+//                            false otherwise
+//********************************************************************************************
+bool Cluster::parseLoadBalancing(const string & name, loadBalancing_en & balancing)
+{
+    for (int i = 0; i <= LOAD_BALANCING_MAX; i++)
+    {
+        if (name == getLoadBalancingName((loadBalancing_en)i))
+        {
+            balancing = (loadBalancing_en)i;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+//******************************************************************************************
+// @name                    : getLoadBalancingName
+//
+// @description             : Fetches the name of a load balancing policy.
+//
+// @param balancing         : Policy
+//
+// @returns                 : Name
+//********************************************************************************************
+const char* Cluster::getLoadBalancingName(loadBalancing_en balancing)
+{
+    switch (balancing)
+    {
+        case LOAD_BALANCING_RANDOM:         return "random";
+        case LOAD_BALANCING_ROUND_ROBIN:    return "round_robin";
+        case LOAD_BALANCING_JSQ:            return "jsq";
+        case LOAD_BALANCING_POWER_OF_TWO:   return "power_of_two";
+        default:                            return "all";
+    }
+}
+
+//******************************************************************************************
+// @name                    : displayResults
+//
+// @description             : Displays the results of clusters side by side, with the tail
+//                            of their response times.
+//
+// @param results           : Results of the clusters
+//
+// @returns                 : Nothing
+//********************************************************************************************
+void Cluster::displayResults(const vector<clusterResult_st> & results)
+{
+    const char *separator = "+-------------------------------------------+--------------+-------+-----------+-----------+-------------+-------------+-------------+-------------+-------------+-------------+--------+-----------+-------------+\n";
+
+    printf("\n\n");
+    printf("%s", separator);
+    printf("| %-41s | %-12s | %5s | %9s | %9s | %11s | %11s | %11s | %11s | %11s | %11s | %6s | %9s | %11s |\n",
+           "Scheduler", "Balancing", "Nodes", "Completed", "Shed", "Avg wait(s)", "Avg resp(s)", "p50 resp(s)", "p99 resp(s)", "p99.9 (s)", "Max resp(s)", "CPU(%)", "Imbalance", "Wall(s)");
+    printf("%s", separator);
+    for (auto it = results.begin(); it != results.end(); it++)
+    {
+        printf("| %-41s | %-12s | %5u | %9zu | %9zu | %11.2lf | %11.2lf | %11.2lf | %11.2lf | %11.2lf | %11.2lf | %6.2lf | %9.2lf | %11.2lf |\n",
+               it->schedulerName.c_str(),
+               it->balancingName.c_str(),
+               it->nodes,
+               it->completedJobs,
+               it->shedJobs,
+               it->avgWaitingTime / (double)NANOSECONDS_PER_SECOND,
+               it->avgResponseTime / (double)NANOSECONDS_PER_SECOND,
+               it->p50ResponseTime / (double)NANOSECONDS_PER_SECOND,
+               it->p99ResponseTime / (double)NANOSECONDS_PER_SECOND,
+               it->p999ResponseTime / (double)NANOSECONDS_PER_SECOND,
+               it->maxResponseTime / (double)NANOSECONDS_PER_SECOND,
+               it->cpuUtilization,
+               it->loadImbalance,
+               it->wallTime / (double)1000);
+    }
+    printf("%s\n", separator);
+}
@@ -0,0 +1,459 @@
+#include "comparison_runner.h"
+#include "job_batcher.h"
+#include "stats_reporter.h"
+#include "timing.h"
+#include<chrono>
+#include<stdio.h>
+#include<thread>
+
+//******************************************************************************************
+// @name                    : ComparisonRunner
+//
+// @description             : Constructor
+//
+// @param workload          : Jobs to be fed to every scheduler. Must outlive the runner.
+// @param showJobStatus     : Show details of job running status
+// @param responseTimeThreshold : Threshold for job response time
+// @param useVirtualClock   : Simulate each scheduler on its own virtual clock
+//
+// @returns                 : Nothing
+//******************************************************************************************
+ComparisonRunner::ComparisonRunner(const Workload & workload, bool showJobStatus, int responseTimeThreshold, bool useVirtualClock)
+    : m_workload(workload)
+{
+    m_showJobStatus = showJobStatus;
+    m_responseTimeThreshold = responseTimeThreshold;
+    m_useVirtualClock = useVirtualClock;
+    m_submitBatchSize = 1;
+    m_submitBatchWindow = 0;
+    m_wallTime = 0;
+}
+
+//******************************************************************************************
+// @name                    : ~ComparisonRunner
+//
+// @description             : Destroys all the schedulers added to this runner.
+//
+// @returns                 : Nothing
+//******************************************************************************************
+ComparisonRunner::~ComparisonRunner()
+{
+    for (auto it = m_schedulers.begin(); it != m_schedulers.end(); it++)
+    {
+        delete *it;
+    }
+
+    m_schedulers.clear();
+}
+
+//******************************************************************************************
+// @name                    : addScheduler
+//
+// @description             : Adds a scheduler to the comparison. The runner takes ownership
+//                            of the scheduler.
+//
+// @param scheduler         : scheduler object
+//
+// @returns                 : Nothing
+//******************************************************************************************
+void ComparisonRunner::addScheduler(ProcessScheduler *scheduler)
+{
+    if (scheduler)
+    {
+        m_schedulers.push_back(scheduler);
+    }
+}
+
+//******************************************************************************************
+// @name                    : setSubmitBatching
+//
+// @description             : Makes the feeder threads add the jobs to the ready queues in
+//                            batches (see JobBatcher). Has no effect on a virtual clock,
+//                            where the jobs due at once are always added as a batch.
+//
+// @param batchSize         : Jobs added at once, 1 to add every job on its own
+// @param batchWindow       : Max time (ns) a job is held back, 0 for no limit
+//
+// @returns                 : Nothing
+//******************************************************************************************
+void ComparisonRunner::setSubmitBatching(size_t batchSize, long long batchWindow)
+{
+    m_submitBatchSize = batchSize;
+    m_submitBatchWindow = batchWindow;
+}
+
+//******************************************************************************************
+// @name                    : feedWorkload
+//
+// @description             : Feeder thread of a scheduler. Creates the jobs of the workload
+//                            and adds them to the ready queue of the scheduler at their
+//                            arrival time. Arrival times are absolute deadlines from the
+//                            start of the feed, so sleeping late once does not delay
+//                            all the following jobs. Marks end of simulation once all the
+//                            jobs are complete. Jobs are added in batches if set.
+//
+// @param scheduler         : scheduler object
+//
+// @returns                 : Nothing
+//********************************************************************************************
+void ComparisonRunner::feedWorkload(ProcessScheduler *scheduler)
+{
+    long long tsStart = getCurrentTimestampInNanoseconds();
+
+    {
+        // Jobs shed by admission control are deleted by the batcher
+        JobBatcher batcher(scheduler, m_submitBatchSize, m_submitBatchWindow);
+
+        for (size_t i = 0; i < m_workload.size(); i++)
+        {
+            const jobSpec_st & spec = m_workload.at(i);
+            batcher.waitUntil(tsStart + spec.arrivalTime);
+            batcher.add(new Job(m_showJobStatus, spec, m_responseTimeThreshold, nullptr));
+        }
+    }
+
+    // Wait till all the created jobs are complete or shed
+    while (scheduler->getCompletedJobs() + scheduler->getShedJobs() < m_workload.size())
+    {
+        this_thread::sleep_for(chrono::milliseconds(100));
+    }
+
+    scheduler->setSimulationComplete(true);
+}
+
+//******************************************************************************************
+// @name                    : runScheduler
+//
+// @description             : Runs the simulation of one scheduler and records its results.
+//                            This is executed on a thread of its own. Stats of the scheduler
+//                            are displayed from a reporter thread as per its display interval.
+//
+// @param scheduler         : scheduler object
+// @param result            : Result of the simulation
+//
+// @returns                 : Nothing
+//********************************************************************************************
+void ComparisonRunner::runScheduler(ProcessScheduler *scheduler, simulationResult_st *result)
+{
+    long long tsStart = getCurrentTimestampInMilliseconds();
+    StatsReporter reporter(scheduler, scheduler->getDisplayInterval());
+
+    if (m_useVirtualClock)
+    {
+        VirtualClock clock;
+        WorkloadFeeder feeder(m_workload, m_showJobStatus, m_responseTimeThreshold, &clock);
+
+        scheduler->setClock(&clock);
+        scheduler->setWorkloadFeeder(&feeder);
+        reporter.start();
+        scheduler->runOnCpus();
+        reporter.stop();
+        scheduler->getSimulationResult(*result);
+
+        // The clock goes out of scope now
+        scheduler->setWorkloadFeeder(nullptr);
+        scheduler->setClock(getRealTimeClock());
+    }
+    else
+    {
+        thread feederThreadId = thread(&ComparisonRunner::feedWorkload, this, scheduler);
+        reporter.start();
+        scheduler->runOnCpus();
+        feederThreadId.join();
+        reporter.stop();
+
+        scheduler->getSimulationResult(*result);
+    }
+
+    result->wallTime = getCurrentTimestampInMilliseconds() - tsStart;
+}
+
+//******************************************************************************************
+// @name                    : run
+//
+// @description             : Simulates all the schedulers at the same time and waits for
+//                            all of them to complete.
+//
+// @returns                 : true if simulation executed successfully,
+//                            false otherwise
+//********************************************************************************************
+bool ComparisonRunner::run()
+{
+    if (m_schedulers.empty() || m_workload.size() == 0)
+    {
+        printf("ERROR: Nothing to compare!\n");
+        return false;
+    }
+
+    long long tsStart = getCurrentTimestampInMilliseconds();
+    vector<thread> schedulerThreads;
+
+    m_results.assign(m_schedulers.size(), simulationResult_st());
+    for (size_t i = 0; i < m_schedulers.size(); i++)
+    {
+        schedulerThreads.push_back(thread(&ComparisonRunner::runScheduler, this, m_schedulers[i], &m_results[i]));
+    }
+
+    for (auto it = schedulerThreads.begin(); it != schedulerThreads.end(); it++)
+    {
+        it->join();
+    }
+
+    m_wallTime = getCurrentTimestampInMilliseconds() - tsStart;
+    return true;
+}
+
+//******************************************************************************************
+// @name                    : displayResults
+//
+// @description             : Displays the metrics of all the schedulers side by side.
+//
+// @returns                 : Nothing
+//********************************************************************************************
+void ComparisonRunner::displayResults()
+{
+    const char *separator = "+-------------------------------------------+-----------+-----------+-------------+-------------+-------------+-----------+-------------+--------+-------------+\n";
+
+    printf("\n\n");
+    printf("%s", separator);
+    printf("| %-41s | %9s | %9s | %11s | %11s | %11s | %9s | %11s | %6s | %11s |\n",
+           "Scheduler", "Completed", "Shed", "Avg req(s)", "Avg wait(s)", "Avg resp(s)", "RT exc(%)", "Thruput(/s)", "CPU(%)", "Wall(s)");
+    printf("%s", separator);
+    for (auto it = m_results.begin(); it != m_results.end(); it++)
+    {
+        printf("| %-41s | %9zu | %9zu | %11.2lf | %11.2lf | %11.2lf | %9.2lf | %11.6lf | %6.2lf | %11.2lf |\n",
+               it->schedulerName.c_str(),
+               it->completedJobs,
+               it->shedJobs,
+               it->avgTimeRequired / (double)NANOSECONDS_PER_SECOND,
+               it->avgWaitingTime / (double)NANOSECONDS_PER_SECOND,
+               it->avgResponseTime / (double)NANOSECONDS_PER_SECOND,
+               it->thresholdExceeded,
+               it->throughput,
+               it->cpuUtilization,
+               it->wallTime / (double)1000);
+    }
+    printf("%s", separator);
+    printf("Jobs per scheduler: %zu, total wall time: %.2lf seconds\n\n", m_workload.size(), m_wallTime / (double)1000);
+    displayPredictionResults();
+    displayCpuResults();
+    displayGangResults();
+    displayTenantResults();
+}
+
+//******************************************************************************************
+// @name                    : displayPredictionResults
+//
+// @description             : Displays the errors of the schedulers that order jobs on
+//                            predicted CPU bursts, and how much longer their average
+//                            response time is than that of the same algorithm on the
+//                            actual bursts (the oracle), if it was simulated too.
+//
+// @returns                 : Nothing
+//********************************************************************************************
+void ComparisonRunner::displayPredictionResults()
+{
+    const char *separator = "+-------------------------------------------+-------------+-------------+------------------+\n";
+    bool headerShown = false;
+
+    for (auto it = m_results.begin(); it != m_results.end(); it++)
+    {
+        if (it->oracleSchedulerName.empty())
+        {
+            continue;
+        }
+
+        if (!headerShown)
+        {
+            printf("%s", separator);
+            printf("| %-41s | %11s | %11s | %16s |\n", "Scheduler", "Avg err(s)", "Bias(s)", "Resp penalty(%)");
+            printf("%s", separator);
+            headerShown = true;
+        }
+
+        char penalty[32] = "-";
+        for (auto oracle = m_results.begin(); oracle != m_results.end(); oracle++)
+        {
+            if (oracle->schedulerName == it->oracleSchedulerName && oracle->avgResponseTime > 0)
+            {
+                snprintf(penalty, sizeof(penalty), "%+.2lf", (it->avgResponseTime - oracle->avgResponseTime) * 100 / oracle->avgResponseTime);
+            }
+        }
+
+        printf("| %-41s | %11.2lf | %+11.2lf | %16s |\n",
+               it->schedulerName.c_str(),
+               it->avgPredictionError / (double)NANOSECONDS_PER_SECOND,
+               it->avgPredictionBias / (double)NANOSECONDS_PER_SECOND,
+               penalty);
+    }
+
+    if (headerShown)
+    {
+        printf("%s\n", separator);
+    }
+}
+
+//******************************************************************************************
+// @name                    : displayCpuResults
+//
+// @description             : Displays how the time of the CPUs was spent, for the
+//                            schedulers simulated on several CPUs or with a cost of
+//                            context switches: how often jobs were switched and migrated,
+//                            and the share of the CPU time lost to it.
+//
+// @returns                 : Nothing
+//********************************************************************************************
+void ComparisonRunner::displayCpuResults()
+{
+    const char *separator = "+-------------------------------------------+------+-------------+-------------+-------------+-------------+---------------+\n";
+    bool headerShown = false;
+
+    for (auto it = m_results.begin(); it != m_results.end(); it++)
+    {
+        if (it->cpus <= 1 && it->contextSwitchOverhead == 0)
+        {
+            continue;
+        }
+
+        if (!headerShown)
+        {
+            printf("%s", separator);
+            printf("| %-41s | %4s | %11s | %11s | %11s | %11s | %13s |\n",
+                   "Scheduler", "CPUs", "CPU(%)", "Switches", "Migrations", "Lost CPU(%)", "Efficiency(%)");
+            printf("%s", separator);
+            headerShown = true;
+        }
+
+        printf("| %-41s | %4u | %11.2lf | %11llu | %11llu | %11.2lf | %13.2lf |\n",
+               it->schedulerName.c_str(),
+               it->cpus,
+               it->cpuUtilization,
+               it->contextSwitches,
+               it->migrations,
+               it->contextSwitchOverhead + it->migrationOverhead,
+               it->cpuEfficiency);
+    }
+
+    if (headerShown)
+    {
+        printf("%s\n", separator);
+    }
+}
+
+//******************************************************************************************
+// @name                    : displayGangResults
+//
+// @description             : Displays how well the gang schedulers packed the parallel
+//                            jobs on the CPUs: the share of the time of the CPUs left idle
+//                            while jobs waited for them, and the jobs backfilled.
+//
+// @returns                 : Nothing
+//******************************************************************************************
+void ComparisonRunner::displayGangResults()
+{
+    const char *separator = "+-------------------------------------------+------+-------------+------------------+-------------+\n";
+    bool headerShown = false;
+
+    for (auto it = m_results.begin(); it != m_results.end(); it++)
+    {
+        if (it->fragmentation < 0)
+        {
+            continue;
+        }
+
+        if (!headerShown)
+        {
+            printf("%s", separator);
+            printf("| %-41s | %4s | %11s | %16s | %11s |\n", "Scheduler", "CPUs", "CPU(%)", "Fragmentation(%)", "Backfilled");
+            printf("%s", separator);
+            headerShown = true;
+        }
+
+        printf("| %-41s | %4u | %11.2lf | %16.2lf | %11llu |\n",
+               it->schedulerName.c_str(),
+               it->cpus,
+               it->cpuUtilization,
+               it->fragmentation,
+               it->backfilledJobs);
+    }
+
+    if (headerShown)
+    {
+        printf("%s\n", separator);
+    }
+}
+
+//******************************************************************************************
+// @name                    : displayTenantResults
+//
+// @description             : Displays how each scheduler shared the CPUs between the tenant
+//                            groups: the share of the CPU time each group got against the
+//                            share its weights entitle it to, and how its jobs were served.
+//
+// @returns                 : Nothing
+//******************************************************************************************
+void ComparisonRunner::displayTenantResults()
+{
+    const char *separator = "+-------------------------------------------+----------------------+--------+----------+----------+----------+------------+------------+\n";
+    bool headerShown = false;
+
+    for (auto it = m_results.begin(); it != m_results.end(); it++)
+    {
+        if (it->tenantGroups.empty())
+        {
+            continue;
+        }
+
+        if (!headerShown)
+        {
+            printf("%s", separator);
+            printf("| %-41s | %-20s | %6s | %8s | %8s | %8s | %10s | %10s |\n",
+                   "Scheduler", "Tenant group", "Jobs", "Thruput", "CPU(%)", "Entitled", "Avg resp", "Throttled");
+            printf("%s", separator);
+            headerShown = true;
+        }
+
+        for (auto group = it->tenantGroups.begin(); group != it->tenantGroups.end(); group++)
+        {
+            printf("| %-41s | %-20s | %6zu | %8.3lf | %8.2lf | %8.2lf | %10.2lf | %10.2lf |\n",
+                   it->schedulerName.c_str(),
+                   group->name.c_str(),
+                   group->completedJobs,
+                   group->throughput,
+                   group->cpuShare,
+                   group->entitledShare,
+                   group->avgResponseTime / (double)NANOSECONDS_PER_SECOND,
+                   group->throttledTime / (double)NANOSECONDS_PER_SECOND);
+        }
+    }
+
+    if (headerShown)
+    {
+        printf("%s\n", separator);
+    }
+}
+
+//******************************************************************************************
+// @name                    : saveStatsSeries
+//
+// @description             : Writes the samples of the state of all the schedulers to a
+//                            single CSV file, one scheduler after the other.
+//
+// @param fileName          : CSV file
+//
+// @returns                 : true if the samples were written,
+//                            false otherwise
+//******************************************************************************************
+bool ComparisonRunner::saveStatsSeries(const string & fileName)
+{
+    for (size_t i = 0; i < m_schedulers.size(); i++)
+    {
+        if (!m_schedulers[i]->saveStatsSeries(fileName, i > 0))
+        {
+            return false;
+        }
+    }
+
+    printf("Stats series written to %s\n", fileName.c_str());
+    return true;
+}
@@ -0,0 +1,707 @@
+#include "config.h"
+#include "job.h"
+#include<errno.h>
+#include<limits.h>
+#include<stdint.h>
+#include<stdio.h>
+#include<stdlib.h>
+
+//******************************************************************************************
+// @name                    : setDefaultConfig
+//
+// @description             : Sets the default value of all the configurations.
+//
+// @param config            : Configuration to be set
+//
+// @returns                 : Nothing
+//******************************************************************************************
+void setDefaultConfig(simulationConfig_st & config)
+{
+    config.schedulingAlgorithm = "rr";
+    config.simulateAll = true;
+    config.simulateInParallel = true;
+    config.timeQuantum = MAX_TIME_REQUIRED / 2 * NANOSECONDS_PER_MILLISECOND;
+    config.ageingRate = 1;
+    config.jobsToCreate = 1000;
+    config.responseTimeThreshold = 1000;
+    config.showJobStatus = true;
+    config.admissionMaxJobs = 0;
+    config.admissionMaxWait = 0;
+    config.admissionRejectLate = false;
+    config.submitBatchSize = 1;
+    config.submitBatchWindow = 0;
+    config.useRandomJobCreationSleep = false;
+    config.statsDisplayInterval = -1;
+    config.statsSampleInterval = 1000 * NANOSECONDS_PER_MILLISECOND;
+    config.statsWindow = 60 * NANOSECONDS_PER_SECOND;
+    config.statsSeriesFile = "";
+    config.statsSeriesSize = 10000;
+    config.jobCreationSleepMax = 1000;
+    config.jobCreationSleepConst = 1000;
+    config.useVirtualClock = false;
+    config.cpus = 1;
+    config.cpuAffinity = true;
+    config.migrationCost = NANOSECONDS_PER_MILLISECOND;
+    config.contextSwitchCost = 0;
+    config.contextSwitchDistribution = SWITCH_COST_FIXED;
+    config.seed = 0;
+    config.checkpointFile = "";
+    config.checkpointInterval = 600 * NANOSECONDS_PER_SECOND;
+    config.restoreCheckpointFile = "";
+
+    config.runParameterSweep = false;
+    config.sweepTimeQuanta = { 10, 50, 100, 250, 500, 1000, 2500, 5000 };
+    for (size_t i = 0; i < config.sweepTimeQuanta.size(); i++)
+    {
+        config.sweepTimeQuanta[i] *= NANOSECONDS_PER_MILLISECOND;
+    }
+    config.sweepResponseTimeThresholds = { 2, 5, 10, 100 };
+    config.sweepLoadFactors = { 0.5, 0.8, 0.95, 1.2 };
+    config.sweepAgeingRates = { 1, 4, 16 };
+    config.sweepSeeds = { 1, 2, 3 };
+    config.sweepJobsPerRun = 1000;
+    config.sweepResultsFile = "sweep_results.csv";
+    config.threads = 0;
+    config.traceFile = "";
+    config.chromeTraceFile = "";
+    config.logLevel = LOG_LEVEL_INFO;
+    config.logFile = "";
+    config.usePhaseTimers = true;
+    config.useHardwareCounters = false;
+    config.simdLevel = getSupportedSimdLevel();
+    config.burstEstimator = BURST_ESTIMATOR_EXPONENTIAL;
+    config.burstAlpha = 0.5;
+    config.burstInitialEstimate = MAX_TIME_REQUIRED / 2 * NANOSECONDS_PER_MILLISECOND;
+    config.payloadKernel = PAYLOAD_KERNEL_NONE;
+    config.payloadScale = 0.001;
+    config.payloadPreemptible = false;
+    config.workers = 0;
+    config.ioJobRatio = 0;
+    config.ioBurstsMax = 4;
+    config.ioBurstTimeMax = 1000 * NANOSECONDS_PER_MILLISECOND;
+    config.ioDevices = 1;
+    config.parallelJobRatio = 0;
+    config.jobWidthMax = 4;
+    config.tenantGroups.clear();
+    config.tenantQuotaPeriod = 100 * NANOSECONDS_PER_MILLISECOND;
+    config.clusterNodes = 0;
+    config.loadBalancing = LOAD_BALANCING_MAX;
+    config.networkDelay = 0;
+    config.networkJitter = 0;
+    config.clusterLoad = 0;
+}
+
+//******************************************************************************************
+// @name                    : getAdmissionPolicy
+//
+// @description             : Fetches the admission policy of the schedulers.
+//
+// @param config            : Configurations
+// @param policy            : Admission policy
+//
+// @returns                 : Nothing
+//******************************************************************************************
+void getAdmissionPolicy(const simulationConfig_st & config, admissionPolicy_st & policy)
+{
+    policy.maxJobs = config.admissionMaxJobs;
+    policy.maxEstimatedWait = config.admissionMaxWait;
+    policy.rejectLateJobs = config.admissionRejectLate;
+}
+
+//******************************************************************************************
+// @name                    : getContextSwitchCost
+//
+// @description             : Fetches the cost of the context switches of the schedulers.
+//                            Costs are drawn from the seed of the workload.
+//
+// @param config            : Configurations
+// @param cost              : Cost of a context switch
+//
+// @returns                 : Nothing
+//******************************************************************************************
+void getContextSwitchCost(const simulationConfig_st & config, contextSwitchCost_st & cost)
+{
+    cost.meanCost = config.contextSwitchCost;
+    cost.distribution = config.contextSwitchDistribution;
+    cost.seed = config.seed;
+}
+
+//******************************************************************************************
+// @name                    : getClusterSetup
+//
+// @description             : Fetches the setup of the clusters. Placements and network
+//                            delays are drawn from the seed of the workload.
+//
+// @param config            : Configurations
+// @param setup             : Setup of a cluster
+//
+// @returns                 : Nothing
+//******************************************************************************************
+void getClusterSetup(const simulationConfig_st & config, clusterSetup_st & setup)
+{
+    setup.nodes = config.clusterNodes;
+    setup.balancing = config.loadBalancing;
+    setup.networkDelay = config.networkDelay;
+    setup.networkJitter = config.networkJitter;
+    setup.load = config.clusterLoad;
+    setup.seed = config.seed;
+}
+
+//******************************************************************************************
+// @name                    : getTenantProfile
+//
+// @description             : Fetches how the jobs to generate are spread over the tenant
+//                            groups. Must be called once the groups are set up.
+//
+// @param config            : Configurations
+// @param profile           : Tenant profile
+//
+// @returns                 : Nothing
+//******************************************************************************************
+void getTenantProfile(const simulationConfig_st & config, tenantProfile_st & profile)
+{
+    profile.jobShares.clear();
+    for (const tenantGroupSetup_st & group : config.tenantGroups)
+    {
+        profile.jobShares.push_back(group.jobShare);
+    }
+}
+
+//******************************************************************************************
+// @name                    : getIoProfile
+//
+// @description             : Fetches the I/O profile of the jobs to generate.
+//
+// @param config            : Configurations
+// @param profile           : I/O profile
+//
+// @returns                 : Nothing
+//******************************************************************************************
+void getIoProfile(const simulationConfig_st & config, ioProfile_st & profile)
+{
+    profile.jobRatio = config.ioJobRatio;
+    profile.maxBursts = config.ioBurstsMax;
+    profile.maxBurstTime = config.ioBurstTimeMax;
+    profile.devices = config.ioDevices;
+}
+
+//******************************************************************************************
+// @name                    : getParallelProfile
+//
+// @description             : Fetches the parallel profile of the jobs to generate.
+//
+// @param config            : Configurations
+// @param profile           : Parallel profile
+//
+// @returns                 : Nothing
+//******************************************************************************************
+void getParallelProfile(const simulationConfig_st & config, parallelProfile_st & profile)
+{
+    profile.jobRatio = config.parallelJobRatio;
+    profile.maxWidth = config.jobWidthMax;
+}
+
+//******************************************************************************************
+// Value parsers. Each returns false if the whole string is not a valid value.
+//******************************************************************************************
+static bool parseValue(const string & str, long long & value)
+{
+    char *end = nullptr;
+    errno = 0;
+    value = strtoll(str.c_str(), &end, 10);
+    return (!str.empty() && *end == '\0' && errno == 0);
+}
+
+static bool parseValue(const string & str, double & value)
+{
+    char *end = nullptr;
+    errno = 0;
+    value = strtod(str.c_str(), &end);
+    return (!str.empty() && *end == '\0' && errno == 0);
+}
+
+static bool parseValue(const string & str, int & value)
+{
+    long long val = 0;
+    if (!parseValue(str, val) || val < INT32_MIN || val > INT32_MAX)
+        return false;
+
+    value = (int)val;
+    return true;
+}
+
+static bool parseValue(const string & str, long int & value)
+{
+    long long val = 0;
+    if (!parseValue(str, val))
+        return false;
+
+    value = (long int)val;
+    return true;
+}
+
+static bool parseValue(const string & str, unsigned int & value)
+{
+    long long val = 0;
+    if (!parseValue(str, val) || val < 0 || val > UINT32_MAX)
+        return false;
+
+    value = (unsigned int)val;
+    return true;
+}
+
+static bool parseValue(const string & str, bool & value)
+{
+    if (str == "true" || str == "1" || str == "yes" || str == "on")
+    {
+        value = true;
+        return true;
+    }
+
+    if (str == "false" || str == "0" || str == "no" || str == "off")
+    {
+        value = false;
+        return true;
+    }
+
+    return false;
+}
+
+// Tenant group, as path:weight[:quota[:jobs]], where an empty quota is no quota
+static bool parseValue(const string & str, tenantGroupSetup_st & value)
+{
+    vector<string> fields;
+    size_t start = 0;
+    while (start <= str.size())
+    {
+        size_t end = str.find(':', start);
+        if (end == string::npos)
+            end = str.size();
+
+        fields.push_back(str.substr(start, end - start));
+        start = end + 1;
+    }
+
+    if (fields.size() < 2 || fields.size() > 4 || fields[0].empty() || fields[0].front() == '/' || fields[0].back() == '/')
+        return false;
+
+    value.name = fields[0];
+    value.quota = 0;
+    value.jobShare = -1;                                             // Set by TenantGroups::completeSetup()
+    if (!parseValue(fields[1], value.weight) || value.weight <= 0)
+        return false;
+
+    if (fields.size() > 2 && !fields[2].empty() && (!parseValue(fields[2], value.quota) || value.quota < 0))
+        return false;
+
+    if (fields.size() > 3 && (!parseValue(fields[3], value.jobShare) || value.jobShare < 0))
+        return false;
+
+    return true;
+}
+
+// Comma separated list of values
+template<typename T>
+static bool parseValue(const string & str, vector<T> & values)
+{
+    vector<T> parsed;
+    size_t start = 0;
+
+    while (start <= str.size())
+    {
+        size_t end = str.find(',', start);
+        if (end == string::npos)
+            end = str.size();
+
+        T value;
+        if (!parseValue(str.substr(start, end - start), value))
+            return false;
+
+        parsed.push_back(value);
+        start = end + 1;
+    }
+
+    values = parsed;
+    return true;
+}
+
+// Duration in milliseconds, fractions allowed, converted to nanoseconds
+static bool parseMilliseconds(const string & str, long long & value)
+{
+    double ms = 0;
+    if (!parseValue(str, ms) || ms <= 0)
+        return false;
+
+    value = (long long)(ms * NANOSECONDS_PER_MILLISECOND);
+    return (value > 0);
+}
+
+// Same as above, where 0 is valid too
+static bool parseMillisecondsOrZero(const string & str, long long & value)
+{
+    double ms = 0;
+    if (!parseValue(str, ms) || ms < 0)
+        return false;
+
+    value = (long long)(ms * NANOSECONDS_PER_MILLISECOND);
+    return true;
+}
+
+// Duration in seconds, fractions allowed, converted to nanoseconds
+static bool parseSeconds(const string & str, long long & value)
+{
+    double seconds = 0;
+    if (!parseValue(str, seconds) || seconds <= 0)
+        return false;
+
+    value = (long long)(seconds * NANOSECONDS_PER_SECOND);
+    return (value > 0);
+}
+
+// Comma separated list of durations in milliseconds, converted to nanoseconds
+static bool parseMilliseconds(const string & str, vector<long long> & values)
+{
+    vector<double> ms;
+    if (!parseValue(str, ms))
+        return false;
+
+    vector<long long> parsed;
+    for (size_t i = 0; i < ms.size(); i++)
+    {
+        long long value = (long long)(ms[i] * NANOSECONDS_PER_MILLISECOND);
+        if (value <= 0)
+            return false;
+
+        parsed.push_back(value);
+    }
+
+    values = parsed;
+    return true;
+}
+
+//******************************************************************************************
+// @name                    : trim
+//
+// @description             : Removes the leading and trailing white spaces.
+//
+// @returns                 : Trimmed string
+//******************************************************************************************
+static string trim(const string & str)
+{
+    const char *whitespace = " \t\r\n";
+    size_t start = str.find_first_not_of(whitespace);
+    if (start == string::npos)
+        return "";
+
+    size_t end = str.find_last_not_of(whitespace);
+    return str.substr(start, end - start + 1);
+}
+
+//******************************************************************************************
+// @name                    : setConfigOption
+//
+// @description             : Sets a configuration by its name. '-' and '_' are the same
+//                            in a name, so "time-quantum" is also "time_quantum".
+//
+// @param name              : Name of the configuration
+// @param value             : Value as text
+// @param config            : Configuration to be updated
+//
+// @returns                 : true if the configuration was set,
+//                            false if the name or value is invalid
+//******************************************************************************************
+bool setConfigOption(const string & name, const string & value, simulationConfig_st & config)
+{
+    string key = name;
+    for (size_t i = 0; i < key.size(); i++)
+    {
+        if (key[i] == '-')
+            key[i] = '_';
+    }
+
+    bool valid = false;
+
+    if (key == "algorithm")                         { config.schedulingAlgorithm = value; valid = !value.empty(); }
+    else if (key == "simulate_all")                 valid = parseValue(value, config.simulateAll);
+    else if (key == "parallel")                     valid = parseValue(value, config.simulateInParallel);
+    else if (key == "time_quantum")                 valid = parseMilliseconds(value, config.timeQuantum);
+    else if (key == "ageing_rate")                  valid = parseValue(value, config.ageingRate);
+    else if (key == "burst_estimator")              valid = BurstPredictor::parseEstimator(value, config.burstEstimator);
+    else if (key == "burst_alpha")                  valid = parseValue(value, config.burstAlpha) && config.burstAlpha > 0 && config.burstAlpha <= 1;
+    else if (key == "burst_initial")                valid = parseMilliseconds(value, config.burstInitialEstimate);
+    else if (key == "jobs")                         valid = parseValue(value, config.jobsToCreate);
+    else if (key == "response_time_threshold")      valid = parseValue(value, config.responseTimeThreshold);
+    else if (key == "show_job_status")              valid = parseValue(value, config.showJobStatus);
+    else if (key == "admission_max_jobs")           valid = parseValue(value, config.admissionMaxJobs);
+    else if (key == "admission_max_wait")           valid = parseMilliseconds(value, config.admissionMaxWait);
+    else if (key == "admission_reject_late")        valid = parseValue(value, config.admissionRejectLate);
+    else if (key == "submit_batch_size")            valid = parseValue(value, config.submitBatchSize) && config.submitBatchSize > 0;
+    else if (key == "submit_batch_window")          valid = parseMilliseconds(value, config.submitBatchWindow);
+    else if (key == "random_creation_sleep")        valid = parseValue(value, config.useRandomJobCreationSleep);
+    else if (key == "stats_interval")               valid = parseValue(value, config.statsDisplayInterval);
+    else if (key == "stats_sample_interval")        valid = parseMillisecondsOrZero(value, config.statsSampleInterval);
+    else if (key == "stats_window")                 valid = parseSeconds(value, config.statsWindow);
+    else if (key == "stats_series_file")            { config.statsSeriesFile = value; valid = true; }
+    else if (key == "stats_series_size")            valid = parseValue(value, config.statsSeriesSize) && config.statsSeriesSize > 0;
+    else if (key == "creation_sleep_max")           valid = parseValue(value, config.jobCreationSleepMax) && config.jobCreationSleepMax > 0;
+    else if (key == "creation_sleep_const")         valid = parseValue(value, config.jobCreationSleepConst) && config.jobCreationSleepConst > 0;
+    else if (key == "virtual_clock")                valid = parseValue(value, config.useVirtualClock);
+    else if (key == "cpus")                         valid = parseValue(value, config.cpus) && config.cpus > 0 && config.cpus <= USHRT_MAX;
+    else if (key == "cpu_affinity")                 valid = parseValue(value, config.cpuAffinity);
+    else if (key == "migration_cost")               valid = parseMilliseconds(value, config.migrationCost);
+    else if (key == "context_switch_cost")          valid = parseMillisecondsOrZero(value, config.contextSwitchCost);
+    else if (key == "context_switch_distribution")  valid = CpuSet::parseSwitchCostDistribution(value, config.contextSwitchDistribution);
+    else if (key == "seed")                         valid = parseValue(value, config.seed);
+    else if (key == "checkpoint_file")              { config.checkpointFile = value; valid = true; }
+    else if (key == "checkpoint_interval")          valid = parseSeconds(value, config.checkpointInterval);
+    else if (key == "restore_checkpoint")           { config.restoreCheckpointFile = value; valid = true; }
+    else if (key == "sweep")                        valid = parseValue(value, config.runParameterSweep);
+    else if (key == "sweep_time_quanta")            valid = parseMilliseconds(value, config.sweepTimeQuanta);
+    else if (key == "sweep_response_time_thresholds") valid = parseValue(value, config.sweepResponseTimeThresholds);
+    else if (key == "sweep_load_factors")           valid = parseValue(value, config.sweepLoadFactors);
+    else if (key == "sweep_ageing_rates")           valid = parseValue(value, config.sweepAgeingRates);
+    else if (key == "sweep_seeds")                  valid = parseValue(value, config.sweepSeeds);
+    else if (key == "sweep_jobs")                   valid = parseValue(value, config.sweepJobsPerRun);
+    else if (key == "sweep_results")                { config.sweepResultsFile = value; valid = !value.empty(); }
+    else if (key == "threads")                      valid = parseValue(value, config.threads);
+    else if (key == "trace_file")                   { config.traceFile = value; valid = true; }
+    else if (key == "chrome_trace_file")            { config.chromeTraceFile = value; valid = true; }
+    else if (key == "log_level")                    valid = Logger::parseLevel(value, config.logLevel);
+    else if (key == "log_file")                     { config.logFile = value; valid = true; }
+    else if (key == "phase_timers")                 valid = parseValue(value, config.usePhaseTimers);
+    else if (key == "hardware_counters")            valid = parseValue(value, config.useHardwareCounters);
+    else if (key == "simd")                         valid = parseSimdLevel(value, config.simdLevel);
+    else if (key == "payload")                      valid = WorkerPool::parseKernel(value, config.payloadKernel);
+    else if (key == "payload_scale")                valid = parseValue(value, config.payloadScale) && config.payloadScale > 0;
+    else if (key == "payload_coroutines")           valid = parseValue(value, config.payloadPreemptible);
+    else if (key == "workers")                      valid = parseValue(value, config.workers);
+    else if (key == "io_job_ratio")                 valid = parseValue(value, config.ioJobRatio) && config.ioJobRatio >= 0 && config.ioJobRatio <= 1;
+    else if (key == "io_bursts_max")                valid = parseValue(value, config.ioBurstsMax) && config.ioBurstsMax > 0;
+    else if (key == "io_burst_time_max")            valid = parseMilliseconds(value, config.ioBurstTimeMax);
+    else if (key == "io_devices")                   valid = parseValue(value, config.ioDevices) && config.ioDevices > 0;
+    else if (key == "parallel_job_ratio")           valid = parseValue(value, config.parallelJobRatio) && config.parallelJobRatio >= 0 && config.parallelJobRatio <= 1;
+    else if (key == "job_width_max")                valid = parseValue(value, config.jobWidthMax) && config.jobWidthMax >= 2 && config.jobWidthMax <= USHRT_MAX;
+    else if (key == "tenant_groups")                valid = parseValue(value, config.tenantGroups) && TenantGroups::completeSetup(config.tenantGroups);
+    else if (key == "tenant_quota_period")          valid = parseMilliseconds(value, config.tenantQuotaPeriod);
+    else if (key == "cluster_nodes")                valid = parseValue(value, config.clusterNodes) && config.clusterNodes <= USHRT_MAX;
+    else if (key == "load_balancing")               valid = Cluster::parseLoadBalancing(value, config.loadBalancing);
+    else if (key == "network_delay")                valid = parseMillisecondsOrZero(value, config.networkDelay);
+    else if (key == "network_jitter")               valid = parseMillisecondsOrZero(value, config.networkJitter);
+    else if (key == "cluster_load")                 valid = parseValue(value, config.clusterLoad) && config.clusterLoad >= 0;
+    else
+    {
+        printf("ERROR: Unknown configuration '%s'\n", name.c_str());
+        return false;
+    }
+
+    if (!valid)
+    {
+        printf("ERROR: Invalid value '%s' for configuration '%s'\n", value.c_str(), name.c_str());
+    }
+
+    return valid;
+}
+
+//******************************************************************************************
+// @name                    : loadConfigFile
+//
+// @description             : Reads configurations from a file. Each line is of the form
+//                            "name = value". Empty lines and lines starting with '#' are
+//                            ignored.
+//
+// @param fileName          : Name of the config file
+// @param config            : Configuration to be updated
+//
+// @returns                 : true if the whole file was valid,
+//                            false otherwise
+//******************************************************************************************
+bool loadConfigFile(const string & fileName, simulationConfig_st & config)
+{
+    FILE *file = fopen(fileName.c_str(), "r");
+    if (!file)
+    {
+        printf("ERROR: Unable to open config file %s\n", fileName.c_str());
+        return false;
+    }
+
+    bool valid = true;
+    int lineNumber = 0;
+    char buffer[1024];
+
+    while (valid && fgets(buffer, sizeof(buffer), file))
+    {
+        lineNumber++;
+        string line = trim(buffer);
+        if (line.empty() || line[0] == '#')
+            continue;
+
+        size_t separator = line.find('=');
+        if (separator == string::npos)
+        {
+            printf("ERROR: %s:%d: Expected 'name = value'\n", fileName.c_str(), lineNumber);
+            valid = false;
+            break;
+        }
+
+        valid = setConfigOption(trim(line.substr(0, separator)), trim(line.substr(separator + 1)), config);
+        if (!valid)
+        {
+            printf("ERROR: %s:%d: Invalid configuration\n", fileName.c_str(), lineNumber);
+        }
+    }
+
+    fclose(file);
+    return valid;
+}
+
+//******************************************************************************************
+// @name                    : parseCommandLine
+//
+// @description             : Reads configurations from the command line. Every option is
+//                            of the form "--name=value" or "--name value". "--config file"
+//                            reads a config file at that point, so options after it
+//                            override the file.
+//
+// @param argc              : Number of arguments
+// @param argv              : Arguments
+// @param config            : Configuration to be updated
+// @param showHelp          : Set if usage has been asked for
+//
+// @returns                 : true if all the arguments were valid,
+//                            false otherwise
+//******************************************************************************************
+bool parseCommandLine(int argc, char *argv[], simulationConfig_st & config, bool & showHelp)
+{
+    showHelp = false;
+
+    for (int i = 1; i < argc; i++)
+    {
+        string arg = argv[i];
+        if (arg == "-h" || arg == "--help")
+        {
+            showHelp = true;
+            continue;
+        }
+
+        if (arg.compare(0, 2, "--") != 0)
+        {
+            printf("ERROR: Unexpected argument '%s'\n", arg.c_str());
+            return false;
+        }
+
+        string name = arg.substr(2);
+        string value;
+        size_t separator = name.find('=');
+        if (separator != string::npos)
+        {
+            value = name.substr(separator + 1);
+            name = name.substr(0, separator);
+        }
+        else if (i + 1 < argc)
+        {
+            value = argv[++i];
+        }
+        else
+        {
+            printf("ERROR: Missing value for '%s'\n", arg.c_str());
+            return false;
+        }
+
+        bool valid = (name == "config") ? loadConfigFile(value, config) : setConfigOption(name, value, config);
+        if (!valid)
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+//******************************************************************************************
+// @name                    : displayUsage
+//
+// @description             : Displays the command line usage.
+//
+// @param programName       : Name of the executable
+//
+// @returns                 : Nothing
+//******************************************************************************************
+void displayUsage(const char *programName)
+{
+    simulationConfig_st defaults;
+    setDefaultConfig(defaults);
+
+    printf("Usage: %s [--config FILE] [--NAME=VALUE]...\n\n", programName);
+    printf("Options (same names are used in a config file as 'NAME = VALUE'):\n");
+    printf("  --config FILE                        Read configurations from FILE\n");
+    printf("  --algorithm NAME                     Scheduling algorithm to use (default: %s)\n", defaults.schedulingAlgorithm.c_str());
+    printf("  --simulate_all BOOL                  Simulate all the algorithms (default: %s)\n", defaults.simulateAll ? "true" : "false");
+    printf("  --parallel BOOL                      Simulate all the algorithms at the same time (default: %s)\n", defaults.simulateInParallel ? "true" : "false");
+    printf("  --time_quantum MS                    Round Robin time quantum, e.g. 0.25 (default: %.3lf)\n", defaults.timeQuantum / (double)NANOSECONDS_PER_MILLISECOND);
+    printf("  --ageing_rate N                      Priority levels gained per ageing pass (default: %u)\n", defaults.ageingRate);
+    printf("  --burst_estimator NAME               Burst estimator of predicted SJF/SRTF: exponential, last or mean (default: exponential)\n");
+    printf("  --burst_alpha X                      Weight of the last burst in exponential averaging (default: %g)\n", defaults.burstAlpha);
+    printf("  --burst_initial MS                   Predicted burst of a job class with no history (default: %.3lf)\n", defaults.burstInitialEstimate / (double)NANOSECONDS_PER_MILLISECOND);
+    printf("  --jobs N                             Jobs to simulate, -1 for continuous (default: %ld)\n", defaults.jobsToCreate);
+    printf("  --response_time_threshold N          Response time threshold (default: %d)\n", defaults.responseTimeThreshold);
+    printf("  --show_job_status BOOL               Show details of job running status (default: %s)\n", defaults.showJobStatus ? "true" : "false");
+    printf("  --admission_max_jobs N               Shed arriving jobs beyond N jobs in the scheduler, 0 for no limit (default: %u)\n", defaults.admissionMaxJobs);
+    printf("  --admission_max_wait MS              Shed arriving jobs estimated to wait longer, 0 for no limit (default: %.3lf)\n", defaults.admissionMaxWait / (double)NANOSECONDS_PER_MILLISECOND);
+    printf("  --admission_reject_late BOOL         Shed arriving jobs estimated to exceed their response threshold (default: %s)\n", defaults.admissionRejectLate ? "true" : "false");
+    printf("  --submit_batch_size N                Jobs added to the ready queue at once by the job creation thread (default: %u)\n", defaults.submitBatchSize);
+    printf("  --submit_batch_window MS             Max time a created job is held back for its batch, 0 for no limit (default: %.3lf)\n", defaults.submitBatchWindow / (double)NANOSECONDS_PER_MILLISECOND);
+    printf("  --random_creation_sleep BOOL         Use random sleep before creating a job (default: %s)\n", defaults.useRandomJobCreationSleep ? "true" : "false");
+    printf("  --stats_interval SECONDS             Stats display interval, -1 for end only (default: %d)\n", defaults.statsDisplayInterval);
+    printf("  --stats_sample_interval MS           Time between two samples of the state of a scheduler, 0 for none (default: %.3lf)\n", defaults.statsSampleInterval / (double)NANOSECONDS_PER_MILLISECOND);
+    printf("  --stats_window SECONDS               Time the recent rates are taken over (default: %.0lf)\n", defaults.statsWindow / (double)NANOSECONDS_PER_SECOND);
+    printf("  --stats_series_file FILE             Write the samples to a CSV FILE at the end\n");
+    printf("  --stats_series_size N                Samples kept for the CSV file, the latest ones (default: %u)\n", defaults.statsSeriesSize);
+    printf("  --creation_sleep_max MS              Max random sleep before creating a job (default: %d)\n", defaults.jobCreationSleepMax);
+    printf("  --creation_sleep_const MS            Sleep before creating a job (default: %d)\n", defaults.jobCreationSleepConst);
+    printf("  --virtual_clock BOOL                 Simulate on a virtual clock (default: %s)\n", defaults.useVirtualClock ? "true" : "false");
+    printf("  --cpus N                             CPUs of each scheduler, more than 1 on a virtual clock only (default: %u)\n", defaults.cpus);
+    printf("  --cpu_affinity BOOL                  Prefer running jobs on the CPU they last ran on (default: %s)\n", defaults.cpuAffinity ? "true" : "false");
+    printf("  --migration_cost MS                  CPU time a job takes to warm up on another CPU (default: %.3lf)\n", defaults.migrationCost / (double)NANOSECONDS_PER_MILLISECOND);
+    printf("  --context_switch_cost MS             Mean CPU time of switching a CPU to another job (default: %.3lf)\n", defaults.contextSwitchCost / (double)NANOSECONDS_PER_MILLISECOND);
+    printf("  --context_switch_distribution NAME   Distribution of the switch cost: fixed, uniform or exponential (default: %s)\n",
+           CpuSet::getSwitchCostDistributionName(defaults.contextSwitchDistribution));
+    printf("  --seed N                             Workload seed, 0 for random (default: %u)\n", defaults.seed);
+    printf("  --checkpoint_file FILE               Save checkpoints of the simulation to FILE (virtual clock only)\n");
+    printf("  --checkpoint_interval SECONDS        Simulated time between two checkpoints (default: %.0lf)\n", defaults.checkpointInterval / (double)NANOSECONDS_PER_SECOND);
+    printf("  --restore_checkpoint FILE            Resume the simulation from the checkpoint in FILE\n");
+    printf("  --sweep BOOL                         Run the parameter sweep (default: %s)\n", defaults.runParameterSweep ? "true" : "false");
+    printf("  --sweep_time_quanta LIST             Comma separated time quanta (ms) to sweep\n");
+    printf("  --sweep_response_time_thresholds LIST  Comma separated thresholds to sweep\n");
+    printf("  --sweep_load_factors LIST            Comma separated load factors to sweep\n");
+    printf("  --sweep_ageing_rates LIST            Comma separated ageing rates to sweep\n");
+    printf("  --sweep_seeds LIST                   Comma separated workload seeds to sweep\n");
+    printf("  --sweep_jobs N                       Jobs in each sweep run (default: %ld)\n", defaults.sweepJobsPerRun);
+    printf("  --sweep_results FILE                 CSV file for sweep results (default: %s)\n", defaults.sweepResultsFile.c_str());
+    printf("  --threads N                          Sweep worker threads, 0 for all cores (default: %u)\n", defaults.threads);
+    printf("  --trace_file FILE                    Record scheduling events to a binary trace FILE\n");
+    printf("  --chrome_trace_file FILE             Export the trace as Chrome trace JSON to FILE\n");
+    printf("  --log_level LEVEL                    debug, info, warning, error or none (default: info)\n");
+    printf("  --log_file FILE                      Write the log to FILE instead of stderr\n");
+    printf("  --phase_timers BOOL                  Time the phases of the schedulers (default: %s)\n", defaults.usePhaseTimers ? "true" : "false");
+    printf("  --hardware_counters BOOL             Count cycles and cache misses of the phases (default: %s)\n", defaults.useHardwareCounters ? "true" : "false");
+    printf("  --simd NAME                          Kernels of the schedulers: auto, scalar, avx2 or avx512 (default: auto, i.e. %s)\n", getSimdLevelName(defaults.simdLevel));
+    printf("  --payload KERNEL                     Real work of jobs: none, spin, sort or matmul (default: none)\n");
+    printf("  --payload_scale X                    CPU time of a payload per unit of time required (default: %g)\n", defaults.payloadScale);
+    printf("  --payload_coroutines BOOL            Run payloads as coroutines that can be preempted (default: %s)\n", defaults.payloadPreemptible ? "true" : "false");
+    printf("  --workers N                          Worker threads running payloads, 0 for scheduler threads (default: %u)\n", defaults.workers);
+    printf("  --io_job_ratio X                     Fraction of jobs doing I/O, 0 to 1 (default: %g)\n", defaults.ioJobRatio);
+    printf("  --io_bursts_max N                    Max I/O bursts of a job (default: %u)\n", defaults.ioBurstsMax);
+    printf("  --io_burst_time_max MS               Max service time of an I/O burst (default: %.3lf)\n", defaults.ioBurstTimeMax / (double)NANOSECONDS_PER_MILLISECOND);
+    printf("  --io_devices N                       I/O devices of each scheduler (default: %u)\n", defaults.ioDevices);
+    printf("  --parallel_job_ratio X               Fraction of jobs running on several CPUs at once, 0 to 1 (default: %g)\n", defaults.parallelJobRatio);
+    printf("  --job_width_max N                    Max CPUs of a parallel job, at most cpus (default: %u)\n", defaults.jobWidthMax);
+    printf("  --tenant_groups LIST                 Tenant groups as path:weight[:quota[:jobs]],... parents first (default: none)\n");
+    printf("  --tenant_quota_period MS             Period the quotas of the tenant groups are given for (default: %.3lf)\n", defaults.tenantQuotaPeriod / (double)NANOSECONDS_PER_MILLISECOND);
+    printf("  --cluster_nodes N                    Simulate a cluster of N single CPU nodes, 0 for one machine (default: %u)\n", defaults.clusterNodes);
+    printf("  --load_balancing NAME                Placement of jobs on nodes: random, round_robin, jsq, power_of_two or all (default: %s)\n",
+           Cluster::getLoadBalancingName(defaults.loadBalancing));
+    printf("  --network_delay MS                   Time a job takes to reach its node (default: %.3lf)\n", defaults.networkDelay / (double)NANOSECONDS_PER_MILLISECOND);
+    printf("  --network_jitter MS                  Max random time a job may take on top of the delay (default: %.3lf)\n", defaults.networkJitter / (double)NANOSECONDS_PER_MILLISECOND);
+    printf("  --cluster_load X                     Load of each node the arrivals are scaled to, 0 to keep them (default: %g)\n", defaults.clusterLoad);
+    printf("  -h, --help                           Show this help\n");
+}
@@ -0,0 +1,207 @@
+#include "cpu_set.h"
+#include<math.h>
+
+//******************************************************************************************
+// @name                    : CpuSet
+//
+// @description             : Constructor. A single CPU, with free context switches.
+//
+// @returns                 : Nothing
+//******************************************************************************************
+CpuSet::CpuSet()
+{
+    m_switchCost = contextSwitchCost_st{ 0, SWITCH_COST_FIXED, 0 };
+    m_lockstepClock = nullptr;
+    setup(1, false, 0);
+}
+
+//******************************************************************************************
+// @name                    : setup
+//
+// @description             : Sets the CPUs sharing the pools of the scheduler.
+//
+// @param count             : Number of CPUs
+// @param affinity          : Leave jobs to the CPU they last ran on, when it pays off
+// @param migrationCost     : Time (ns) a job takes to warm up on another CPU
+//
+// @returns                 : Nothing
+//******************************************************************************************
+void CpuSet::setup(unsigned int count, bool affinity, long long migrationCost)
+{
+    m_count = (count > 0) ? count : 1;
+    m_affinity = affinity;
+    m_migrationCost = (migrationCost > 0) ? migrationCost : 0;
+    m_cpus.assign(m_count, cpuState_st{ -1, 0, 0, false, -1, false });
+}
+
+//******************************************************************************************
+// @name                    : attachLockstepClock
+//
+// @description             : Starts the CPUs afresh on the clock they take turns on, one
+//                            thread each.
+//
+// @param clock             : Clock with a participant per CPU
+//
+// @returns                 : Nothing
+//******************************************************************************************
+void CpuSet::attachLockstepClock(LockstepClock *clock)
+{
+    m_lockstepClock = clock;
+    m_cpus.assign(m_count, cpuState_st{ -1, 0, 0, false, -1, false });
+}
+
+//******************************************************************************************
+// @name                    : isMigration
+//
+// @description             : Checks whether running a job on the calling CPU would migrate
+//                            it, i.e. whether it has run on another CPU before.
+//
+// @param job               : Pending job
+//
+// @returns                 : true if the job would migrate,
+//                            false otherwise
+//******************************************************************************************
+bool CpuSet::isMigration(Job *job)
+{
+    return (job->getJobTimeServed() > 0 && job->getCpuId() != getCurrent());
+}
+
+//******************************************************************************************
+// @name                    : drawSwitchCost
+//
+// @description             : Draws the cost of a context switch from the distribution set.
+//                            The cost is a function of the seed and of the number of the
+//                            switch, rather than the next value of a generator, so that a
+//                            simulation restored from a checkpoint draws the same costs as
+//                            the one it was saved from.
+//
+// @param switchNumber      : Switches so far
+//
+// @returns                 : Time (ns)
+//******************************************************************************************
+long long CpuSet::drawSwitchCost(unsigned long long switchNumber) const
+{
+    const double meanCost = (double)m_switchCost.meanCost;
+
+    if (m_switchCost.meanCost <= 0 || m_switchCost.distribution == SWITCH_COST_FIXED)
+    {
+        return (m_switchCost.meanCost > 0) ? m_switchCost.meanCost : 0;
+    }
+
+    // SplitMix64 of the switch number, as a uniform number in [0, 1)
+    unsigned long long bits = ((unsigned long long)m_switchCost.seed << 32) + switchNumber;
+    bits += 0x9E3779B97F4A7C15ULL;
+    bits = (bits ^ (bits >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    bits = (bits ^ (bits >> 27)) * 0x94D049BB133111EBULL;
+    bits = bits ^ (bits >> 31);
+    double uniform = (bits >> 11) * (1.0 / (double)(1ULL << 53));
+
+    if (m_switchCost.distribution == SWITCH_COST_UNIFORM)
+    {
+        return (long long)(uniform * 2 * meanCost);
+    }
+
+    return (long long)(-log(1 - uniform) * meanCost);
+}
+
+//******************************************************************************************
+// @name                    : takeOverhead
+//
+// @description             : Takes the time the calling CPU has to spend switching to the
+//                            job dispatched on it, before running it.
+//
+// @returns                 : Time (ns), 0 if none
+//******************************************************************************************
+long long CpuSet::takeOverhead()
+{
+    cpuState_st & cpu = getCurrentState();
+    long long overhead = cpu.overheadTime;
+
+    cpu.overheadTime = 0;
+    return overhead;
+}
+
+//******************************************************************************************
+// @name                    : getNextStopTime
+//
+// @description             : Fetches when the first of the jobs running on the CPUs is due
+//                            to stop.
+//
+// @returns                 : timestamp (ns), -1 if no CPU is running a job
+//******************************************************************************************
+long long CpuSet::getNextStopTime() const
+{
+    long long tsNextStop = -1;
+
+    for (auto it = m_cpus.begin(); it != m_cpus.end(); it++)
+    {
+        if (it->tsBusyUntil >= 0 && (tsNextStop < 0 || it->tsBusyUntil < tsNextStop))
+        {
+            tsNextStop = it->tsBusyUntil;
+        }
+    }
+
+    return tsNextStop;
+}
+
+//******************************************************************************************
+// @name                    : repickTenantGroups
+//
+// @description             : Makes every CPU pick the tenant group to run next again, once
+//                            the jobs to run or the CPU time used by the groups change.
+//
+// @returns                 : Nothing
+//******************************************************************************************
+void CpuSet::repickTenantGroups()
+{
+    for (cpuState_st &cpuState : m_cpus)
+    {
+        cpuState.tenantGroupPicked = false;
+    }
+}
+
+//******************************************************************************************
+// @name                    : parseSwitchCostDistribution
+//
+// @description             : Converts the name of a distribution of the context switch cost
+//                            (fixed, uniform or exponential) to its value.
+//
+// @param name              : Name of the distribution
+// @param distribution      : Distribution, set only if the name is valid
+//
+// @returns                 : true if the name is valid,
+//                            false otherwise
+//******************************************************************************************
+bool CpuSet::parseSwitchCostDistribution(const string & name, switchCostDistribution_en & distribution)
+{
+    for (int value = 0; value < SWITCH_COST_MAX; value++)
+    {
+        if (name == getSwitchCostDistributionName((switchCostDistribution_en)value))
+        {
+            distribution = (switchCostDistribution_en)value;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+//******************************************************************************************
+// @name                    : getSwitchCostDistributionName
+//
+// @description             : Fetches the name of a distribution of the context switch cost.
+//
+// @param distribution      : Distribution
+//
+// @returns                 : Name
+//******************************************************************************************
+const char* CpuSet::getSwitchCostDistributionName(switchCostDistribution_en distribution)
+{
+    switch (distribution)
+    {
+    case SWITCH_COST_FIXED:         return "fixed";
+    case SWITCH_COST_UNIFORM:       return "uniform";
+    case SWITCH_COST_EXPONENTIAL:   return "exponential";
+    default:                        return "unknown";
+    }
+}
@@ -0,0 +1,433 @@
+#include "event_trace.h"
+#include<algorithm>
+#include<chrono>
+#include<map>
+#include<string.h>
+
+//---------------------------------------------------------------------------------------------------
+// Trace file layout: header, traceEvent_st records, a TRACE_EVENT_END record holding the track
+// count in jobId, and then a traceTrack_st for each track.
+//---------------------------------------------------------------------------------------------------
+const char          TRACE_FILE_MAGIC[8]         = { 'P', 'S', 'S', 'T', 'R', 'A', 'C', 'E' };
+const unsigned int  TRACE_FILE_VERSION          = 2;
+const int           TRACE_FLUSH_INTERVAL        = 10;     // Milliseconds between two flushes
+
+typedef struct
+{
+    char                    magic[8];
+    unsigned int            version;
+    unsigned int            eventSize;                // sizeof(traceEvent_st)
+}traceFileHeader_st;
+
+//******************************************************************************************
+// @name                    : drain
+//
+// @description             : Writes all the events recorded so far to the file and frees
+//                            their space in the buffer. Called only from one thread at a time.
+//
+// @param file              : File to write to
+//
+// @returns                 : Number of events written
+//******************************************************************************************
+size_t TraceBuffer::drain(FILE *file)
+{
+    size_t tail = m_tail.load(memory_order_relaxed);
+    size_t head = m_head.load(memory_order_acquire);
+    size_t count = head - tail;
+
+    while (tail != head)
+    {
+        // Write the contiguous part till the end of the ring first
+        size_t index = tail & (CAPACITY - 1);
+        size_t chunk = head - tail;
+        if (chunk > CAPACITY - index)
+        {
+            chunk = CAPACITY - index;
+        }
+
+        fwrite(&m_events[index], sizeof(traceEvent_st), chunk, file);
+        tail += chunk;
+    }
+
+    m_tail.store(tail, memory_order_release);
+    return count;
+}
+
+//******************************************************************************************
+// @name                    : EventTracer
+//
+// @description             : Constructor
+//
+// @returns                 : Nothing
+//******************************************************************************************
+EventTracer::EventTracer()
+{
+    m_enabled = false;
+    m_file = nullptr;
+    m_eventsWritten = 0;
+    m_stopRequested = false;
+}
+
+//******************************************************************************************
+// @name                    : ~EventTracer
+//
+// @description             : Stops tracing and frees the buffers of all the threads.
+//
+// @returns                 : Nothing
+//******************************************************************************************
+EventTracer::~EventTracer()
+{
+    stop();
+
+    for (auto it = m_buffers.begin(); it != m_buffers.end(); it++)
+    {
+        delete *it;
+    }
+
+    m_buffers.clear();
+}
+
+//******************************************************************************************
+// @name                    : getInstance
+//
+// @description             : Fetches the tracer shared by all the schedulers.
+//
+// @returns                 : Event tracer
+//******************************************************************************************
+EventTracer & EventTracer::getInstance()
+{
+    static EventTracer tracer;
+    return tracer;
+}
+
+//******************************************************************************************
+// @name                    : start
+//
+// @description             : Starts recording events to a trace file, and the thread
+//                            flushing them.
+//
+// @param fileName          : Name of the trace file
+//
+// @returns                 : true if tracing was started,
+//                            false if the file could not be created
+//******************************************************************************************
+bool EventTracer::start(const string & fileName)
+{
+    stop();
+
+    FILE *file = fopen(fileName.c_str(), "wb");
+    if (!file)
+    {
+        printf("ERROR: Unable to create trace file '%s'\n", fileName.c_str());
+        return false;
+    }
+
+    traceFileHeader_st header;
+    memcpy(header.magic, TRACE_FILE_MAGIC, sizeof(header.magic));
+    header.version = TRACE_FILE_VERSION;
+    header.eventSize = sizeof(traceEvent_st);
+    fwrite(&header, sizeof(header), 1, file);
+
+    m_bufferMutex.lock();
+    m_file = file;
+    m_eventsWritten = 0;
+    m_bufferMutex.unlock();
+
+    m_stopRequested = false;
+    m_flushThread = thread(&EventTracer::flushAtInterval, this);
+    m_enabled = true;
+    return true;
+}
+
+//******************************************************************************************
+// @name                    : stop
+//
+// @description             : Stops recording events. All the events recorded so far are
+//                            written to the trace file, followed by the names of the tracks.
+//
+// @returns                 : Nothing
+//******************************************************************************************
+void EventTracer::stop()
+{
+    if (!m_flushThread.joinable())
+    {
+        return;
+    }
+
+    m_enabled = false;
+
+    {
+        lock_guard<mutex> lock(m_flushMutex);
+        m_stopRequested = true;
+    }
+
+    m_stopEvent.notify_one();
+    m_flushThread.join();
+    flush();
+
+    unsigned long long dropped = 0;
+    lock_guard<mutex> bufferLock(m_bufferMutex);
+    lock_guard<mutex> trackLock(m_trackMutex);
+
+    for (auto it = m_buffers.begin(); it != m_buffers.end(); it++)
+    {
+        dropped += (*it)->getDroppedEvents();
+    }
+
+    traceEvent_st end;
+    memset(&end, 0, sizeof(end));
+    end.type = TRACE_EVENT_END;
+    end.jobId = m_trackNames.size();
+    fwrite(&end, sizeof(end), 1, m_file);
+
+    for (size_t i = 0; i < m_trackNames.size(); i++)
+    {
+        traceTrack_st track;
+        memset(&track, 0, sizeof(track));
+        track.trackId = (unsigned int)i;
+        strncpy(track.name, m_trackNames[i].c_str(), sizeof(track.name) - 1);
+        fwrite(&track, sizeof(track), 1, m_file);
+    }
+
+    fclose(m_file);
+    m_file = nullptr;
+
+    printf("Trace: %llu event(s) written, %llu dropped\n", m_eventsWritten, dropped);
+}
+
+//******************************************************************************************
+// @name                    : registerTrack
+//
+// @description             : Creates a track, on which a scheduler records its events.
+//
+// @param name              : Name of the track
+//
+// @returns                 : Track id
+//******************************************************************************************
+unsigned int EventTracer::registerTrack(const string & name)
+{
+    lock_guard<mutex> lock(m_trackMutex);
+    m_trackNames.push_back(name);
+    return (unsigned int)(m_trackNames.size() - 1);
+}
+
+//******************************************************************************************
+// @name                    : registerThreadBuffer
+//
+// @description             : Creates the trace buffer of the calling thread. Buffers are
+//                            kept till the tracer is destroyed, so that the events of
+//                            threads that have already exited are still flushed.
+//
+// @returns                 : Trace buffer
+//******************************************************************************************
+TraceBuffer* EventTracer::registerThreadBuffer()
+{
+    TraceBuffer *buffer = new TraceBuffer();
+
+    lock_guard<mutex> lock(m_bufferMutex);
+    m_buffers.push_back(buffer);
+    return buffer;
+}
+
+//******************************************************************************************
+// @name                    : flush
+//
+// @description             : Writes the events of all the threads to the trace file.
+//
+// @returns                 : Nothing
+//******************************************************************************************
+void EventTracer::flush()
+{
+    lock_guard<mutex> lock(m_bufferMutex);
+    if (!m_file)
+    {
+        return;
+    }
+
+    for (auto it = m_buffers.begin(); it != m_buffers.end(); it++)
+    {
+        m_eventsWritten += (*it)->drain(m_file);
+    }
+}
+
+//******************************************************************************************
+// @name                    : flushAtInterval
+//
+// @description             : Flush thread. Keeps writing the recorded events to the trace
+//                            file till tracing is stopped.
+//
+// @returns                 : Nothing
+//******************************************************************************************
+void EventTracer::flushAtInterval()
+{
+    unique_lock<mutex> lock(m_flushMutex);
+
+    while (!m_stopEvent.wait_for(lock, chrono::milliseconds(TRACE_FLUSH_INTERVAL), [this] { return m_stopRequested; }))
+    {
+        flush();
+    }
+}
+
+//******************************************************************************************
+// @name                    : exportChromeTrace
+//
+// @description             : Converts a trace file to the Chrome trace event JSON format.
+//                            Each track is shown as a process, with a thread for the job
+//                            arrivals and one for each CPU. Every stretch of execution of
+//                            a job becomes a slice on the thread of its CPU. Timestamps are
+//                            relative to the first event.
+//
+// @param traceFileName     : Name of the trace file
+// @param jsonFileName      : Name of the JSON file to create
+//
+// @returns                 : true if the trace was exported,
+//                            false otherwise
+//******************************************************************************************
+bool EventTracer::exportChromeTrace(const string & traceFileName, const string & jsonFileName)
+{
+    FILE *traceFile = fopen(traceFileName.c_str(), "rb");
+    if (!traceFile)
+    {
+        printf("ERROR: Unable to open trace file '%s'\n", traceFileName.c_str());
+        return false;
+    }
+
+    traceFileHeader_st header;
+    if (fread(&header, sizeof(header), 1, traceFile) != 1 ||
+        memcmp(header.magic, TRACE_FILE_MAGIC, sizeof(header.magic)) != 0 ||
+        header.version != TRACE_FILE_VERSION || header.eventSize != sizeof(traceEvent_st))
+    {
+        printf("ERROR: '%s' is not a trace file\n", traceFileName.c_str());
+        fclose(traceFile);
+        return false;
+    }
+
+    vector<traceEvent_st> events;
+    traceEvent_st event;
+    bool complete = false;
+    long long tsFirst = 0;
+
+    while (fread(&event, sizeof(event), 1, traceFile) == 1)
+    {
+        if (event.type == TRACE_EVENT_END)
+        {
+            complete = true;
+            break;
+        }
+
+        if (events.empty() || event.timestamp < tsFirst)
+        {
+            tsFirst = event.timestamp;
+        }
+
+        events.push_back(event);
+    }
+
+    map<unsigned int, string> trackNames;
+    for (unsigned long long i = 0; complete && i < event.jobId; i++)
+    {
+        traceTrack_st track;
+        if (fread(&track, sizeof(track), 1, traceFile) != 1)
+        {
+            break;
+        }
+
+        track.name[sizeof(track.name) - 1] = '\0';
+        trackNames[track.trackId] = track.name;
+    }
+
+    fclose(traceFile);
+
+    if (!complete)
+    {
+        printf("WARNING: Trace file '%s' is truncated\n", traceFileName.c_str());
+    }
+
+    FILE *jsonFile = fopen(jsonFileName.c_str(), "w");
+    if (!jsonFile)
+    {
+        printf("ERROR: Unable to create file '%s'\n", jsonFileName.c_str());
+        return false;
+    }
+
+    // Thread 0 of every process shows the arrivals, CPU n is shown as thread n + 1
+    map<unsigned int, vector<unsigned short>> trackCpus;
+    map<pair<unsigned int, unsigned long long>, long long> tsDispatched;
+    const char *separator = "\n";
+
+    fprintf(jsonFile, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[");
+    for (auto it = events.begin(); it != events.end(); it++)
+    {
+        double ts = (it->timestamp - tsFirst) / 1000.0;
+        auto key = make_pair(it->trackId, it->jobId);
+
+        vector<unsigned short> & cpus = trackCpus[it->trackId];
+        if (it->type != TRACE_EVENT_ARRIVE && find(cpus.begin(), cpus.end(), it->cpuId) == cpus.end())
+        {
+            cpus.push_back(it->cpuId);
+        }
+
+        switch (it->type)
+        {
+        case TRACE_EVENT_ARRIVE:
+            fprintf(jsonFile, "%s{\"name\":\"Job %llu\",\"cat\":\"arrive\",\"ph\":\"i\",\"s\":\"t\",\"pid\":%u,\"tid\":0,\"ts\":%.3lf}",
+                    separator, it->jobId, it->trackId, ts);
+            break;
+
+        case TRACE_EVENT_DISPATCH:
+            tsDispatched[key] = it->timestamp;
+            continue;
+
+        case TRACE_EVENT_PREEMPT:
+        case TRACE_EVENT_COMPLETE:
+        {
+            auto dispatched = tsDispatched.find(key);
+            if (dispatched == tsDispatched.end())
+            {
+                continue;
+            }
+
+            fprintf(jsonFile, "%s{\"name\":\"Job %llu\",\"cat\":\"%s\",\"ph\":\"X\",\"pid\":%u,\"tid\":%u,\"ts\":%.3lf,\"dur\":%.3lf}",
+                    separator, it->jobId, (it->type == TRACE_EVENT_COMPLETE) ? "complete" : "preempt",
+                    it->trackId, it->cpuId + 1u, (dispatched->second - tsFirst) / 1000.0, (it->timestamp - dispatched->second) / 1000.0);
+            tsDispatched.erase(dispatched);
+            break;
+        }
+
+        case TRACE_EVENT_BLOCK:
+        case TRACE_EVENT_WAKE:
+            // I/O bursts are shown as async slices, as bursts of several jobs overlap
+            fprintf(jsonFile, "%s{\"name\":\"I/O Job %llu\",\"cat\":\"io\",\"ph\":\"%s\",\"id\":%llu,\"pid\":%u,\"tid\":0,\"ts\":%.3lf}",
+                    separator, it->jobId, (it->type == TRACE_EVENT_BLOCK) ? "b" : "e", it->jobId, it->trackId, ts);
+            break;
+
+        default:
+            continue;
+        }
+
+        separator = ",\n";
+    }
+
+    // Names of processes and threads
+    for (auto it = trackCpus.begin(); it != trackCpus.end(); it++)
+    {
+        string name = trackNames.count(it->first) ? trackNames[it->first] : "Track";
+        fprintf(jsonFile, "%s{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":%u,\"args\":{\"name\":\"%s #%u\"}}",
+                separator, it->first, name.c_str(), it->first);
+        separator = ",\n";
+        fprintf(jsonFile, "%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":%u,\"tid\":0,\"args\":{\"name\":\"Arrivals\"}}",
+                separator, it->first);
+
+        for (auto cpu = it->second.begin(); cpu != it->second.end(); cpu++)
+        {
+            fprintf(jsonFile, "%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":%u,\"tid\":%u,\"args\":{\"name\":\"CPU %u\"}}",
+                    separator, it->first, *cpu + 1u, (unsigned int)*cpu);
+        }
+    }
+
+    fprintf(jsonFile, "\n]}\n");
+    fclose(jsonFile);
+
+    printf("Exported %zu trace event(s) to '%s'\n", events.size(), jsonFileName.c_str());
+    return true;
+}
@@ -0,0 +1,366 @@
+#include "gang_scheduler.h"
+#include "job.h"
+#include "logger.h"
+#include<algorithm>
+
+//******************************************************************************************
+// @name                    : GangScheduler
+//
+// @description             : Constructor
+//
+// @param packing           : How the waiting jobs are packed on the idle CPUs
+//
+// @returns                 : Nothing
+//******************************************************************************************
+GangScheduler::GangScheduler(string name, gangPacking_en packing) :ProcessScheduler(name)
+{
+    m_packing = packing;
+    m_idleCpus = 0;
+    m_fragmentedCpus = 0;
+    m_tsLastDispatch = 0;
+    LOG_INFO("Creating [ %s ] scheduler", name.c_str());
+}
+
+//******************************************************************************************
+// @name                    : ~GangScheduler
+//
+// @description             : Destructor
+//
+// @returns                 : Nothing
+//******************************************************************************************
+GangScheduler::~GangScheduler()
+{
+
+}
+
+//******************************************************************************************
+// @name                    : setSchedulerName
+//
+// @description             : Stores name of the scheduling algorithm being used.
+//
+// @returns                 : Nothing
+//******************************************************************************************
+void GangScheduler::setSchedulerName(string name)
+{
+    m_schedulerName = name;
+}
+
+//******************************************************************************************
+// @name                    : ProcessJobs
+//
+// @description             : Processes the jobs on all the CPUs, a gang at a time. Each
+//                            round starts the waiting jobs that can be packed on the idle
+//                            CPUs, then lets time pass till the next gang is over or the
+//                            next job arrives, whichever comes first.
+//
+// @returns                 : Nothing
+//********************************************************************************************
+void GangScheduler::ProcessJobs()
+{
+    m_gangs.clear();
+    m_cpuJobs.assign(getCpuCount(), nullptr);
+    m_idleCpus = getCpuCount();
+    m_fragmentedCpus = 0;
+    m_tsLastDispatch = m_clock->now();
+
+    while (!isSimulationComplete())
+    {
+        {
+            ScopedPhaseTimer timer(getPhaseStats(PHASE_FETCH), getHardwareCounters());
+            fetchReadyJobs();
+        }
+
+        {
+            ScopedPhaseTimer timer(getPhaseStats(PHASE_DISPATCH), getHardwareCounters());
+            dispatchJobs();
+        }
+
+        {
+            ScopedPhaseTimer timer(getPhaseStats(PHASE_WORK), getHardwareCounters());
+            waitForNextEvent();
+        }
+
+        {
+            ScopedPhaseTimer timer(getPhaseStats(PHASE_COMPLETE), getHardwareCounters());
+            completeGangs();
+        }
+    }
+}
+
+//******************************************************************************************
+// @name                    : dispatchJobs
+//
+// @description             : Starts the waiting jobs that fit on the idle CPUs, as per the
+//                            packing policy. With tenant groups, only the jobs of the group
+//                            picked to run next are started, and the group is picked again
+//                            after each. The CPUs left idle while jobs keep waiting are
+//                            accounted as fragmentation till the next dispatch.
+//
+// @returns                 : Nothing
+//********************************************************************************************
+void GangScheduler::dispatchJobs()
+{
+    long long tsNow = m_clock->now();
+    long long tsReservation = -1;                     // Reserved start of the first job that did not fit
+    unsigned int spareCpus = 0;                       // CPUs it leaves to the jobs running past its start
+    bool jobPassedOver = false;                       // A job ahead did not fit
+
+    accountFragmentation(m_fragmentedCpus * (tsNow - m_tsLastDispatch));
+
+    auto it = m_pendingJobPool.begin();
+    while (it != m_pendingJobPool.end() && m_idleCpus > 0)
+    {
+        // Real work is done right away, and the job leaves the pool
+        Job *job = *it;
+        it++;
+
+        if (job->getJobState() == STATE_RUNNING || !isDispatchable(job))
+        {
+            continue;
+        }
+
+        unsigned int width = getWidth(job);
+        if (width > m_idleCpus)
+        {
+            if (m_packing == GANG_PACKING_FCFS)
+            {
+                break;
+            }
+
+            if (m_packing == GANG_PACKING_BACKFILL && !jobPassedOver)
+            {
+                tsReservation = getReservation(width, spareCpus);
+            }
+
+            jobPassedOver = true;
+            continue;
+        }
+
+        if (tsReservation >= 0 && tsNow + getPredictedBurstRemaining(job) > tsReservation)
+        {
+            // Still running at the reserved start, so it must leave enough CPUs for it
+            if (width > spareCpus)
+            {
+                continue;
+            }
+
+            spareCpus -= width;
+        }
+
+        if (jobPassedOver)
+        {
+            accountBackfill();
+        }
+
+        startGang(job);
+        if (hasTenantGroups())
+        {
+            repickTenantGroups();
+        }
+    }
+
+    m_fragmentedCpus = 0;
+    for (auto waiting = m_pendingJobPool.begin(); waiting != m_pendingJobPool.end() && m_idleCpus > 0; waiting++)
+    {
+        if ((*waiting)->getJobState() != STATE_RUNNING)
+        {
+            m_fragmentedCpus = m_idleCpus;
+            break;
+        }
+    }
+
+    m_tsLastDispatch = m_clock->now();
+}
+
+//******************************************************************************************
+// @name                    : getReservation
+//
+// @description             : Finds the earliest time at which enough CPUs will be idle for
+//                            a job that does not fit now, as the running gangs end.
+//
+// @param width             : CPUs the job needs
+// @param spareCpus         : CPUs idle at that time beyond those the job needs
+//
+// @returns                 : timestamp (ns), -1 if the job can never fit
+//********************************************************************************************
+long long GangScheduler::getReservation(unsigned int width, unsigned int & spareCpus)
+{
+    vector<gang_st> gangs = m_gangs;
+    unsigned int idleCpus = m_idleCpus;
+
+    sort(gangs.begin(), gangs.end(), [](const gang_st & a, const gang_st & b) { return a.tsEnd < b.tsEnd; });
+
+    spareCpus = 0;
+    for (auto it = gangs.begin(); it != gangs.end(); it++)
+    {
+        idleCpus += getWidth(it->job);
+        if (idleCpus >= width)
+        {
+            spareCpus = idleCpus - width;
+            return it->tsEnd;
+        }
+    }
+
+    return -1;
+}
+
+//******************************************************************************************
+// @name                    : startGang
+//
+// @description             : Starts a job on as many idle CPUs as its width, for the whole
+//                            of its CPU burst, after the CPUs have switched to it. A job with
+//                            real work (only allowed on a single CPU) is run to the end of
+//                            its CPU burst right away instead.
+//
+// @param job               : Job that fits on the idle CPUs
+//
+// @returns                 : true if the job is running,
+//                            false if it is already done
+//********************************************************************************************
+bool GangScheduler::startGang(Job *job)
+{
+    if (job->hasPayload() || job->hasCoroutine())
+    {
+        assignCpu(job);
+        job->markJobAsStartedExecution();
+        endCpuBurst(job, DoJob(job));
+        return false;
+    }
+
+    unsigned int width = getWidth(job);
+    unsigned int cpusTaken = 0;
+    long long switchTime = 0;
+
+    for (unsigned int cpu = 0; cpu < m_cpuJobs.size() && cpusTaken < width; cpu++)
+    {
+        if (m_cpuJobs[cpu])
+        {
+            continue;
+        }
+
+        if (cpusTaken == 0)
+        {
+            job->setCpuId((unsigned short)cpu);
+        }
+
+        // The gang starts once the last of its CPUs has switched to it
+        m_cpuJobs[cpu] = job;
+        switchTime = max(switchTime, switchCpu(cpu, job));
+        cpusTaken++;
+    }
+
+    m_idleCpus -= cpusTaken;
+    job->markJobAsStartedExecution();
+
+    long long timeSlice = job->getCpuBurstRemaining();
+    m_gangs.push_back(gang_st{ job, m_clock->now() + switchTime + timeSlice, timeSlice });
+    return true;
+}
+
+//******************************************************************************************
+// @name                    : waitForNextEvent
+//
+// @description             : Lets time pass till the next gang is over, or till the next
+//                            known arrival or I/O completion if it comes first, as the
+//                            arrival may fit on the idle CPUs.
+//
+// @returns                 : Nothing
+//********************************************************************************************
+void GangScheduler::waitForNextEvent()
+{
+    if (m_gangs.empty())
+    {
+        return;
+    }
+
+    long long tsNext = m_gangs.front().tsEnd;
+    for (auto it = m_gangs.begin(); it != m_gangs.end(); it++)
+    {
+        tsNext = min(tsNext, it->tsEnd);
+    }
+
+    long long tsNextEvent = getNextEventTime();
+    if (tsNextEvent >= 0 && tsNextEvent < tsNext)
+    {
+        tsNext = tsNextEvent;
+    }
+
+    m_clock->waitFor(tsNext - m_clock->now());
+}
+
+//******************************************************************************************
+// @name                    : completeGangs
+//
+// @description             : Ends the gangs whose CPU burst is over, in the order they
+//                            started, and releases their CPUs.
+//
+// @returns                 : Nothing
+//********************************************************************************************
+void GangScheduler::completeGangs()
+{
+    long long tsNow = m_clock->now();
+
+    auto it = m_gangs.begin();
+    while (it != m_gangs.end())
+    {
+        if (it->tsEnd > tsNow)
+        {
+            it++;
+            continue;
+        }
+
+        Job *job = it->job;
+        for (auto cpu = m_cpuJobs.begin(); cpu != m_cpuJobs.end(); cpu++)
+        {
+            if (*cpu == job)
+            {
+                *cpu = nullptr;
+                m_idleCpus++;
+            }
+        }
+
+        accountTimeSlice(job, it->timeSlice, getWidth(job));
+        it = m_gangs.erase(it);
+        endCpuBurst(job, job->isLastCpuBurst());
+    }
+}
+
+//******************************************************************************************
+// @name                    : endCpuBurst
+//
+// @description             : Completes a job whose CPU burst is over, or moves it to the
+//                            blocked pool if it needs I/O.
+//
+// @param job               : Job whose CPU burst is over
+// @param jobComplete       : The job is complete
+//
+// @returns                 : Nothing
+//********************************************************************************************
+void GangScheduler::endCpuBurst(Job *job, bool jobComplete)
+{
+    if (jobComplete)
+    {
+        job->markJobAsComplete();
+        this->JobComplete(job);
+    }
+    else
+    {
+        job->markJobAsPaused(m_timeSliceServed);
+        this->JobBlocked(job);
+    }
+}
+
+//******************************************************************************************
+// @name                    : getWidth
+//
+// @description             : Fetches the CPUs a job runs on. A job wider than the CPUs of
+//                            the scheduler runs on all of them.
+//
+// @param job               : Job
+//
+// @returns                 : Number of CPUs
+//********************************************************************************************
+unsigned int GangScheduler::getWidth(Job *job)
+{
+    return min(job->getWidth(), getCpuCount());
+}
@@ -0,0 +1,208 @@
+#include "io_device.h"
+
+//******************************************************************************************
+// @name                    : IoDevice
+//
+// @description             : Constructor
+//
+// @returns                 : Nothing
+//******************************************************************************************
+IoDevice::IoDevice()
+{
+    m_tsBusyUntil = 0;
+    m_busyTime = 0;
+    m_queueingDelay = 0;
+    m_requests = 0;
+}
+
+//******************************************************************************************
+// @name                    : submit
+//
+// @description             : Queues an I/O burst. It is served once all the bursts
+//                            submitted before it are.
+//
+// @param tsNow             : Current timestamp (ns)
+// @param serviceTime       : Time (ns) the device takes to serve the burst
+//
+// @returns                 : timestamp (ns) at which the burst will be complete
+//******************************************************************************************
+long long IoDevice::submit(long long tsNow, long long serviceTime)
+{
+    long long tsStart = (m_tsBusyUntil > tsNow) ? m_tsBusyUntil : tsNow;
+
+    m_queueingDelay += tsStart - tsNow;
+    m_busyTime += serviceTime;
+    m_requests++;
+    m_tsBusyUntil = tsStart + serviceTime;
+
+    return m_tsBusyUntil;
+}
+
+//******************************************************************************************
+// @name                    : IoController
+//
+// @description             : Constructor. Starts with a single device.
+//
+// @returns                 : Nothing
+//******************************************************************************************
+IoController::IoController()
+{
+    m_devices.resize(1);
+}
+
+//******************************************************************************************
+// @name                    : setDeviceCount
+//
+// @description             : Sets the number of devices. Must be called before any burst
+//                            is submitted.
+//
+// @param count             : Number of devices, at least 1
+//
+// @returns                 : Nothing
+//******************************************************************************************
+void IoController::setDeviceCount(unsigned int count)
+{
+    m_devices.assign((count > 0) ? count : 1, IoDevice());
+}
+
+//******************************************************************************************
+// @name                    : submit
+//
+// @description             : Blocks a job on its next I/O burst, on its device.
+//
+// @param job               : Job, already marked as blocked
+// @param tsNow             : Current timestamp (ns)
+//
+// @returns                 : Nothing
+//******************************************************************************************
+void IoController::submit(Job *job, long long tsNow)
+{
+    IoDevice & device = m_devices[job->getIoDevice() % m_devices.size()];
+
+    ioEvent_st event;
+    event.tsComplete = device.submit(tsNow, job->getIoBurstTime());
+    event.job = job;
+    m_blockedJobs.push(event);
+}
+
+//******************************************************************************************
+// @name                    : getNextCompletionTime
+//
+// @description             : Fetches the timestamp at which the next I/O burst completes.
+//
+// @returns                 : timestamp (ns) of the next completion, -1 if no job is blocked
+//******************************************************************************************
+long long IoController::getNextCompletionTime()
+{
+    return m_blockedJobs.empty() ? -1 : m_blockedJobs.top().tsComplete;
+}
+
+//******************************************************************************************
+// @name                    : releaseCompletedJobs
+//
+// @description             : Wakes the jobs whose I/O burst is complete by now, in the
+//                            order of completion, and appends them to a pool.
+//
+// @param tsNow             : Current timestamp (ns)
+// @param pool              : Pool the woken jobs are appended to
+//
+// @returns                 : Nothing
+//******************************************************************************************
+void IoController::releaseCompletedJobs(long long tsNow, list<Job*> & pool)
+{
+    while (!m_blockedJobs.empty() && m_blockedJobs.top().tsComplete <= tsNow)
+    {
+        ioEvent_st event = m_blockedJobs.top();
+        m_blockedJobs.pop();
+
+        event.job->markJobAsUnblocked(event.tsComplete);
+        pool.push_back(event.job);
+    }
+}
+
+//******************************************************************************************
+// @name                    : takeBlockedJobs
+//
+// @description             : Moves all the blocked jobs to a pool without waking them,
+//                            e.g. to free them.
+//
+// @param pool              : Pool the jobs are appended to
+//
+// @returns                 : Nothing
+//******************************************************************************************
+void IoController::takeBlockedJobs(list<Job*> & pool)
+{
+    while (!m_blockedJobs.empty())
+    {
+        pool.push_back(m_blockedJobs.top().job);
+        m_blockedJobs.pop();
+    }
+}
+
+//******************************************************************************************
+// @name                    : saveCheckpoint
+//
+// @description             : Saves the state of the devices and the blocked pool.
+//
+// @param writer            : Checkpoint
+//
+// @returns                 : Nothing
+//******************************************************************************************
+void IoController::saveCheckpoint(CheckpointWriter & writer)
+{
+    writer.write((unsigned int)m_devices.size());
+    for (IoDevice & device : m_devices)
+    {
+        writer.write(device);
+    }
+
+    vector<ioEvent_st> & events = m_blockedJobs.getEvents();
+    writer.write((unsigned long long)events.size());
+    for (ioEvent_st & event : events)
+    {
+        writer.write(event.tsComplete);
+        event.job->saveCheckpoint(writer);
+    }
+}
+
+//******************************************************************************************
+// @name                    : restoreCheckpoint
+//
+// @description             : Restores the devices and the blocked pool saved in a
+//                            checkpoint. The blocked pool must be empty.
+//
+// @param reader            : Checkpoint
+// @param clock             : Clock of the restored jobs
+// @param restoredJobs      : Pool the restored jobs are appended to as well, e.g. to trace
+//                            them
+//
+// @returns                 : true if the checkpoint could be read,
+//                            false otherwise
+//******************************************************************************************
+bool IoController::restoreCheckpoint(CheckpointReader & reader, SimulationClock *clock, list<Job*> & restoredJobs)
+{
+    unsigned int deviceCount = reader.read<unsigned int>();
+    if (reader.hasFailed() || deviceCount == 0)
+    {
+        return false;
+    }
+
+    m_devices.resize(deviceCount);
+    for (IoDevice & device : m_devices)
+    {
+        device = reader.read<IoDevice>();
+    }
+
+    unsigned long long eventCount = reader.read<unsigned long long>();
+    vector<ioEvent_st> & events = m_blockedJobs.getEvents();
+    for (unsigned long long index = 0; index < eventCount && !reader.hasFailed(); index++)
+    {
+        ioEvent_st event;
+        event.tsComplete = reader.read<long long>();
+        event.job = new Job(reader, clock);
+        events.push_back(event);
+        restoredJobs.push_back(event.job);
+    }
+
+    return !reader.hasFailed();
+}
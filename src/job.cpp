@@ -1,16 +1,8 @@
-#include <chrono>
 #include "job.h"
+#include "logger.h"
 
 RandomGenerator rng;                            // Random Generator
 
-// Get time stamp in milliseconds.
-long long getCurrentTimestampInMilliseconds()
-{
-    long long ts_us = chrono::duration_cast<std::chrono::milliseconds>(std::chrono::high_resolution_clock::
-                      now().time_since_epoch()).count();
-    return ts_us;
-}
-
 //******************************************************************************************
 // @name                    : Job
 //
@@ -20,18 +12,109 @@ long long getCurrentTimestampInMilliseconds()
 //******************************************************************************************
 Job::Job(bool showJobStatus, unsigned long jobId, unsigned int priority, int responseTimeThreshold)
 {
+    m_clock = getRealTimeClock();
     m_showJobStatus = showJobStatus;
     m_jobId = jobId;
     m_priority = priority;
     m_state = STATE_READY;
-    m_timeRequired = rng.generateRandomNumber(MAX_TIME_REQUIRED);    // Don't know how this would be estimated in an actual run
+    m_timeRequired = rng.generateRandomNumber(MAX_TIME_REQUIRED) * NANOSECONDS_PER_MILLISECOND;    // Don't know how this would be estimated in an actual run
+    m_timeServed = 0;                                                // Job has not yet started execution
+    m_tsCreated = m_clock->now();
+    m_tsExecutionStart = -1;                                         // Not yet started
+    m_tsExecutionEnd = -1;                                           // Not yet completed 
+    m_waitingTime = -1;
+    m_responseTime = -1;
+    m_responseTimeThreshold = responseTimeThreshold;
+    m_traceTrack = 0;
+    m_pendingSlot = 0;
+    m_cpuId = 0;                                                     // Till dispatched on another CPU
+    m_burstTimeServed = 0;
+    m_burstEstimate.predicted = -1;                                  // Not predicted yet
+    m_burstEstimate.samples = 0;
+    setIoBursts(0, 0, 0);                                            // Pure CPU job
+    m_width = 1;                                                     // Single thread
+    m_tenantGroup = 0;                                               // First group, if any
+}
+
+//******************************************************************************************
+// @name                    : Job
+//
+// @description             : Constructor. Creates the job described by a pre-generated
+//                            job specification instead of drawing its time required
+//                            from the RNG.
+//
+// @param clock             : Clock used for timestamps of this job. Use nullptr for the
+//                            real time clock.
+//
+// @returns                 : Nothing
+//******************************************************************************************
+Job::Job(bool showJobStatus, const jobSpec_st & spec, int responseTimeThreshold, SimulationClock *clock)
+{
+    m_clock = clock ? clock : getRealTimeClock();
+    m_showJobStatus = showJobStatus;
+    m_jobId = spec.jobId;
+    m_priority = spec.priority;
+    m_state = STATE_READY;
+    m_timeRequired = spec.timeRequired;
     m_timeServed = 0;                                                // Job has not yet started execution
-    m_tsCreated = getCurrentTimestampInMilliseconds();
+    m_tsCreated = m_clock->now();
     m_tsExecutionStart = -1;                                         // Not yet started
     m_tsExecutionEnd = -1;                                           // Not yet completed 
     m_waitingTime = -1;
     m_responseTime = -1;
     m_responseTimeThreshold = responseTimeThreshold;
+    m_traceTrack = 0;
+    m_pendingSlot = 0;
+    m_cpuId = 0;                                                     // Till dispatched on another CPU
+    m_burstTimeServed = 0;
+    m_burstEstimate.predicted = -1;                                  // Not predicted yet
+    m_burstEstimate.samples = 0;
+    setIoBursts(spec.ioBursts, spec.ioBurstTime, spec.ioDevice);
+    setWidth(spec.width);
+    m_tenantGroup = spec.tenantGroup;
+}
+
+//******************************************************************************************
+// @name                    : Job
+//
+// @description             : Constructor. Restores a job saved in a checkpoint by
+//                            saveCheckpoint(), in the state it was saved in.
+//
+// @param reader            : Checkpoint, positioned at the job
+// @param clock             : Clock used for timestamps of this job. It must run on the
+//                            timeline of the clock the job was saved with.
+//
+// @returns                 : Nothing
+//******************************************************************************************
+Job::Job(CheckpointReader & reader, SimulationClock *clock)
+{
+    m_clock = clock ? clock : getRealTimeClock();
+    m_showJobStatus = reader.read<bool>();
+    m_jobId = reader.read<unsigned long>();
+    m_priority = reader.read<unsigned int>();
+    m_state = reader.read<jobState_en>();
+    m_timeRequired = reader.read<long long>();
+    m_timeServed = reader.read<long long>();
+    m_tsCreated = reader.read<long long>();
+    m_tsExecutionStart = reader.read<long long>();
+    m_tsExecutionEnd = reader.read<long long>();
+    m_waitingTime = reader.read<long long>();
+    m_responseTime = reader.read<long long>();
+    m_responseTimeThreshold = reader.read<int>();
+    m_traceTrack = 0;
+    m_pendingSlot = 0;
+    m_cpuId = reader.read<unsigned short>();
+    m_cpuBurst = reader.read<long long>();
+    m_burstTimeServed = reader.read<long long>();
+    m_ioBurstsRemaining = reader.read<unsigned int>();
+    m_ioBurstTime = reader.read<long long>();
+    m_ioDevice = reader.read<unsigned int>();
+    m_width = reader.read<unsigned int>();
+    m_tenantGroup = reader.read<unsigned int>();
+    m_burstEstimate = reader.read<burstEstimate_st>();
+
+    if (m_state <= STATE_INVALID || m_state >= STATE_MAX)
+        reader.setFailed();
 }
 
 //******************************************************************************************
@@ -46,6 +129,41 @@ Job::~Job()
 
 }
 
+//******************************************************************************************
+// @name                    : saveCheckpoint
+//
+// @description             : Saves the state of this job to a checkpoint. The real work of
+//                            the job (payload or coroutine) cannot be saved.
+//
+// @param writer            : Checkpoint
+//
+// @returns                 : Nothing
+//******************************************************************************************
+void Job::saveCheckpoint(CheckpointWriter & writer)
+{
+    writer.write(m_showJobStatus);
+    writer.write(m_jobId);
+    writer.write(m_priority);
+    writer.write(m_state);
+    writer.write(m_timeRequired);
+    writer.write(m_timeServed);
+    writer.write(m_tsCreated);
+    writer.write(m_tsExecutionStart);
+    writer.write(m_tsExecutionEnd);
+    writer.write(m_waitingTime);
+    writer.write(m_responseTime);
+    writer.write(m_responseTimeThreshold);
+    writer.write(m_cpuId);
+    writer.write(m_cpuBurst);
+    writer.write(m_burstTimeServed);
+    writer.write(m_ioBurstsRemaining);
+    writer.write(m_ioBurstTime);
+    writer.write(m_ioDevice);
+    writer.write(m_width);
+    writer.write(m_tenantGroup);
+    writer.write(m_burstEstimate);
+}
+
 //******************************************************************************************
 // @name                    : getJobTimeRemaining
 //
@@ -54,13 +172,53 @@ Job::~Job()
 //                            Round Robin Scheduling algorithm), so this needs to take into 
 //                            account the total time served in running this task.
 //
-// @returns                 : Time required to complete this job (in milli seconds)
+// @returns                 : Time required to complete this job (in nano seconds)
 //******************************************************************************************
 long long Job::getJobTimeRemaining()
 { 
     return (m_timeRequired - m_timeServed); 
 }
 
+//******************************************************************************************
+// @name                    : setIoBursts
+//
+// @description             : Makes this job alternate between CPU and I/O bursts. Its time
+//                            required is split into equal CPU bursts, with an I/O burst in
+//                            between every two of them. Must be called before the job is
+//                            started.
+//
+// @param ioBursts          : Number of I/O bursts, 0 for a pure CPU job
+// @param ioBurstTime       : Time (ns) a device takes to serve each I/O burst
+// @param ioDevice          : Device the I/O bursts are served by
+//
+// @returns                 : Nothing
+//******************************************************************************************
+void Job::setIoBursts(unsigned int ioBursts, long long ioBurstTime, unsigned int ioDevice)
+{
+    m_ioBurstsRemaining = ioBursts;
+    m_ioBurstTime = ioBurstTime;
+    m_ioDevice = ioDevice;
+    m_cpuBurst = m_timeRequired / (ioBursts + 1);
+}
+
+//******************************************************************************************
+// @name                    : getCpuBurstRemaining
+//
+// @description             : Calculates the CPU time left till this job either needs its
+//                            next I/O burst or completes.
+//
+// @returns                 : Time (ns) left in the current CPU burst
+//******************************************************************************************
+long long Job::getCpuBurstRemaining()
+{
+    if (isLastCpuBurst())
+    {
+        return getJobTimeRemaining();
+    }
+
+    return m_cpuBurst - m_burstTimeServed;
+}
+
 //******************************************************************************************
 // @name                    : getJobTimeRequired
 //
@@ -80,15 +238,15 @@ long long Job::getJobTimeRequired()
 //******************************************************************************************
 // @name                    : getWaitingTime
 //
-// @description             : Get the duration (ms) for which this task has been waiting in ready queue
+// @description             : Get the duration (ns) for which this task has been waiting in ready queue
 //
-// @returns                 : waiting time in ms.
+// @returns                 : waiting time in ns.
 //******************************************************************************************
 long long Job::getWaitingTime()
 {
     // Job not yet complete
     if (m_waitingTime < 0)
-        printf("*** %s:: Job %lu not yet started\n", __FUNCTION__, m_jobId);
+        LOG_WARNING("%s:: Job %lu not yet started", __FUNCTION__, m_jobId);
 
     return m_waitingTime;
 }
@@ -108,15 +266,15 @@ void Job::setWaitingTime(long long waitingTime)
 //******************************************************************************************
 // @name                    : getResponseTime
 //
-// @description             : Get the duration (ms) from work becoming enabled until it is finished
+// @description             : Get the duration (ns) from work becoming enabled until it is finished
 //
-// @returns                 : response time in ms.
+// @returns                 : response time in ns.
 //******************************************************************************************
 long long Job::getResponseTime()
 {
     // Job not yet complete
     if (m_responseTime < 0)
-        printf("*** %s:: Job %lu not yet complete\n", __FUNCTION__, m_jobId);
+        LOG_WARNING("%s:: Job %lu not yet complete", __FUNCTION__, m_jobId);
     
     return m_responseTime;
 }
@@ -146,13 +304,13 @@ void Job::displayJobDetails()
     printf("Job ID             : %lu\n", m_jobId);
     printf("Priority           : %d\n", m_priority);
     printf("State              : %d\n", m_state);
-    printf("Time required      : %lld ms.\n", m_timeRequired);
-    printf("Time served        : %lld ms.\n", m_timeServed);
+    printf("Time required      : %.3lf ms.\n", m_timeRequired / (double)NANOSECONDS_PER_MILLISECOND);
+    printf("Time served        : %.3lf ms.\n", m_timeServed / (double)NANOSECONDS_PER_MILLISECOND);
     printf("Created at         : %lld\n", m_tsCreated);
     printf("Execution started  : %lld\n", m_tsExecutionStart);
     printf("Execution ended    : %lld\n", m_tsExecutionEnd);
-    printf("Waiting time       : %lld ms.\n", getWaitingTime());
-    printf("Response time      : %lld ms.\n", getResponseTime());
+    printf("Waiting time       : %.3lf ms.\n", getWaitingTime() / (double)NANOSECONDS_PER_MILLISECOND);
+    printf("Response time      : %.3lf ms.\n", getResponseTime() / (double)NANOSECONDS_PER_MILLISECOND);
     printf("Reached RT thrshold: %s\n", isResponseThresholdReached() ? "YES" : "NO");
     printf("Complete           : %s\n", isJobComplete() ? "YES" : "NO");
 }
@@ -169,14 +327,14 @@ void Job::markJobAsStartedExecution()
 {
     if (m_state == STATE_READY)
     {
-        m_tsExecutionStart = getCurrentTimestampInMilliseconds();
+        m_tsExecutionStart = m_clock->now();
         if (isDebugEnabled())
-            printf("Job %lu (Priority: %d, TimeRequired: %.2lf s.) started\n", m_jobId, m_priority, m_timeRequired / (double)1000);
+            LOG_INFO("Job %lu (Priority: %u, TimeRequired: %.2lf s.) started", m_jobId, m_priority, m_timeRequired / (double)NANOSECONDS_PER_SECOND);
     }
     else if (m_state == STATE_PAUSED)
     {
         if (isDebugEnabled())
-            printf("Job %lu resumed from %.2lf/%.2lf (s.)\n", m_jobId, m_timeServed / (double)1000, m_timeRequired / (double)1000);
+            LOG_INFO("Job %lu resumed from %.2lf/%.2lf (s.)", m_jobId, m_timeServed / (double)NANOSECONDS_PER_SECOND, m_timeRequired / (double)NANOSECONDS_PER_SECOND);
     }
     else
     {
@@ -185,6 +343,7 @@ void Job::markJobAsStartedExecution()
 
     m_state = STATE_RUNNING;
     setWaitingTime(m_tsExecutionStart - m_tsCreated);
+    traceEvent(TRACE_EVENT_DISPATCH, m_clock->now());
 }
 
 //******************************************************************************************
@@ -193,17 +352,58 @@ void Job::markJobAsStartedExecution()
 // @description             : Updates the state and records the time for which this
 //                            job executed.
 //
-// @param timeServed        : Duration of time (ms) for which this job was executed. 
+// @param timeServed        : Duration of time (ns) for which this job was executed. 
+//                            This is added to the time already served.
 //
 // @returns                 : Nothing
 //******************************************************************************************
 void Job::markJobAsPaused(long long timeServed)
 {
     m_state = STATE_PAUSED;
-    m_timeServed = timeServed;
+    m_timeServed += timeServed;
+    m_burstTimeServed += timeServed;
+    traceEvent(TRACE_EVENT_PREEMPT, m_clock->now());
+
+    if (isDebugEnabled())
+        LOG_INFO("Job %lu paused %.2lf/%.2lf (s.)", m_jobId, m_timeServed / (double)NANOSECONDS_PER_SECOND, m_timeRequired / (double)NANOSECONDS_PER_SECOND);
+}
+
+//******************************************************************************************
+// @name                    : markJobAsBlocked
+//
+// @description             : Updates the state once this job has served its current CPU
+//                            burst and starts its next I/O burst.
+//
+// @returns                 : Nothing
+//******************************************************************************************
+void Job::markJobAsBlocked()
+{
+    m_state = STATE_BLOCKED;
+    m_burstTimeServed = 0;
+    m_ioBurstsRemaining--;
+    traceEvent(TRACE_EVENT_BLOCK, m_clock->now());
+
+    if (isDebugEnabled())
+        LOG_INFO("Job %lu blocked on device %u for %.2lf s.", m_jobId, m_ioDevice, m_ioBurstTime / (double)NANOSECONDS_PER_SECOND);
+}
+
+//******************************************************************************************
+// @name                    : markJobAsUnblocked
+//
+// @description             : Updates the state once the I/O burst of this job is complete.
+//                            The job is ready to be resumed.
+//
+// @param tsWake            : timestamp (ns) at which the I/O burst completed
+//
+// @returns                 : Nothing
+//******************************************************************************************
+void Job::markJobAsUnblocked(long long tsWake)
+{
+    m_state = STATE_PAUSED;
+    traceEvent(TRACE_EVENT_WAKE, tsWake);
 
     if (isDebugEnabled())
-        printf("Job %lu paused %.2lf/%.2lf (s.)\n", m_jobId, m_timeServed / (double)1000, m_timeRequired / (double)1000);
+        LOG_INFO("Job %lu woken up", m_jobId);
 }
 
 //******************************************************************************************
@@ -217,17 +417,39 @@ void Job::markJobAsPaused(long long timeServed)
 void Job::markJobAsComplete()
 {
     m_state = STATE_COMPLETED;
-    m_tsExecutionEnd = getCurrentTimestampInMilliseconds();
+    m_tsExecutionEnd = m_clock->now();
+    m_burstTimeServed += m_timeRequired - m_timeServed;
     m_timeServed = m_timeRequired;
     setResponseTime(m_tsExecutionEnd - m_tsCreated);
+    traceEvent(TRACE_EVENT_COMPLETE, m_tsExecutionEnd);
 
     if (isDebugEnabled())
     {
-        printf("Job %lu completed\n", m_jobId);
+        LOG_INFO("Job %lu completed", m_jobId);
         //displayJobDetails();
     }
 }
 
+//******************************************************************************************
+// @name                    : traceEvent
+//
+// @description             : Records a scheduling event of this job, if tracing is
+//                            started.
+//
+// @param type              : Type of the event
+// @param timestamp         : timestamp (ns) of the event
+//
+// @returns                 : Nothing
+//******************************************************************************************
+void Job::traceEvent(traceEventType_en type, long long timestamp)
+{
+    EventTracer & tracer = EventTracer::getInstance();
+    if (tracer.isEnabled())
+    {
+        tracer.record(type, m_traceTrack, m_cpuId, m_jobId, timestamp);
+    }
+}
+
 //******************************************************************************************
 // @name                    : isThresholdReached
 //
@@ -242,5 +464,5 @@ void Job::markJobAsComplete()
 //******************************************************************************************
 bool Job::isResponseThresholdReached()
 {
-    return (m_responseTime >= (m_responseTimeThreshold * m_timeRequired));
+    return (m_responseTime >= getResponseTimeLimit());
 }
\ No newline at end of file
@@ -0,0 +1,157 @@
+#include "job_batcher.h"
+#include "timing.h"
+
+//******************************************************************************************
+// @name                    : JobBatcher
+//
+// @description             : Constructor
+//
+// @param scheduler         : Scheduler the jobs are added to
+// @param batchSize         : Jobs in a full batch, at least 1
+// @param batchWindow       : Max time (ns) a job is held back, 0 for no limit
+//
+// @returns                 : Nothing
+//******************************************************************************************
+JobBatcher::JobBatcher(ProcessScheduler *scheduler, size_t batchSize, long long batchWindow)
+{
+    m_scheduler = scheduler;
+    m_batchSize = (batchSize > 0) ? batchSize : 1;
+    m_batchWindow = (batchWindow > 0) ? batchWindow : 0;
+    m_tsFirstJob = 0;
+    m_batches = 0;
+    m_batch.reserve(m_batchSize);
+}
+
+//******************************************************************************************
+// @name                    : ~JobBatcher
+//
+// @description             : Destructor. Adds the jobs still held back.
+//
+// @returns                 : Nothing
+//******************************************************************************************
+JobBatcher::~JobBatcher()
+{
+    flush();
+}
+
+//******************************************************************************************
+// @name                    : add
+//
+// @description             : Adds a job to the batch, and the batch to the ready queue if
+//                            it is full or its window has expired.
+//
+// @param job               : Job, owned by the batcher from now on
+//
+// @returns                 : Nothing
+//******************************************************************************************
+void JobBatcher::add(Job *job)
+{
+    long long tsNow = getCurrentTimestampInNanoseconds();
+
+    if (m_batch.empty())
+    {
+        m_tsFirstJob = tsNow;
+    }
+
+    m_batch.push_back(job);
+
+    long long tsDeadline = getDeadline();
+    if (m_batch.size() >= m_batchSize || (tsDeadline >= 0 && tsNow >= tsDeadline))
+    {
+        flush();
+    }
+}
+
+//******************************************************************************************
+// @name                    : flush
+//
+// @description             : Adds the jobs held back to the ready queue, as one batch.
+//
+// @returns                 : Nothing
+//******************************************************************************************
+void JobBatcher::flush()
+{
+    if (m_batch.empty())
+    {
+        return;
+    }
+
+    m_scheduler->addToReadyQueue(m_batch, m_shedJobs);
+    m_batches++;
+
+    for (Job *job : m_shedJobs)
+    {
+        delete job;
+    }
+
+    m_batch.clear();
+    m_shedJobs.clear();
+}
+
+//******************************************************************************************
+// @name                    : getDeadline
+//
+// @description             : Fetches the time at which the batch has to be added, as per
+//                            the batch window.
+//
+// @returns                 : timestamp (ns) of the deadline, -1 if there is none
+//******************************************************************************************
+long long JobBatcher::getDeadline()
+{
+    if (m_batch.empty() || m_batchWindow == 0)
+    {
+        return -1;
+    }
+
+    return m_tsFirstJob + m_batchWindow;
+}
+
+//******************************************************************************************
+// @name                    : waitFor
+//
+// @description             : Sleeps for a duration, e.g. till the producer's next job, and
+//                            adds the batch in between if its window expires meanwhile.
+//                            Back to back waits do not drift, as with sleepForNanoseconds().
+//
+// @param duration          : Duration (ns) to sleep
+//
+// @returns                 : Nothing
+//******************************************************************************************
+void JobBatcher::waitFor(long long duration)
+{
+    long long tsDeadline = getDeadline();
+    long long tsNow = getCurrentTimestampInNanoseconds();
+
+    if (tsDeadline >= 0 && tsDeadline < tsNow + duration)
+    {
+        waitUntil(tsNow + duration);
+    }
+    else
+    {
+        sleepForNanoseconds(duration);
+    }
+}
+
+//******************************************************************************************
+// @name                    : waitUntil
+//
+// @description             : Sleeps till a timestamp, and adds the batch in between if its
+//                            window expires meanwhile.
+//
+// @param timestamp         : timestamp (ns), as returned by
+//                            getCurrentTimestampInNanoseconds()
+//
+// @returns                 : Nothing
+//******************************************************************************************
+void JobBatcher::waitUntil(long long timestamp)
+{
+    long long tsDeadline = getDeadline();
+
+    if (tsDeadline >= 0 && tsDeadline < timestamp)
+    {
+        sleepUntilNanoseconds(tsDeadline);
+        flush();
+    }
+
+    sleepUntilNanoseconds(timestamp);
+}
@@ -0,0 +1,93 @@
+#include "job_coroutine.h"
+#include "logger.h"
+#include<exception>
+
+//******************************************************************************************
+// @name                    : unhandled_exception
+//
+// @description             : Called when the work of a job throws. The error is logged and
+//                            the coroutine ends, so the job is taken as complete.
+//
+// @returns                 : Nothing
+//******************************************************************************************
+void JobCoroutine::promise_type::unhandled_exception()
+{
+    try
+    {
+        throw;
+    }
+    catch (const exception & e)
+    {
+        LOG_ERROR("Job coroutine failed: %s", e.what());
+    }
+    catch (...)
+    {
+        LOG_ERROR("Job coroutine failed");
+    }
+}
+
+//******************************************************************************************
+// @name                    : operator=
+//
+// @description             : Takes over the frame of another coroutine, destroying the
+//                            frame owned till now.
+//
+// @param other             : Coroutine to take over
+//
+// @returns                 : This coroutine
+//******************************************************************************************
+JobCoroutine & JobCoroutine::operator=(JobCoroutine && other) noexcept
+{
+    if (this != &other)
+    {
+        if (m_handle)
+        {
+            m_handle.destroy();
+        }
+
+        m_handle = other.m_handle;
+        other.m_handle = nullptr;
+    }
+
+    return *this;
+}
+
+//******************************************************************************************
+// @name                    : ~JobCoroutine
+//
+// @description             : Destroys the frame of the coroutine, whether it is complete or
+//                            suspended.
+//
+// @returns                 : Nothing
+//******************************************************************************************
+JobCoroutine::~JobCoroutine()
+{
+    if (m_handle)
+    {
+        m_handle.destroy();
+    }
+}
+
+//******************************************************************************************
+// @name                    : resume
+//
+// @description             : Runs the coroutine from where it was suspended, till it is
+//                            complete or reaches a checkpoint after its time slice has
+//                            expired. It always runs till at least one checkpoint.
+//
+// @param timeSlice         : Time slice (ns), -1 to run it to completion
+//
+// @returns                 : true if the coroutine is complete,
+//                            false otherwise
+//******************************************************************************************
+bool JobCoroutine::resume(long long timeSlice)
+{
+    if (isDone())
+    {
+        return true;
+    }
+
+    m_handle.promise().setDeadline((timeSlice < 0) ? -1 : getCurrentTimestampInNanoseconds() + timeSlice);
+    m_handle.resume();
+    return m_handle.done();
+}
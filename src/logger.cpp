@@ -0,0 +1,295 @@
+#include "logger.h"
+#include "timing.h"
+#include<chrono>
+
+//---------------------------------------------------------------------------------------------------
+// Globals
+//---------------------------------------------------------------------------------------------------
+const int           LOG_WRITE_INTERVAL          = 5;                  // Max milliseconds a record waits to be written
+const size_t        LOG_BATCH_SIZE              = 64 * 1024;          // Bytes written at a time
+const char*         LOG_LEVEL_NAMES[]           = { "DEBUG", "INFO ", "WARN ", "ERROR" };
+
+//******************************************************************************************
+// @name                    : Logger
+//
+// @description             : Constructor. Starts the writer thread.
+//
+// @returns                 : Nothing
+//******************************************************************************************
+Logger::Logger()
+{
+    m_level = LOG_LEVEL_INFO;
+    m_slots.reset(new logSlot_st[QUEUE_CAPACITY]);
+    for (size_t i = 0; i < QUEUE_CAPACITY; i++)
+    {
+        m_slots[i].sequence.store(i, memory_order_relaxed);
+    }
+
+    m_enqueuePos = 0;
+    m_dequeuePos = 0;
+    m_dropped = 0;
+    m_threadCount = 0;
+    m_tsCreated = getCurrentTimestampInNanoseconds();
+    m_file = stderr;
+    m_stopRequested = false;
+    m_writerThread = thread(&Logger::writeAtInterval, this);
+}
+
+//******************************************************************************************
+// @name                    : ~Logger
+//
+// @description             : Writes all the pending records and stops the writer thread.
+//
+// @returns                 : Nothing
+//******************************************************************************************
+Logger::~Logger()
+{
+    {
+        lock_guard<mutex> lock(m_writerMutex);
+        m_stopRequested = true;
+    }
+
+    m_writerEvent.notify_one();
+    m_writerThread.join();
+
+    if (getDroppedRecords())
+    {
+        fprintf(m_file, "%llu log record(s) dropped\n", getDroppedRecords());
+    }
+
+    if (m_file != stderr)
+    {
+        fclose(m_file);
+    }
+}
+
+//******************************************************************************************
+// @name                    : getInstance
+//
+// @description             : Fetches the logger shared by the whole program.
+//
+// @returns                 : Logger
+//******************************************************************************************
+Logger & Logger::getInstance()
+{
+    static Logger logger;
+    return logger;
+}
+
+//******************************************************************************************
+// @name                    : setOutputFile
+//
+// @description             : Writes the records to a file instead of stderr. Records
+//                            logged so far are written to the previous destination.
+//
+// @param fileName          : Name of the log file
+//
+// @returns                 : true if the file was created,
+//                            false otherwise
+//******************************************************************************************
+bool Logger::setOutputFile(const string & fileName)
+{
+    FILE *file = fopen(fileName.c_str(), "w");
+    if (!file)
+    {
+        printf("ERROR: Unable to create log file '%s'\n", fileName.c_str());
+        return false;
+    }
+
+    flush();
+
+    lock_guard<mutex> lock(m_fileMutex);
+    if (m_file != stderr)
+    {
+        fclose(m_file);
+    }
+
+    m_file = file;
+    return true;
+}
+
+//******************************************************************************************
+// @name                    : log
+//
+// @description             : Queues a record to be written. Never blocks: the record is
+//                            dropped if the queue is full.
+//
+// @param level             : Severity of the record
+// @param format            : printf style format of the message
+//
+// @returns                 : Nothing
+//******************************************************************************************
+void Logger::log(logLevel_en level, const char *format, ...)
+{
+    static thread_local unsigned int threadId = ++m_threadCount;
+
+    // Claim a free slot
+    logSlot_st *slot = nullptr;
+    size_t pos = m_enqueuePos.load(memory_order_relaxed);
+    for (;;)
+    {
+        slot = &m_slots[pos & (QUEUE_CAPACITY - 1)];
+        size_t sequence = slot->sequence.load(memory_order_acquire);
+
+        if (sequence == pos)
+        {
+            if (m_enqueuePos.compare_exchange_weak(pos, pos + 1, memory_order_relaxed))
+                break;
+        }
+        else if (sequence < pos)
+        {
+            // Queue is full
+            m_dropped.fetch_add(1, memory_order_relaxed);
+            return;
+        }
+        else
+        {
+            pos = m_enqueuePos.load(memory_order_relaxed);
+        }
+    }
+
+    slot->record.timestamp = getCurrentTimestampInNanoseconds() - m_tsCreated;
+    slot->record.threadId = threadId;
+    slot->record.level = level;
+
+    va_list args;
+    va_start(args, format);
+    vsnprintf(slot->record.message, sizeof(slot->record.message), format, args);
+    va_end(args);
+
+    // Hand the slot over to the writer
+    slot->sequence.store(pos + 1, memory_order_release);
+}
+
+//******************************************************************************************
+// @name                    : flush
+//
+// @description             : Waits till all the records logged so far are written.
+//
+// @returns                 : Nothing
+//******************************************************************************************
+void Logger::flush()
+{
+    size_t target = m_enqueuePos.load(memory_order_acquire);
+
+    while (m_dequeuePos.load(memory_order_acquire) < target)
+    {
+        m_writerEvent.notify_one();
+        this_thread::sleep_for(chrono::milliseconds(1));
+    }
+}
+
+//******************************************************************************************
+// @name                    : writeBatch
+//
+// @description             : Writes all the records queued so far, formatted into as few
+//                            writes as possible. Called only from the writer thread.
+//
+// @returns                 : true if any record was written,
+//                            false otherwise
+//******************************************************************************************
+bool Logger::writeBatch()
+{
+    static char batch[LOG_BATCH_SIZE];
+    size_t used = 0;
+    size_t pos = m_dequeuePos.load(memory_order_relaxed);
+    size_t start = pos;
+
+    lock_guard<mutex> lock(m_fileMutex);
+
+    for (;;)
+    {
+        logSlot_st *slot = &m_slots[pos & (QUEUE_CAPACITY - 1)];
+        if (slot->sequence.load(memory_order_acquire) != pos + 1)
+        {
+            break;
+        }
+
+        // Make room for the longest possible line
+        if (LOG_BATCH_SIZE - used < LOG_MESSAGE_SIZE + 64)
+        {
+            fwrite(batch, 1, used, m_file);
+            used = 0;
+        }
+
+        const logRecord_st & record = slot->record;
+        int length = snprintf(batch + used, LOG_BATCH_SIZE - used, "[%12.6lf] %s [T%u] %s\n",
+                              record.timestamp / (double)NANOSECONDS_PER_SECOND,
+                              LOG_LEVEL_NAMES[record.level < LOG_LEVEL_NONE ? record.level : (unsigned int)LOG_LEVEL_ERROR],
+                              record.threadId, record.message);
+        if (length > 0)
+        {
+            used += ((size_t)length < LOG_BATCH_SIZE - used) ? (size_t)length : LOG_BATCH_SIZE - used - 1;
+        }
+
+        // Free the slot for the next round of the queue
+        slot->sequence.store(pos + QUEUE_CAPACITY, memory_order_release);
+        pos++;
+    }
+
+    if (pos == start)
+    {
+        return false;
+    }
+
+    fwrite(batch, 1, used, m_file);
+    fflush(m_file);
+    m_dequeuePos.store(pos, memory_order_release);
+    return true;
+}
+
+//******************************************************************************************
+// @name                    : writeAtInterval
+//
+// @description             : Writer thread. Keeps writing the queued records till the
+//                            logger is destroyed, and then writes the remaining ones.
+//
+// @returns                 : Nothing
+//******************************************************************************************
+void Logger::writeAtInterval()
+{
+    unique_lock<mutex> lock(m_writerMutex);
+
+    while (!m_stopRequested)
+    {
+        lock.unlock();
+        bool written = writeBatch();
+        lock.lock();
+
+        if (!written)
+        {
+            m_writerEvent.wait_for(lock, chrono::milliseconds(LOG_WRITE_INTERVAL));
+        }
+    }
+
+    lock.unlock();
+    while (writeBatch())
+    {
+        // Write everything logged till now
+    }
+}
+
+//******************************************************************************************
+// @name                    : parseLevel
+//
+// @description             : Converts the name of a level (debug, info, warning, error or
+//                            none) to the level.
+//
+// @param name              : Name of the level
+// @param level             : Level
+//
+// @returns                 : true if the name is valid,
+//                            false otherwise
+//******************************************************************************************
+bool Logger::parseLevel(const string & name, logLevel_en & level)
+{
+    if (name == "debug")            level = LOG_LEVEL_DEBUG;
+    else if (name == "info")        level = LOG_LEVEL_INFO;
+    else if (name == "warning")     level = LOG_LEVEL_WARNING;
+    else if (name == "error")       level = LOG_LEVEL_ERROR;
+    else if (name == "none")        level = LOG_LEVEL_NONE;
+    else
+        return false;
+
+    return true;
+}
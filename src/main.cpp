@@ -1,88 +1,35 @@
 #include<iostream>
 #include<stdio.h>
 #include<thread>
-#include <windows.h>
 
-#include "fcfs.h"
-#include "sjf.h"
-#include "priority.h"
-#include "priority_ageing.h"
-#include "round_robin.h"
+#include "cluster.h"
+#include "comparison_runner.h"
+#include "config.h"
+#include "event_trace.h"
 #include "job.h"
+#include "job_batcher.h"
+#include "logger.h"
+#include "parameter_sweep.h"
 #include "process_scheduler.h"
+#include "scheduler_registry.h"
+#include "stats_reporter.h"
+#include "timing.h"
+#include "workload.h"
 
 using namespace std;
 
 //---------------------------------------------------------------------------------------------------
-// Enum
+// Exit status
 //---------------------------------------------------------------------------------------------------
-typedef enum
-{
-    SCHEDULING_FCFS,
-    SCHEDULING_PRIORITY,
-    SCHEDULING_PRIORITY_WITH_AGEING,
-    SCHEDULING_SJF,
-    SCHEDULING_ROUND_ROBIN,
-    SCHEDULING_MULTI_LEVEL_FEEDBACK,
-
-    // This should be last
-    SCHEDULING_MAX
-}schedulingAlgorithm_en;
-
-
-//---------------------------------------------------------------------------------------------------
-// CONFIGURATIONS - Alter to vary simulation results
-//---------------------------------------------------------------------------------------------------
-
-// Simulate all the algorithms.
-const bool SIMULATE_ALL_SCHEDULING_ALGORITHMS = true;
-
-// Scheduling algorithm to use. Refer to enum 'schedulingAlgorithm_en' above.
-const int SCHEDULING_ALGORITHM = SCHEDULING_ROUND_ROBIN;
-
-// Time quantum (in milliseconds) to be used. This is used in case of Round-Robin scheduling
-// algorithm. This is the maximum time window a job will be allocated for execution.
-// If the job completes in this duration, then the next job is processed. Otherwise,
-// the job is paused and its state is saved. The scheduler will process other jobs for this
-// time quantum again and return back to process this job again.
-const long long TIME_QUANTUM = MAX_TIME_REQUIRED / 2;
-
-// Number of jobs for which simulation has to be done.
-// use '-1' to create jobs continuously.
-const long int JOBS_TO_CREATE = 1000;
-
-// This parameter identifies the jobs whose response time period exceeds the 
-// permissible value in comparison to its time required for completion. So for
-// instance if a job requires 200ms. to complete and if the response time
-// threshold is 2, then response time threshold for this job is 400ms.
-const int RESPONSE_TIME_THRESHOLD = JOBS_TO_CREATE;
-
-// Show details of job running status
-const bool SHOW_JOB_STATUS = true;
-
-// Use random sleep duration for creation thread
-const bool USE_RANDOM_JOB_CREATION_SLEEP = false;
-
-// Seconds to wait before displaying statistics
-// Use -1 to display the stats only at the end of simulation.
-// Be careful though, if the simulation is run without a finite
-// number of jobs, no stats would be shown.
-const int STATS_DISPLAY_INTERVAL = -1;
-
-// Max time duration (ms) before proceeding to 
-// create another job. This means that before creating
-// a new job, the system will wait for any value in b/w
-// 0 to JOB_CREATION_SLEEP_MAX-1 seconds.
-const int JOB_CREATION_SLEEP_MAX = 1000;
-
-// Milliseconds before proceeding to create another job
-const int JOB_CREATION_SLEEP_CONST = 1000;
-
+const int EXIT_STATUS_SUCCESS             = 0;    // All the simulations were executed
+const int EXIT_STATUS_SIMULATION_FAILED   = 1;    // A simulation could not be executed
+const int EXIT_STATUS_INVALID_CONFIG      = 2;    // Invalid command line or config file
 
 //---------------------------------------------------------------------------------------------------
 // Globals
 //---------------------------------------------------------------------------------------------------
 unsigned long long g_totalJobs = 0;
+WorkerPool *g_workerPool = nullptr;              // Runs the payloads of jobs in real execution mode
 
 //---------------------------------------------------------------------------------------------------
 // Functions
@@ -93,13 +40,48 @@ unsigned long long g_totalJobs = 0;
 //
 // @description             : Create a a job with a jobID and random priority.
 //
+// @param config            : Configuration of the simulation
+//
 // @returns                 : Pointer to created job
 //********************************************************************************************
-Job* createJob()
+Job* createJob(const simulationConfig_st & config)
 {
     static RandomGenerator rng;
-    Job *job = new Job(SHOW_JOB_STATUS, ++g_totalJobs, 
-                       rng.generateRandomNumber(JOB_PRIORITY_LOWEST), RESPONSE_TIME_THRESHOLD);
+    Job *job = new Job(config.showJobStatus, ++g_totalJobs, 
+                       rng.generateRandomNumber(JOB_PRIORITY_LOWEST), config.responseTimeThreshold);
+
+    if (config.ioJobRatio > 0)
+    {
+        static RandomGenerator ioRng;
+        ioProfile_st profile;
+        jobSpec_st spec;
+
+        getIoProfile(config, profile);
+        Workload::generateIoBursts(spec, profile, ioRng);
+        job->setIoBursts(spec.ioBursts, spec.ioBurstTime, spec.ioDevice);
+    }
+
+    if (config.parallelJobRatio > 0)
+    {
+        static RandomGenerator widthRng;
+        parallelProfile_st profile;
+        jobSpec_st spec;
+
+        getParallelProfile(config, profile);
+        Workload::generateWidth(spec, profile, widthRng);
+        job->setWidth(spec.width);
+    }
+
+    if (config.tenantGroups.size())
+    {
+        static RandomGenerator tenantRng;
+        tenantProfile_st profile;
+        jobSpec_st spec;
+
+        getTenantProfile(config, profile);
+        Workload::generateTenantGroup(spec, profile, tenantRng);
+        job->setTenantGroup(spec.tenantGroup);
+    }
     
     return job;
 }
@@ -111,39 +93,46 @@ Job* createJob()
 // @description             : This thread is spawned from main(). Creates jobs and adds it to
 //                            the ready queue of the scheduler.
 //
+// @param config            : Configuration of the simulation
+//
 // @returns                 : Nothing
 //********************************************************************************************
-void jobCreationThread(ProcessScheduler *scheduler)
+void jobCreationThread(ProcessScheduler *scheduler, const simulationConfig_st & config)
 {
     static RandomGenerator rng;
     long int i = 0;
 
-    while (i < JOBS_TO_CREATE)
+    // Jobs shed by admission control are deleted by the batcher
+    JobBatcher batcher(scheduler, config.submitBatchSize, config.submitBatchWindow);
+
+    while (i < config.jobsToCreate)
     {
-        Job *j = createJob();
-        scheduler->addToReadyQueue(j);
+        Job *j = createJob(config);
+        batcher.add(j);
         //j->displayJobDetails();
 
-        if (USE_RANDOM_JOB_CREATION_SLEEP)
+        if (config.useRandomJobCreationSleep)
         {
             // Wait for some random time duration before proceeding to
             // create another job
-            Sleep(rng.generateRandomNumber(JOB_CREATION_SLEEP_MAX));
+            batcher.waitFor(rng.generateRandomNumber(config.jobCreationSleepMax) * NANOSECONDS_PER_MILLISECOND);
         }
         else
         {
-            Sleep(rng.generateRandomNumber(JOB_CREATION_SLEEP_CONST));
+            batcher.waitFor(rng.generateRandomNumber(config.jobCreationSleepConst) * NANOSECONDS_PER_MILLISECOND);
         }
 
         // Do this only if a finite value is specified in configurations
-        if (JOBS_TO_CREATE >= 0)
+        if (config.jobsToCreate >= 0)
         {
             i++;
         }
     } // simulation complete
 
-    // Wait till all the created jobs are complete
-    while (scheduler->getCompletedJobs() < JOBS_TO_CREATE)
+    batcher.flush();
+
+    // Wait till all the created jobs are complete or shed
+    while (scheduler->getCompletedJobs() + scheduler->getShedJobs() < (size_t)config.jobsToCreate)
     {
         // This sleep is very important. As it allows the thread
         // to stop processing while loop continuosly thereby offering
@@ -169,45 +158,176 @@ void jobCreationThread(ProcessScheduler *scheduler)
 }
 
 //******************************************************************************************
-// @name                    : getScheduler
+// @name                    : generateWorkload
 //
-// @description             : Retrieves scheduler object on the basis of algorithm
+// @description             : Generates the jobs to be simulated, as per the configuration.
 //
-// @param algo_index        : algorithm index
+// @param config            : Configuration of the simulation
+// @param workload          : Generated workload
 //
-// @returns                 : Scheduler object 
+// @returns                 : Nothing
 //********************************************************************************************
-ProcessScheduler* getScheduler(schedulingAlgorithm_en algo_index)
+void generateWorkload(const simulationConfig_st & config, Workload & workload)
 {
-    ProcessScheduler *scheduler = nullptr;
+    int creationSleepMax = config.useRandomJobCreationSleep ? config.jobCreationSleepMax : config.jobCreationSleepConst;
+    ioProfile_st profile;
+    parallelProfile_st parallelProfile;
+    tenantProfile_st tenantProfile;
+
+    getIoProfile(config, profile);
+    workload.setIoProfile(profile);
+    getParallelProfile(config, parallelProfile);
+    workload.setParallelProfile(parallelProfile);
+    getTenantProfile(config, tenantProfile);
+    workload.setTenantProfile(tenantProfile);
+
+    if (config.seed)
+    {
+        RandomGenerator rng(config.seed);
+        workload.generate(config.jobsToCreate, creationSleepMax, rng);
+    }
+    else
+    {
+        workload.generate(config.jobsToCreate, creationSleepMax);
+    }
+}
 
-    switch (algo_index)
-    {
-    case SCHEDULING_FCFS:
-        scheduler = new FirstComeFirstServed("First Come First Served");
-        break;
-    case SCHEDULING_PRIORITY:
-        scheduler = new PriorityScheduling("Priority Scheduling");
-        break;
-    case SCHEDULING_PRIORITY_WITH_AGEING:
-        scheduler = new PriorityAgeingScheduling("Priority Scheduling with Ageing");
-        break;
-    case SCHEDULING_SJF:
-        scheduler = new ShortestJobFirst("Shortest Job First");
-        break;
-    case SCHEDULING_ROUND_ROBIN:
-        scheduler = new RoundRobin("Round Robin", TIME_QUANTUM);
-        break;
-    case SCHEDULING_MULTI_LEVEL_FEEDBACK:
-        printf("SCHEDULING_MULTI_LEVEL_FEEDBACK: Not implemented yet\n");
-        //scheduler = new MultiLevelFeedback("Multi Level Feedback");
-        break;
-    default:
-        printf("ERROR: Invalid Scheduling algorithm specified!\n");
-        return false;
+//******************************************************************************************
+// @name                    : doParallelSimulation
+//
+// @description             : Runs the simulation of all the scheduling algorithms at the
+//                            same time, on a workload shared by all of them.
+//
+// @param config            : Configuration of the simulation
+//
+// @returns                 : Number of simulations executed
+//********************************************************************************************
+int doParallelSimulation(const simulationConfig_st & config)
+{
+    Workload workload;
+    generateWorkload(config, workload);
+
+    ComparisonRunner runner(workload, config.showJobStatus, config.responseTimeThreshold, config.useVirtualClock);
+    runner.setSubmitBatching(config.submitBatchSize, config.submitBatchWindow);
+    vector<string> names = SchedulerRegistry::getInstance().getSchedulerNames();
+    for (auto it = names.begin(); it != names.end(); it++)
+    {
+        ProcessScheduler *scheduler = SchedulerRegistry::getInstance().createScheduler(*it, config);
+        if (scheduler)
+        {
+            scheduler->setDisplayInterval(config.statsDisplayInterval);
+            scheduler->setWorkerPool(g_workerPool);
+            runner.addScheduler(scheduler);
+        }
+    }
+
+    printf("\nRunning %zu simulation(s) in parallel for %zu jobs...\n", runner.getSchedulerCount(), workload.size());
+    if (!runner.run())
+    {
+        return 0;
+    }
+
+    runner.displayResults();
+    if (config.statsSeriesFile.size())
+    {
+        runner.saveStatsSeries(config.statsSeriesFile);
+    }
+
+    return (int)runner.getResults().size();
+}
+
+//******************************************************************************************
+// @name                    : doClusterSimulation
+//
+// @description             : Simulates clusters of nodes running the scheduling algorithm,
+//                            or each of the algorithms in turn, for each load balancing
+//                            policy, on a workload shared by all of them.
+//
+// @param config            : Configuration of the simulation
+//
+// @returns                 : Number of simulations executed
+//********************************************************************************************
+int doClusterSimulation(const simulationConfig_st & config)
+{
+    SchedulerRegistry & registry = SchedulerRegistry::getInstance();
+    vector<string> names = config.simulateAll ? registry.getSchedulerNames() : vector<string>{ config.schedulingAlgorithm };
+    vector<clusterResult_st> results;
+    clusterSetup_st setup;
+    Workload workload;
+
+    if (config.jobsToCreate < 0)
+    {
+        printf("ERROR: Virtual clock needs a finite number of jobs!\n");
+        return 0;
+    }
+
+    getClusterSetup(config, setup);
+    generateWorkload(config, workload);
+
+    for (auto it = names.begin(); it != names.end(); it++)
+    {
+        for (int balancing = 0; balancing < LOAD_BALANCING_MAX; balancing++)
+        {
+            if (config.loadBalancing != LOAD_BALANCING_MAX && config.loadBalancing != balancing)
+            {
+                continue;
+            }
+
+            setup.balancing = (loadBalancing_en)balancing;
+            Cluster cluster(workload, setup, config.showJobStatus, config.responseTimeThreshold);
+            for (unsigned int node = 0; node < setup.nodes; node++)
+            {
+                ProcessScheduler *scheduler = registry.createScheduler(*it, config);
+                if (!scheduler)
+                {
+                    return 0;
+                }
+
+                cluster.addNode(scheduler);
+            }
+
+            printf("\nRunning [ %s ] on %u nodes with %s load balancing for %zu jobs...\n",
+                   it->c_str(), setup.nodes, Cluster::getLoadBalancingName(setup.balancing), workload.size());
+            if (!cluster.run())
+            {
+                return 0;
+            }
+
+            results.push_back(clusterResult_st());
+            cluster.getResult(results.back());
+        }
     }
 
-    return scheduler;
+    Cluster::displayResults(results);
+    return (int)results.size();
+}
+
+//******************************************************************************************
+// @name                    : doParameterSweep
+//
+// @description             : Simulates all the combinations of the sweep parameters for all
+//                            the scheduling algorithms.
+//
+// @param config            : Configuration of the simulation
+//
+// @returns                 : Number of simulations executed
+//********************************************************************************************
+int doParameterSweep(const simulationConfig_st & config)
+{
+    ParameterSweep sweep(config, SchedulerRegistry::getInstance().getSchedulerNames());
+    printf("Sweeping %zu configuration(s) of %ld jobs each...\n", sweep.getPointCount(), config.sweepJobsPerRun);
+    if (!sweep.run(config.threads))
+    {
+        return 0;
+    }
+
+    if (!sweep.writeResults(config.sweepResultsFile))
+    {
+        return 0;
+    }
+
+    sweep.displayBestResults();
+    return (int)sweep.getPointCount();
 }
 
 //******************************************************************************************
@@ -216,11 +336,12 @@ ProcessScheduler* getScheduler(schedulingAlgorithm_en algo_index)
 // @description             : Runs the simulation
 //
 // @param scheduler         : scheduler object
+// @param config            : Configuration of the simulation
 //
 // @returns                 : true if simulation executed successfully,
 //                            false otherwise
 //********************************************************************************************
-bool doSimulation(ProcessScheduler *scheduler, int simulationIndex)
+bool doSimulation(ProcessScheduler *scheduler, int simulationIndex, const simulationConfig_st & config)
 {
     if (!scheduler)
     {
@@ -228,6 +349,13 @@ bool doSimulation(ProcessScheduler *scheduler, int simulationIndex)
         return false;
     }
 
+    if (config.useVirtualClock && config.jobsToCreate < 0)
+    {
+        printf("ERROR: Virtual clock needs a finite number of jobs!\n");
+        delete scheduler;
+        return false;
+    }
+
     printf("\n");
     printf("+------------------------------------------------------------------------+\n");
     printf("| SIMULATION #%d: %s\n", simulationIndex+1, scheduler->getSchedulerName().c_str());
@@ -238,29 +366,36 @@ bool doSimulation(ProcessScheduler *scheduler, int simulationIndex)
     printf("Started: %s\n", startTimeStr);
 
     // Display jobs being created for this simulation
-    if (JOBS_TO_CREATE >= 0)
+    if (config.jobsToCreate >= 0)
     {
-        printf("Running simulation for          : %ld jobs\n", JOBS_TO_CREATE);
+        printf("Running simulation for          : %ld jobs\n", config.jobsToCreate);
     }
     else
     {
         printf("Running simulation jobs being created continuously\n");
     }
 
-    printf("Using Response Time threshold   : %d\n", RESPONSE_TIME_THRESHOLD);
+    printf("Using Response Time threshold   : %d\n", config.responseTimeThreshold);
 
-    if (USE_RANDOM_JOB_CREATION_SLEEP)
+    if (config.useRandomJobCreationSleep)
     {
         printf("Using random job creation rate\n");
     }
     else
     {
-        printf("Waiting for %f second(s) before creating a new job\n", (float)JOB_CREATION_SLEEP_CONST / 1000);
+        printf("Waiting for %f second(s) before creating a new job\n", (float)config.jobCreationSleepConst / 1000);
+    }
+
+    if (config.payloadKernel != PAYLOAD_KERNEL_NONE)
+    {
+        printf("Running real payloads on %u worker thread(s)\n", g_workerPool ? g_workerPool->getWorkerCount() : 0);
+        scheduler->setWorkerPool(g_workerPool);
     }
 
-    // Set stats display interval
-    scheduler->setDisplayInterval(STATS_DISPLAY_INTERVAL);
-    if (STATS_DISPLAY_INTERVAL >= 0)
+    // Set stats display interval. Stats are displayed from a reporter thread of their own.
+    scheduler->setDisplayInterval(config.statsDisplayInterval);
+    StatsReporter reporter(scheduler, scheduler->getDisplayInterval());
+    if (config.statsDisplayInterval >= 0)
     {
         printf("Using stats display interval: %d second(s)\n", scheduler->getDisplayInterval());
     }
@@ -270,17 +405,57 @@ bool doSimulation(ProcessScheduler *scheduler, int simulationIndex)
         printf("Running simulation...\n\n");
     }
 
-    // Spawn a thread to create jobs randomly
-    thread jobCreationThreadId = thread(jobCreationThread, scheduler);
+    if (config.useVirtualClock)
+    {
+        // Jobs are released by the scheduler itself as its virtual time goes by
+        VirtualClock clock;
+        Workload workload;
+        generateWorkload(config, workload);
+        WorkloadFeeder feeder(workload, config.showJobStatus, config.responseTimeThreshold, &clock);
+
+        scheduler->setClock(&clock);
+        scheduler->setWorkloadFeeder(&feeder);
+        if ((config.checkpointFile.size() && !scheduler->setCheckpointInterval(config.checkpointFile, config.checkpointInterval)) ||
+            (config.restoreCheckpointFile.size() && !scheduler->restoreCheckpoint(config.restoreCheckpointFile)))
+        {
+            delete scheduler;
+            return false;
+        }
 
-    // Start executing the jobs
-    scheduler->ProcessJobs();
+        reporter.start();
+        scheduler->runOnCpus();
+        reporter.stop();
+        scheduler->displayStats();
+        scheduler->displayTenantStats();
+        if (config.statsSeriesFile.size() && scheduler->saveStatsSeries(config.statsSeriesFile, simulationIndex > 0))
+        {
+            printf("Stats series written to %s\n", config.statsSeriesFile.c_str());
+        }
 
-    // Wait for Job creation thread to complete.
-    jobCreationThreadId.join();
+        // Destroy the scheduler while its clock is still around
+        delete scheduler;
+    }
+    else
+    {
+        // Spawn a thread to create jobs randomly
+        thread jobCreationThreadId = thread(jobCreationThread, scheduler, cref(config));
+
+        // Start executing the jobs
+        reporter.start();
+        scheduler->runOnCpus();
+
+        // Wait for Job creation thread to complete.
+        jobCreationThreadId.join();
+        reporter.stop();
+        scheduler->displayTenantStats();
+        if (config.statsSeriesFile.size() && scheduler->saveStatsSeries(config.statsSeriesFile, simulationIndex > 0))
+        {
+            printf("Stats series written to %s\n", config.statsSeriesFile.c_str());
+        }
 
-    // Destroy the scheduler
-    delete scheduler;
+        // Destroy the scheduler
+        delete scheduler;
+    }
 
     time_t endTime = time(&endTime);
     char *endTimeStr = ctime(&endTime);
@@ -308,38 +483,163 @@ Jobs with an ID and a random priority are continuously created by an RNG (Random
 The job creator is a separate thread. This is done so as to simulate scenarios where pre-emption is
 required.
 
-The scheduler is then started with ProcessJobs() API. It will keep on processing the jobs present
-in the pending job pool list.
+The scheduler is then started with runOnCpus(), which runs the ProcessJobs() API on each of its
+CPUs. It will keep on processing the jobs present in the pending job pool list.
 -----------------------------------------------------------------------------------------------------*/
-int main()
+int main(int argc, char *argv[])
 {
+    SchedulerRegistry & registry = SchedulerRegistry::getInstance();
+    simulationConfig_st config;
     ProcessScheduler *scheduler = nullptr;
     int totalSimulations = 0;
-    bool simulationSuccessful = false;
+    int failedSimulations = 0;
+    bool showHelp = false;
+
+    // Defaults, overridden by config files and the command line
+    setDefaultConfig(config);
+    if (!parseCommandLine(argc, argv, config, showHelp))
+    {
+        printf("Use --help for usage.\n");
+        return EXIT_STATUS_INVALID_CONFIG;
+    }
+
+    if (showHelp)
+    {
+        displayUsage(argv[0]);
+        registry.displaySchedulers();
+        return EXIT_STATUS_SUCCESS;
+    }
+
+    if (!config.simulateAll && !config.runParameterSweep && !registry.isRegistered(config.schedulingAlgorithm))
+    {
+        printf("ERROR: Invalid Scheduling algorithm '%s' specified!\n", config.schedulingAlgorithm.c_str());
+        registry.displaySchedulers();
+        return EXIT_STATUS_INVALID_CONFIG;
+    }
+
+    Logger::getInstance().setLevel(config.logLevel);
+    if (config.logFile.size() && !Logger::getInstance().setOutputFile(config.logFile))
+    {
+        return EXIT_STATUS_INVALID_CONFIG;
+    }
+
+    if (!setSimdLevel(config.simdLevel))
+    {
+        printf("ERROR: This CPU does not support the %s kernels (at most %s)!\n", getSimdLevelName(config.simdLevel), getSimdLevelName(getSupportedSimdLevel()));
+        return EXIT_STATUS_INVALID_CONFIG;
+    }
+
+    if (config.chromeTraceFile.size() && config.traceFile.empty())
+    {
+        printf("ERROR: Chrome trace needs a trace file!\n");
+        return EXIT_STATUS_INVALID_CONFIG;
+    }
+
+    // Checkpoints capture a scheduler driven by a workload feeder. Each sequential simulation
+    // can be resumed from the same checkpoint, but only a single one may save checkpoints.
+    if ((config.checkpointFile.size() || config.restoreCheckpointFile.size()) &&
+        (!config.useVirtualClock || config.runParameterSweep || (config.simulateAll && config.simulateInParallel) ||
+         config.payloadKernel != PAYLOAD_KERNEL_NONE || config.cpus > 1))
+    {
+        printf("ERROR: Checkpoints need a virtual clock, a single CPU, no payloads, and simulations run one at a time!\n");
+        return EXIT_STATUS_INVALID_CONFIG;
+    }
+
+    if (config.cpus > 1 && (!config.useVirtualClock || config.payloadKernel != PAYLOAD_KERNEL_NONE))
+    {
+        printf("ERROR: Several CPUs need a virtual clock and no payloads!\n");
+        return EXIT_STATUS_INVALID_CONFIG;
+    }
+
+    if (config.clusterNodes > 0 &&
+        (!config.useVirtualClock || config.runParameterSweep || config.cpus > 1 || config.payloadKernel != PAYLOAD_KERNEL_NONE ||
+         config.checkpointFile.size() || config.restoreCheckpointFile.size()))
+    {
+        printf("ERROR: Clusters need a virtual clock, single CPU nodes, no payloads and no checkpoints, and can't be swept!\n");
+        return EXIT_STATUS_INVALID_CONFIG;
+    }
+
+    if (config.parallelJobRatio > 0 && config.jobWidthMax > config.cpus)
+    {
+        printf("ERROR: Parallel jobs can't be wider than the CPUs (job_width_max <= cpus)!\n");
+        return EXIT_STATUS_INVALID_CONFIG;
+    }
+
+    if (config.checkpointFile.size() && config.simulateAll)
+    {
+        printf("ERROR: Checkpoints can only be saved by a single simulation (simulate_all = false)!\n");
+        return EXIT_STATUS_INVALID_CONFIG;
+    }
 
-    // Default - the one specified by configuration
-    schedulingAlgorithm_en schedulingAlgorithm = static_cast<schedulingAlgorithm_en>(SCHEDULING_ALGORITHM);
+    if (config.statsSeriesFile.size() && (config.statsSampleInterval == 0 || config.runParameterSweep || config.clusterNodes > 0))
+    {
+        printf("ERROR: The stats series needs samples (stats_sample_interval > 0), and is not saved by sweeps and clusters!\n");
+        return EXIT_STATUS_INVALID_CONFIG;
+    }
+
+    if (config.traceFile.size() && !EventTracer::getInstance().start(config.traceFile))
+    {
+        return EXIT_STATUS_INVALID_CONFIG;
+    }
 
-    if (SIMULATE_ALL_SCHEDULING_ALGORITHMS == true)
+    if (config.payloadKernel != PAYLOAD_KERNEL_NONE && config.workers > 0 && !config.runParameterSweep)
+    {
+        g_workerPool = new WorkerPool(config.workers);
+    }
+
+    if (config.runParameterSweep)
+    {
+        printf("Running parameter sweep...\n");
+        totalSimulations = doParameterSweep(config);
+        if (totalSimulations == 0)
+            failedSimulations++;
+    }
+    else if (config.clusterNodes > 0)
+    {
+        printf("Simulating clusters of %u nodes...\n", config.clusterNodes);
+        totalSimulations = doClusterSimulation(config);
+        if (totalSimulations == 0)
+            failedSimulations++;
+    }
+    else if (config.simulateAll && config.simulateInParallel && config.jobsToCreate >= 0)
+    {
+        printf("Simulating all the available scheduling algorithms in parallel...\n");
+        totalSimulations = doParallelSimulation(config);
+        if (totalSimulations == 0)
+            failedSimulations++;
+    }
+    else if (config.simulateAll)
     {
         printf("Simulating all the available scheduling algorithms...\n");
-        for (int algo_index = 0; algo_index < SCHEDULING_MAX; algo_index++)
+        vector<string> names = registry.getSchedulerNames();
+        for (auto it = names.begin(); it != names.end(); it++)
         {
-            scheduler = getScheduler(static_cast<schedulingAlgorithm_en>(algo_index));
-            simulationSuccessful = doSimulation(scheduler, totalSimulations);
-            if (simulationSuccessful)
+            scheduler = registry.createScheduler(*it, config);
+            if (doSimulation(scheduler, totalSimulations, config))
                 totalSimulations++;
+            else
+                failedSimulations++;
         }
     }
     else
     {
-        scheduler = getScheduler(schedulingAlgorithm);
-        simulationSuccessful = doSimulation(scheduler, totalSimulations);
-        if (simulationSuccessful)
+        scheduler = registry.createScheduler(config.schedulingAlgorithm, config);
+        if (doSimulation(scheduler, totalSimulations, config))
             totalSimulations++;
+        else
+            failedSimulations++;
+    }
+
+    delete g_workerPool;
+
+    if (config.traceFile.size())
+    {
+        EventTracer::getInstance().stop();
+        if (config.chromeTraceFile.size() && !EventTracer::exportChromeTrace(config.traceFile, config.chromeTraceFile))
+            failedSimulations++;
     }
     
+    Logger::getInstance().flush();
     printf("\n**** Completed %d simulation(s)\n", totalSimulations);
-    getchar();
-    return 0;
-}
\ No newline at end of file
+    return (failedSimulations == 0) ? EXIT_STATUS_SUCCESS : EXIT_STATUS_SIMULATION_FAILED;
+}
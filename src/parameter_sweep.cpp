@@ -0,0 +1,313 @@
+#include "parameter_sweep.h"
+#include "scheduler_registry.h"
+#include<stdio.h>
+#include<thread>
+
+//******************************************************************************************
+// @name                    : ParameterSweep
+//
+// @description             : Constructor. Generates the workloads and all the combinations
+//                            of the parameters.
+//
+// @param config            : Values to be tried for each parameter, from the sweep_*
+//                            configurations. All the other configurations are used as is.
+// @param algorithms        : Names of the schedulers to simulate
+//
+// @returns                 : Nothing
+//******************************************************************************************
+ParameterSweep::ParameterSweep(const simulationConfig_st & config, const vector<string> & algorithms)
+{
+    m_config = config;
+    m_algorithms = algorithms;
+    m_nextPoint = 0;
+    m_wallTime = 0;
+
+    generateWorkloads();
+    buildPoints();
+}
+
+//******************************************************************************************
+// @name                    : ~ParameterSweep
+//
+// @description             : Destructor
+//
+// @returns                 : Nothing
+//******************************************************************************************
+ParameterSweep::~ParameterSweep()
+{
+
+}
+
+//******************************************************************************************
+// @name                    : generateWorkloads
+//
+// @description             : Generates a workload for each load factor and seed. Time required
+//                            by a job is uniform in [0, MAX_TIME_REQUIRED), and so is the time
+//                            between two arrivals in [0, creationSleepMax). So for a load
+//                            factor L, arrivals are at most MAX_TIME_REQUIRED / L ms apart.
+//
+// @returns                 : Nothing
+//******************************************************************************************
+void ParameterSweep::generateWorkloads()
+{
+    m_workloads.resize(m_config.sweepLoadFactors.size() * m_config.sweepSeeds.size());
+    ioProfile_st profile;
+    parallelProfile_st parallelProfile;
+    tenantProfile_st tenantProfile;
+
+    getIoProfile(m_config, profile);
+    getParallelProfile(m_config, parallelProfile);
+    getTenantProfile(m_config, tenantProfile);
+
+    for (size_t l = 0; l < m_config.sweepLoadFactors.size(); l++)
+    {
+        for (size_t s = 0; s < m_config.sweepSeeds.size(); s++)
+        {
+            RandomGenerator rng(m_config.sweepSeeds[s]);
+            int creationSleepMax = (int)(MAX_TIME_REQUIRED / m_config.sweepLoadFactors[l]);
+            m_workloads[l * m_config.sweepSeeds.size() + s].setIoProfile(profile);
+            m_workloads[l * m_config.sweepSeeds.size() + s].setParallelProfile(parallelProfile);
+            m_workloads[l * m_config.sweepSeeds.size() + s].setTenantProfile(tenantProfile);
+            m_workloads[l * m_config.sweepSeeds.size() + s].generate(m_config.sweepJobsPerRun, creationSleepMax, rng);
+        }
+    }
+}
+
+//******************************************************************************************
+// @name                    : buildPoints
+//
+// @description             : Builds the cartesian product of all the parameters.
+//
+// @returns                 : Nothing
+//******************************************************************************************
+void ParameterSweep::buildPoints()
+{
+    m_points.clear();
+
+    for (size_t l = 0; l < m_config.sweepLoadFactors.size(); l++)
+    for (size_t s = 0; s < m_config.sweepSeeds.size(); s++)
+    for (size_t a = 0; a < m_algorithms.size(); a++)
+    for (size_t q = 0; q < m_config.sweepTimeQuanta.size(); q++)
+    for (size_t r = 0; r < m_config.sweepResponseTimeThresholds.size(); r++)
+    for (size_t g = 0; g < m_config.sweepAgeingRates.size(); g++)
+    {
+        sweepPoint_st point;
+        point.algorithm = m_algorithms[a];
+        point.timeQuantum = m_config.sweepTimeQuanta[q];
+        point.responseTimeThreshold = m_config.sweepResponseTimeThresholds[r];
+        point.loadFactor = m_config.sweepLoadFactors[l];
+        point.ageingRate = m_config.sweepAgeingRates[g];
+        point.seed = m_config.sweepSeeds[s];
+        point.workloadIndex = l * m_config.sweepSeeds.size() + s;
+        point.simulated = false;
+        m_points.push_back(point);
+    }
+}
+
+//******************************************************************************************
+// @name                    : simulatePoint
+//
+// @description             : Simulates one combination of the parameters on a virtual clock.
+//                            The whole simulation runs on the calling thread.
+//
+// @param point             : Combination to be simulated
+//
+// @returns                 : Nothing
+//******************************************************************************************
+void ParameterSweep::simulatePoint(sweepPoint_st & point)
+{
+    long long tsStart = getCurrentTimestampInMilliseconds();
+
+    simulationConfig_st config = m_config;
+    config.timeQuantum = point.timeQuantum;
+    config.ageingRate = point.ageingRate;
+    config.responseTimeThreshold = point.responseTimeThreshold;
+
+    ProcessScheduler *scheduler = SchedulerRegistry::getInstance().createScheduler(point.algorithm, config);
+    if (!scheduler)
+    {
+        return;
+    }
+
+    VirtualClock clock;
+    WorkloadFeeder feeder(m_workloads[point.workloadIndex], false, point.responseTimeThreshold, &clock);
+
+    scheduler->setClock(&clock);
+    scheduler->setWorkloadFeeder(&feeder);
+    scheduler->setDisplayInterval(-1);
+    scheduler->setPhaseTimersEnabled(false);
+    scheduler->setPayloadKernel(PAYLOAD_KERNEL_NONE, 0, false);
+    scheduler->runOnCpus();
+
+    scheduler->getSimulationResult(point.result);
+    point.result.wallTime = getCurrentTimestampInMilliseconds() - tsStart;
+    point.simulated = true;
+
+    delete scheduler;
+}
+
+//******************************************************************************************
+// @name                    : workerThread
+//
+// @description             : Keeps on simulating the next combination which has not been
+//                            picked by any other worker, till none is left.
+//
+// @returns                 : Nothing
+//******************************************************************************************
+void ParameterSweep::workerThread()
+{
+    size_t index = m_nextPoint++;
+
+    while (index < m_points.size())
+    {
+        simulatePoint(m_points[index]);
+        index = m_nextPoint++;
+    }
+}
+
+//******************************************************************************************
+// @name                    : run
+//
+// @description             : Simulates all the combinations in parallel.
+//
+// @param threadCount       : Number of worker threads. Use 0 to use all the cores.
+//
+// @returns                 : true if sweep executed successfully,
+//                            false otherwise
+//******************************************************************************************
+bool ParameterSweep::run(unsigned int threadCount)
+{
+    if (m_points.empty() || m_config.sweepJobsPerRun <= 0)
+    {
+        printf("ERROR: Nothing to sweep!\n");
+        return false;
+    }
+
+    if (threadCount == 0)
+    {
+        threadCount = thread::hardware_concurrency() ? thread::hardware_concurrency() : 1;
+    }
+
+    long long tsStart = getCurrentTimestampInMilliseconds();
+    vector<thread> workerThreads;
+
+    m_nextPoint = 0;
+    for (unsigned int i = 0; i < threadCount; i++)
+    {
+        workerThreads.push_back(thread(&ParameterSweep::workerThread, this));
+    }
+
+    for (auto it = workerThreads.begin(); it != workerThreads.end(); it++)
+    {
+        it->join();
+    }
+
+    m_wallTime = getCurrentTimestampInMilliseconds() - tsStart;
+    printf("\nSimulated %zu configuration(s) on %u thread(s) in %.2lf seconds\n", m_points.size(), threadCount, m_wallTime / (double)1000);
+    return true;
+}
+
+//******************************************************************************************
+// @name                    : writeResults
+//
+// @description             : Writes the results of all the combinations to a CSV file.
+//
+// @param fileName          : Name of the file
+//
+// @returns                 : true if results were written,
+//                            false otherwise
+//******************************************************************************************
+bool ParameterSweep::writeResults(const string & fileName)
+{
+    FILE *file = fopen(fileName.c_str(), "w");
+    if (!file)
+    {
+        printf("ERROR: Unable to open %s\n", fileName.c_str());
+        return false;
+    }
+
+    const double nsPerMs = (double)NANOSECONDS_PER_MILLISECOND;
+
+    fprintf(file, "scheduler,time_quantum_ms,response_time_threshold,load_factor,ageing_rate,seed,"
+                  "completed_jobs,shed_jobs,avg_time_required_ms,avg_waiting_time_ms,avg_response_time_ms,"
+                  "threshold_exceeded_pct,throughput_per_s,context_switches,cpu_efficiency_pct,simulated_time_ms,wall_time_ms\n");
+
+    for (auto it = m_points.begin(); it != m_points.end(); it++)
+    {
+        if (!it->simulated)
+        {
+            continue;
+        }
+
+        fprintf(file, "%s,%.3lf,%d,%.3lf,%u,%u,%zu,%zu,%.3lf,%.3lf,%.3lf,%.3lf,%.6lf,%llu,%.3lf,%.3lf,%lld\n",
+                it->result.schedulerName.c_str(),
+                it->timeQuantum / nsPerMs,
+                it->responseTimeThreshold,
+                it->loadFactor,
+                it->ageingRate,
+                it->seed,
+                it->result.completedJobs,
+                it->result.shedJobs,
+                it->result.avgTimeRequired / nsPerMs,
+                it->result.avgWaitingTime / nsPerMs,
+                it->result.avgResponseTime / nsPerMs,
+                it->result.thresholdExceeded,
+                it->result.throughput,
+                it->result.contextSwitches,
+                it->result.cpuEfficiency,
+                it->result.simulatedTime / nsPerMs,
+                it->result.wallTime);
+    }
+
+    fclose(file);
+    printf("Sweep results written to %s\n", fileName.c_str());
+    return true;
+}
+
+//******************************************************************************************
+// @name                    : displayBestResults
+//
+// @description             : Displays, for each load factor and algorithm, the combination
+//                            with the least average response time.
+//
+// @returns                 : Nothing
+//******************************************************************************************
+void ParameterSweep::displayBestResults()
+{
+    const char *separator = "+-------------------------------------------+-------------+-----------+--------+--------+-------------+-------------+-----------+\n";
+
+    printf("\n");
+    printf("%s", separator);
+    printf("| %-41s | %11s | %9s | %6s | %6s | %11s | %11s | %9s |\n",
+           "Scheduler", "Quantum(ms)", "RT thrshd", "Load", "Ageing", "Avg wait(s)", "Avg resp(s)", "RT exc(%)");
+    printf("%s", separator);
+
+    for (auto load = m_config.sweepLoadFactors.begin(); load != m_config.sweepLoadFactors.end(); load++)
+    for (auto algo = m_algorithms.begin(); algo != m_algorithms.end(); algo++)
+    {
+        const sweepPoint_st *best = nullptr;
+        for (auto it = m_points.begin(); it != m_points.end(); it++)
+        {
+            if (it->simulated && it->algorithm == *algo && it->loadFactor == *load &&
+                (!best || it->result.avgResponseTime < best->result.avgResponseTime))
+            {
+                best = &(*it);
+            }
+        }
+
+        if (best)
+        {
+            printf("| %-41s | %11.3lf | %9d | %6.2lf | %6u | %11.2lf | %11.2lf | %9.2lf |\n",
+                   best->result.schedulerName.c_str(),
+                   best->timeQuantum / (double)NANOSECONDS_PER_MILLISECOND,
+                   best->responseTimeThreshold,
+                   best->loadFactor,
+                   best->ageingRate,
+                   best->result.avgWaitingTime / (double)NANOSECONDS_PER_SECOND,
+                   best->result.avgResponseTime / (double)NANOSECONDS_PER_SECOND,
+                   best->result.thresholdExceeded);
+        }
+    }
+
+    printf("%s", separator);
+}
@@ -0,0 +1,207 @@
+#include "pending_job_table.h"
+#include<utility>
+
+//******************************************************************************************
+// @name                    : PendingJobTable
+//
+// @description             : Constructor
+//
+// @returns                 : Nothing
+//******************************************************************************************
+PendingJobTable::PendingJobTable()
+{
+    clear();
+}
+
+//******************************************************************************************
+// @name                    : clear
+//
+// @description             : Forgets all the jobs, as when the pending pool is cleared, and
+//                            frees the arrays.
+//
+// @returns                 : Nothing
+//******************************************************************************************
+void PendingJobTable::clear()
+{
+    m_jobs = vector<Job*>();
+    m_nodes = vector<list<Job*>::iterator>();
+    m_ranks = vector<long long>();
+    m_keys = vector<long long>();
+    m_priorities = vector<unsigned int>();
+    m_tsCreated = vector<long long>();
+    m_timeRequired = vector<long long>();
+    m_keyedSlots = 0;
+    m_frontRank = 0;
+    m_backRank = -1;
+}
+
+//******************************************************************************************
+// @name                    : reserve
+//
+// @description             : Makes room for a number of jobs in the arrays, so that filling
+//                            them does not grow them several times.
+//
+// @param count             : Jobs
+//
+// @returns                 : Nothing
+//******************************************************************************************
+void PendingJobTable::reserve(size_t count)
+{
+    m_jobs.reserve(count);
+    m_nodes.reserve(count);
+    m_ranks.reserve(count);
+    m_keys.reserve(count);
+    m_priorities.reserve(count);
+    m_tsCreated.reserve(count);
+    m_timeRequired.reserve(count);
+}
+
+//******************************************************************************************
+// @name                    : swapSlots
+//
+// @description             : Swaps the jobs of two slots, along with their fields.
+//
+// @param lhs               : Slot
+// @param rhs               : Slot
+//
+// @returns                 : Nothing
+//******************************************************************************************
+void PendingJobTable::swapSlots(size_t lhs, size_t rhs)
+{
+    if (lhs == rhs)
+    {
+        return;
+    }
+
+    swap(m_jobs[lhs], m_jobs[rhs]);
+    swap(m_nodes[lhs], m_nodes[rhs]);
+    swap(m_ranks[lhs], m_ranks[rhs]);
+    swap(m_keys[lhs], m_keys[rhs]);
+    swap(m_priorities[lhs], m_priorities[rhs]);
+    swap(m_tsCreated[lhs], m_tsCreated[rhs]);
+    swap(m_timeRequired[lhs], m_timeRequired[rhs]);
+
+    m_jobs[lhs]->setPendingSlot(lhs);
+    m_jobs[rhs]->setPendingSlot(rhs);
+}
+
+//******************************************************************************************
+// @name                    : add
+//
+// @description             : Adds a job appended to the back of the pending pool, after all
+//                            the others. Its key is not set.
+//
+// @param node              : Node of the job in the pool
+//
+// @returns                 : Nothing
+//******************************************************************************************
+void PendingJobTable::add(list<Job*>::iterator node)
+{
+    Job *job = *node;
+
+    job->setPendingSlot(m_jobs.size());
+    m_jobs.push_back(job);
+    m_nodes.push_back(node);
+    m_ranks.push_back(++m_backRank);
+    m_keys.push_back(0);
+    m_priorities.push_back(job->getJobPriority());
+    m_tsCreated.push_back(job->getJobTimeCreated());
+    m_timeRequired.push_back(job->getJobTimeRequired());
+}
+
+//******************************************************************************************
+// @name                    : remove
+//
+// @description             : Removes a job leaving the pending pool. The last slot whose key
+//                            is set, if the job had one, and then the last slot, are moved
+//                            into the slot freed, so that the slots whose key is not set stay
+//                            at the end.
+//
+// @param job               : Job in the table
+//
+// @returns                 : Node of the job in the pool, to be erased by the caller
+//******************************************************************************************
+list<Job*>::iterator PendingJobTable::remove(Job *job)
+{
+    size_t slot = job->getPendingSlot();
+    list<Job*>::iterator node = m_nodes[slot];
+
+    if (slot < m_keyedSlots)
+    {
+        m_keyedSlots--;
+        swapSlots(slot, m_keyedSlots);
+        slot = m_keyedSlots;
+    }
+    swapSlots(slot, m_jobs.size() - 1);
+
+    m_jobs.pop_back();
+    m_nodes.pop_back();
+    m_ranks.pop_back();
+    m_keys.pop_back();
+    m_priorities.pop_back();
+    m_tsCreated.pop_back();
+    m_timeRequired.pop_back();
+
+    return node;
+}
+
+//******************************************************************************************
+// @name                    : update
+//
+// @description             : Reads the fields of a job again, e.g. after it ran, and unsets
+//                            its key.
+//
+// @param job               : Job in the table
+//
+// @returns                 : Nothing
+//******************************************************************************************
+void PendingJobTable::update(Job *job)
+{
+    size_t slot = job->getPendingSlot();
+
+    m_priorities[slot] = job->getJobPriority();
+    m_tsCreated[slot] = job->getJobTimeCreated();
+    m_timeRequired[slot] = job->getJobTimeRequired();
+
+    if (slot < m_keyedSlots)
+    {
+        m_keyedSlots--;
+        swapSlots(slot, m_keyedSlots);
+    }
+}
+
+//******************************************************************************************
+// @name                    : moveToFront
+//
+// @description             : Ranks a job spliced to the front of the pending pool ahead of
+//                            all the others.
+//
+// @param slot              : Slot of the job
+//
+// @returns                 : Nothing
+//******************************************************************************************
+void PendingJobTable::moveToFront(size_t slot)
+{
+    m_ranks[slot] = --m_frontRank;
+}
+
+//******************************************************************************************
+// @name                    : setRanks
+//
+// @description             : Ranks the jobs after the pending pool was reordered.
+//
+// @param slots             : Slots of all the jobs, in their new order in the pool
+// @param count             : Slots
+//
+// @returns                 : Nothing
+//******************************************************************************************
+void PendingJobTable::setRanks(const size_t *slots, size_t count)
+{
+    for (size_t i = 0; i < count; i++)
+    {
+        m_ranks[slots[i]] = (long long)i;
+    }
+
+    m_frontRank = 0;
+    m_backRank = (long long)count - 1;
+}
@@ -0,0 +1,244 @@
+#include "phase_timer.h"
+#ifdef __linux__
+#include<linux/perf_event.h>
+#include<sys/ioctl.h>
+#include<sys/syscall.h>
+#include<unistd.h>
+#include<string.h>
+#endif
+
+//******************************************************************************************
+// @name                    : HardwareCounters
+//
+// @description             : Constructor
+//
+// @returns                 : Nothing
+//******************************************************************************************
+HardwareCounters::HardwareCounters()
+{
+    m_groupFd = -1;
+    m_cacheMissesFd = -1;
+}
+
+//******************************************************************************************
+// @name                    : ~HardwareCounters
+//
+// @description             : Closes the counters.
+//
+// @returns                 : Nothing
+//******************************************************************************************
+HardwareCounters::~HardwareCounters()
+{
+#ifdef __linux__
+    if (m_cacheMissesFd >= 0)
+        close(m_cacheMissesFd);
+    if (m_groupFd >= 0)
+        close(m_groupFd);
+#endif
+}
+
+#ifdef __linux__
+//******************************************************************************************
+// @name                    : openCounter
+//
+// @description             : Opens a hardware counter of the calling thread, counting in
+//                            user space only.
+//
+// @param config            : PERF_COUNT_HW_* event to count
+// @param groupFd           : Group leader, -1 to create a group
+//
+// @returns                 : File descriptor of the counter, -1 on failure
+//******************************************************************************************
+static int openCounter(unsigned long long config, int groupFd)
+{
+    struct perf_event_attr attr;
+    memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = PERF_TYPE_HARDWARE;
+    attr.config = config;
+    attr.read_format = PERF_FORMAT_GROUP;
+    attr.disabled = (groupFd < 0) ? 1 : 0;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+
+    return (int)syscall(__NR_perf_event_open, &attr, 0, -1, groupFd, 0);
+}
+#endif
+
+//******************************************************************************************
+// @name                    : open
+//
+// @description             : Starts counting the cycles and cache misses of the calling
+//                            thread.
+//
+// @returns                 : true if the counters are available,
+//                            false otherwise
+//******************************************************************************************
+bool HardwareCounters::open()
+{
+#ifdef __linux__
+    if (isOpen())
+    {
+        return true;
+    }
+
+    m_groupFd = openCounter(PERF_COUNT_HW_CPU_CYCLES, -1);
+    if (m_groupFd < 0)
+    {
+        return false;
+    }
+
+    m_cacheMissesFd = openCounter(PERF_COUNT_HW_CACHE_MISSES, m_groupFd);
+    if (m_cacheMissesFd < 0)
+    {
+        close(m_groupFd);
+        m_groupFd = -1;
+        return false;
+    }
+
+    ioctl(m_groupFd, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+    ioctl(m_groupFd, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+    return true;
+#else
+    return false;
+#endif
+}
+
+//******************************************************************************************
+// @name                    : read
+//
+// @description             : Reads the counts since the counters were opened.
+//
+// @param counts            : Counts read
+//
+// @returns                 : true if the counts were read,
+//                            false otherwise
+//******************************************************************************************
+bool HardwareCounters::read(hardwareCounts_st & counts)
+{
+#ifdef __linux__
+    // Layout of PERF_FORMAT_GROUP: number of counters, then the value of each
+    unsigned long long values[3];
+    if (::read(m_groupFd, values, sizeof(values)) != (ssize_t)sizeof(values) || values[0] != 2)
+    {
+        return false;
+    }
+
+    counts.cycles = values[1];
+    counts.cacheMisses = values[2];
+    return true;
+#else
+    (void)counts;
+    return false;
+#endif
+}
+
+//******************************************************************************************
+// @name                    : PhaseStats
+//
+// @description             : Constructor
+//
+// @returns                 : Nothing
+//******************************************************************************************
+PhaseStats::PhaseStats()
+{
+    m_count = 0;
+    m_totalTime = 0;
+    m_maxTime = 0;
+    m_totalCycles = 0;
+    m_totalCacheMisses = 0;
+    for (int i = 0; i < HISTOGRAM_BUCKETS; i++)
+    {
+        m_histogram[i] = 0;
+    }
+}
+
+//******************************************************************************************
+// @name                    : add
+//
+// @description             : Accounts for one execution of the phase. Called only from the
+//                            scheduler thread, so plain loads and stores are enough.
+//
+// @param duration          : Time (ns) taken by the phase
+// @param counts            : Hardware counts of the phase, null if not available
+//
+// @returns                 : Nothing
+//******************************************************************************************
+void PhaseStats::add(long long duration, const hardwareCounts_st *counts)
+{
+    int bucket = 0;
+    for (unsigned long long value = (duration > 0) ? (unsigned long long)duration : 0; value > 1 && bucket < HISTOGRAM_BUCKETS - 1; value >>= 1)
+    {
+        bucket++;
+    }
+
+    m_count.store(m_count.load(memory_order_relaxed) + 1, memory_order_relaxed);
+    m_totalTime.store(m_totalTime.load(memory_order_relaxed) + duration, memory_order_relaxed);
+    if (duration > m_maxTime.load(memory_order_relaxed))
+    {
+        m_maxTime.store(duration, memory_order_relaxed);
+    }
+
+    m_histogram[bucket].store(m_histogram[bucket].load(memory_order_relaxed) + 1, memory_order_relaxed);
+
+    if (counts)
+    {
+        m_totalCycles.store(m_totalCycles.load(memory_order_relaxed) + counts->cycles, memory_order_relaxed);
+        m_totalCacheMisses.store(m_totalCacheMisses.load(memory_order_relaxed) + counts->cacheMisses, memory_order_relaxed);
+    }
+}
+
+//******************************************************************************************
+// @name                    : getPercentile
+//
+// @description             : Estimates a percentile of the durations from the histogram.
+//
+// @param percentile        : Percentile, e.g. 99
+//
+// @returns                 : Upper bound (ns) of the bucket holding the percentile, 0 if
+//                            the phase was never executed
+//******************************************************************************************
+long long PhaseStats::getPercentile(double percentile)
+{
+    unsigned long long total = 0;
+    unsigned long long counts[HISTOGRAM_BUCKETS];
+    for (int i = 0; i < HISTOGRAM_BUCKETS; i++)
+    {
+        counts[i] = m_histogram[i].load(memory_order_relaxed);
+        total += counts[i];
+    }
+
+    unsigned long long cumulative = 0;
+    for (int i = 0; i < HISTOGRAM_BUCKETS; i++)
+    {
+        cumulative += counts[i];
+        if (total && cumulative >= total * percentile / 100)
+        {
+            return 1LL << (i + 1);
+        }
+    }
+
+    return 0;
+}
+
+//******************************************************************************************
+// @name                    : getPhaseName
+//
+// @description             : Fetches the name of a phase, for display.
+//
+// @param phase             : Phase
+//
+// @returns                 : Name of the phase
+//******************************************************************************************
+const char* PhaseStats::getPhaseName(schedulerPhase_en phase)
+{
+    switch (phase)
+    {
+    case PHASE_FETCH:       return "Fetch ready jobs";
+    case PHASE_ORDER:       return "Order pending jobs";
+    case PHASE_DISPATCH:    return "Dispatch";
+    case PHASE_WORK:        return "Job work (DoJob)";
+    case PHASE_COMPLETE:    return "Pause/complete";
+    default:                return "Unknown";
+    }
+}
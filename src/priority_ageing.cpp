@@ -1,7 +1,9 @@
 #include "priority_ageing.h"
 #include "job.h"
+#include "logger.h"
+#include "simd_kernels.h"
+#include<algorithm>
 #include<time.h>
-#include<Windows.h>
 
 //******************************************************************************************
 // @name                    : PriorityAgeingScheduling
@@ -10,9 +12,11 @@
 //
 // @returns                 : Nothing
 //******************************************************************************************
-PriorityAgeingScheduling::PriorityAgeingScheduling(string name) :ProcessScheduler(name)
+PriorityAgeingScheduling::PriorityAgeingScheduling(string name, unsigned int ageingRate) :PolicyScheduler<PriorityAgeingPolicy>(name)
 {
-    printf("\nCreating [ %s ] scheduler\n", name.c_str());
+    m_ageingRate = ageingRate;
+    keepPendingJobTable();
+    LOG_INFO("Creating [ %s ] scheduler with ageing rate: %u", name.c_str(), m_ageingRate);
 }
 
 //******************************************************************************************
@@ -28,97 +32,82 @@ PriorityAgeingScheduling::~PriorityAgeingScheduling()
 }
 
 //******************************************************************************************
-// @name                    : setSchedulerName
+// @name                    : agePendingJobs
 //
-// @description             : Stores name of the scheduling algorithm being used.
+// @description             : From the pending job pool, check if any job's priority has to
+//                            be updated. If a job has spent as much time in the queue as its
+//                            time to completion, its priority shall be increased by the
+//                            ageing rate. Lower value means higher priority.
+//
+//                            The priorities, creation timestamps and times required are kept
+//                            in the PendingJobTable, so the SIMD kernel ages them in place,
+//                            and only the jobs it aged are updated.
 //
 // @returns                 : Nothing
-//******************************************************************************************
-void PriorityAgeingScheduling::setSchedulerName(string name)
+//********************************************************************************************
+void PriorityAgeingScheduling::agePendingJobs()
 {
-    m_schedulerName = name;
-}
+    PendingJobTable *table = getPendingJobTable();
+    unsigned int *priorities = table->getPriorities();
 
+    m_agedJobs.resize(table->size());
+    size_t agedJobs = agePriorities(priorities, table->getTsCreated(), table->getTimeRequired(), table->size(),
+                                    m_clock->now(), getAgeingRate(), m_agedJobs.data());
+
+    for (size_t i = 0; i < agedJobs; i++)
+    {
+        size_t slot = m_agedJobs[i];
+        table->getJob(slot)->setJobPriority(priorities[slot]);
+    }
+}
 
 //******************************************************************************************
-// @name                    : ProcessJobs
+// @name                    : orderPendingJobs
+//
+// @description             : Ages the pending jobs and sorts the pending job pool with
+//                            highest priority job in the beginning. Ageing must be done
+//                            before sorting the list.
 //
-// @description             : Selects for execution the waiting process with the highest
-//                            priority. If a job keeps on waiting beyond its time required
-//                            for completion, its priority is increased.
+//                            The sort is done on the aged priorities of the table, each
+//                            packed with the rank of its job, so that jobs of the same
+//                            priority keep their order in the pool, as with list::sort().
+//                            The ranks are those given by the last sort, and after it to
+//                            the jobs that arrived, so they are small enough to index the
+//                            jobs with. The nodes of the pool are then moved into the sorted
+//                            order, so they still hold the same jobs.
 //
 // @returns                 : Nothing
 //********************************************************************************************
-void PriorityAgeingScheduling::ProcessJobs()
+void PriorityAgeingScheduling::orderPendingJobs()
 {
-    time_t t1 = time(&t1);
-    time_t t2 = time(&t2);
+    agePendingJobs();
 
-    // Process jobs in pending queue continuously
-    while (!isSimulationComplete())
-    {
-        // Move all the jobs in ready queue to pending job pool. Thread synchronization
-        // is required as m_readyJobPool might be continuously being updated by the
-        // Job creation thread.
-        m_schedulerMutex.lock();
-        m_pendingJobPool.splice(m_pendingJobPool.end(), m_readyJobPool);
-        m_schedulerMutex.unlock();
+    PendingJobTable *table = getPendingJobTable();
+    const unsigned int *priorities = table->getPriorities();
+    const long long *ranks = table->getRanks();
 
-        if (m_pendingJobPool.size())
+    m_ageingOrder.clear();
+    for (size_t slot = 0; slot < table->size(); slot++)
+    {
+        size_t rank = (size_t)ranks[slot];
+        if (rank >= m_slotOfRank.size())
         {
-            displayStatsAtInterval(t1, t2);
-
-            // From the pending job pool, check if any job's priority has to be updated. 
-            // If a job has spent as much time in the queue as its time to completion, its
-            // priority shall be increased. Lower value means higher priority
-            // This must be done before sorting the list.
-            for (auto it = m_pendingJobPool.begin(); it != m_pendingJobPool.end(); it++)
-            {
-                Job *job = *it;
-                long long currentWaitingTime = getCurrentTimestampInMilliseconds() - job->getJobTimeCreated();
-                if (currentWaitingTime >= job->getJobTimeRequired() && job->getJobPriority() > JOB_PRIORITY_HIGHEST)
-                {
-                    job->setJobPriority(job->getJobPriority() - 1);
-                }
-            }
-
-            // Sort the pending job pool with least time required by job to complete in the beginning.
-            m_pendingJobPool.sort([](Job* lhs, Job* rhs) {return lhs->getJobPriority() < rhs->getJobPriority(); });
-
-            // Iterate through all the jobs in the list. This list must be sorted
-            // at this point of time. So process the job with highest priority
-            // fist, and proceed in decreasing order thereafter.
-            auto it = m_pendingJobPool.begin();
-            while (it != m_pendingJobPool.end())
-            {
-                /*printf("Sorted pending job list: \n");
-                for (auto it = m_pendingJobPool.begin(); it != m_pendingJobPool.end(); it++)
-                {
-                    printf("%lld  ", (*it)->getJobTimeRemaining());
-                }
-                printf("\n");*/
-
-                Job *job = *it;
-                bool jobComplete = false;
+            m_slotOfRank.resize(rank + 1);
+        }
 
-                job->markJobAsStartedExecution();
-                //printf("Job [%-5lu] running...\n", job->getJobId());
+        m_slotOfRank[rank] = slot;
+        m_ageingOrder.push_back(((unsigned long long)priorities[slot] << 32) | rank);
+    }
 
-                jobComplete = DoJob(job);
-                if (jobComplete)
-                {
-                    job->markJobAsComplete();
+    sort(m_ageingOrder.begin(), m_ageingOrder.end());
 
-                    // This will remove job from pending list. use
-                    // the modified "it" value
-                    it = this->JobComplete(job);
-                }
-                else
-                {
-                    // Increment it.
-                    it++;
-                }
-            }// Reached end of Pending Job pool
-        }
+    m_orderedSlots.clear();
+    for (auto it = m_ageingOrder.begin(); it != m_ageingOrder.end(); it++)
+    {
+        size_t slot = m_slotOfRank[*it & 0xFFFFFFFF];
+        m_pendingJobPool.splice(m_pendingJobPool.end(), m_pendingJobPool, table->getNode(slot));
+        m_orderedSlots.push_back(slot);
     }
-}
\ No newline at end of file
+
+    table->setRanks(m_orderedSlots.data(), m_orderedSlots.size());
+}
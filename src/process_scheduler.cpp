@@ -1,6 +1,9 @@
 #include "process_scheduler.h"
-#include<Windows.h>
+#include "logger.h"
+#include "workload.h"
 #include<assert.h>
+#include<math.h>
+#include<thread>
 
 //******************************************************************************************
 // @name                    : ProcessScheduler
@@ -15,7 +18,32 @@ ProcessScheduler::ProcessScheduler(string name)
     m_simulationComplete = false;
     m_totalJobsInflow = 0;
     m_displayInterval = 10;          // Default is 10 seconds
-    m_tsCreated = getCurrentTimestampInMilliseconds();
+    m_feeder = nullptr;
+    m_clock = getRealTimeClock();
+    m_tsCreated = m_clock->now();
+    m_stats = schedulerStats_st();
+    m_traceTrack = EventTracer::getInstance().registerTrack(name);
+    m_phaseTimersEnabled = true;
+    m_hardwareCountersEnabled = false;
+    m_hardwareCountersOpened = false;
+    m_workerPool = nullptr;
+    m_payloadKernel = PAYLOAD_KERNEL_NONE;
+    m_payloadScale = 0;
+    m_payloadPreemptible = false;
+    m_timeSliceServed = 0;
+    m_tsIoWaitStart = -1;
+    m_burstPredictor = nullptr;
+    m_admissionPolicy = admissionPolicy_st();
+    m_jobsInSystem = 0;
+    m_backlogTime = 0;
+    for (int status = 0; status < ADMISSION_MAX; status++)
+    {
+        m_rejectedJobs[status] = 0;
+    }
+    m_checkpointInterval = 0;
+    m_tsNextCheckpoint = -1;
+    m_tenantGroups = nullptr;
+    m_pendingJobTable = nullptr;
 }
 
 //******************************************************************************************
@@ -28,7 +56,7 @@ ProcessScheduler::ProcessScheduler(string name)
 //******************************************************************************************
 ProcessScheduler::~ProcessScheduler()
 {
-    printf("Terminating scheduler [ %s ]\n", getSchedulerName().c_str());
+    LOG_INFO("Terminating scheduler [ %s ]", getSchedulerName().c_str());
 
     // Clear memory allocated to job object in ready queue
     for (auto it = m_readyJobPool.begin(); it != m_readyJobPool.end(); it++)
@@ -44,6 +72,15 @@ ProcessScheduler::~ProcessScheduler()
         delete job;
     }
 
+    // Clear memory allocated to job object in Blocked pool
+    list<Job*> blockedJobs;
+    m_ioController.takeBlockedJobs(blockedJobs);
+    for (auto it = blockedJobs.begin(); it != blockedJobs.end(); it++)
+    {
+        Job *job = *it;
+        delete job;
+    }
+
     // Clear memory allocated to job object in Completed pool
     for (auto it = m_completedJobPool.begin(); it != m_completedJobPool.end(); it++)
     {
@@ -54,6 +91,10 @@ ProcessScheduler::~ProcessScheduler()
     m_readyJobPool.clear();
     m_pendingJobPool.clear();
     m_completedJobPool.clear();
+
+    delete m_burstPredictor;
+    delete m_pendingJobTable;
+    delete m_tenantGroups;
 }
 
 //******************************************************************************************
@@ -68,6 +109,23 @@ string ProcessScheduler::getSchedulerName()
     return m_schedulerName;
 }
 
+//******************************************************************************************
+// @name                    : setClock
+//
+// @description             : Sets the source of time of this scheduler. Must be done before
+//                            any job is added. The scheduler is taken to be created at the
+//                            current time of the new clock.
+//
+// @param clock             : Clock to use
+//
+// @returns                 : Nothing
+//******************************************************************************************
+void ProcessScheduler::setClock(SimulationClock *clock)
+{
+    m_clock = clock;
+    m_tsCreated = m_clock->now();
+}
+
 //******************************************************************************************
 // @name                    : addToReadyQueue
 //
@@ -78,311 +136,2039 @@ string ProcessScheduler::getSchedulerName()
 //                            Jobs get added to the scheduler via this API continuously from
 //                            the job creater into the pending jobs list. 
 //
-// @returns                 : Nothing
+//                            A job rejected by admission control is not added, and is
+//                            still owned by the caller.
+//
+// @returns                 : ADMISSION_ACCEPTED if the job was added,
+//                            the reason it was shed otherwise
 //********************************************************************************************
-bool ProcessScheduler::addToReadyQueue(Job* job)
+admissionStatus_en ProcessScheduler::addToReadyQueue(Job* job)
 {
-    m_readyJobPool.push_back(job);
-    m_totalJobsInflow++;
+    prepareJob(job);
 
-    return true;
+    // The check and the reservation of the admitted job are done together, so producers
+    // adding jobs at the same time cannot all pass the limits and overshoot them
+    m_schedulerMutex.lock();
+    admissionStatus_en status = admitJob(job, m_jobsInSystem.load(), m_backlogTime.load());
+    if (status == ADMISSION_ACCEPTED)
+    {
+        m_jobsInSystem++;
+        m_backlogTime += job->getJobTimeRemaining();
+
+        EventTracer::getInstance().record(TRACE_EVENT_ARRIVE, m_traceTrack, 0, job->getJobId(), job->getJobTimeCreated());
+        m_readyJobPool.push_back(job);
+        m_totalJobsInflow++;
+    }
+    m_schedulerMutex.unlock();
+
+    return status;
 }
 
-void ProcessScheduler::setDisplayInterval(int interval)
+//******************************************************************************************
+// @name                    : addToReadyQueue
+//
+// @description             : Adds a batch of jobs to the ready queue of the scheduler, in
+//                            their order. The jobs are prepared outside the lock. They are
+//                            then admitted one by one, as if they were added one at a time,
+//                            and the admitted ones are reserved room for and spliced into
+//                            the ready queue, all in a single critical section, so the
+//                            scheduler thread is contended with once per batch instead of
+//                            once per job, and never sees a job counted in the system that
+//                            is not in any pool.
+//
+//                            The jobs rejected by admission control are not added, and are
+//                            still owned by the caller.
+//
+// @param jobs              : Jobs to add
+// @param shedJobs          : Jobs rejected by admission control are appended to it
+//
+// @returns                 : Number of jobs added
+//********************************************************************************************
+size_t ProcessScheduler::addToReadyQueue(span<Job* const> jobs, vector<Job*> & shedJobs)
 {
-    m_displayInterval = interval;
+    list<Job*> admittedJobs;
+    long long admittedTime = 0;
+
+    for (Job *job : jobs)
+    {
+        prepareJob(job);
+    }
+
+    // Admit the whole batch, reserve room for it and publish it at once, as for a single job
+    m_schedulerMutex.lock();
+    unsigned long long jobsInSystem = m_jobsInSystem.load();
+    long long backlogTime = m_backlogTime.load();
+
+    for (Job *job : jobs)
+    {
+        if (admitJob(job, jobsInSystem + admittedJobs.size(), backlogTime + admittedTime) != ADMISSION_ACCEPTED)
+        {
+            shedJobs.push_back(job);
+            continue;
+        }
+
+        EventTracer::getInstance().record(TRACE_EVENT_ARRIVE, m_traceTrack, 0, job->getJobId(), job->getJobTimeCreated());
+        admittedTime += job->getJobTimeRemaining();
+        admittedJobs.push_back(job);
+    }
+
+    size_t admitted = admittedJobs.size();
+    m_jobsInSystem += admitted;
+    m_backlogTime += admittedTime;
+    m_readyJobPool.splice(m_readyJobPool.end(), admittedJobs);
+    m_totalJobsInflow += admitted;
+    m_schedulerMutex.unlock();
+
+    return admitted;
 }
 
-int ProcessScheduler::getDisplayInterval()
+//******************************************************************************************
+// @name                    : admitJob
+//
+// @description             : Checks a job being added against the admission policy, and
+//                            accounts for it being shed if it is not admitted. Called with
+//                            the scheduler mutex held, so the counts given are up to date
+//                            till the admitted job is accounted for.
+//
+// @param job               : Job being added
+// @param jobsInSystem      : Jobs admitted before it and not complete yet
+// @param backlogTime       : CPU time (ns) left of the jobs admitted before it
+//
+// @returns                 : ADMISSION_ACCEPTED if the job is admitted,
+//                            the reason it was shed otherwise
+//********************************************************************************************
+admissionStatus_en ProcessScheduler::admitJob(Job *job, unsigned long long jobsInSystem, long long backlogTime)
 {
-    return m_displayInterval;
+    admissionStatus_en status = checkAdmission(job, jobsInSystem, backlogTime);
+    if (status != ADMISSION_ACCEPTED)
+    {
+        m_rejectedJobs[status]++;
+        if (job->isDebugEnabled())
+            LOG_INFO("Job %lu shed: %s", job->getJobId(), getAdmissionStatusName(status));
+    }
+
+    return status;
 }
 
 //******************************************************************************************
-// @name                    : displayStats
+// @name                    : prepareJob
 //
-// @param t1                : Start timestamp (seconds).
-// @param t2                : End timestamp (seconds).
+// @description             : Prepares a job to be run by this scheduler, before it is
+//                            admitted, outside the lock, as it needs no state of the
+//                            scheduler. A job shed afterwards keeps what it was given.
 //
-// @description             : Displays statistics for this Scheduler only at an interval
-//                            as specified by the display interval. No stats will be displayed
-//                            if the interval is < 0.
+// @param job               : Job being added
 //
 // @returns                 : Nothing
 //********************************************************************************************
-void ProcessScheduler::displayStatsAtInterval(time_t & t1, time_t & t2)
+void ProcessScheduler::prepareJob(Job *job)
 {
-    if (getDisplayInterval() < 0)
+    if (m_payloadKernel != PAYLOAD_KERNEL_NONE && !job->hasPayload() && !job->hasCoroutine())
     {
-        // Do not display stats
-        return;
+        long long cpuTime = (long long)(job->getJobTimeRequired() * m_payloadScale);
+        if (m_payloadPreemptible)
+            job->setCoroutine(WorkerPool::createCoroutine(m_payloadKernel, cpuTime));
+        else
+            job->setPayload(WorkerPool::createPayload(m_payloadKernel, cpuTime));
+    }
+
+    job->setTraceTrack(m_traceTrack);
+}
+
+//******************************************************************************************
+// @name                    : checkAdmission
+//
+// @description             : Checks a job against the admission policy. The job would wait
+//                            for the CPU time left of all the admitted jobs, on top of the
+//                            time since it was created (a job may be added a bit after it
+//                            arrives), and respond after its own time required on top of
+//                            that.
+//
+// @param job               : Job being added
+// @param jobsInSystem      : Jobs admitted before it and not complete yet
+// @param backlogTime       : CPU time (ns) left of the jobs admitted before it
+//
+// @returns                 : ADMISSION_ACCEPTED if the job can be admitted,
+//                            the reason to shed it otherwise
+//********************************************************************************************
+admissionStatus_en ProcessScheduler::checkAdmission(Job *job, unsigned long long jobsInSystem, long long backlogTime)
+{
+    if (m_admissionPolicy.maxJobs && jobsInSystem >= m_admissionPolicy.maxJobs)
+    {
+        return ADMISSION_REJECTED_QUEUE_FULL;
+    }
+
+    long long timeWaited = m_clock->now() - job->getJobTimeCreated();
+    long long estimatedWait = ((backlogTime > 0) ? backlogTime : 0) + ((timeWaited > 0) ? timeWaited : 0);
+
+    if (m_admissionPolicy.maxEstimatedWait && estimatedWait > m_admissionPolicy.maxEstimatedWait)
+    {
+        return ADMISSION_REJECTED_WAIT;
     }
 
-    // Display job statistics at pre-defined interval
-    t2 = time(&t2);
-    if (t2 - t1 >= getDisplayInterval())
+    if (m_admissionPolicy.rejectLateJobs && estimatedWait + job->getJobTimeRemaining() > job->getResponseTimeLimit())
     {
-        displayStats();
-        t1 = time(&t1);
+        return ADMISSION_REJECTED_DEADLINE;
     }
+
+    return ADMISSION_ACCEPTED;
 }
 
 //******************************************************************************************
-// @name                    : displayStats
+// @name                    : getShedJobs
 //
-// @description             : Displays statistics for this Scheduler.
+// @description             : Fetches the number of jobs rejected by admission control so
+//                            far. This can be called from any thread.
 //
-// @returns                 : Nothing 
+// @returns                 : Jobs shed
 //********************************************************************************************
-void ProcessScheduler::displayStats()
+unsigned long long ProcessScheduler::getShedJobs()
 {
-    printf("\n\n");
-    printf("+------------------------------------------------------------------------+\n");
-    printf("| %-70s |\n", getSchedulerName().c_str());
-    printf("+------------------------------------------------------------------------+\n");
-    printf("Time elapsed                            : %lld seconds\n", ((getCurrentTimestampInMilliseconds() - m_tsCreated) / 1000));
-    printf("Total jobs added to ready queue         : %llu\n", m_totalJobsInflow);
-    printf("Pending jobs                            : %u\n", m_pendingJobPool.size());
-    printf("Completed jobs                          : %u\n", m_completedJobPool.size());
-    printf("Job inflow rate                         : %lf per second.\n", getJobInflowRate());
-    printf("Avg time required by job to complete    : %.2lf seconds\n", getAverageTimeRequired() / (double)1000);
-    printf("Average waiting time                    : %.2lf seconds\n", getAverageWaitingTime() / (double)1000);
-    printf("Average response time                   : %.2lf seconds\n", getAverageResponseTime() / (double)1000);
-    printf("Response threshold exceeded for         : %.2lf %% jobs\n", getResponseThresholdExceededJobs());
-    printf("Throughput                              : %lf per second.\n", getThroughput());
-    printf("+------------------------------------------------------------------------+\n\n");
+    unsigned long long shedJobs = 0;
+    for (int status = ADMISSION_ACCEPTED + 1; status < ADMISSION_MAX; status++)
+    {
+        shedJobs += m_rejectedJobs[status].load();
+    }
+
+    return shedJobs;
 }
 
+//******************************************************************************************
+// @name                    : getAdmissionStatusName
+//
+// @description             : Fetches the description of an admission status.
+//
+// @param status            : Admission status
+//
+// @returns                 : Description
+//********************************************************************************************
+const char* ProcessScheduler::getAdmissionStatusName(admissionStatus_en status)
+{
+    switch (status)
+    {
+    case ADMISSION_ACCEPTED:            return "accepted";
+    case ADMISSION_REJECTED_QUEUE_FULL: return "queue full";
+    case ADMISSION_REJECTED_WAIT:       return "wait too long";
+    case ADMISSION_REJECTED_DEADLINE:   return "deadline";
+    default:                            return "unknown";
+    }
+}
 
 //******************************************************************************************
-// @name                    : getAverageWaitingTime
+// @name                    : fetchReadyJobs
 //
-// @description             : Get average waiting time (in ms.) of all the jobs in ready queue.
-//                            Wait time - time from work becoming enabled until the first 
-//                                        point it begins execution on resources
+// @description             : Move all the jobs in ready queue to pending job pool. Thread
+//                            synchronization is required as m_readyJobPool might be 
+//                            continuously being updated by the Job creation thread.
 //
-// @returns                 : AverageWaitingTime
+//                            If a workload feeder is attached, the jobs that have arrived
+//                            by now are released first. If there is nothing to do till the
+//                            next arrival or I/O completion, the CPU waits for it, i.e. time
+//                            is moved ahead to it unless something wakes the CPU before. Once
+//                            all the jobs of the workload are complete, the simulation is
+//                            marked complete. On several CPUs, a CPU with nothing to do
+//                            only sleeps till another CPU stops the job it is running, as
+//                            that job may be left to it. With CPU affinity, it also finds
+//                            out whether it has jobs to run without migrating any.
+//
+//                            Jobs whose I/O is complete by now are moved from the blocked
+//                            pool to the pending pool, ahead of the newly arrived jobs. With
+//                            tenant groups, the group to run next is picked again. The jobs
+//                            moved are added to the PendingJobTable, if one is kept.
+//
+//                            A checkpoint is saved here when one is due, as no job is
+//                            running and the counters have just been published.
+//
+// @returns                 : Nothing
 //********************************************************************************************
-double ProcessScheduler::getAverageWaitingTime()
+void ProcessScheduler::fetchReadyJobs()
 {
-    if (m_completedJobPool.size() == 0)
+    if (m_feeder)
     {
-        return 0;
+        if (!hasDispatchableJob() && m_readyJobPool.empty())
+        {
+            // Sleep till whichever comes first
+            long long tsNextEvent = getNextEventTime();
+            long long tsNextStop = m_cpuSet.getNextStopTime();
+            if (tsNextStop >= 0 && (tsNextEvent < 0 || tsNextStop < tsNextEvent))
+            {
+                tsNextEvent = tsNextStop;
+            }
+
+            if (tsNextEvent >= 0)
+            {
+                m_clock->waitFor(tsNextEvent - m_clock->now());
+            }
+        }
+
+        m_feeder->releaseDueJobs(this);
     }
 
-    long long totalWaitTime = 0;
-    for (auto it = m_completedJobPool.begin(); it != m_completedJobPool.end(); it++)
+    long long tsNow = m_clock->now();
+    bool wasEmpty = m_pendingJobPool.empty();
+    auto last = wasEmpty ? m_pendingJobPool.end() : prev(m_pendingJobPool.end());
+
+    m_ioController.releaseCompletedJobs(tsNow, m_pendingJobPool);
+
+    m_schedulerMutex.lock();
+    m_pendingJobPool.splice(m_pendingJobPool.end(), m_readyJobPool);
+    m_schedulerMutex.unlock();
+
+    if (m_pendingJobTable)
     {
-        Job *job = it->second;
-        if (totalWaitTime + job->getWaitingTime() < totalWaitTime)
+        for (auto it = wasEmpty ? m_pendingJobPool.begin() : next(last); it != m_pendingJobPool.end(); it++)
         {
-            printf("ASSERTION failed: totalWaitTime exceeded limit. %lld, %lld\n", totalWaitTime, job->getWaitingTime());
-            assert(0);
+            m_pendingJobTable->add(it);
         }
+    }
+
+    if (m_cpuSet.getLockstepClock() && m_cpuSet.hasAffinity())
+    {
+        m_cpuSet.getCurrentState().hasAffineJob = hasAffineJob();
+    }
+
+    if (m_tenantGroups)
+    {
+        repickTenantGroups();
+    }
+
+    if (m_feeder && m_feeder->isExhausted() && m_pendingJobPool.empty() && m_ioController.getBlockedJobCount() == 0)
+    {
+        setSimulationComplete(true);
+    }
 
-        totalWaitTime += job->getWaitingTime();
+    // Account for the time the CPU has nothing to do but wait for I/O
+    if (m_pendingJobPool.empty() && m_ioController.getBlockedJobCount())
+    {
+        if (m_tsIoWaitStart < 0)
+            m_tsIoWaitStart = tsNow;
+    }
+    else if (m_tsIoWaitStart >= 0)
+    {
+        m_stats.ioWaitTime += tsNow - m_tsIoWaitStart;
+        m_tsIoWaitStart = -1;
     }
 
-    return (double)totalWaitTime / m_completedJobPool.size();
+    publishStats();
+
+    if (m_checkpointInterval > 0)
+    {
+        if (m_tsNextCheckpoint >= 0 && tsNow >= m_tsNextCheckpoint)
+        {
+            saveCheckpoint(m_checkpointFile);
+        }
+        if (m_tsNextCheckpoint < 0 || tsNow >= m_tsNextCheckpoint)
+        {
+            m_tsNextCheckpoint = tsNow + m_checkpointInterval;
+        }
+    }
 }
 
 //******************************************************************************************
-// @name                    : getAverageTimeRequired
+// @name                    : keepPendingJobTable
 //
-// @description             : Get average time required (in ms.) of all the jobs that have completed
+// @description             : Keeps the fields of the pending jobs in a PendingJobTable from
+//                            now on, for the kernels of the algorithm. Called from the
+//                            constructor of the algorithms that use it.
 //
-// @returns                 : AverageTimeRequired
+// @returns                 : Nothing
 //********************************************************************************************
-double ProcessScheduler::getAverageTimeRequired()
+void ProcessScheduler::keepPendingJobTable()
 {
-    if (m_completedJobPool.size() == 0)
+    if (!m_pendingJobTable)
     {
-        return -1;
+        m_pendingJobTable = new PendingJobTable();
+        resetPendingJobTable();
     }
+}
 
-    long long totalTimeRequired = 0;
-    for (auto it = m_completedJobPool.begin(); it != m_completedJobPool.end(); it++)
+//******************************************************************************************
+// @name                    : resetPendingJobTable
+//
+// @description             : Adds all the jobs of the pending pool to the PendingJobTable
+//                            again, after the pool was replaced as a whole, e.g. restored
+//                            from a checkpoint.
+//
+// @returns                 : Nothing
+//********************************************************************************************
+void ProcessScheduler::resetPendingJobTable()
+{
+    if (!m_pendingJobTable)
     {
-        Job *job = it->second;
-
-        if (totalTimeRequired + job->getJobTimeRequired() < totalTimeRequired)
-        {
-            printf("ASSERTION failed: totalTimeRequired exceeded limit. %lld, %lld\n", totalTimeRequired, job->getJobTimeRequired());
-            assert(0);
-        }
-
-        totalTimeRequired += job->getJobTimeRequired();
+        return;
     }
 
-    return (double)totalTimeRequired / m_completedJobPool.size();
+    m_pendingJobTable->clear();
+    m_pendingJobTable->reserve(m_pendingJobPool.size());
+    for (auto it = m_pendingJobPool.begin(); it != m_pendingJobPool.end(); it++)
+    {
+        m_pendingJobTable->add(it);
+    }
 }
 
-
 //******************************************************************************************
-// @name                    : getAverageResponseTime
+// @name                    : getNextEventTime
 //
-// @description             : Get average response time (in ms.) of all the jobs. 
-//                            Response time- time from work becoming enabled until it is finished 
+// @description             : Fetches the timestamp of the next event that brings a job into
+//                            the pending pool: the next arrival from the workload feeder, if
+//                            one is attached, or the next I/O completion. Arrivals from a job
+//                            creation thread are not known in advance. With tenant groups,
+//                            a throttled group with jobs getting tokens again is one too,
+//                            if its jobs would be picked over the job running.
 //
-// @returns                 : AverageResponseTime
+// @param runningJob        : Job running on the calling CPU, nullptr if none
+//
+// @returns                 : timestamp (ns) of the next event, -1 if none is known
 //********************************************************************************************
-double ProcessScheduler::getAverageResponseTime()
+long long ProcessScheduler::getNextEventTime(Job *runningJob)
 {
-    if (m_completedJobPool.size() == 0)
+    long long tsNextEvent = m_ioController.getNextCompletionTime();
+
+    if (m_feeder && !m_feeder->isExhausted() && (tsNextEvent < 0 || m_feeder->getNextArrivalTime() < tsNextEvent))
     {
-        return -1;
+        tsNextEvent = m_feeder->getNextArrivalTime();
     }
 
-    long long totalResponseTime = 0;
-    for (auto it = m_completedJobPool.begin(); it != m_completedJobPool.end(); it++)
+    if (m_tenantGroups)
     {
-        Job *job = it->second;
-
-        if (totalResponseTime + job->getResponseTime() < totalResponseTime)
+        long long tsUnthrottle = m_tenantGroups->getNextUnthrottleTime(runningJob ? (int)runningJob->getTenantGroup() : -1);
+        if (tsUnthrottle >= 0 && (tsNextEvent < 0 || tsUnthrottle < tsNextEvent))
         {
-            printf("ASSERTION failed: totalResponseTime exceeded limit. %lld, %lld\n", totalResponseTime, job->getResponseTime());
-            assert(0);
+            tsNextEvent = tsUnthrottle;
         }
-
-        totalResponseTime += job->getResponseTime();
     }
 
-    return (double)totalResponseTime / m_completedJobPool.size();
+    return tsNextEvent;
 }
 
 //******************************************************************************************
-// @name                    : getThroughput
+// @name                    : areArrivalsKnown
 //
-// @description             : Get throughput(the total amount of work completed per second).
+// @description             : Checks whether the arrival times of the jobs are known before
+//                            they are due, i.e. whether the scheduler never has to look out
+//                            for arrivals it was not told about.
 //
-// @returns                 : Throughput
+// @returns                 : true if a feeder knowing its arrivals is attached,
+//                            false otherwise
 //********************************************************************************************
-double ProcessScheduler::getThroughput()
+bool ProcessScheduler::areArrivalsKnown()
 {
-    long long currentTimestamp = getCurrentTimestampInMilliseconds();
-    if (m_completedJobPool.size() == 0 || (currentTimestamp - m_tsCreated == 0))
-    {
-        return 0;
-    }
-
-    long long timeDiff = (currentTimestamp - m_tsCreated);
-    double throughput = ((double)(m_completedJobPool.size() * 1000)) / timeDiff;
-
-    return throughput;
+    return (m_feeder != nullptr && m_feeder->areArrivalsKnown());
 }
 
 //******************************************************************************************
-// @name                    : getJobInflowRate
+// @name                    : publishStats
 //
-// @description             : Get jobs added to ready queue per second.
+// @description             : Publishes the current counters of this scheduler, so that
+//                            they can be read from other threads. Must only be called from
+//                            the thread running ProcessJobs(). On several CPUs, each CPU
+//                            thread publishes in its turn on the LockstepClock, which orders
+//                            the writes of the seqlock one after the other.
 //
-// @returns                 : jobInflowRate
+// @returns                 : Nothing
 //********************************************************************************************
-double ProcessScheduler::getJobInflowRate()
+void ProcessScheduler::publishStats()
 {
-    long long currentTimestamp = getCurrentTimestampInMilliseconds();
-    if ((m_totalJobsInflow == 0) || (currentTimestamp - m_tsCreated == 0))
+    assert(m_cpuSet.getLockstepClock() == nullptr || m_cpuSet.getLockstepClock()->hasTurn());
+
+    m_stats.timeElapsed = m_clock->now() - m_tsCreated;
+    m_stats.totalJobsInflow = m_totalJobsInflow.load(memory_order_relaxed);
+    for (int status = 0; status < ADMISSION_MAX; status++)
     {
-        return 0;
+        m_stats.rejectedJobs[status] = m_rejectedJobs[status].load(memory_order_relaxed);
     }
+    m_stats.pendingJobs = m_pendingJobPool.size();
+    m_stats.completedJobs = m_completedJobPool.size();
+    m_stats.blockedJobs = m_ioController.getBlockedJobCount();
+    if (m_statsSeries.isDue(m_stats.timeElapsed))
+    {
+        sampleStats();
+    }
+    m_statsSnapshot.write(m_stats);
+}
 
-    long long timeDiff = (currentTimestamp - m_tsCreated);
-    double jobInflowRate = ((double)(m_totalJobsInflow * 1000)) / timeDiff;
+//******************************************************************************************
+// @name                    : sampleStats
+//
+// @description             : Adds the current state of this scheduler to its series, and
+//                            updates the rates over the recent window from it. Jobs that are
+//                            admitted but neither pending nor blocked are in the ready
+//                            queue. Must only be called from publishStats().
+//
+// @returns                 : Nothing
+//********************************************************************************************
+void ProcessScheduler::sampleStats()
+{
+    statsSample_st sample;
+    sample.timestamp = m_stats.timeElapsed;
+    sample.pendingJobs = m_stats.pendingJobs;
+    sample.blockedJobs = m_stats.blockedJobs;
+    sample.jobsInSystem = m_jobsInSystem.load(memory_order_relaxed);
+    sample.readyJobs = (sample.jobsInSystem > sample.pendingJobs + sample.blockedJobs) ? sample.jobsInSystem - sample.pendingJobs - sample.blockedJobs : 0;
+    sample.totalJobsInflow = m_stats.totalJobsInflow;
+    sample.completedJobs = m_stats.completedJobs;
+    sample.cpuBusyTime = m_stats.cpuBusyTime;
+    sample.totalResponseTime = m_stats.totalResponseTime;
+    m_statsSeries.record(sample);
 
-    return jobInflowRate;
+    windowedRates_st rates;
+    m_statsSeries.getRates(m_statsSeries.size() - 1, getCpuCount(), rates);
+    m_stats.recentTimeSpan = rates.timeSpan;
+    m_stats.recentThroughput = rates.throughput;
+    m_stats.recentInflowRate = rates.inflowRate;
+    m_stats.recentCpuUtilization = rates.cpuUtilization;
 }
 
 //******************************************************************************************
-// @name                    : JobComplete
+// @name                    : setStatsSampling
 //
-// @description             : This will move the job from pending job pool to completed 
-//                            job pool.
+// @description             : Makes this scheduler sample its state at a regular interval of
+//                            its clock, and publish the rates over a recent window. Must be
+//                            done before any job is added.
 //
-// @param job               : Job to execute
+// @param interval          : Time (ns) between two samples, 0 for none
+// @param window            : Time (ns) the recent rates are taken over
+// @param keptSamples       : Samples to keep for saveStatsSeries(), the latest ones
 //
-// @returns                 : Returns an iterator to the next job in the pending list.
+// @returns                 : Nothing
 //********************************************************************************************
-list<Job*>::iterator ProcessScheduler::JobComplete(Job *job)
+void ProcessScheduler::setStatsSampling(long long interval, long long window, size_t keptSamples)
 {
-    unsigned long jobId = job->getJobId();
+    m_statsSeries.setup(interval, window, keptSamples);
+}
 
-    // Place this job in completed pool
-    m_completedJobPool[jobId] = job;
+//******************************************************************************************
+// @name                    : saveStatsSeries
+//
+// @description             : Writes the samples of the state of this scheduler to a CSV
+//                            file, with the rates over the window ending at each. Must only
+//                            be called once the simulation is over.
+//
+// @param fileName          : CSV file
+// @param append            : Add the samples to those of other schedulers in the file,
+//                            rather than starting a new file
+//
+// @returns                 : true if the samples were written,
+//                            false otherwise
+//********************************************************************************************
+bool ProcessScheduler::saveStatsSeries(const string & fileName, bool append)
+{
+    FILE *file = fopen(fileName.c_str(), append ? "a" : "w");
+    if (!file)
+    {
+        printf("ERROR: Unable to open %s\n", fileName.c_str());
+        return false;
+    }
 
-    // Remove from pending jobs pool
-    auto it = m_pendingJobPool.begin();
-    while (it != m_pendingJobPool.end())
+    if (!append)
     {
-        if ((*it)->getJobId() == jobId)
-        {
-            it = m_pendingJobPool.erase(it);
-            //printf(" Removing [%lu] from Pending pool\n", jobId);
-            break;
-        }
-        else
-        {
-            it++;
-        }
+        StatsSeries::writeCsvHeader(file);
     }
 
-    return it;
+    m_statsSeries.writeCsv(file, getSchedulerName(), getCpuCount());
+    fclose(file);
+    return true;
 }
 
 //******************************************************************************************
-// @name                    : DoJob
+// @name                    : orderPendingJobs
 //
-// @description             : Simulate execution of a job. This sleep is just a simulation 
-//                            for doing work. Once this sleep duration gets completed, it 
-//                            will be assumed that the job has finished executing.
-//
-// @param job               : Job to execute
+// @description             : Orders the pending job pool in the order in which the jobs
+//                            are to be executed, i.e. picks the next job to run. By default
+//                            jobs are run in their order of arrival.
 //
-// @returns                 : true on job completion, 
-//                            false otherwise
+// @returns                 : Nothing
 //********************************************************************************************
-bool ProcessScheduler::DoJob(Job *job)
+void ProcessScheduler::orderPendingJobs()
 {
-    Sleep(job->getJobTimeRemaining());
-    return true;
 }
 
 //******************************************************************************************
-// @name                    : setSimulationComplete
+// @name                    : getPhaseStats
 //
-// @description             : Marks end of simulation. This is used in ProcessJobs() function
-//                            to check if simulation has been terminated.
+// @description             : Fetches the stats of a phase of ProcessJobs(), to be given to
+//                            a ScopedPhaseTimer or a PhaseTimeline.
 //
-// @param val               : value
+// @param phase             : Phase
 //
-// @returns                 : Nothing
+// @returns                 : Stats of the phase, nullptr if phases are not timed
 //********************************************************************************************
-void ProcessScheduler::setSimulationComplete(bool val)
+PhaseStats* ProcessScheduler::getPhaseStats(schedulerPhase_en phase)
 {
-    m_schedulerMutex.lock();
-    m_simulationComplete = val; 
-    m_schedulerMutex.unlock();
+    return m_phaseTimersEnabled ? &m_phaseStats[phase] : nullptr;
 }
 
 //******************************************************************************************
-// @name                    : getResponseThresholdExceededJobs
+// @name                    : getHardwareCounters
 //
-// @description             : Gets the percentage of completed jobs whose response time
-//                            exceeded the threshold value.
+// @description             : Fetches the hardware counters of the scheduler thread. They
+//                            are opened on the first call, which must be made from the
+//                            thread running ProcessJobs(). They are not counted on several
+//                            CPUs, as they would only count the thread of one of them.
 //
-// @returns                 : %age of jobs whose response time exceeded threshold.
+// @returns                 : Hardware counters, nullptr if not enabled or not available
 //********************************************************************************************
-double ProcessScheduler::getResponseThresholdExceededJobs()
+HardwareCounters* ProcessScheduler::getHardwareCounters()
 {
-    long long countExceededResponseTimes = 0;
-    for (auto it = m_completedJobPool.begin(); it != m_completedJobPool.end(); it++)
+    if (!m_hardwareCountersEnabled || getCpuCount() > 1)
     {
-        Job *job = it->second;
+        return nullptr;
+    }
 
-        if (job->isResponseThresholdReached())
+    if (!m_hardwareCountersOpened)
+    {
+        m_hardwareCountersOpened = true;
+        if (!m_hardwareCounters.open())
         {
-            countExceededResponseTimes++;
+            LOG_WARNING("Hardware counters are not available for [ %s ]", getSchedulerName().c_str());
         }
     }
 
-    return ((double)countExceededResponseTimes / m_completedJobPool.size()) * 100;
-}
\ No newline at end of file
+    return m_hardwareCounters.isOpen() ? &m_hardwareCounters : nullptr;
+}
+
+void ProcessScheduler::setDisplayInterval(int interval)
+{
+    m_displayInterval = interval;
+}
+
+int ProcessScheduler::getDisplayInterval()
+{
+    return m_displayInterval;
+}
+
+//******************************************************************************************
+// @name                    : displayStats
+//
+// @description             : Displays statistics for this Scheduler, as last published by
+//                            the scheduler thread. This can be called from any thread.
+//
+// @returns                 : Nothing 
+//********************************************************************************************
+void ProcessScheduler::displayStats()
+{
+    schedulerStats_st stats = getStatsSnapshot();
+
+    printf("\n\n");
+    printf("+------------------------------------------------------------------------+\n");
+    printf("| %-70s |\n", getSchedulerName().c_str());
+    printf("+------------------------------------------------------------------------+\n");
+    printf("Time elapsed                            : %lld seconds\n", (stats.timeElapsed / NANOSECONDS_PER_SECOND));
+    printf("Total jobs added to ready queue         : %llu\n", stats.totalJobsInflow);
+    unsigned long long shedJobs = stats.rejectedJobs[ADMISSION_REJECTED_QUEUE_FULL] + stats.rejectedJobs[ADMISSION_REJECTED_WAIT] + stats.rejectedJobs[ADMISSION_REJECTED_DEADLINE];
+    if (shedJobs)
+    {
+        printf("Jobs shed on arrival                    : %llu (queue full: %llu, wait: %llu, deadline: %llu)\n",
+               shedJobs,
+               stats.rejectedJobs[ADMISSION_REJECTED_QUEUE_FULL],
+               stats.rejectedJobs[ADMISSION_REJECTED_WAIT],
+               stats.rejectedJobs[ADMISSION_REJECTED_DEADLINE]);
+    }
+    printf("Pending jobs                            : %llu\n", stats.pendingJobs);
+    printf("Completed jobs                          : %llu\n", stats.completedJobs);
+    printf("Job inflow rate                         : %lf per second.\n", getRate(stats.totalJobsInflow, stats.timeElapsed));
+    printf("Avg time required by job to complete    : %.2lf seconds\n", getAverage(stats.totalTimeRequired, stats.completedJobs, -1) / (double)NANOSECONDS_PER_SECOND);
+    printf("Average waiting time                    : %.2lf seconds\n", getAverage(stats.totalWaitingTime, stats.completedJobs, 0) / (double)NANOSECONDS_PER_SECOND);
+    printf("Average response time                   : %.2lf seconds\n", getAverage(stats.totalResponseTime, stats.completedJobs, -1) / (double)NANOSECONDS_PER_SECOND);
+    printf("Response threshold exceeded for         : %.2lf %% jobs\n", getAverage((long long)stats.thresholdExceededJobs * 100, stats.completedJobs, 0));
+    printf("Throughput                              : %lf per second.\n", getRate(stats.completedJobs, stats.timeElapsed));
+    printf("CPU utilization                         : %.2lf %%\n", getAverage(stats.cpuBusyTime * 100, stats.timeElapsed * getCpuCount(), 0));
+    if (stats.recentTimeSpan > 0)
+    {
+        printf("Recent throughput                       : %lf per second, over the last %.0lf seconds\n", stats.recentThroughput, stats.recentTimeSpan / (double)NANOSECONDS_PER_SECOND);
+        printf("Recent job inflow rate                  : %lf per second\n", stats.recentInflowRate);
+        printf("Recent CPU utilization                  : %.2lf %%\n", stats.recentCpuUtilization);
+    }
+    if (getCpuCount() > 1)
+    {
+        printf("CPUs                                    : %u (%s)\n", getCpuCount(), m_cpuSet.hasAffinity() ? "affinity" : "global queue");
+        printf("Migrations                              : %llu, %.2lf %% of the CPU time lost\n",
+               stats.migrations, getAverage(stats.migrationTime * 100, stats.timeElapsed * getCpuCount(), 0));
+    }
+    printf("Context switches                        : %llu, %.2lf %% of the CPU time lost\n",
+           stats.contextSwitches, getAverage(stats.contextSwitchTime * 100, stats.timeElapsed * getCpuCount(), 0));
+    printf("CPU efficiency                          : %.2lf %% of the busy time on useful work\n", getCpuEfficiency());
+    if (schedulesAllCpus())
+    {
+        printf("Fragmentation                           : %.2lf %% of the CPU time idle while jobs waited\n",
+               getAverage(stats.fragmentedTime * 100, stats.timeElapsed * getCpuCount(), 0));
+        printf("Backfilled jobs                         : %llu\n", stats.backfilledJobs);
+    }
+    if (stats.ioRequests)
+    {
+        printf("Blocked jobs                            : %llu\n", stats.blockedJobs);
+        printf("I/O bursts                              : %llu\n", stats.ioRequests);
+        printf("I/O device utilization                  : %.2lf %% of %u device(s)\n",
+               getAverage(stats.ioBusyTime * 100, stats.timeElapsed * m_ioController.getDeviceCount(), 0), m_ioController.getDeviceCount());
+        printf("CPU idle waiting for I/O                : %.2lf %%\n", getAverage(stats.ioWaitTime * 100, stats.timeElapsed, 0));
+    }
+    if (stats.predictedBursts)
+    {
+        printf("Burst prediction error                  : %.2lf seconds avg, %+.2lf seconds bias (%s)\n",
+               getAverage(stats.totalPredictionError, stats.predictedBursts, 0) / (double)NANOSECONDS_PER_SECOND,
+               getAverage(stats.totalPredictionBias, stats.predictedBursts, 0) / (double)NANOSECONDS_PER_SECOND,
+               m_burstPredictor->getEstimatorName());
+    }
+    printf("+------------------------------------------------------------------------+\n");
+    displayPhaseStats();
+    printf("\n");
+}
+
+//******************************************************************************************
+// @name                    : displayPhaseStats
+//
+// @description             : Displays the wall time spent by this Scheduler in each phase
+//                            of ProcessJobs(), i.e. in making scheduling decisions versus
+//                            simulating the work of jobs. Percentiles are estimated from
+//                            power of 2 histograms. This can be called from any thread.
+//
+// @returns                 : Nothing
+//********************************************************************************************
+void ProcessScheduler::displayPhaseStats()
+{
+    long long totalTime = 0;
+    bool hasHardwareCounts = false;
+    for (int phase = 0; phase < PHASE_MAX; phase++)
+    {
+        totalTime += m_phaseStats[phase].getTotalTime();
+        hasHardwareCounts = hasHardwareCounts || m_phaseStats[phase].getTotalCycles();
+    }
+
+    if (totalTime == 0)
+    {
+        return;
+    }
+
+    printf("%-20s %10s %12s %7s %10s %10s %10s %12s", "Phase", "Calls", "Total(ms)", "Share", "Avg(ns)", "p50(ns)", "p99(ns)", "Max(ns)");
+    printf(hasHardwareCounts ? " %13s %13s\n" : "\n", "Cycles/call", "Misses/call");
+
+    for (int phase = 0; phase < PHASE_MAX; phase++)
+    {
+        PhaseStats & stats = m_phaseStats[phase];
+        unsigned long long count = stats.getCount();
+        if (count == 0)
+        {
+            continue;
+        }
+
+        printf("%-20s %10llu %12.3lf %6.2lf%% %10.0lf %10lld %10lld %12lld",
+               PhaseStats::getPhaseName((schedulerPhase_en)phase),
+               count,
+               stats.getTotalTime() / (double)NANOSECONDS_PER_MILLISECOND,
+               stats.getTotalTime() * 100.0 / totalTime,
+               stats.getTotalTime() / (double)count,
+               stats.getPercentile(50),
+               stats.getPercentile(99),
+               stats.getMaxTime());
+
+        if (hasHardwareCounts)
+        {
+            printf(" %13.0lf %13.0lf", stats.getTotalCycles() / (double)count, stats.getTotalCacheMisses() / (double)count);
+        }
+
+        printf("\n");
+    }
+
+    printf("Scheduling overhead                     : %.2lf %% of the time in ProcessJobs\n",
+           (totalTime - m_phaseStats[PHASE_WORK].getTotalTime()) * 100.0 / totalTime);
+    printf("+------------------------------------------------------------------------+\n");
+}
+
+//******************************************************************************************
+// @name                    : getAverage
+//
+// @description             : Get average of a total over a number of jobs.
+//
+// @param total             : Sum of the values
+// @param count             : Number of values
+// @param defaultValue      : Returned if there are no values
+//
+// @returns                 : Average
+//********************************************************************************************
+double ProcessScheduler::getAverage(long long total, unsigned long long count, double defaultValue)
+{
+    if (count == 0)
+    {
+        return defaultValue;
+    }
+
+    return (double)total / count;
+}
+
+//******************************************************************************************
+// @name                    : getRate
+//
+// @description             : Get number of events per second.
+//
+// @param count             : Number of events
+// @param timeElapsed       : Time (ns) in which the events occurred
+//
+// @returns                 : Rate
+//********************************************************************************************
+double ProcessScheduler::getRate(unsigned long long count, long long timeElapsed)
+{
+    if (count == 0 || timeElapsed <= 0)
+    {
+        return 0;
+    }
+
+    return ((double)count * NANOSECONDS_PER_SECOND) / timeElapsed;
+}
+
+//******************************************************************************************
+// @name                    : getAverageWaitingTime
+//
+// @description             : Get average waiting time (in ns.) of all the completed jobs.
+//                            Wait time - time from work becoming enabled until the first 
+//                                        point it begins execution on resources
+//
+// @returns                 : AverageWaitingTime
+//********************************************************************************************
+double ProcessScheduler::getAverageWaitingTime()
+{
+    schedulerStats_st stats = getStatsSnapshot();
+    return getAverage(stats.totalWaitingTime, stats.completedJobs, 0);
+}
+
+//******************************************************************************************
+// @name                    : getAverageTimeRequired
+//
+// @description             : Get average time required (in ns.) of all the jobs that have completed
+//
+// @returns                 : AverageTimeRequired
+//********************************************************************************************
+double ProcessScheduler::getAverageTimeRequired()
+{
+    schedulerStats_st stats = getStatsSnapshot();
+    return getAverage(stats.totalTimeRequired, stats.completedJobs, -1);
+}
+
+//******************************************************************************************
+// @name                    : getAverageResponseTime
+//
+// @description             : Get average response time (in ns.) of all the jobs. 
+//                            Response time- time from work becoming enabled until it is finished 
+//
+// @returns                 : AverageResponseTime
+//********************************************************************************************
+double ProcessScheduler::getAverageResponseTime()
+{
+    schedulerStats_st stats = getStatsSnapshot();
+    return getAverage(stats.totalResponseTime, stats.completedJobs, -1);
+}
+
+//******************************************************************************************
+// @name                    : getThroughput
+//
+// @description             : Get throughput(the total amount of work completed per second).
+//
+// @returns                 : Throughput
+//********************************************************************************************
+double ProcessScheduler::getThroughput()
+{
+    schedulerStats_st stats = getStatsSnapshot();
+    return getRate(stats.completedJobs, stats.timeElapsed);
+}
+
+//******************************************************************************************
+// @name                    : getRecentThroughput
+//
+// @description             : Gets the jobs completed per second over the recent window,
+//                            as of the last sample of the state of this scheduler.
+//
+// @returns                 : Throughput, 0 till the first sample
+//********************************************************************************************
+double ProcessScheduler::getRecentThroughput()
+{
+    return getStatsSnapshot().recentThroughput;
+}
+
+//******************************************************************************************
+// @name                    : getCpuUtilization
+//
+// @description             : Gets the percentage of the time for which the CPUs were busy
+//                            executing jobs, on average.
+//
+// @returns                 : CPU utilization (%)
+//********************************************************************************************
+double ProcessScheduler::getCpuUtilization()
+{
+    schedulerStats_st stats = getStatsSnapshot();
+    return getAverage(stats.cpuBusyTime * 100, stats.timeElapsed * getCpuCount(), 0);
+}
+
+//******************************************************************************************
+// @name                    : getCpuEfficiency
+//
+// @description             : Gets the percentage of the time for which the CPUs were not
+//                            idle that went to executing jobs, rather than to switching
+//                            between them and warming up migrated jobs.
+//
+// @returns                 : CPU efficiency (%)
+//********************************************************************************************
+double ProcessScheduler::getCpuEfficiency()
+{
+    schedulerStats_st stats = getStatsSnapshot();
+    long long busyTime = stats.cpuBusyTime + stats.contextSwitchTime + stats.migrationTime;
+    return getAverage(stats.cpuBusyTime * 100, (unsigned long long)busyTime, 100);
+}
+
+//******************************************************************************************
+// @name                    : getJobInflowRate
+//
+// @description             : Get jobs added to ready queue per second.
+//
+// @returns                 : jobInflowRate
+//********************************************************************************************
+double ProcessScheduler::getJobInflowRate()
+{
+    schedulerStats_st stats = getStatsSnapshot();
+    return getRate(stats.totalJobsInflow, stats.timeElapsed);
+}
+
+//******************************************************************************************
+// @name                    : getRecentJobInflowRate
+//
+// @description             : Gets the jobs added to the ready queue per second over the
+//                            recent window, as of the last sample of the state of this
+//                            scheduler.
+//
+// @returns                 : Job inflow rate, 0 till the first sample
+//********************************************************************************************
+double ProcessScheduler::getRecentJobInflowRate()
+{
+    return getStatsSnapshot().recentInflowRate;
+}
+
+//******************************************************************************************
+// @name                    : JobComplete
+//
+// @description             : This will move the job from pending job pool to completed 
+//                            job pool and account for it in the published counters.
+//
+// @param job               : Job to execute
+//
+// @returns                 : Returns an iterator to the next job in the pending list, or
+//                            to its first job with tenant groups, unless the algorithm
+//                            rotates through it.
+//********************************************************************************************
+list<Job*>::iterator ProcessScheduler::JobComplete(Job *job)
+{
+    unsigned long jobId = job->getJobId();
+
+    observeCpuBurst(job);
+
+    m_jobsInSystem--;
+
+    // Place this job in completed pool
+    m_completedJobPool[jobId] = job;
+    m_stats.totalTimeRequired += job->getJobTimeRequired();
+    m_stats.totalWaitingTime += job->getWaitingTime();
+    m_stats.totalResponseTime += job->getResponseTime();
+    if (job->isResponseThresholdReached())
+    {
+        m_stats.thresholdExceededJobs++;
+    }
+
+    if (m_tenantGroups)
+    {
+        m_tenantGroups->accountCompletion(job->getTenantGroup(), job->getWaitingTime(), job->getResponseTime());
+    }
+
+    // Remove from pending jobs pool
+    auto it = m_pendingJobPool.begin();
+    if (m_pendingJobTable)
+    {
+        it = m_pendingJobPool.erase(m_pendingJobTable->remove(job));
+    }
+    else
+    {
+        while (it != m_pendingJobPool.end())
+        {
+            if ((*it)->getJobId() == jobId)
+            {
+                it = m_pendingJobPool.erase(it);
+                //printf(" Removing [%lu] from Pending pool\n", jobId);
+                break;
+            }
+            else
+            {
+                it++;
+            }
+        }
+    }
+
+    publishStats();
+    return (m_tenantGroups && !rotatesJobs()) ? m_pendingJobPool.begin() : it;
+}
+
+//******************************************************************************************
+// @name                    : JobBlocked
+//
+// @description             : This will move a job that has completed its CPU burst from
+//                            the pending job pool to the blocked pool, and submit its next
+//                            I/O burst to its device.
+//
+// @param job               : Job that needs I/O
+//
+// @returns                 : Returns an iterator to the next job in the pending list, or
+//                            to its first job with tenant groups (see JobComplete()).
+//********************************************************************************************
+list<Job*>::iterator ProcessScheduler::JobBlocked(Job *job)
+{
+    unsigned long jobId = job->getJobId();
+
+    observeCpuBurst(job);
+    job->markJobAsBlocked();
+    m_ioController.submit(job, m_clock->now());
+    m_stats.ioRequests++;
+    m_stats.ioBusyTime += job->getIoBurstTime();
+
+    // Remove from pending jobs pool
+    auto it = m_pendingJobPool.begin();
+    if (m_pendingJobTable)
+    {
+        it = m_pendingJobPool.erase(m_pendingJobTable->remove(job));
+    }
+    else
+    {
+        while (it != m_pendingJobPool.end())
+        {
+            if ((*it)->getJobId() == jobId)
+            {
+                it = m_pendingJobPool.erase(it);
+                break;
+            }
+            else
+            {
+                it++;
+            }
+        }
+    }
+
+    publishStats();
+    return (m_tenantGroups && !rotatesJobs()) ? m_pendingJobPool.begin() : it;
+}
+
+//******************************************************************************************
+// @name                    : DoJob
+//
+// @description             : Simulate execution of a job. This sleep is just a simulation 
+//                            for doing work. Once this sleep duration gets completed, it 
+//                            will be assumed that the job has finished executing.
+//                            A job with a payload or a coroutine runs its real work
+//                            instead, to completion.
+//
+// @param job               : Job to execute
+//
+// @returns                 : true on job completion, 
+//                            false otherwise
+//********************************************************************************************
+bool ProcessScheduler::DoJob(Job *job)
+{
+    if (job->hasPayload())
+    {
+        return executePayload(job);
+    }
+
+    if (job->hasCoroutine())
+    {
+        return executeCoroutine(job, -1);
+    }
+
+    // Run till the end of the CPU burst. The job is complete unless it needs I/O then.
+    accountTimeSlice(job, job->getCpuBurstRemaining());
+    serveTimeSlice();
+    return job->isLastCpuBurst();
+}
+
+//******************************************************************************************
+// @name                    : accountTimeSlice
+//
+// @description             : Records the time for which DoJob() ran the job, as the CPUs
+//                            it ran on were busy all that time. With tenant groups, the CPU
+//                            time is charged to the group of the job, as of the end of the
+//                            time slice, and the group to run next is picked again.
+//
+// @param job               : Job that ran
+// @param timeServed        : Time (ns) the job ran for
+// @param cpus              : CPUs it ran on at once
+//
+// @returns                 : Nothing
+//********************************************************************************************
+void ProcessScheduler::accountTimeSlice(Job *job, long long timeServed, unsigned int cpus)
+{
+    m_timeSliceServed = timeServed;
+    m_stats.cpuBusyTime += timeServed * cpus;
+    m_backlogTime -= timeServed;
+
+    if (m_tenantGroups)
+    {
+        // Real work and gangs are accounted for once they have run, the others before
+        bool served = job->hasPayload() || job->hasCoroutine() || schedulesAllCpus();
+        m_tenantGroups->charge(job->getTenantGroup(), timeServed * cpus, m_clock->now() + (served ? 0 : timeServed));
+        repickTenantGroups();
+    }
+}
+
+//******************************************************************************************
+// @name                    : serveTimeSlice
+//
+// @description             : Lets the time slice accounted for by accountTimeSlice() pass
+//                            on the clock, after the context switch to the job and its warm
+//                            up if it has migrated to this CPU. The other CPUs run in the
+//                            meantime, so the time slice is set again for the caller once
+//                            it is over.
+//
+// @returns                 : Nothing
+//********************************************************************************************
+void ProcessScheduler::serveTimeSlice()
+{
+    long long timeSlice = m_timeSliceServed;
+    long long overhead = m_cpuSet.takeOverhead();
+
+    if (!m_cpuSet.getLockstepClock())
+    {
+        m_clock->sleepFor(overhead + timeSlice);
+        return;
+    }
+
+    cpuState_st & cpu = m_cpuSet.getCurrentState();
+    cpu.tsBusyUntil = m_clock->now() + overhead + timeSlice;
+    m_clock->sleepFor(overhead + timeSlice);
+    cpu.tsBusyUntil = -1;
+    m_timeSliceServed = timeSlice;
+}
+
+//******************************************************************************************
+// @name                    : isDispatchable
+//
+// @description             : Checks whether a pending job may run on the calling CPU, i.e.
+//                            whether it may run on the CPU (see mayRunOnCpu()) and, with
+//                            tenant groups, belongs to the group picked to run next.
+//
+// @param job               : Pending job
+//
+// @returns                 : true if the job may run on the calling CPU,
+//                            false otherwise
+//********************************************************************************************
+bool ProcessScheduler::isDispatchable(Job *job)
+{
+    if (!mayRunOnCpu(job))
+    {
+        return false;
+    }
+
+    return (!m_tenantGroups || (int)job->getTenantGroup() == getTenantGroupPick());
+}
+
+//******************************************************************************************
+// @name                    : mayRunOnCpu
+//
+// @description             : Checks whether a pending job may run on the calling CPU, its
+//                            tenant group aside. It may not if it is running on another CPU.
+//                            With CPU affinity, a job that last ran on another CPU may not
+//                            either, unless the calling CPU had nothing else to run when it
+//                            last fetched jobs.
+//
+// @param job               : Pending job
+//
+// @returns                 : true if the job may run on the calling CPU,
+//                            false otherwise
+//********************************************************************************************
+bool ProcessScheduler::mayRunOnCpu(Job *job)
+{
+    if (!m_cpuSet.getLockstepClock())
+    {
+        return true;
+    }
+
+    if (job->getJobState() == STATE_RUNNING)
+    {
+        return false;
+    }
+
+    if (m_cpuSet.hasAffinity() && m_cpuSet.getCurrentState().hasAffineJob && m_cpuSet.isMigration(job))
+    {
+        return false;
+    }
+
+    return true;
+}
+
+//******************************************************************************************
+// @name                    : assignCpu
+//
+// @description             : Dispatches a job on the calling CPU, if it may run there (see
+//                            isDispatchable()). Must be called by ProcessJobs() before it
+//                            starts the job. If the CPU ran another job last, it is switched
+//                            to this one before its next time slice. A job that has run on
+//                            another CPU before is migrated, and is warmed up as well. With
+//                            tenant groups, the other CPUs pick a group again, as the job
+//                            is no longer theirs to run.
+//
+// @param job               : Pending job
+//
+// @returns                 : true if the job is to run on the calling CPU,
+//                            false if it is to be skipped
+//********************************************************************************************
+bool ProcessScheduler::assignCpu(Job *job)
+{
+    if ((m_cpuSet.getLockstepClock() || m_tenantGroups) && !isDispatchable(job))
+    {
+        return false;
+    }
+
+    unsigned int cpu = m_cpuSet.getCurrent();
+    m_cpuSet.getState(cpu).overheadTime += switchCpu(cpu, job);
+
+    if (m_cpuSet.getLockstepClock() && m_cpuSet.isMigration(job))
+    {
+        m_cpuSet.getState(cpu).overheadTime += m_cpuSet.getMigrationCost();
+        m_stats.migrations++;
+        m_stats.migrationTime += m_cpuSet.getMigrationCost();
+    }
+
+    job->setCpuId((unsigned short)cpu);
+    if (m_tenantGroups)
+    {
+        repickTenantGroups();
+    }
+
+    return true;
+}
+
+//******************************************************************************************
+// @name                    : switchCpu
+//
+// @description             : Switches a CPU to a job, which costs a context switch if the
+//                            CPU ran another job last.
+//
+// @param cpu               : CPU
+// @param job               : Job dispatched on the CPU
+//
+// @returns                 : Time (ns) the switch takes, 0 if the CPU ran the job last
+//********************************************************************************************
+long long ProcessScheduler::switchCpu(unsigned int cpu, Job *job)
+{
+    if (job->getJobId() == m_cpuSet.getState(cpu).lastJobId)
+    {
+        return 0;
+    }
+
+    long long switchCost = m_cpuSet.drawSwitchCost(m_stats.contextSwitches);
+    m_cpuSet.getState(cpu).lastJobId = job->getJobId();
+    m_stats.contextSwitches++;
+    m_stats.contextSwitchTime += switchCost;
+    return switchCost;
+}
+
+//******************************************************************************************
+// @name                    : hasDispatchableJob
+//
+// @description             : Checks whether there is a pending job for the calling CPU to
+//                            run, i.e. one that is not running on another CPU and, with
+//                            tenant groups, whose group is not throttled.
+//
+// @returns                 : true if there is a job to run,
+//                            false otherwise
+//********************************************************************************************
+bool ProcessScheduler::hasDispatchableJob()
+{
+    if (m_tenantGroups)
+    {
+        return (getTenantGroupPick() >= 0);
+    }
+
+    if (!m_cpuSet.getLockstepClock())
+    {
+        return !m_pendingJobPool.empty();
+    }
+
+    for (auto it = m_pendingJobPool.begin(); it != m_pendingJobPool.end(); it++)
+    {
+        if ((*it)->getJobState() != STATE_RUNNING)
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+//******************************************************************************************
+// @name                    : hasAffineJob
+//
+// @description             : Checks whether there is a pending job the calling CPU could
+//                            run without migrating it, i.e. a new job or one that last ran
+//                            on it.
+//
+// @returns                 : true if there is such a job,
+//                            false otherwise
+//********************************************************************************************
+bool ProcessScheduler::hasAffineJob()
+{
+    for (auto it = m_pendingJobPool.begin(); it != m_pendingJobPool.end(); it++)
+    {
+        if ((*it)->getJobState() != STATE_RUNNING && !m_cpuSet.isMigration(*it))
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+//******************************************************************************************
+// @name                    : runOnCpus
+//
+// @description             : Runs the simulation, i.e. ProcessJobs(), on every CPU of this
+//                            scheduler, and returns once all of them are done. The calling
+//                            thread is CPU 0, and each of the other CPUs has a thread of its
+//                            own, which takes turns with the others on a LockstepClock.
+//                            An algorithm that schedules all the CPUs itself runs only on
+//                            the calling thread.
+//
+// @returns                 : Nothing
+//********************************************************************************************
+void ProcessScheduler::runOnCpus()
+{
+    if (getCpuCount() == 1 || schedulesAllCpus())
+    {
+        ProcessJobs();
+        return;
+    }
+
+    if (!m_feeder)
+    {
+        LOG_WARNING("[ %s ] needs a virtual clock to run on %u CPUs, running on one", getSchedulerName().c_str(), getCpuCount());
+        m_cpuSet.setup(1, m_cpuSet.hasAffinity(), m_cpuSet.getMigrationCost());
+        ProcessJobs();
+        return;
+    }
+
+    SimulationClock *baseClock = m_clock;
+    LockstepClock lockstepClock(baseClock, getCpuCount());
+    vector<thread> cpuThreads;
+
+    m_clock = &lockstepClock;
+    m_cpuSet.attachLockstepClock(&lockstepClock);
+
+    for (unsigned int cpu = 1; cpu < getCpuCount(); cpu++)
+    {
+        cpuThreads.push_back(thread(&ProcessScheduler::runCpu, this, cpu));
+    }
+
+    runCpu(0);
+    for (auto it = cpuThreads.begin(); it != cpuThreads.end(); it++)
+    {
+        it->join();
+    }
+
+    m_cpuSet.detachLockstepClock();
+    m_clock = baseClock;
+}
+
+//******************************************************************************************
+// @name                    : runCpu
+//
+// @description             : Runs ProcessJobs() as one of the CPUs of this scheduler.
+//
+// @param cpu               : CPU of the calling thread
+//
+// @returns                 : Nothing
+//********************************************************************************************
+void ProcessScheduler::runCpu(unsigned int cpu)
+{
+    m_cpuSet.getLockstepClock()->enter(cpu);
+    ProcessJobs();
+    m_cpuSet.getLockstepClock()->leave();
+}
+
+//******************************************************************************************
+// @name                    : setBurstPredictor
+//
+// @description             : Makes this scheduler order jobs on predicted CPU bursts instead
+//                            of the actual ones. Must be done before any job is added.
+//
+// @param predictor         : Predictor, deleted by the scheduler
+// @param oracleName        : Name of the scheduler doing the same on the actual bursts, to
+//                            compare the results with
+//
+// @returns                 : Nothing
+//********************************************************************************************
+void ProcessScheduler::setBurstPredictor(BurstPredictor *predictor, const string & oracleName)
+{
+    delete m_burstPredictor;
+    m_burstPredictor = predictor;
+    m_oracleSchedulerName = oracleName;
+}
+
+//******************************************************************************************
+// @name                    : setTenantGroups
+//
+// @description             : Makes this scheduler share the CPUs between tenant groups: a
+//                            job only runs when its group is picked to run next, and the
+//                            algorithm picks the job to run among those of that group. Must
+//                            be done before any job is added.
+//
+// @param groups            : Tenant groups, deleted by the scheduler
+//
+// @returns                 : Nothing
+//********************************************************************************************
+void ProcessScheduler::setTenantGroups(TenantGroups *groups)
+{
+    delete m_tenantGroups;
+    m_tenantGroups = groups;
+}
+
+//******************************************************************************************
+// @name                    : getTenantGroupPick
+//
+// @description             : Fetches the tenant group whose jobs the calling CPU is to run
+//                            next. The group is picked among those of the pending jobs that
+//                            may run on the CPU, and is kept till repickTenantGroups().
+//
+// @returns                 : Tenant group picked, -1 if all the groups with jobs to run
+//                            are throttled
+//********************************************************************************************
+int ProcessScheduler::getTenantGroupPick()
+{
+    cpuState_st &cpuState = m_cpuSet.getCurrentState();
+    if (!cpuState.tenantGroupPicked)
+    {
+        m_tenantGroups->clearRunnableJobs();
+        for (Job *job : m_pendingJobPool)
+        {
+            if (job->getJobState() != STATE_RUNNING && mayRunOnCpu(job))
+            {
+                m_tenantGroups->addRunnableJob(job->getTenantGroup());
+            }
+        }
+
+        cpuState.tenantGroup = m_tenantGroups->pick(m_clock->now());
+        cpuState.tenantGroupPicked = true;
+    }
+
+    return cpuState.tenantGroup;
+}
+
+//******************************************************************************************
+// @name                    : displayTenantStats
+//
+// @description             : Displays the share of the CPU time each tenant group got and
+//                            how it served its jobs, if this scheduler has tenant groups.
+//                            Must only be called once the simulation is over.
+//
+// @returns                 : Nothing
+//********************************************************************************************
+void ProcessScheduler::displayTenantStats()
+{
+    if (!m_tenantGroups)
+    {
+        return;
+    }
+
+    vector<tenantResult_st> results;
+    m_tenantGroups->getResults(results, getStatsSnapshot().timeElapsed);
+
+    printf("+------------------------------------------------------------------------+\n");
+    printf("| %-70s |\n", "Tenant groups");
+    printf("+------------------------------------------------------------------------+\n");
+    for (const tenantResult_st &result : results)
+    {
+        printf("%-40s: %zu jobs, %.2lf %% of the CPU time (%.2lf %% entitled), %.2lf seconds avg response, %.2lf seconds throttled\n",
+               result.name.c_str(),
+               result.completedJobs,
+               result.cpuShare,
+               result.entitledShare,
+               result.avgResponseTime / (double)NANOSECONDS_PER_SECOND,
+               result.throttledTime / (double)NANOSECONDS_PER_SECOND);
+    }
+    printf("+------------------------------------------------------------------------+\n\n");
+}
+
+//******************************************************************************************
+// @name                    : getPredictedBurstRemaining
+//
+// @description             : Fetches the CPU time a job is expected to run for till it
+//                            completes or needs I/O. This is the actual time left in its
+//                            CPU burst, unless bursts are predicted. A job that has run
+//                            longer than predicted is expected to be done any time now.
+//
+// @param job               : Job
+//
+// @returns                 : Time (ns) left in the current CPU burst
+//********************************************************************************************
+long long ProcessScheduler::getPredictedBurstRemaining(Job *job)
+{
+    if (!m_burstPredictor)
+    {
+        return job->getCpuBurstRemaining();
+    }
+
+    long long timeRemaining = m_burstPredictor->predict(job) - job->getCpuBurstServed();
+    return (timeRemaining > 0) ? timeRemaining : 0;
+}
+
+//******************************************************************************************
+// @name                    : observeCpuBurst
+//
+// @description             : Lets the burst predictor, if any, learn from the CPU burst a
+//                            job has just ended, and accounts for the error of its
+//                            prediction.
+//
+// @param job               : Job that is complete or needs I/O
+//
+// @returns                 : Nothing
+//********************************************************************************************
+void ProcessScheduler::observeCpuBurst(Job *job)
+{
+    if (!m_burstPredictor)
+    {
+        return;
+    }
+
+    long long error = m_burstPredictor->observe(job);
+    m_stats.predictedBursts++;
+    m_stats.totalPredictionError += (error < 0) ? -error : error;
+    m_stats.totalPredictionBias += error;
+}
+
+//******************************************************************************************
+// @name                    : runOnWorker
+//
+// @description             : Runs a payload on the worker pool if one is set, or else on
+//                            the calling thread.
+//
+// @param payload           : Payload to run
+//
+// @returns                 : CPU time (ns) taken by the payload
+//********************************************************************************************
+long long ProcessScheduler::runOnWorker(const jobPayload_fn & payload)
+{
+    return m_workerPool ? m_workerPool->execute(payload) : WorkerPool::runPayload(payload);
+}
+
+//******************************************************************************************
+// @name                    : executePayload
+//
+// @description             : Runs the payload of a job to completion, on the worker pool
+//                            if one is set, or else on the calling thread. The CPU time
+//                            taken by the payload becomes the time required by the job.
+//                            If less time than that has passed on the clock (which is the
+//                            case on a VirtualClock), the clock is moved ahead by the rest.
+//                            The cost of switching the CPU to the job passes first.
+//
+// @param job               : Job to execute
+//
+// @returns                 : true, as a payload always runs to completion
+//********************************************************************************************
+bool ProcessScheduler::executePayload(Job *job)
+{
+    m_clock->sleepFor(m_cpuSet.takeOverhead());
+
+    long long tsStart = m_clock->now();
+    long long cpuTime = runOnWorker(job->getPayload());
+    long long timeElapsed = m_clock->now() - tsStart;
+
+    if (timeElapsed < cpuTime)
+    {
+        m_clock->sleepFor(cpuTime - timeElapsed);
+    }
+
+    accountTimeSlice(job, cpuTime);
+    setMeasuredTimeRequired(job, job->getJobTimeServed() + cpuTime);
+    return true;
+}
+
+//******************************************************************************************
+// @name                    : executeCoroutine
+//
+// @description             : Resumes the coroutine of a job, in the same way as
+//                            executePayload(), till it is complete or its time slice
+//                            expires. The time served is the CPU time it actually ran for,
+//                            which overshoots the time slice by the work till the next
+//                            checkpoint. Once the coroutine is complete, the time served
+//                            becomes the time required by the job.
+//
+// @param job               : Job to execute
+// @param timeSlice         : Time slice (ns), -1 to run it to completion
+//
+// @returns                 : true on job completion,
+//                            false otherwise
+//********************************************************************************************
+bool ProcessScheduler::executeCoroutine(Job *job, long long timeSlice)
+{
+    JobCoroutine & coroutine = job->getCoroutine();
+    m_clock->sleepFor(m_cpuSet.takeOverhead());
+
+    long long tsStart = m_clock->now();
+    long long cpuTime = runOnWorker([&coroutine, timeSlice] { coroutine.resume(timeSlice); });
+    long long timeElapsed = m_clock->now() - tsStart;
+
+    if (timeElapsed < cpuTime)
+    {
+        m_clock->sleepFor(cpuTime - timeElapsed);
+    }
+
+    accountTimeSlice(job, cpuTime);
+    if (!coroutine.isDone())
+    {
+        return false;
+    }
+
+    setMeasuredTimeRequired(job, job->getJobTimeServed() + cpuTime);
+    return true;
+}
+
+//******************************************************************************************
+// @name                    : setMeasuredTimeRequired
+//
+// @description             : Replaces the time required of a job whose real work is done
+//                            with the CPU time it took, and takes the difference out of the
+//                            backlog, which was estimated with the time required.
+//
+// @param job               : Job whose work is complete
+// @param timeRequired      : CPU time (ns) the work took in all
+//
+// @returns                 : Nothing
+//********************************************************************************************
+void ProcessScheduler::setMeasuredTimeRequired(Job *job, long long timeRequired)
+{
+    m_backlogTime -= job->getJobTimeRequired() - timeRequired;
+    job->setJobTimeRequired(timeRequired);
+}
+
+//******************************************************************************************
+// @name                    : setPayloadKernel
+//
+// @description             : Turns on real execution mode for the jobs added from now on
+//                            without a payload of their own: each of them is given a
+//                            built-in kernel, taking its time required times the scale
+//                            of CPU time.
+//
+// @param kernel            : Kernel to run, PAYLOAD_KERNEL_NONE to simulate the work
+// @param scale             : CPU time of the payload per ns of time required
+// @param preemptible       : Give the kernel as a coroutine, with a checkpoint after
+//                            every unit of work
+//
+// @returns                 : Nothing
+//********************************************************************************************
+void ProcessScheduler::setPayloadKernel(payloadKernel_en kernel, double scale, bool preemptible)
+{
+    m_payloadKernel = kernel;
+    m_payloadScale = scale;
+    m_payloadPreemptible = preemptible;
+}
+
+//******************************************************************************************
+// @name                    : setCheckpointInterval
+//
+// @description             : Makes the scheduler save a checkpoint periodically while it
+//                            runs. Each checkpoint replaces the previous one.
+//
+// @param fileName          : File to save the checkpoints to
+// @param interval          : Simulated time (ns) between two checkpoints, 0 for none
+//
+// @returns                 : true if the checkpoints can be saved,
+//                            false otherwise
+//******************************************************************************************
+bool ProcessScheduler::setCheckpointInterval(const string & fileName, long long interval)
+{
+    m_checkpointFile = fileName;
+    m_checkpointInterval = (interval > 0) ? interval : 0;
+    m_tsNextCheckpoint = -1;
+
+    return (m_checkpointInterval == 0 || canCheckpoint());
+}
+
+//******************************************************************************************
+// @name                    : canCheckpoint
+//
+// @description             : Checks whether the state of this scheduler can be saved to a
+//                            checkpoint. It cannot while jobs are added by a job creation
+//                            thread, as the thread and the real time clock are not part of
+//                            the checkpoint, or while jobs carry real work, as a payload or
+//                            a coroutine part way through cannot be saved.
+//
+// @returns                 : true if it can be checkpointed,
+//                            false otherwise
+//******************************************************************************************
+bool ProcessScheduler::canCheckpoint()
+{
+    if (!m_feeder)
+    {
+        printf("ERROR: Checkpoints need a workload feeder, i.e. a virtual clock\n");
+        return false;
+    }
+
+    if (m_workerPool || m_payloadKernel != PAYLOAD_KERNEL_NONE)
+    {
+        printf("ERROR: Checkpoints are not supported in real execution mode\n");
+        return false;
+    }
+
+    if (getCpuCount() > 1)
+    {
+        printf("ERROR: Checkpoints are not supported on several CPUs\n");
+        return false;
+    }
+
+    if (schedulesAllCpus())
+    {
+        printf("ERROR: Checkpoints are not supported by [ %s ]\n", m_schedulerName.c_str());
+        return false;
+    }
+
+    return true;
+}
+
+//******************************************************************************************
+// @name                    : saveJobs
+//
+// @description             : Saves the jobs of a pool to a checkpoint, in their order.
+//
+// @param writer            : Checkpoint
+// @param pool              : Jobs
+//
+// @returns                 : Nothing
+//******************************************************************************************
+void ProcessScheduler::saveJobs(CheckpointWriter & writer, list<Job*> & pool)
+{
+    writer.write((unsigned long long)pool.size());
+    for (Job *job : pool)
+    {
+        job->saveCheckpoint(writer);
+    }
+}
+
+//******************************************************************************************
+// @name                    : restoreJobs
+//
+// @description             : Restores the jobs saved by saveJobs() to a pool.
+//
+// @param reader            : Checkpoint
+// @param clock             : Clock of the restored jobs
+// @param pool              : Pool the jobs are appended to
+//
+// @returns                 : true if the checkpoint could be read,
+//                            false otherwise
+//******************************************************************************************
+bool ProcessScheduler::restoreJobs(CheckpointReader & reader, SimulationClock *clock, list<Job*> & pool)
+{
+    unsigned long long count = reader.read<unsigned long long>();
+    for (unsigned long long index = 0; index < count && !reader.hasFailed(); index++)
+    {
+        pool.push_back(new Job(reader, clock));
+    }
+
+    return !reader.hasFailed();
+}
+
+//******************************************************************************************
+// @name                    : saveCheckpoint
+//
+// @description             : Saves the state of the simulation to a checkpoint file. Must
+//                            only be called from the thread running ProcessJobs(), between
+//                            jobs, or while it is not running.
+//
+// @param fileName          : Checkpoint file. It is replaced once the new checkpoint is
+//                            complete.
+//
+// @returns                 : true if the checkpoint was saved,
+//                            false otherwise
+//******************************************************************************************
+bool ProcessScheduler::saveCheckpoint(const string & fileName)
+{
+    if (!canCheckpoint())
+    {
+        return false;
+    }
+
+    CheckpointWriter writer;
+    if (!writer.open(fileName))
+    {
+        return false;
+    }
+
+    long long tsNow = m_clock->now();
+    writer.writeString(m_schedulerName);
+    writer.write(tsNow);
+    writer.write(m_tsCreated);
+    m_feeder->saveCheckpoint(writer);
+
+    writer.write((unsigned int)sizeof(m_stats));
+    writer.write(m_stats);
+    writer.write(m_totalJobsInflow.load());
+    for (int status = 0; status < ADMISSION_MAX; status++)
+    {
+        writer.write(m_rejectedJobs[status].load());
+    }
+    writer.write(m_jobsInSystem.load());
+    writer.write(m_backlogTime.load());
+    writer.write(m_tsIoWaitStart);
+    writer.write(m_timeSliceServed);
+    writer.write(m_cpuSet.getState(0).lastJobId);
+
+    m_schedulerMutex.lock();
+    saveJobs(writer, m_readyJobPool);
+    m_schedulerMutex.unlock();
+    saveJobs(writer, m_pendingJobPool);
+    m_ioController.saveCheckpoint(writer);
+
+    writer.write((unsigned long long)m_completedJobPool.size());
+    for (auto it = m_completedJobPool.begin(); it != m_completedJobPool.end(); it++)
+    {
+        it->second->saveCheckpoint(writer);
+    }
+
+    writer.write(m_burstPredictor != nullptr);
+    if (m_burstPredictor)
+    {
+        m_burstPredictor->saveCheckpoint(writer);
+    }
+
+    writer.write(m_tenantGroups != nullptr);
+    if (m_tenantGroups)
+    {
+        m_tenantGroups->saveCheckpoint(writer);
+    }
+
+    m_statsSeries.saveCheckpoint(writer);
+
+    if (!writer.commit())
+    {
+        return false;
+    }
+
+    LOG_INFO("[ %s ] checkpoint saved to '%s' at %.2lf s.", m_schedulerName.c_str(), fileName.c_str(), (tsNow - m_tsCreated) / (double)NANOSECONDS_PER_SECOND);
+    return true;
+}
+
+//******************************************************************************************
+// @name                    : restoreCheckpoint
+//
+// @description             : Restores the state of a simulation from a checkpoint file, so
+//                            that ProcessJobs() resumes it from there. Must be called after
+//                            the clock and the workload feeder are set, and before any job
+//                            is added. The clock is moved ahead to the time the checkpoint
+//                            was taken at, so it must not be past it. The workload must be
+//                            the one the checkpoint was taken on.
+//
+//                            The checkpoint may have been taken with another algorithm. Its
+//                            predictions of the CPU bursts are only restored if this
+//                            scheduler predicts them too. Its tenant groups, if any, must be
+//                            the ones of this scheduler, and so must its stats sample
+//                            interval and window. The scheduler must be discarded if the
+//                            restore fails.
+//
+// @param fileName          : Checkpoint file
+//
+// @returns                 : true if the simulation was restored,
+//                            false otherwise
+//******************************************************************************************
+bool ProcessScheduler::restoreCheckpoint(const string & fileName)
+{
+    if (!canCheckpoint())
+    {
+        return false;
+    }
+
+    if (m_totalJobsInflow.load() || !m_completedJobPool.empty())
+    {
+        printf("ERROR: A checkpoint can only be restored before the simulation starts\n");
+        return false;
+    }
+
+    CheckpointReader reader;
+    if (!reader.open(fileName))
+    {
+        return false;
+    }
+
+    string schedulerName = reader.readString();
+    long long tsSaved = reader.read<long long>();
+    long long tsCreated = reader.read<long long>();
+    if (reader.hasFailed())
+    {
+        printf("ERROR: Checkpoint file '%s' is corrupt\n", fileName.c_str());
+        return false;
+    }
+
+    if (tsSaved < m_clock->now())
+    {
+        printf("ERROR: The clock of [ %s ] is already past the checkpoint\n", m_schedulerName.c_str());
+        return false;
+    }
+
+    if (!m_feeder->restoreCheckpoint(reader))
+    {
+        return false;
+    }
+
+    bool restored = (reader.read<unsigned int>() == sizeof(m_stats));
+    m_stats = reader.read<schedulerStats_st>();
+    m_totalJobsInflow = reader.read<unsigned long long>();
+    for (int status = 0; status < ADMISSION_MAX; status++)
+    {
+        m_rejectedJobs[status] = reader.read<unsigned long long>();
+    }
+    m_jobsInSystem = reader.read<unsigned long long>();
+    m_backlogTime = reader.read<long long>();
+    m_tsIoWaitStart = reader.read<long long>();
+    m_timeSliceServed = reader.read<long long>();
+    m_cpuSet.getState(0).lastJobId = reader.read<unsigned long>();
+
+    list<Job*> restoredJobs;
+    list<Job*> completedJobs;
+    restored = restored && restoreJobs(reader, m_clock, m_readyJobPool);
+    restored = restored && restoreJobs(reader, m_clock, m_pendingJobPool);
+    resetPendingJobTable();
+    restored = restored && m_ioController.restoreCheckpoint(reader, m_clock, restoredJobs);
+    restored = restored && restoreJobs(reader, m_clock, completedJobs);
+
+    for (Job *job : completedJobs)
+    {
+        m_completedJobPool[job->getJobId()] = job;
+    }
+
+    bool hasPredictions = reader.read<bool>();
+    if (restored && hasPredictions)
+    {
+        // Read the predictions anyway, to check the whole checkpoint
+        BurstPredictor predictions(nullptr, 0);
+        BurstPredictor *predictor = m_burstPredictor ? m_burstPredictor : &predictions;
+        restored = predictor->restoreCheckpoint(reader);
+    }
+
+    bool hasTenantGroups = reader.read<bool>();
+    if (restored && !reader.hasFailed() && hasTenantGroups != (m_tenantGroups != nullptr))
+    {
+        printf("ERROR: The checkpoint was taken with other tenant groups\n");
+        return false;
+    }
+
+    if (restored && hasTenantGroups)
+    {
+        restored = m_tenantGroups->restoreCheckpoint(reader);
+    }
+
+    restored = restored && m_statsSeries.restoreCheckpoint(reader);
+
+    if (!restored || reader.hasFailed())
+    {
+        printf("ERROR: Checkpoint file '%s' is corrupt\n", fileName.c_str());
+        return false;
+    }
+
+    restoredJobs.insert(restoredJobs.end(), m_readyJobPool.begin(), m_readyJobPool.end());
+    restoredJobs.insert(restoredJobs.end(), m_pendingJobPool.begin(), m_pendingJobPool.end());
+    for (Job *job : restoredJobs)
+    {
+        job->setTraceTrack(m_traceTrack);
+    }
+
+    m_clock->sleepFor(tsSaved - m_clock->now());
+    m_tsCreated = tsCreated;
+    m_tsNextCheckpoint = -1;
+    publishStats();
+
+    if (schedulerName != m_schedulerName)
+        LOG_INFO("Resuming the checkpoint of [ %s ] with [ %s ]", schedulerName.c_str(), m_schedulerName.c_str());
+    LOG_INFO("[ %s ] restored from '%s' at %.2lf s.", m_schedulerName.c_str(), fileName.c_str(), (tsSaved - m_tsCreated) / (double)NANOSECONDS_PER_SECOND);
+
+    return true;
+}
+
+//******************************************************************************************
+// @name                    : setSimulationComplete
+//
+// @description             : Marks end of simulation. This is used in ProcessJobs() function
+//                            to check if simulation has been terminated.
+//
+// @param val               : value
+//
+// @returns                 : Nothing
+//********************************************************************************************
+void ProcessScheduler::setSimulationComplete(bool val)
+{
+    m_simulationComplete.store(val);
+}
+
+//******************************************************************************************
+// @name                    : getResponseThresholdExceededJobs
+//
+// @description             : Gets the percentage of completed jobs whose response time
+//                            exceeded the threshold value.
+//
+// @returns                 : %age of jobs whose response time exceeded threshold.
+//********************************************************************************************
+double ProcessScheduler::getResponseThresholdExceededJobs()
+{
+    schedulerStats_st stats = getStatsSnapshot();
+    return getAverage((long long)stats.thresholdExceededJobs * 100, stats.completedJobs, 0);
+}
+
+//******************************************************************************************
+// @name                    : getSimulationResult
+//
+// @description             : Collects the metrics of this scheduler. Wall time is not known
+//                            to the scheduler and is left to the caller.
+//
+// @param result            : Result of the simulation
+//
+// @returns                 : Nothing
+//********************************************************************************************
+void ProcessScheduler::getSimulationResult(simulationResult_st & result)
+{
+    result.schedulerName = getSchedulerName();
+    result.completedJobs = getCompletedJobs();
+    result.shedJobs = (size_t)getShedJobs();
+    result.avgTimeRequired = getAverageTimeRequired();
+    result.avgWaitingTime = getAverageWaitingTime();
+    result.avgResponseTime = getAverageResponseTime();
+    result.thresholdExceeded = getResponseThresholdExceededJobs();
+    result.throughput = getThroughput();
+    result.cpuUtilization = getCpuUtilization();
+    result.simulatedTime = getStatsSnapshot().timeElapsed;
+    result.wallTime = 0;
+
+    schedulerStats_st stats = getStatsSnapshot();
+    result.cpus = getCpuCount();
+    result.migrations = stats.migrations;
+    result.migrationOverhead = getAverage(stats.migrationTime * 100, stats.timeElapsed * getCpuCount(), 0);
+    result.contextSwitches = stats.contextSwitches;
+    result.contextSwitchOverhead = getAverage(stats.contextSwitchTime * 100, stats.timeElapsed * getCpuCount(), 0);
+    result.cpuEfficiency = getCpuEfficiency();
+    result.fragmentation = schedulesAllCpus() ? getAverage(stats.fragmentedTime * 100, stats.timeElapsed * getCpuCount(), 0) : -1;
+    result.backfilledJobs = stats.backfilledJobs;
+    result.avgPredictionError = getAverage(stats.totalPredictionError, stats.predictedBursts, -1);
+    result.avgPredictionBias = getAverage(stats.totalPredictionBias, stats.predictedBursts, 0);
+    result.oracleSchedulerName = m_burstPredictor ? m_oracleSchedulerName : "";
+
+    result.tenantGroups.clear();
+    if (m_tenantGroups)
+    {
+        m_tenantGroups->getResults(result.tenantGroups, stats.timeElapsed);
+    }
+}
+
+//******************************************************************************************
+// @name                    : getResponseTimes
+//
+// @description             : Fetches the response times of all the completed jobs, e.g. to
+//                            find the percentiles. Must only be called once the simulation
+//                            is over.
+//
+// @param responseTimes     : Response times (ns), appended to
+//
+// @returns                 : Nothing
+//********************************************************************************************
+void ProcessScheduler::getResponseTimes(vector<long long> & responseTimes)
+{
+    for (auto it = m_completedJobPool.begin(); it != m_completedJobPool.end(); it++)
+    {
+        responseTimes.push_back(it->second->getResponseTime());
+    }
+}
@@ -6,6 +6,15 @@ RandomGenerator::RandomGenerator()
     m_bIsSeedGenerated = false;
 }
 
+/*******************************************************************************************************************/
+/* Generator with a fixed seed. It always generates the same sequence of numbers. */
+/*******************************************************************************************************************/
+RandomGenerator::RandomGenerator(unsigned int seed)
+{
+    m_engine.seed(seed);
+    m_bIsSeedGenerated = true;
+}
+
 /*******************************************************************************************************************/
 RandomGenerator::~RandomGenerator()
 {
@@ -15,7 +24,8 @@ RandomGenerator::~RandomGenerator()
 /*******************************************************************************************************************/
 void RandomGenerator::generateSeed()
 {
-    srand((unsigned)time(0));
+    random_device device;
+    m_engine.seed(device() ^ (unsigned)time(0));
     m_bIsSeedGenerated = true;
 }
 
@@ -28,12 +38,12 @@ unsigned int RandomGenerator::generateRandomNumber(unsigned int range)
 
     if (m_bIsSeedGenerated)
     {
-        return rand() % range;
+        return m_engine() % range;
     }
     else
     {
         generateSeed();
-        return rand() % range;
+        return m_engine() % range;
     }
 }
 
@@ -0,0 +1,252 @@
+#include "scheduler_registry.h"
+#include "fcfs.h"
+#include "sjf.h"
+#include "srtf.h"
+#include "priority.h"
+#include "priority_ageing.h"
+#include "round_robin.h"
+#include "gang_scheduler.h"
+#include<stdio.h>
+
+//---------------------------------------------------------------------------------------------------
+// Factories of the schedulers of this project
+//---------------------------------------------------------------------------------------------------
+static ProcessScheduler* createFirstComeFirstServed(const simulationConfig_st &)
+{
+    return new FirstComeFirstServed("First Come First Served");
+}
+
+static ProcessScheduler* createPriorityScheduling(const simulationConfig_st &)
+{
+    return new PriorityScheduling("Priority Scheduling");
+}
+
+static ProcessScheduler* createPriorityAgeingScheduling(const simulationConfig_st & config)
+{
+    return new PriorityAgeingScheduling("Priority Scheduling with Ageing", config.ageingRate);
+}
+
+static ProcessScheduler* createShortestJobFirst(const simulationConfig_st &)
+{
+    return new ShortestJobFirst("Shortest Job First");
+}
+
+static ProcessScheduler* createShortestJobFirstPredicted(const simulationConfig_st & config)
+{
+    ProcessScheduler *scheduler = new ShortestJobFirst("Shortest Job First (predicted)");
+    scheduler->setBurstPredictor(BurstPredictor::create(config.burstEstimator, config.burstAlpha, config.burstInitialEstimate), "Shortest Job First");
+    return scheduler;
+}
+
+static ProcessScheduler* createShortestRemainingTimeFirst(const simulationConfig_st & config)
+{
+    return new ShortestRemainingTimeFirst("Shortest Remaining Time First", config.timeQuantum);
+}
+
+static ProcessScheduler* createShortestRemainingTimeFirstPredicted(const simulationConfig_st & config)
+{
+    ProcessScheduler *scheduler = new ShortestRemainingTimeFirst("Shortest Remaining Time First (predicted)", config.timeQuantum);
+    scheduler->setBurstPredictor(BurstPredictor::create(config.burstEstimator, config.burstAlpha, config.burstInitialEstimate), "Shortest Remaining Time First");
+    return scheduler;
+}
+
+static ProcessScheduler* createRoundRobin(const simulationConfig_st & config)
+{
+    return new RoundRobin("Round Robin", config.timeQuantum);
+}
+
+static ProcessScheduler* createGangScheduling(const simulationConfig_st &)
+{
+    return new GangScheduler("Gang Scheduling", GANG_PACKING_FCFS);
+}
+
+static ProcessScheduler* createGangSchedulingFirstFit(const simulationConfig_st &)
+{
+    return new GangScheduler("Gang Scheduling (first fit)", GANG_PACKING_FIRST_FIT);
+}
+
+static ProcessScheduler* createGangSchedulingBackfill(const simulationConfig_st &)
+{
+    return new GangScheduler("Gang Scheduling (backfilling)", GANG_PACKING_BACKFILL);
+}
+
+//******************************************************************************************
+// @name                    : SchedulerRegistry
+//
+// @description             : Constructor
+//
+// @returns                 : Nothing
+//******************************************************************************************
+SchedulerRegistry::SchedulerRegistry()
+{
+    registerBuiltinSchedulers();
+}
+
+//******************************************************************************************
+// @name                    : registerBuiltinSchedulers
+//
+// @description             : Registers all the schedulers implemented by this project.
+//                            These are registered here rather than from the file of each
+//                            scheduler, as static initializers of a library are dropped
+//                            by the linker if nothing else refers to their file.
+//
+// @returns                 : Nothing
+//******************************************************************************************
+void SchedulerRegistry::registerBuiltinSchedulers()
+{
+    registerScheduler("fcfs", "First Come First Served", createFirstComeFirstServed);
+    registerScheduler("priority", "Priority Scheduling", createPriorityScheduling);
+    registerScheduler("priority_ageing", "Priority Scheduling with Ageing", createPriorityAgeingScheduling);
+    registerScheduler("sjf", "Shortest Job First", createShortestJobFirst);
+    registerScheduler("sjf_predicted", "Shortest Job First on predicted bursts", createShortestJobFirstPredicted);
+    registerScheduler("srtf", "Shortest Remaining Time First", createShortestRemainingTimeFirst);
+    registerScheduler("srtf_predicted", "Shortest Remaining Time First on predicted bursts", createShortestRemainingTimeFirstPredicted);
+    registerScheduler("rr", "Round Robin", createRoundRobin);
+    registerScheduler("gang", "Gang Scheduling of parallel jobs", createGangScheduling);
+    registerScheduler("gang_first_fit", "Gang Scheduling, first job that fits", createGangSchedulingFirstFit);
+    registerScheduler("gang_backfill", "Gang Scheduling with EASY backfilling", createGangSchedulingBackfill);
+}
+
+//******************************************************************************************
+// @name                    : getInstance
+//
+// @description             : Fetches the registry.
+//
+// @returns                 : Registry
+//******************************************************************************************
+SchedulerRegistry & SchedulerRegistry::getInstance()
+{
+    static SchedulerRegistry registry;
+    return registry;
+}
+
+//******************************************************************************************
+// @name                    : registerScheduler
+//
+// @description             : Registers a scheduling algorithm.
+//
+// @param name              : Name used in configurations
+// @param description       : Name of the scheduling algorithm
+// @param factory           : Creates the scheduler
+//
+// @returns                 : true if registered,
+//                            false if the name is already registered
+//******************************************************************************************
+bool SchedulerRegistry::registerScheduler(const string & name, const string & description, schedulerFactory_fn factory)
+{
+    if (isRegistered(name) || !factory)
+    {
+        printf("ERROR: Unable to register scheduler '%s'\n", name.c_str());
+        return false;
+    }
+
+    schedulerRegistryEntry_st entry;
+    entry.name = name;
+    entry.description = description;
+    entry.factory = factory;
+    m_entries.push_back(entry);
+
+    return true;
+}
+
+//******************************************************************************************
+// @name                    : isRegistered
+//
+// @description             : Checks if a scheduling algorithm has been registered.
+//
+// @param name              : Name used in configurations
+//
+// @returns                 : true if registered,
+//                            false otherwise
+//******************************************************************************************
+bool SchedulerRegistry::isRegistered(const string & name)
+{
+    for (auto it = m_entries.begin(); it != m_entries.end(); it++)
+    {
+        if (it->name == name)
+            return true;
+    }
+
+    return false;
+}
+
+//******************************************************************************************
+// @name                    : createScheduler
+//
+// @description             : Creates the scheduler of a scheduling algorithm.
+//
+// @param name              : Name used in configurations
+// @param config            : Configuration of the scheduler
+//
+// @returns                 : Scheduler object, nullptr if the name is not registered
+//******************************************************************************************
+ProcessScheduler* SchedulerRegistry::createScheduler(const string & name, const simulationConfig_st & config)
+{
+    for (auto it = m_entries.begin(); it != m_entries.end(); it++)
+    {
+        if (it->name == name)
+        {
+            ProcessScheduler *scheduler = it->factory(config);
+            if (scheduler)
+            {
+                scheduler->setPhaseTimersEnabled(config.usePhaseTimers);
+                scheduler->setHardwareCountersEnabled(config.useHardwareCounters);
+                scheduler->setPayloadKernel(config.payloadKernel, config.payloadScale, config.payloadPreemptible);
+                scheduler->setIoDeviceCount(config.ioDevices);
+                scheduler->setCpuCount(config.cpus, config.cpuAffinity, config.migrationCost);
+
+                contextSwitchCost_st switchCost;
+                getContextSwitchCost(config, switchCost);
+                scheduler->setContextSwitchCost(switchCost);
+
+                admissionPolicy_st policy;
+                getAdmissionPolicy(config, policy);
+                scheduler->setAdmissionPolicy(policy);
+                scheduler->setStatsSampling(config.statsSampleInterval, config.statsWindow, config.statsSeriesFile.size() ? config.statsSeriesSize : 0);
+
+                if (config.tenantGroups.size())
+                {
+                    scheduler->setTenantGroups(new TenantGroups(config.tenantGroups, config.tenantQuotaPeriod));
+                }
+            }
+            return scheduler;
+        }
+    }
+
+    printf("ERROR: Invalid Scheduling algorithm '%s' specified!\n", name.c_str());
+    return nullptr;
+}
+
+//******************************************************************************************
+// @name                    : getSchedulerNames
+//
+// @description             : Fetches the names of all the registered scheduling algorithms.
+//
+// @returns                 : Names, in order of registration
+//******************************************************************************************
+vector<string> SchedulerRegistry::getSchedulerNames()
+{
+    vector<string> names;
+    for (auto it = m_entries.begin(); it != m_entries.end(); it++)
+    {
+        names.push_back(it->name);
+    }
+
+    return names;
+}
+
+//******************************************************************************************
+// @name                    : displaySchedulers
+//
+// @description             : Displays all the registered scheduling algorithms.
+//
+// @returns                 : Nothing
+//******************************************************************************************
+void SchedulerRegistry::displaySchedulers()
+{
+    printf("\nScheduling algorithms:\n");
+    for (auto it = m_entries.begin(); it != m_entries.end(); it++)
+    {
+        printf("  %-20s %s\n", it->name.c_str(), it->description.c_str());
+    }
+}
@@ -0,0 +1,476 @@
+#include "simd_kernels.h"
+#include "job.h"
+#include<atomic>
+
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define SIMD_KERNELS_X86
+#include<immintrin.h>
+#endif
+
+//---------------------------------------------------------------------------------------------------
+// Globals
+//---------------------------------------------------------------------------------------------------
+static const unsigned int PRIORITY_HIGHEST = (unsigned int)JOB_PRIORITY_HIGHEST;
+
+static atomic<int> s_simdLevel(-1);                   // Level set, -1 for the supported one
+
+//******************************************************************************************
+// @name                    : agePrioritiesScalar
+//
+// @description             : Ages the priority of every job that has waited as long as its
+//                            time required, by the ageing rate, up to the highest priority.
+//                            Lower value means higher priority. Also ages the jobs left
+//                            over by the vector versions.
+//
+// @param priorities        : Priority of each job, aged in place
+// @param tsCreated         : timestamp each job was created at
+// @param timeRequired      : Time (ns) required by each job
+// @param count             : Jobs
+// @param tsNow             : timestamp of the ageing pass
+// @param ageingRate        : Priority levels gained
+// @param first             : Index of the first job, added to the indexes of the aged jobs
+// @param agedJobs          : Indexes of the jobs whose priority changed, in increasing order
+//
+// @returns                 : Number of jobs whose priority changed
+//******************************************************************************************
+static size_t agePrioritiesScalar(unsigned int *priorities, const long long *tsCreated, const long long *timeRequired,
+                                  size_t count, long long tsNow, unsigned int ageingRate, size_t first, size_t *agedJobs)
+{
+    size_t aged = 0;
+
+    for (size_t i = 0; i < count; i++)
+    {
+        if (tsNow - tsCreated[i] >= timeRequired[i] && priorities[i] > PRIORITY_HIGHEST)
+        {
+            priorities[i] = (priorities[i] > PRIORITY_HIGHEST + ageingRate) ? priorities[i] - ageingRate : PRIORITY_HIGHEST;
+            agedJobs[aged++] = first + i;
+        }
+    }
+
+    return aged;
+}
+
+//******************************************************************************************
+// @name                    : findMinKeyScalar
+//
+// @description             : Finds the lowest key, and of the keys as low, the one of the
+//                            lowest rank.
+//
+// @param keys              : Keys
+// @param ranks             : Rank of each key, all different
+// @param count             : Keys, at least 1
+//
+// @returns                 : Index of the lowest key, of the lowest rank on a tie
+//******************************************************************************************
+static size_t findMinKeyScalar(const long long *keys, const long long *ranks, size_t count)
+{
+    size_t lowest = 0;
+
+    for (size_t i = 1; i < count; i++)
+    {
+        if (keys[i] < keys[lowest] || (keys[i] == keys[lowest] && ranks[i] < ranks[lowest]))
+        {
+            lowest = i;
+        }
+    }
+
+    return lowest;
+}
+
+#ifdef SIMD_KERNELS_X86
+//******************************************************************************************
+// @name                    : agePrioritiesAvx2
+//
+// @description             : Same as agePrioritiesScalar(), 8 jobs at a time. The waiting
+//                            times are compared as 2 vectors of 4 64 bit lanes, whose masks
+//                            are narrowed to the 8 32 bit lanes of the priorities. AVX2 has
+//                            no unsigned compare, so the priorities are compared with their
+//                            sign bit flipped. The jobs aged are taken from the bits of the
+//                            mask.
+//
+// @returns                 : Number of jobs whose priority changed
+//******************************************************************************************
+__attribute__((target("avx2")))
+static size_t agePrioritiesAvx2(unsigned int *priorities, const long long *tsCreated, const long long *timeRequired,
+                                size_t count, long long tsNow, unsigned int ageingRate, size_t *agedJobs)
+{
+    const __m256i now = _mm256_set1_epi64x(tsNow);
+    const __m256i signBit = _mm256_set1_epi32((int)0x80000000);
+    const __m256i highest = _mm256_set1_epi32((int)PRIORITY_HIGHEST);
+    const __m256i highestSigned = _mm256_xor_si256(highest, signBit);
+    const __m256i ageingLimitSigned = _mm256_xor_si256(_mm256_set1_epi32((int)(PRIORITY_HIGHEST + ageingRate)), signBit);
+    const __m256i rate = _mm256_set1_epi32((int)ageingRate);
+    size_t aged = 0;
+    size_t i = 0;
+
+    for (; i + 8 <= count; i += 8)
+    {
+        // Jobs that have not waited long enough yet, i.e. time required > waiting time
+        __m256i waiting0 = _mm256_sub_epi64(now, _mm256_loadu_si256((const __m256i*)(tsCreated + i)));
+        __m256i waiting1 = _mm256_sub_epi64(now, _mm256_loadu_si256((const __m256i*)(tsCreated + i + 4)));
+        __m256i early0 = _mm256_cmpgt_epi64(_mm256_loadu_si256((const __m256i*)(timeRequired + i)), waiting0);
+        __m256i early1 = _mm256_cmpgt_epi64(_mm256_loadu_si256((const __m256i*)(timeRequired + i + 4)), waiting1);
+        __m256i early = _mm256_castps_si256(_mm256_shuffle_ps(_mm256_castsi256_ps(early0), _mm256_castsi256_ps(early1), _MM_SHUFFLE(2, 0, 2, 0)));
+        early = _mm256_permute4x64_epi64(early, _MM_SHUFFLE(3, 1, 2, 0));
+
+        __m256i priority = _mm256_loadu_si256((const __m256i*)(priorities + i));
+        __m256i prioritySigned = _mm256_xor_si256(priority, signBit);
+        __m256i ageable = _mm256_andnot_si256(early, _mm256_cmpgt_epi32(prioritySigned, highestSigned));
+        __m256i agedPriority = _mm256_blendv_epi8(highest, _mm256_sub_epi32(priority, rate), _mm256_cmpgt_epi32(prioritySigned, ageingLimitSigned));
+
+        _mm256_storeu_si256((__m256i*)(priorities + i), _mm256_blendv_epi8(priority, agedPriority, ageable));
+
+        for (unsigned int mask = (unsigned int)_mm256_movemask_ps(_mm256_castsi256_ps(ageable)); mask; mask &= mask - 1)
+        {
+            agedJobs[aged++] = i + __builtin_ctz(mask);
+        }
+    }
+
+    return aged + agePrioritiesScalar(priorities + i, tsCreated + i, timeRequired + i, count - i, tsNow, ageingRate, i, agedJobs + aged);
+}
+
+//******************************************************************************************
+// @name                    : findMinKeyAvx2
+//
+// @description             : Same as findMinKeyScalar(), 4 keys at a time. Each lane keeps
+//                            the lowest key of its own, with its rank and where it was. The
+//                            lanes are merged at the end the same way.
+//
+// @returns                 : Index of the lowest key, of the lowest rank on a tie
+//******************************************************************************************
+__attribute__((target("avx2")))
+static size_t findMinKeyAvx2(const long long *keys, const long long *ranks, size_t count)
+{
+    if (count < 8)
+    {
+        return findMinKeyScalar(keys, ranks, count);
+    }
+
+    const __m256i step = _mm256_set1_epi64x(4);
+    __m256i index = _mm256_set_epi64x(3, 2, 1, 0);
+    __m256i lowest = _mm256_loadu_si256((const __m256i*)keys);
+    __m256i lowestRank = _mm256_loadu_si256((const __m256i*)ranks);
+    __m256i lowestIndex = index;
+    size_t i = 4;
+
+    for (; i + 4 <= count; i += 4)
+    {
+        index = _mm256_add_epi64(index, step);
+        __m256i key = _mm256_loadu_si256((const __m256i*)(keys + i));
+        __m256i rank = _mm256_loadu_si256((const __m256i*)(ranks + i));
+        __m256i lower = _mm256_or_si256(_mm256_cmpgt_epi64(lowest, key),
+                                        _mm256_and_si256(_mm256_cmpeq_epi64(lowest, key), _mm256_cmpgt_epi64(lowestRank, rank)));
+        lowest = _mm256_blendv_epi8(lowest, key, lower);
+        lowestRank = _mm256_blendv_epi8(lowestRank, rank, lower);
+        lowestIndex = _mm256_blendv_epi8(lowestIndex, index, lower);
+    }
+
+    long long laneIndexes[4];
+    _mm256_storeu_si256((__m256i*)laneIndexes, lowestIndex);
+
+    size_t result = (size_t)laneIndexes[0];
+    for (int lane = 1; lane < 4; lane++)
+    {
+        size_t candidate = (size_t)laneIndexes[lane];
+        if (keys[candidate] < keys[result] || (keys[candidate] == keys[result] && ranks[candidate] < ranks[result]))
+        {
+            result = candidate;
+        }
+    }
+
+    for (; i < count; i++)
+    {
+        if (keys[i] < keys[result] || (keys[i] == keys[result] && ranks[i] < ranks[result]))
+        {
+            result = i;
+        }
+    }
+
+    return result;
+}
+
+//******************************************************************************************
+// @name                    : agePrioritiesAvx512
+//
+// @description             : Same as agePrioritiesScalar(), 16 jobs at a time, with the
+//                            compares done into mask registers.
+//
+// @returns                 : Number of jobs whose priority changed
+//******************************************************************************************
+__attribute__((target("avx512f")))
+static size_t agePrioritiesAvx512(unsigned int *priorities, const long long *tsCreated, const long long *timeRequired,
+                                  size_t count, long long tsNow, unsigned int ageingRate, size_t *agedJobs)
+{
+    const __m512i now = _mm512_set1_epi64(tsNow);
+    const __m512i highest = _mm512_set1_epi32((int)PRIORITY_HIGHEST);
+    const __m512i ageingLimit = _mm512_set1_epi32((int)(PRIORITY_HIGHEST + ageingRate));
+    const __m512i rate = _mm512_set1_epi32((int)ageingRate);
+    size_t aged = 0;
+    size_t i = 0;
+
+    for (; i + 16 <= count; i += 16)
+    {
+        // Jobs that have waited as long as their time required
+        __m512i waiting0 = _mm512_sub_epi64(now, _mm512_loadu_si512(tsCreated + i));
+        __m512i waiting1 = _mm512_sub_epi64(now, _mm512_loadu_si512(tsCreated + i + 8));
+        __mmask8 due0 = _mm512_cmpge_epi64_mask(waiting0, _mm512_loadu_si512(timeRequired + i));
+        __mmask8 due1 = _mm512_cmpge_epi64_mask(waiting1, _mm512_loadu_si512(timeRequired + i + 8));
+        __mmask16 due = (__mmask16)(due0 | (due1 << 8));
+
+        __m512i priority = _mm512_loadu_si512(priorities + i);
+        __mmask16 ageable = _mm512_mask_cmpgt_epu32_mask(due, priority, highest);
+        __mmask16 aboveLimit = _mm512_cmpgt_epu32_mask(priority, ageingLimit);
+        __m512i agedPriority = _mm512_mask_sub_epi32(highest, aboveLimit, priority, rate);
+
+        _mm512_storeu_si512(priorities + i, _mm512_mask_mov_epi32(priority, ageable, agedPriority));
+
+        for (unsigned int mask = ageable; mask; mask &= mask - 1)
+        {
+            agedJobs[aged++] = i + __builtin_ctz(mask);
+        }
+    }
+
+    return aged + agePrioritiesScalar(priorities + i, tsCreated + i, timeRequired + i, count - i, tsNow, ageingRate, i, agedJobs + aged);
+}
+
+//******************************************************************************************
+// @name                    : findMinKeyAvx512
+//
+// @description             : Same as findMinKeyAvx2(), 8 keys at a time.
+//
+// @returns                 : Index of the lowest key, of the lowest rank on a tie
+//******************************************************************************************
+__attribute__((target("avx512f")))
+static size_t findMinKeyAvx512(const long long *keys, const long long *ranks, size_t count)
+{
+    if (count < 16)
+    {
+        return findMinKeyScalar(keys, ranks, count);
+    }
+
+    const __m512i step = _mm512_set1_epi64(8);
+    __m512i index = _mm512_set_epi64(7, 6, 5, 4, 3, 2, 1, 0);
+    __m512i lowest = _mm512_loadu_si512(keys);
+    __m512i lowestRank = _mm512_loadu_si512(ranks);
+    __m512i lowestIndex = index;
+    size_t i = 8;
+
+    for (; i + 8 <= count; i += 8)
+    {
+        index = _mm512_add_epi64(index, step);
+        __m512i key = _mm512_loadu_si512(keys + i);
+        __m512i rank = _mm512_loadu_si512(ranks + i);
+        __mmask8 lower = _mm512_cmplt_epi64_mask(key, lowest) |
+                         _mm512_mask_cmplt_epi64_mask(_mm512_cmpeq_epi64_mask(key, lowest), rank, lowestRank);
+        lowest = _mm512_mask_mov_epi64(lowest, lower, key);
+        lowestRank = _mm512_mask_mov_epi64(lowestRank, lower, rank);
+        lowestIndex = _mm512_mask_mov_epi64(lowestIndex, lower, index);
+    }
+
+    long long laneIndexes[8];
+    _mm512_storeu_si512(laneIndexes, lowestIndex);
+
+    size_t result = (size_t)laneIndexes[0];
+    for (int lane = 1; lane < 8; lane++)
+    {
+        size_t candidate = (size_t)laneIndexes[lane];
+        if (keys[candidate] < keys[result] || (keys[candidate] == keys[result] && ranks[candidate] < ranks[result]))
+        {
+            result = candidate;
+        }
+    }
+
+    for (; i < count; i++)
+    {
+        if (keys[i] < keys[result] || (keys[i] == keys[result] && ranks[i] < ranks[result]))
+        {
+            result = i;
+        }
+    }
+
+    return result;
+}
+#endif
+
+//******************************************************************************************
+// @name                    : getSupportedSimdLevel
+//
+// @description             : Finds the best level of the kernels that the CPU supports
+//                            (along with its OS) and that has been built in.
+//
+// @returns                 : Level
+//******************************************************************************************
+simdLevel_en getSupportedSimdLevel()
+{
+#ifdef SIMD_KERNELS_X86
+    static const simdLevel_en supported = __builtin_cpu_supports("avx512f") ? SIMD_AVX512 :
+                                          __builtin_cpu_supports("avx2") ? SIMD_AVX2 : SIMD_SCALAR;
+    return supported;
+#else
+    return SIMD_SCALAR;
+#endif
+}
+
+//******************************************************************************************
+// @name                    : getSimdLevel
+//
+// @description             : Gets the level the kernels run with.
+//
+// @returns                 : Level set, or the supported one if none was set
+//******************************************************************************************
+simdLevel_en getSimdLevel()
+{
+    int level = s_simdLevel.load(memory_order_relaxed);
+    return (level < 0) ? getSupportedSimdLevel() : (simdLevel_en)level;
+}
+
+//******************************************************************************************
+// @name                    : setSimdLevel
+//
+// @description             : Sets the level the kernels of all the schedulers run with.
+//
+// @param level             : Level, at most the supported one
+//
+// @returns                 : true if the level is supported,
+//                            false otherwise
+//******************************************************************************************
+bool setSimdLevel(simdLevel_en level)
+{
+    if (level >= SIMD_LEVEL_MAX || level > getSupportedSimdLevel())
+    {
+        return false;
+    }
+
+    s_simdLevel.store(level, memory_order_relaxed);
+    return true;
+}
+
+//******************************************************************************************
+// @name                    : parseSimdLevel
+//
+// @description             : Converts the name of a level (auto, scalar, avx2 or avx512) to
+//                            the level. auto is the supported one.
+//
+// @param name              : Name of the level
+// @param level             : Level
+//
+// @returns                 : true if the name is valid,
+//                            false otherwise
+//******************************************************************************************
+bool parseSimdLevel(const string & name, simdLevel_en & level)
+{
+    if (name == "auto")             level = getSupportedSimdLevel();
+    else if (name == "scalar")      level = SIMD_SCALAR;
+    else if (name == "avx2")        level = SIMD_AVX2;
+    else if (name == "avx512")      level = SIMD_AVX512;
+    else
+        return false;
+
+    return true;
+}
+
+//******************************************************************************************
+// @name                    : getSimdLevelName
+//
+// @description             : Gets the name of a level, as parsed by parseSimdLevel().
+//
+// @param level             : Level
+//
+// @returns                 : Name
+//******************************************************************************************
+const char* getSimdLevelName(simdLevel_en level)
+{
+    switch (level)
+    {
+    case SIMD_SCALAR:       return "scalar";
+    case SIMD_AVX2:         return "avx2";
+    case SIMD_AVX512:       return "avx512";
+    default:                return "unknown";
+    }
+}
+
+//******************************************************************************************
+// @name                    : agePriorities
+//
+// @description             : Ages the priority of every job that has waited as long as its
+//                            time required, by the ageing rate, up to the highest priority,
+//                            with the kernel of a level, or of the level set. The jobs whose
+//                            priority changed are listed, so only they need to be updated.
+//
+// @param level             : Level of the kernel, which must be supported
+// @param priorities        : Priority of each job, aged in place
+// @param tsCreated         : timestamp each job was created at
+// @param timeRequired      : Time (ns) required by each job
+// @param count             : Jobs
+// @param tsNow             : timestamp of the ageing pass
+// @param ageingRate        : Priority levels gained
+// @param agedJobs          : Indexes of the jobs whose priority changed, in increasing
+//                            order. Room for count indexes.
+//
+// @returns                 : Number of jobs whose priority changed
+//******************************************************************************************
+size_t agePriorities(simdLevel_en level, unsigned int *priorities, const long long *tsCreated, const long long *timeRequired,
+                     size_t count, long long tsNow, unsigned int ageingRate, size_t *agedJobs)
+{
+#ifdef SIMD_KERNELS_X86
+    if (level == SIMD_AVX512)
+    {
+        return agePrioritiesAvx512(priorities, tsCreated, timeRequired, count, tsNow, ageingRate, agedJobs);
+    }
+
+    if (level == SIMD_AVX2)
+    {
+        return agePrioritiesAvx2(priorities, tsCreated, timeRequired, count, tsNow, ageingRate, agedJobs);
+    }
+#endif
+
+    return agePrioritiesScalar(priorities, tsCreated, timeRequired, count, tsNow, ageingRate, 0, agedJobs);
+}
+
+size_t agePriorities(unsigned int *priorities, const long long *tsCreated, const long long *timeRequired,
+                     size_t count, long long tsNow, unsigned int ageingRate, size_t *agedJobs)
+{
+    return agePriorities(getSimdLevel(), priorities, tsCreated, timeRequired, count, tsNow, ageingRate, agedJobs);
+}
+
+//******************************************************************************************
+// @name                    : findMinKey
+//
+// @description             : Finds the lowest key, with the kernel of a level, or of the
+//                            level set. Of the keys as low, the one of the lowest rank is
+//                            taken, e.g. the job ahead in the pool.
+//
+// @param level             : Level of the kernel, which must be supported
+// @param keys              : Keys
+// @param ranks             : Rank of each key, all different
+// @param count             : Keys
+//
+// @returns                 : Index of the lowest key, of the lowest rank on a tie. 0 if
+//                            there are no keys.
+//******************************************************************************************
+size_t findMinKey(simdLevel_en level, const long long *keys, const long long *ranks, size_t count)
+{
+    if (count == 0)
+    {
+        return 0;
+    }
+
+#ifdef SIMD_KERNELS_X86
+    if (level == SIMD_AVX512)
+    {
+        return findMinKeyAvx512(keys, ranks, count);
+    }
+
+    if (level == SIMD_AVX2)
+    {
+        return findMinKeyAvx2(keys, ranks, count);
+    }
+#endif
+
+    return findMinKeyScalar(keys, ranks, count);
+}
+
+size_t findMinKey(const long long *keys, const long long *ranks, size_t count)
+{
+    return findMinKey(getSimdLevel(), keys, ranks, count);
+}
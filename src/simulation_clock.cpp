@@ -0,0 +1,281 @@
+#include "simulation_clock.h"
+#include "job.h"
+#include "timing.h"
+#include<algorithm>
+
+// Participant of the calling thread, from LockstepClock::enter() to leave()
+static thread_local LockstepClock* s_enteredClock = nullptr;
+static thread_local unsigned int s_enteredParticipant = LockstepClock::NO_PARTICIPANT;
+
+//******************************************************************************************
+// @name                    : getRealTimeClock
+//
+// @description             : Fetches the wall clock shared by all the schedulers and jobs
+//                            that are not given a clock of their own.
+//
+// @returns                 : Real time clock
+//******************************************************************************************
+SimulationClock* getRealTimeClock()
+{
+    static RealTimeClock realTimeClock;
+    return &realTimeClock;
+}
+
+//******************************************************************************************
+// @name                    : now
+//
+// @description             : Get monotonic time stamp in nanoseconds.
+//
+// @returns                 : Current timestamp
+//******************************************************************************************
+long long RealTimeClock::now()
+{
+    return getCurrentTimestampInNanoseconds();
+}
+
+//******************************************************************************************
+// @name                    : sleepFor
+//
+// @description             : Blocks the calling thread for the specified duration.
+//                            Back to back sleeps of a thread do not drift, so a job
+//                            simulated in many time slices takes as long as it should.
+//
+// @param duration          : Duration (ns) to sleep
+//
+// @returns                 : Nothing
+//******************************************************************************************
+void RealTimeClock::sleepFor(long long duration)
+{
+    if (duration > 0)
+    {
+        sleepForNanoseconds(duration);
+    }
+}
+
+//******************************************************************************************
+// @name                    : VirtualClock
+//
+// @description             : Constructor. Virtual time starts at 0.
+//
+// @returns                 : Nothing
+//******************************************************************************************
+VirtualClock::VirtualClock()
+{
+    m_now = 0;
+}
+
+//******************************************************************************************
+// @name                    : sleepFor
+//
+// @description             : Moves the virtual time ahead by the specified duration.
+//                            Returns immediately.
+//
+// @param duration          : Duration (ns) to sleep
+//
+// @returns                 : Nothing
+//******************************************************************************************
+void VirtualClock::sleepFor(long long duration)
+{
+    if (duration > 0)
+    {
+        m_now += duration;
+    }
+}
+
+//******************************************************************************************
+// @name                    : LockstepClock
+//
+// @description             : Constructor. All the participants are due at the current time
+//                            of the base clock, in order, so participant 0 runs first.
+//
+// @param baseClock         : Clock whose time is shared, only moved ahead by this clock
+//                            from now on
+// @param participants      : Number of threads sharing the clock
+//
+// @returns                 : Nothing
+//******************************************************************************************
+LockstepClock::LockstepClock(SimulationClock *baseClock, unsigned int participants)
+{
+    m_baseClock = baseClock;
+    m_turns.reset(new condition_variable[participants]);
+    m_waits.reset(new pair<long long, unsigned long long>[participants]);
+    m_sleeps = 0;
+    m_running = NO_PARTICIPANT;
+
+    for (unsigned int participant = 0; participant < participants; participant++)
+    {
+        m_sleepers[make_pair(baseClock->now(), m_sleeps++)] = participant;
+        m_waits[participant] = make_pair(-1LL, 0ULL);
+    }
+
+    handOver();
+}
+
+//******************************************************************************************
+// @name                    : handOver
+//
+// @description             : Lets the participant due first run, after moving the time
+//                            ahead to when it wakes up. Must be called with the mutex held.
+//                            If all of them wait till they are woken, none runs.
+//
+// @returns                 : Nothing
+//******************************************************************************************
+void LockstepClock::handOver()
+{
+    if (m_sleepers.empty() || m_sleepers.begin()->first.first == LLONG_MAX)
+    {
+        m_running = NO_PARTICIPANT;
+        return;
+    }
+
+    auto next = m_sleepers.begin();
+    long long tsWake = next->first.first;
+    m_running = next->second;
+    m_waits[m_running] = make_pair(-1LL, 0ULL);
+    m_sleepers.erase(next);
+
+    m_baseClock->sleepFor(tsWake - m_baseClock->now());
+    m_turns[m_running].notify_one();
+}
+
+//******************************************************************************************
+// @name                    : enter
+//
+// @description             : Blocks a participant thread till it may run for the first
+//                            time. Must be called by each participant before anything else.
+//
+// @param participant       : Participant of the calling thread
+//
+// @returns                 : Nothing
+//******************************************************************************************
+void LockstepClock::enter(unsigned int participant)
+{
+    s_enteredClock = this;
+    s_enteredParticipant = participant;
+
+    unique_lock<mutex> lock(m_mutex);
+    m_turns[participant].wait(lock, [this, participant] { return m_running == participant; });
+}
+
+//******************************************************************************************
+// @name                    : sleepFor
+//
+// @description             : Hands over to the participant due first, which may be the
+//                            caller itself, and blocks the caller till it is its turn
+//                            again, at the end of the duration.
+//
+// @param duration          : Duration (ns) to sleep
+//
+// @returns                 : Nothing
+//******************************************************************************************
+void LockstepClock::sleepFor(long long duration)
+{
+    sleepUntil(m_baseClock->now() + ((duration > 0) ? duration : 0), false);
+}
+
+//******************************************************************************************
+// @name                    : waitFor
+//
+// @description             : Same as sleepFor(), except that the running participant may
+//                            wake the caller earlier. A duration reaching LLONG_MAX waits
+//                            till the caller is woken.
+//
+// @param duration          : Max duration (ns) to wait
+//
+// @returns                 : Nothing
+//******************************************************************************************
+void LockstepClock::waitFor(long long duration)
+{
+    long long tsNow = m_baseClock->now();
+    sleepUntil((duration >= LLONG_MAX - tsNow) ? LLONG_MAX : tsNow + ((duration > 0) ? duration : 0), true);
+}
+
+//******************************************************************************************
+// @name                    : sleepUntil
+//
+// @description             : Hands over to the participant due first, which may be the
+//                            caller itself, and blocks the caller till it is its turn
+//                            again.
+//
+// @param tsWake            : timestamp (ns) at which the caller is due again
+// @param wakeable          : The caller may be woken earlier
+//
+// @returns                 : Nothing
+//******************************************************************************************
+void LockstepClock::sleepUntil(long long tsWake, bool wakeable)
+{
+    unique_lock<mutex> lock(m_mutex);
+    unsigned int participant = m_running;
+    pair<long long, unsigned long long> sleep = make_pair(tsWake, m_sleeps++);
+
+    m_sleepers[sleep] = participant;
+    if (wakeable)
+    {
+        m_waits[participant] = sleep;
+    }
+
+    handOver();
+
+    m_turns[participant].wait(lock, [this, participant] { return m_running == participant; });
+}
+
+//******************************************************************************************
+// @name                    : wake
+//
+// @description             : Makes a participant waiting in waitFor() due by a timestamp,
+//                            if it is due later. Must be called by the running participant.
+//                            Participants sleeping in sleepFor() are left alone.
+//
+// @param participant       : Participant to wake
+// @param tsWake            : timestamp (ns) by which it is due, from now on
+//
+// @returns                 : Nothing
+//******************************************************************************************
+void LockstepClock::wake(unsigned int participant, long long tsWake)
+{
+    lock_guard<mutex> lock(m_mutex);
+    pair<long long, unsigned long long> & sleep = m_waits[participant];
+
+    tsWake = max(tsWake, m_baseClock->now());
+    if (sleep.first < 0 || sleep.first <= tsWake)
+    {
+        return;
+    }
+
+    m_sleepers.erase(sleep);
+    sleep = make_pair(tsWake, m_sleeps++);
+    m_sleepers[sleep] = participant;
+}
+
+//******************************************************************************************
+// @name                    : leave
+//
+// @description             : Removes the running participant for good, and hands over to
+//                            the next one.
+//
+// @returns                 : Nothing
+//******************************************************************************************
+void LockstepClock::leave()
+{
+    s_enteredClock = nullptr;
+    s_enteredParticipant = NO_PARTICIPANT;
+
+    lock_guard<mutex> lock(m_mutex);
+    handOver();
+}
+
+//******************************************************************************************
+// @name                    : hasTurn
+//
+// @description             : Checks whether the calling thread has entered this clock and
+//                            is the participant allowed to run, e.g. to check that the
+//                            participants only touch what they share in their turn.
+//
+// @returns                 : true if it is the turn of the calling thread,
+//                            false otherwise
+//******************************************************************************************
+bool LockstepClock::hasTurn()
+{
+    lock_guard<mutex> lock(m_mutex);
+    return s_enteredClock == this && m_running == s_enteredParticipant;
+}
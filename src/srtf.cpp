@@ -0,0 +1,29 @@
+#include "srtf.h"
+#include "logger.h"
+
+//******************************************************************************************
+// @name                    : ShortestRemainingTimeFirst
+//
+// @description             : Constructor
+//
+// @param preemptionInterval: Time (ns) after which a running job is preempted to check for
+//                            shorter jobs, when arrivals are not known in advance
+//
+// @returns                 : Nothing
+//******************************************************************************************
+ShortestRemainingTimeFirst::ShortestRemainingTimeFirst(string name, long long preemptionInterval) :PolicyScheduler<SrtfPolicy>(name, preemptionInterval)
+{
+    LOG_INFO("Creating [ %s ] scheduler", name.c_str());
+}
+
+//******************************************************************************************
+// @name                    : ~ShortestRemainingTimeFirst
+//
+// @description             : Destructor
+//
+// @returns                 : Nothing
+//******************************************************************************************
+ShortestRemainingTimeFirst::~ShortestRemainingTimeFirst()
+{
+
+}
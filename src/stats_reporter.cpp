@@ -0,0 +1,91 @@
+#include "stats_reporter.h"
+#include<chrono>
+
+//******************************************************************************************
+// @name                    : StatsReporter
+//
+// @description             : Constructor
+//
+// @param scheduler         : Scheduler to monitor. Must outlive the reporter.
+// @param interval          : Interval (seconds) between two reports
+//
+// @returns                 : Nothing
+//******************************************************************************************
+StatsReporter::StatsReporter(ProcessScheduler *scheduler, int interval)
+{
+    m_scheduler = scheduler;
+    m_interval = interval;
+    m_stopRequested = false;
+}
+
+//******************************************************************************************
+// @name                    : ~StatsReporter
+//
+// @description             : Stops the reporter thread, if running.
+//
+// @returns                 : Nothing
+//******************************************************************************************
+StatsReporter::~StatsReporter()
+{
+    stop();
+}
+
+//******************************************************************************************
+// @name                    : start
+//
+// @description             : Spawns the reporter thread.
+//
+// @returns                 : Nothing
+//******************************************************************************************
+void StatsReporter::start()
+{
+    if (m_interval < 0 || m_thread.joinable())
+    {
+        return;
+    }
+
+    m_stopRequested = false;
+    m_thread = thread(&StatsReporter::reportAtInterval, this);
+}
+
+//******************************************************************************************
+// @name                    : stop
+//
+// @description             : Stops the reporter thread without waiting for the current
+//                            interval to elapse.
+//
+// @returns                 : Nothing
+//******************************************************************************************
+void StatsReporter::stop()
+{
+    if (!m_thread.joinable())
+    {
+        return;
+    }
+
+    {
+        lock_guard<mutex> lock(m_mutex);
+        m_stopRequested = true;
+    }
+
+    m_stopEvent.notify_one();
+    m_thread.join();
+}
+
+//******************************************************************************************
+// @name                    : reportAtInterval
+//
+// @description             : Reporter thread. Displays the stats of the scheduler every
+//                            interval till it is stopped.
+//
+// @returns                 : Nothing
+//******************************************************************************************
+void StatsReporter::reportAtInterval()
+{
+    unique_lock<mutex> lock(m_mutex);
+
+    while (!m_stopEvent.wait_for(lock, chrono::seconds(m_interval), [this] { return m_stopRequested; }))
+    {
+        m_scheduler->displayStats();
+    }
+}
@@ -0,0 +1,298 @@
+#include "stats_series.h"
+#include "timing.h"
+#include<algorithm>
+
+//******************************************************************************************
+// @name                    : StatsSeries
+//
+// @description             : Constructor. No samples are taken till setup() is called.
+//
+// @returns                 : Nothing
+//******************************************************************************************
+StatsSeries::StatsSeries()
+{
+    m_first = 0;
+    m_count = 0;
+    m_recorded = 0;
+    m_interval = 0;
+    m_window = 0;
+    m_tsNextSample = 0;
+}
+
+//******************************************************************************************
+// @name                    : ~StatsSeries
+//
+// @description             : Destructor
+//
+// @returns                 : Nothing
+//******************************************************************************************
+StatsSeries::~StatsSeries()
+{
+
+}
+
+//******************************************************************************************
+// @name                    : setup
+//
+// @description             : Allocates the ring and forgets the samples taken so far. The
+//                            ring holds at least a window of samples, so the rates can be
+//                            taken over the whole window.
+//
+// @param interval          : Time (ns) between two samples, 0 to take none
+// @param window            : Time (ns) the rates are taken over
+// @param keptSamples       : Samples to keep, the latest ones
+//
+// @returns                 : Nothing
+//******************************************************************************************
+void StatsSeries::setup(long long interval, long long window, size_t keptSamples)
+{
+    m_interval = interval;
+    m_window = window;
+    m_first = 0;
+    m_count = 0;
+    m_recorded = 0;
+    m_tsNextSample = 0;
+
+    size_t windowSamples = (interval > 0) ? (size_t)(window / interval) + 2 : 0;
+    m_samples.assign((interval > 0) ? max(keptSamples, windowSamples) : 0, statsSample_st());
+}
+
+//******************************************************************************************
+// @name                    : record
+//
+// @description             : Adds a sample to the ring, in place of the oldest one if it is
+//                            full, and schedules the next sample at the next interval.
+//
+// @param sample            : State of the scheduler now
+//
+// @returns                 : Nothing
+//******************************************************************************************
+void StatsSeries::record(const statsSample_st & sample)
+{
+    if (m_samples.empty())
+    {
+        return;
+    }
+
+    push(sample);
+    m_recorded++;
+    m_tsNextSample = (sample.timestamp / m_interval + 1) * m_interval;
+}
+
+//******************************************************************************************
+// @name                    : push
+//
+// @description             : Stores a sample after the latest one, in place of the oldest
+//                            one if the ring is full.
+//
+// @param sample            : Sample
+//
+// @returns                 : Nothing
+//******************************************************************************************
+void StatsSeries::push(const statsSample_st & sample)
+{
+    m_samples[(m_first + m_count) % m_samples.size()] = sample;
+    if (m_count < m_samples.size())
+    {
+        m_count++;
+    }
+    else
+    {
+        m_first = (m_first + 1) % m_samples.size();
+    }
+}
+
+//******************************************************************************************
+// @name                    : getBaseline
+//
+// @description             : Finds the sample the window ending at a sample starts from:
+//                            the latest one taken a window or more before it. Early on, this
+//                            is the creation of the scheduler, when all the totals were 0.
+//                            Once the ring has wrapped, the oldest sample kept is used if
+//                            the window reaches further back.
+//
+// @param index             : Sample the window ends at, 0 for the oldest
+// @param origin            : Storage of the state at creation, if that is the baseline
+//
+// @returns                 : Baseline sample
+//******************************************************************************************
+const statsSample_st & StatsSeries::getBaseline(size_t index, statsSample_st & origin) const
+{
+    long long tsStart = at(index).timestamp - m_window;
+
+    for (size_t baseline = index; baseline-- > 0; )
+    {
+        if (at(baseline).timestamp <= tsStart)
+        {
+            return at(baseline);
+        }
+    }
+
+    if (m_recorded > m_count)
+    {
+        return at(0);
+    }
+
+    origin = statsSample_st{ 0, 0, 0, 0, 0, 0, 0, 0, 0 };
+    return origin;
+}
+
+//******************************************************************************************
+// @name                    : getRates
+//
+// @description             : Computes the rates over the window that ends at a sample.
+//
+// @param index             : Sample, 0 for the oldest
+// @param cpus              : CPUs of the scheduler
+// @param rates             : Rates over the window
+//
+// @returns                 : Nothing
+//******************************************************************************************
+void StatsSeries::getRates(size_t index, unsigned int cpus, windowedRates_st & rates) const
+{
+    statsSample_st origin;
+    const statsSample_st & last = at(index);
+    const statsSample_st & baseline = getBaseline(index, origin);
+
+    unsigned long long completedJobs = last.completedJobs - baseline.completedJobs;
+    rates.timeSpan = last.timestamp - baseline.timestamp;
+    rates.throughput = 0;
+    rates.inflowRate = 0;
+    rates.cpuUtilization = 0;
+    rates.avgResponseTime = completedJobs ? (last.totalResponseTime - baseline.totalResponseTime) / (double)completedJobs : -1;
+
+    if (rates.timeSpan > 0)
+    {
+        rates.throughput = completedJobs * (double)NANOSECONDS_PER_SECOND / rates.timeSpan;
+        rates.inflowRate = (last.totalJobsInflow - baseline.totalJobsInflow) * (double)NANOSECONDS_PER_SECOND / rates.timeSpan;
+        rates.cpuUtilization = (last.cpuBusyTime - baseline.cpuBusyTime) * 100.0 / ((double)rates.timeSpan * (cpus ? cpus : 1));
+    }
+}
+
+//******************************************************************************************
+// @name                    : saveCheckpoint
+//
+// @description             : Saves the samples kept, oldest first, with the time the next
+//                            one is due at, to a checkpoint.
+//
+// @param writer            : Checkpoint
+//
+// @returns                 : Nothing
+//******************************************************************************************
+void StatsSeries::saveCheckpoint(CheckpointWriter & writer)
+{
+    writer.write(m_interval);
+    writer.write(m_window);
+    writer.write(m_recorded);
+    writer.write(m_tsNextSample);
+    writer.write((unsigned long long)m_count);
+    for (size_t index = 0; index < m_count; index++)
+    {
+        writer.write(at(index));
+    }
+}
+
+//******************************************************************************************
+// @name                    : restoreCheckpoint
+//
+// @description             : Restores the samples saved by saveCheckpoint(). The series must
+//                            be set up with the interval and window it was saved with. If
+//                            the ring is smaller than the one saved, the latest samples are
+//                            kept.
+//
+// @param reader            : Checkpoint
+//
+// @returns                 : true if the checkpoint could be read,
+//                            false otherwise
+//******************************************************************************************
+bool StatsSeries::restoreCheckpoint(CheckpointReader & reader)
+{
+    long long interval = reader.read<long long>();
+    long long window = reader.read<long long>();
+    unsigned long long recorded = reader.read<unsigned long long>();
+    long long tsNextSample = reader.read<long long>();
+    unsigned long long count = reader.read<unsigned long long>();
+    if (reader.hasFailed())
+    {
+        return false;
+    }
+
+    if (interval != m_interval || window != m_window)
+    {
+        printf("ERROR: The checkpoint was taken with another stats sample interval or window\n");
+        return false;
+    }
+
+    m_first = 0;
+    m_count = 0;
+    for (unsigned long long index = 0; index < count && !reader.hasFailed(); index++)
+    {
+        statsSample_st sample = reader.read<statsSample_st>();
+        if (!m_samples.empty())
+        {
+            push(sample);
+        }
+    }
+
+    m_recorded = recorded;
+    m_tsNextSample = tsNextSample;
+
+    return !reader.hasFailed();
+}
+
+//******************************************************************************************
+// @name                    : writeCsvHeader
+//
+// @description             : Writes the names of the columns written by writeCsv().
+//
+// @param file              : CSV file
+//
+// @returns                 : Nothing
+//******************************************************************************************
+void StatsSeries::writeCsvHeader(FILE *file)
+{
+    fprintf(file, "scheduler,time_ms,ready_jobs,pending_jobs,blocked_jobs,in_flight_jobs,completed_jobs,"
+                  "window_ms,throughput_per_s,inflow_per_s,cpu_utilization_pct,avg_response_time_ms,littles_law_jobs\n");
+}
+
+//******************************************************************************************
+// @name                    : writeCsv
+//
+// @description             : Writes a row per sample kept, oldest first, with the rates over
+//                            the window ending at it. The last column is the throughput
+//                            times the average response time over the window, i.e. the jobs
+//                            in flight as per Little's law, to compare with the actual ones.
+//
+// @param file              : CSV file, with its header written
+// @param schedulerName     : Name of the scheduler the samples were taken from
+// @param cpus              : CPUs of the scheduler
+//
+// @returns                 : Nothing
+//******************************************************************************************
+void StatsSeries::writeCsv(FILE *file, const string & schedulerName, unsigned int cpus) const
+{
+    const double nsPerMs = (double)NANOSECONDS_PER_MILLISECOND;
+
+    for (size_t index = 0; index < m_count; index++)
+    {
+        const statsSample_st & sample = at(index);
+        windowedRates_st rates;
+        getRates(index, cpus, rates);
+
+        double avgResponseTime = (rates.avgResponseTime >= 0) ? rates.avgResponseTime : 0;
+        fprintf(file, "%s,%.3lf,%llu,%llu,%llu,%llu,%llu,%.3lf,%.6lf,%.6lf,%.3lf,%.3lf,%.3lf\n",
+                schedulerName.c_str(),
+                sample.timestamp / nsPerMs,
+                sample.readyJobs,
+                sample.pendingJobs,
+                sample.blockedJobs,
+                sample.jobsInSystem,
+                sample.completedJobs,
+                rates.timeSpan / nsPerMs,
+                rates.throughput,
+                rates.inflowRate,
+                rates.cpuUtilization,
+                avgResponseTime / nsPerMs,
+                rates.throughput * avgResponseTime / NANOSECONDS_PER_SECOND);
+    }
+}
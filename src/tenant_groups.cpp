@@ -0,0 +1,582 @@
+#include "tenant_groups.h"
+#include "timing.h"
+#include<algorithm>
+#include<math.h>
+#include<stdio.h>
+
+//******************************************************************************************
+// @name                    : TenantGroups
+//
+// @description             : Constructor. Every group starts with a full bucket.
+//
+// @param setup             : Groups, as completed by completeSetup()
+// @param quotaPeriod       : Time (ns) the quota of a group is given for
+//
+// @returns                 : Nothing
+//******************************************************************************************
+TenantGroups::TenantGroups(const vector<tenantGroupSetup_st> & setup, long long quotaPeriod)
+{
+    m_setup = setup;
+    m_quotaPeriod = quotaPeriod;
+    m_children.resize(setup.size() + 1);
+    m_floorVirtualTimes.assign(setup.size() + 1, 0);
+    m_runnableJobs.assign(setup.size(), 0);
+    m_busyJobs.assign(setup.size(), 0);
+    m_eligible.assign(setup.size(), false);
+
+    for (unsigned int group = 0; group < setup.size(); group++)
+    {
+        int parent = findParent(setup, group);
+        m_parents.push_back(parent);
+        m_children[parent + 1].push_back(group);
+
+        tenantGroupState_st state;
+        state.cpuTime = 0;
+        state.virtualTime = 0;
+        state.tokens = (long long)(setup[group].quota * quotaPeriod);
+        state.tsRefill = -1;
+        state.throttledTime = 0;
+        state.completedJobs = 0;
+        state.totalWaitingTime = 0;
+        state.totalResponseTime = 0;
+        state.active = false;
+        m_groups.push_back(state);
+    }
+}
+
+//******************************************************************************************
+// @name                    : ~TenantGroups
+//
+// @description             : Destructor
+//
+// @returns                 : Nothing
+//******************************************************************************************
+TenantGroups::~TenantGroups()
+{
+
+}
+
+//******************************************************************************************
+// @name                    : clearRunnableJobs
+//
+// @description             : Forgets the jobs that may run, before they are counted again
+//                            for the next pick.
+//
+// @returns                 : Nothing
+//******************************************************************************************
+void TenantGroups::clearRunnableJobs()
+{
+    m_runnableJobs.assign(m_runnableJobs.size(), 0);
+}
+
+//******************************************************************************************
+// @name                    : addRunnableJob
+//
+// @description             : Counts a job that may run now for the next pick.
+//
+// @param group             : Group of the job
+//
+// @returns                 : Nothing
+//******************************************************************************************
+void TenantGroups::addRunnableJob(unsigned int group)
+{
+    if (group < m_runnableJobs.size())
+    {
+        m_runnableJobs[group]++;
+    }
+}
+
+//******************************************************************************************
+// @name                    : pick
+//
+// @description             : Picks the group whose jobs are to run next, among those
+//                            counted by addRunnableJob(). At each level of the hierarchy,
+//                            the group of the lowest virtual time that has jobs to run and
+//                            is not throttled is picked, till a group with no such subgroup.
+//                            The buckets are refilled up to now first, and a group that has
+//                            got jobs to run since the last pick catches up with the virtual
+//                            time of its siblings that were busy.
+//
+// @param tsNow             : Current timestamp (ns)
+//
+// @returns                 : Group, -1 if no group may run
+//******************************************************************************************
+int TenantGroups::pick(long long tsNow)
+{
+    size_t count = m_setup.size();
+
+    // Subgroups are listed after their parent, so they are counted into it first
+    m_busyJobs = m_runnableJobs;
+    for (size_t group = count; group-- > 0;)
+    {
+        if (m_parents[group] >= 0)
+            m_busyJobs[m_parents[group]] += m_busyJobs[group];
+    }
+
+    for (unsigned int group = 0; group < count; group++)
+    {
+        refill(group, tsNow);
+    }
+
+    for (size_t parent = 0; parent <= count; parent++)
+    {
+        double lowest = -1;
+        for (unsigned int child : m_children[parent])
+        {
+            if (m_groups[child].active && m_busyJobs[child] > 0 && (lowest < 0 || m_groups[child].virtualTime < lowest))
+                lowest = m_groups[child].virtualTime;
+        }
+
+        if (lowest > m_floorVirtualTimes[parent])
+            m_floorVirtualTimes[parent] = lowest;
+    }
+
+    for (unsigned int group = 0; group < count; group++)
+    {
+        bool busy = (m_busyJobs[group] > 0);
+        if (busy && !m_groups[group].active && m_groups[group].virtualTime < m_floorVirtualTimes[m_parents[group] + 1])
+            m_groups[group].virtualTime = m_floorVirtualTimes[m_parents[group] + 1];
+
+        m_groups[group].active = busy;
+    }
+
+    // A group is eligible if it is not throttled, and has jobs or an eligible subgroup
+    for (size_t group = 0; group < count; group++)
+    {
+        m_eligible[group] = (m_runnableJobs[group] > 0);
+    }
+    for (size_t group = count; group-- > 0;)
+    {
+        if (isThrottled((unsigned int)group))
+            m_eligible[group] = false;
+        else if (m_eligible[group] && m_parents[group] >= 0)
+            m_eligible[m_parents[group]] = true;
+    }
+
+    int picked = -1;
+    while (true)
+    {
+        int next = -1;
+        for (unsigned int child : m_children[picked + 1])
+        {
+            if (m_eligible[child] && (next < 0 || m_groups[child].virtualTime < m_groups[next].virtualTime))
+                next = (int)child;
+        }
+
+        if (next < 0)
+            break;
+
+        picked = next;
+    }
+
+    return picked;
+}
+
+//******************************************************************************************
+// @name                    : charge
+//
+// @description             : Charges the CPU time a job has run for to its group and the
+//                            groups above it, as of the end of its time slice: their
+//                            virtual time moves ahead by the CPU time over their weight,
+//                            and the CPU time is taken out of their buckets.
+//
+// @param group             : Group of the job
+// @param cpuTime           : CPU time (ns), over all the CPUs it ran on
+// @param tsEnd             : timestamp (ns) the time slice ends at
+//
+// @returns                 : Nothing
+//******************************************************************************************
+void TenantGroups::charge(unsigned int group, long long cpuTime, long long tsEnd)
+{
+    if (group >= m_groups.size())
+    {
+        return;
+    }
+
+    for (int ancestor = (int)group; ancestor >= 0; ancestor = m_parents[ancestor])
+    {
+        tenantGroupState_st & state = m_groups[ancestor];
+
+        refill(ancestor, tsEnd);
+        state.cpuTime += cpuTime;
+        state.virtualTime += cpuTime / m_setup[ancestor].weight;
+        if (m_setup[ancestor].quota > 0)
+            state.tokens -= cpuTime;
+    }
+}
+
+//******************************************************************************************
+// @name                    : refill
+//
+// @description             : Refills the bucket of a group with its quota for the time that
+//                            has passed since it was last refilled, up to a period's worth.
+//                            Tokens are whole ns of CPU time, so only the time turned into
+//                            tokens counts as refilled, and the fraction of a token earned
+//                            is kept for the next refill. The time it was throttled in the
+//                            meantime, with jobs to run, is accounted for.
+//
+// @param group             : Group
+// @param tsNow             : Current timestamp (ns). The bucket is not refilled if it has
+//                            been refilled past it already.
+//
+// @returns                 : Nothing
+//******************************************************************************************
+void TenantGroups::refill(unsigned int group, long long tsNow)
+{
+    tenantGroupState_st & state = m_groups[group];
+    double quota = m_setup[group].quota;
+
+    if (state.tsRefill < 0 || quota <= 0)
+    {
+        state.tsRefill = tsNow;
+        return;
+    }
+
+    long long elapsed = tsNow - state.tsRefill;
+    if (elapsed <= 0)
+    {
+        return;
+    }
+
+    long long bucketSize = (long long)(quota * m_quotaPeriod);
+    long long added = (long long)(elapsed * quota);
+    long long refilled = elapsed;
+
+    if (state.tokens + added < bucketSize)
+    {
+        refilled = min((long long)ceil(added / quota), elapsed);
+    }
+
+    if (state.tokens <= 0 && state.active)
+    {
+        long long timeToRefill = (long long)ceil((1 - state.tokens) / quota);
+        state.throttledTime += (refilled < timeToRefill) ? refilled : timeToRefill;
+    }
+
+    state.tokens = min(state.tokens + added, bucketSize);
+    state.tsRefill += refilled;
+}
+
+//******************************************************************************************
+// @name                    : accountCompletion
+//
+// @description             : Accounts for a completed job in its group and the groups
+//                            above it.
+//
+// @param group             : Group of the job
+// @param waitingTime       : Waiting time (ns) of the job
+// @param responseTime      : Response time (ns) of the job
+//
+// @returns                 : Nothing
+//******************************************************************************************
+void TenantGroups::accountCompletion(unsigned int group, long long waitingTime, long long responseTime)
+{
+    if (group >= m_groups.size())
+    {
+        return;
+    }
+
+    for (int ancestor = (int)group; ancestor >= 0; ancestor = m_parents[ancestor])
+    {
+        m_groups[ancestor].completedJobs++;
+        m_groups[ancestor].totalWaitingTime += waitingTime;
+        m_groups[ancestor].totalResponseTime += responseTime;
+    }
+}
+
+//******************************************************************************************
+// @name                    : getNextUnthrottleTime
+//
+// @description             : Fetches when the first of the throttled groups that had jobs
+//                            to run at the last pick has tokens again. While a job runs,
+//                            only the groups whose jobs would be picked over it count, as
+//                            the others getting tokens again changes nothing till it stops.
+//
+// @param runningGroup      : Group of the job running, -1 if none
+//
+// @returns                 : timestamp (ns), -1 if no such group is throttled
+//******************************************************************************************
+long long TenantGroups::getNextUnthrottleTime(int runningGroup)
+{
+    long long tsNext = -1;
+
+    for (unsigned int group = 0; group < m_groups.size(); group++)
+    {
+        if (!isThrottled(group) || m_busyJobs[group] == 0)
+        {
+            continue;
+        }
+
+        if (runningGroup >= 0 && (size_t)runningGroup < m_groups.size() && !isPickedOver(group, (unsigned int)runningGroup))
+        {
+            continue;
+        }
+
+        long long tsRefilled = m_groups[group].tsRefill + (long long)ceil((1 - m_groups[group].tokens) / m_setup[group].quota);
+        if (tsNext < 0 || tsRefilled < tsNext)
+        {
+            tsNext = tsRefilled;
+        }
+    }
+
+    return tsNext;
+}
+
+//******************************************************************************************
+// @name                    : isPickedOver
+//
+// @description             : Checks whether a group, once eligible, would be picked over
+//                            another one, i.e. whether it is below it in the hierarchy, or
+//                            its ancestor at the level where they part has a lower virtual
+//                            time than that of the other.
+//
+// @param group             : Group
+// @param other             : Group picked so far
+//
+// @returns                 : true if the group would be picked over the other,
+//                            false otherwise
+//******************************************************************************************
+bool TenantGroups::isPickedOver(unsigned int group, unsigned int other)
+{
+    // Ancestors of each, from the top down to the group itself
+    vector<int> groupPath;
+    vector<int> otherPath;
+    for (int ancestor = (int)group; ancestor >= 0; ancestor = m_parents[ancestor])
+        groupPath.insert(groupPath.begin(), ancestor);
+    for (int ancestor = (int)other; ancestor >= 0; ancestor = m_parents[ancestor])
+        otherPath.insert(otherPath.begin(), ancestor);
+
+    size_t level = 0;
+    while (level < groupPath.size() && level < otherPath.size() && groupPath[level] == otherPath[level])
+    {
+        level++;
+    }
+
+    if (level == otherPath.size())
+    {
+        return (level < groupPath.size());
+    }
+
+    if (level == groupPath.size())
+    {
+        return false;
+    }
+
+    return (m_groups[groupPath[level]].virtualTime < m_groups[otherPath[level]].virtualTime);
+}
+
+//******************************************************************************************
+// @name                    : getEntitledShare
+//
+// @description             : Calculates the share of the CPU time the weights of a group
+//                            and of the groups above it entitle it to, when all the groups
+//                            have jobs to run and none is throttled.
+//
+// @param group             : Group
+//
+// @returns                 : Share, 0 to 1
+//******************************************************************************************
+double TenantGroups::getEntitledShare(unsigned int group)
+{
+    double share = 1;
+
+    for (int ancestor = (int)group; ancestor >= 0; ancestor = m_parents[ancestor])
+    {
+        double totalWeight = 0;
+        for (unsigned int sibling : m_children[m_parents[ancestor] + 1])
+        {
+            totalWeight += m_setup[sibling].weight;
+        }
+
+        share *= m_setup[ancestor].weight / totalWeight;
+    }
+
+    return share;
+}
+
+//******************************************************************************************
+// @name                    : getResults
+//
+// @description             : Collects the CPU time and jobs of every group. Must only be
+//                            called once the simulation is over.
+//
+// @param results           : Result of each group, in the order of the setup
+// @param timeElapsed       : Time (ns) the simulation took
+//
+// @returns                 : Nothing
+//******************************************************************************************
+void TenantGroups::getResults(vector<tenantResult_st> & results, long long timeElapsed)
+{
+    long long totalCpuTime = 0;
+    for (unsigned int group : m_children[0])
+    {
+        totalCpuTime += m_groups[group].cpuTime;
+    }
+
+    results.clear();
+    for (unsigned int group = 0; group < m_groups.size(); group++)
+    {
+        const tenantGroupState_st & state = m_groups[group];
+        tenantResult_st result;
+
+        result.name = m_setup[group].name;
+        result.weight = m_setup[group].weight;
+        result.quota = m_setup[group].quota;
+        result.completedJobs = (size_t)state.completedJobs;
+        result.throughput = (timeElapsed > 0) ? state.completedJobs * (double)NANOSECONDS_PER_SECOND / timeElapsed : 0;
+        result.cpuShare = (totalCpuTime > 0) ? state.cpuTime * 100.0 / totalCpuTime : 0;
+        result.entitledShare = getEntitledShare(group) * 100;
+        result.avgWaitingTime = state.completedJobs ? state.totalWaitingTime / (double)state.completedJobs : 0;
+        result.avgResponseTime = state.completedJobs ? state.totalResponseTime / (double)state.completedJobs : 0;
+        result.throttledTime = state.throttledTime;
+        results.push_back(result);
+    }
+}
+
+//******************************************************************************************
+// @name                    : saveCheckpoint
+//
+// @description             : Saves the state of all the groups to a checkpoint.
+//
+// @param writer            : Checkpoint
+//
+// @returns                 : Nothing
+//******************************************************************************************
+void TenantGroups::saveCheckpoint(CheckpointWriter & writer)
+{
+    writer.write((unsigned long long)m_groups.size());
+    for (const tenantGroupState_st & state : m_groups)
+    {
+        writer.write(state);
+    }
+
+    for (double floor : m_floorVirtualTimes)
+    {
+        writer.write(floor);
+    }
+}
+
+//******************************************************************************************
+// @name                    : restoreCheckpoint
+//
+// @description             : Restores the state saved by saveCheckpoint(). The groups must
+//                            be the same as those it was saved with.
+//
+// @param reader            : Checkpoint
+//
+// @returns                 : true if the checkpoint could be read,
+//                            false otherwise
+//******************************************************************************************
+bool TenantGroups::restoreCheckpoint(CheckpointReader & reader)
+{
+    if (reader.read<unsigned long long>() != m_groups.size())
+    {
+        printf("ERROR: The checkpoint was taken with other tenant groups\n");
+        return false;
+    }
+
+    for (tenantGroupState_st & state : m_groups)
+    {
+        state = reader.read<tenantGroupState_st>();
+    }
+
+    for (double & floor : m_floorVirtualTimes)
+    {
+        floor = reader.read<double>();
+    }
+
+    return !reader.hasFailed();
+}
+
+//******************************************************************************************
+// @name                    : findParent
+//
+// @description             : Finds the parent of a group, i.e. the group listed before it
+//                            whose path is that of the group without its last name.
+//
+// @param setup             : Groups
+// @param group             : Group
+//
+// @returns                 : Parent, -1 for a group at the top or whose parent is not
+//                            listed before it
+//******************************************************************************************
+int TenantGroups::findParent(const vector<tenantGroupSetup_st> & setup, unsigned int group)
+{
+    size_t separator = setup[group].name.rfind('/');
+    if (separator == string::npos)
+    {
+        return -1;
+    }
+
+    string parentName = setup[group].name.substr(0, separator);
+    for (unsigned int parent = 0; parent < group; parent++)
+    {
+        if (setup[parent].name == parentName)
+            return (int)parent;
+    }
+
+    return -1;
+}
+
+//******************************************************************************************
+// @name                    : completeSetup
+//
+// @description             : Checks the hierarchy of the groups, and gives the groups with
+//                            no subgroups whose share of the jobs is left out a share of 1.
+//                            Jobs are only submitted to the groups with no subgroups.
+//
+// @param setup             : Groups, parents listed before their subgroups
+//
+// @returns                 : true if the groups are valid,
+//                            false otherwise
+//******************************************************************************************
+bool TenantGroups::completeSetup(vector<tenantGroupSetup_st> & setup)
+{
+    vector<bool> hasSubgroups(setup.size(), false);
+    double totalJobShare = 0;
+
+    for (unsigned int group = 0; group < setup.size(); group++)
+    {
+        for (unsigned int other = 0; other < group; other++)
+        {
+            if (setup[other].name == setup[group].name)
+            {
+                printf("ERROR: Tenant group '%s' is listed twice\n", setup[group].name.c_str());
+                return false;
+            }
+        }
+
+        int parent = findParent(setup, group);
+        if (parent < 0 && setup[group].name.find('/') != string::npos)
+        {
+            printf("ERROR: Tenant group '%s' must be listed after its parent group\n", setup[group].name.c_str());
+            return false;
+        }
+
+        if (parent >= 0)
+            hasSubgroups[parent] = true;
+    }
+
+    for (unsigned int group = 0; group < setup.size(); group++)
+    {
+        if (setup[group].jobShare < 0)
+        {
+            setup[group].jobShare = hasSubgroups[group] ? 0 : 1;
+        }
+        else if (hasSubgroups[group] && setup[group].jobShare > 0)
+        {
+            printf("ERROR: Tenant group '%s' has subgroups, so jobs can't be submitted to it\n", setup[group].name.c_str());
+            return false;
+        }
+
+        totalJobShare += setup[group].jobShare;
+    }
+
+    if (totalJobShare <= 0)
+    {
+        printf("ERROR: No tenant group gets any jobs\n");
+        return false;
+    }
+
+    return true;
+}
@@ -0,0 +1,184 @@
+#include "timing.h"
+#include<thread>
+#if defined(__unix__) || defined(__APPLE__)
+#include<time.h>
+#endif
+
+//******************************************************************************************
+// @name                    : getCurrentTimestampInMilliseconds
+//
+// @description             : Get time stamp in milliseconds. steady_clock is used as it
+//                            never goes back, unlike the system clock, so durations
+//                            measured with it are always right.
+//
+// @returns                 : Current timestamp
+//******************************************************************************************
+long long getCurrentTimestampInMilliseconds()
+{
+    return chrono::duration_cast<chrono::milliseconds>(chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+//******************************************************************************************
+// @name                    : getCurrentTimestampInNanoseconds
+//
+// @description             : Get time stamp in nanoseconds, from the same clock as
+//                            getCurrentTimestampInMilliseconds(). This is precise enough
+//                            for jobs and time slices of a few microseconds.
+//
+// @returns                 : Current timestamp
+//******************************************************************************************
+long long getCurrentTimestampInNanoseconds()
+{
+    return chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+//******************************************************************************************
+// @name                    : getThreadCpuTimeInNanoseconds
+//
+// @description             : Get the CPU time used so far by the calling thread. Time the
+//                            thread spent waiting or preempted is not counted. Where
+//                            thread CPU clocks are not available, this falls back to the
+//                            monotonic clock.
+//
+// @returns                 : CPU time (ns) of the calling thread
+//******************************************************************************************
+long long getThreadCpuTimeInNanoseconds()
+{
+#if defined(CLOCK_THREAD_CPUTIME_ID)
+    struct timespec ts;
+    if (clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts) == 0)
+    {
+        return ts.tv_sec * NANOSECONDS_PER_SECOND + ts.tv_nsec;
+    }
+#endif
+    return getCurrentTimestampInNanoseconds();
+}
+
+//******************************************************************************************
+// @name                    : getThreadSleeper
+//
+// @description             : Fetches the deadline sleeper of the calling thread.
+//
+// @returns                 : Deadline sleeper
+//******************************************************************************************
+static DeadlineSleeper & getThreadSleeper()
+{
+    thread_local DeadlineSleeper sleeper;
+    return sleeper;
+}
+
+//******************************************************************************************
+// @name                    : DeadlineSleeper
+//
+// @description             : Constructor
+//
+// @returns                 : Nothing
+//******************************************************************************************
+DeadlineSleeper::DeadlineSleeper()
+{
+    m_hasDeadline = false;
+}
+
+//******************************************************************************************
+// @name                    : ~DeadlineSleeper
+//
+// @description             : Destructor
+//
+// @returns                 : Nothing
+//******************************************************************************************
+DeadlineSleeper::~DeadlineSleeper()
+{
+
+}
+
+//******************************************************************************************
+// @name                    : sleepFor
+//
+// @description             : Sleeps till the last deadline plus the specified duration.
+//                            If the last deadline is too far behind, the calling thread
+//                            has been busy in between, so the duration counts from now.
+//
+// @param duration          : Duration to sleep
+//
+// @returns                 : Nothing
+//******************************************************************************************
+void DeadlineSleeper::sleepFor(chrono::nanoseconds duration)
+{
+    chrono::steady_clock::time_point now = chrono::steady_clock::now();
+
+    if (!m_hasDeadline || m_deadline + MAX_SLEEP_CATCH_UP < now)
+    {
+        m_deadline = now;
+    }
+
+    sleepUntil(m_deadline + duration);
+}
+
+//******************************************************************************************
+// @name                    : sleepUntil
+//
+// @description             : Sleeps till the specified deadline, which becomes the start
+//                            of the next sleep.
+//
+// @param deadline          : Time at which to wake up
+//
+// @returns                 : Nothing
+//******************************************************************************************
+void DeadlineSleeper::sleepUntil(chrono::steady_clock::time_point deadline)
+{
+    this_thread::sleep_until(deadline);
+    m_deadline = deadline;
+    m_hasDeadline = true;
+}
+
+//******************************************************************************************
+// @name                    : sleepForMilliseconds
+//
+// @description             : Blocks the calling thread for the specified duration. Each
+//                            thread has a deadline sleeper of its own, so back to back
+//                            sleeps of a thread do not drift.
+//
+// @param duration          : Duration (ms) to sleep
+//
+// @returns                 : Nothing
+//******************************************************************************************
+void sleepForMilliseconds(long long duration)
+{
+    if (duration > 0)
+    {
+        getThreadSleeper().sleepFor(chrono::milliseconds(duration));
+    }
+}
+
+//******************************************************************************************
+// @name                    : sleepForNanoseconds
+//
+// @description             : Same as sleepForMilliseconds(), for a duration in ns.
+//
+// @param duration          : Duration (ns) to sleep
+//
+// @returns                 : Nothing
+//******************************************************************************************
+void sleepForNanoseconds(long long duration)
+{
+    if (duration > 0)
+    {
+        getThreadSleeper().sleepFor(chrono::nanoseconds(duration));
+    }
+}
+
+//******************************************************************************************
+// @name                    : sleepUntilNanoseconds
+//
+// @description             : Blocks the calling thread till a timestamp. The following
+//                            sleeps of the thread are timed from it.
+//
+// @param timestamp         : timestamp (ns), as returned by
+//                            getCurrentTimestampInNanoseconds()
+//
+// @returns                 : Nothing
+//******************************************************************************************
+void sleepUntilNanoseconds(long long timestamp)
+{
+    getThreadSleeper().sleepUntil(chrono::steady_clock::time_point(chrono::nanoseconds(timestamp)));
+}
@@ -0,0 +1,344 @@
+#include "worker_pool.h"
+#include "logger.h"
+#include "timing.h"
+#include<algorithm>
+#include<atomic>
+#include<exception>
+
+//---------------------------------------------------------------------------------------------------
+// Globals
+//---------------------------------------------------------------------------------------------------
+const int           SPIN_UNIT_ITERATIONS        = 4096;               // Iterations between two reads of the CPU time
+const int           SORT_UNIT_SIZE              = 4096;               // Elements sorted at a time
+const int           MATMUL_UNIT_SIZE            = 32;                 // Rows and columns of the matrices
+
+atomic<unsigned long long> g_payloadSink(0);                          // Keeps the results of the kernels alive
+
+//******************************************************************************************
+// @name                    : WorkerPool
+//
+// @description             : Constructor. Starts the worker threads.
+//
+// @param workerCount       : Number of worker threads, at least 1
+//
+// @returns                 : Nothing
+//******************************************************************************************
+WorkerPool::WorkerPool(unsigned int workerCount)
+{
+    m_stopRequested = false;
+    for (unsigned int i = 0; i < std::max(workerCount, 1u); i++)
+    {
+        m_workers.push_back(thread(&WorkerPool::runTasks, this));
+    }
+}
+
+//******************************************************************************************
+// @name                    : ~WorkerPool
+//
+// @description             : Stops the worker threads. No payload must be executing.
+//
+// @returns                 : Nothing
+//******************************************************************************************
+WorkerPool::~WorkerPool()
+{
+    {
+        lock_guard<mutex> lock(m_mutex);
+        m_stopRequested = true;
+    }
+
+    m_taskEvent.notify_all();
+    for (auto it = m_workers.begin(); it != m_workers.end(); it++)
+    {
+        it->join();
+    }
+}
+
+//******************************************************************************************
+// @name                    : execute
+//
+// @description             : Runs a payload on the next free worker, and waits till it has
+//                            run.
+//
+// @param payload           : Payload to run
+//
+// @returns                 : CPU time (ns) taken by the payload
+//******************************************************************************************
+long long WorkerPool::execute(const jobPayload_fn & payload)
+{
+    workerTask_st task;
+    task.payload = &payload;
+    task.cpuTime = 0;
+    task.done = false;
+
+    unique_lock<mutex> lock(m_mutex);
+    m_tasks.push_back(&task);
+    m_taskEvent.notify_one();
+
+    m_doneEvent.wait(lock, [&task] { return task.done; });
+    return task.cpuTime;
+}
+
+//******************************************************************************************
+// @name                    : runTasks
+//
+// @description             : Worker thread. Runs the queued tasks till the pool is
+//                            destroyed.
+//
+// @returns                 : Nothing
+//******************************************************************************************
+void WorkerPool::runTasks()
+{
+    unique_lock<mutex> lock(m_mutex);
+
+    for (;;)
+    {
+        m_taskEvent.wait(lock, [this] { return m_stopRequested || !m_tasks.empty(); });
+        if (m_tasks.empty())
+        {
+            return;
+        }
+
+        workerTask_st *task = m_tasks.front();
+        m_tasks.pop_front();
+
+        lock.unlock();
+        long long cpuTime = runPayload(*task->payload);
+        lock.lock();
+
+        task->cpuTime = cpuTime;
+        task->done = true;
+        m_doneEvent.notify_all();
+    }
+}
+
+//******************************************************************************************
+// @name                    : runPayload
+//
+// @description             : Runs a payload on the calling thread. A payload that throws
+//                            is logged and taken as complete.
+//
+// @param payload           : Payload to run
+//
+// @returns                 : CPU time (ns) taken by the payload
+//******************************************************************************************
+long long WorkerPool::runPayload(const jobPayload_fn & payload)
+{
+    long long tsStart = getThreadCpuTimeInNanoseconds();
+
+    try
+    {
+        payload();
+    }
+    catch (const exception & e)
+    {
+        LOG_ERROR("Job payload failed: %s", e.what());
+    }
+    catch (...)
+    {
+        LOG_ERROR("Job payload failed");
+    }
+
+    return getThreadCpuTimeInNanoseconds() - tsStart;
+}
+
+//******************************************************************************************
+// @name                    : createSpinUnit
+//
+// @description             : Creates a unit of work keeping the CPU busy with integer
+//                            arithmetic, without touching memory.
+//
+// @returns                 : Unit of work, to be called repeatedly
+//******************************************************************************************
+static auto createSpinUnit()
+{
+    return [x = 88172645463325252ULL]() mutable
+    {
+        for (int i = 0; i < SPIN_UNIT_ITERATIONS; i++)
+        {
+            x ^= x << 13;
+            x ^= x >> 7;
+            x ^= x << 17;
+        }
+
+        g_payloadSink.fetch_add(x, memory_order_relaxed);
+    };
+}
+
+//******************************************************************************************
+// @name                    : createSortUnit
+//
+// @description             : Creates a unit of work sorting an array of pseudo random
+//                            numbers, which exercises the caches and the branch predictor.
+//
+// @returns                 : Unit of work, to be called repeatedly
+//******************************************************************************************
+static auto createSortUnit()
+{
+    return [values = vector<unsigned int>(SORT_UNIT_SIZE), seed = 12345u]() mutable
+    {
+        for (auto it = values.begin(); it != values.end(); it++)
+        {
+            seed = seed * 1664525 + 1013904223;
+            *it = seed;
+        }
+
+        sort(values.begin(), values.end());
+        g_payloadSink.fetch_add(values[SORT_UNIT_SIZE / 2], memory_order_relaxed);
+    };
+}
+
+//******************************************************************************************
+// @name                    : createMatmulUnit
+//
+// @description             : Creates a unit of work multiplying matrices of doubles. The
+//                            result is fed back, so every unit depends on the previous one.
+//
+// @returns                 : Unit of work, to be called repeatedly
+//******************************************************************************************
+static auto createMatmulUnit()
+{
+    const int n = MATMUL_UNIT_SIZE;
+    vector<double> a(n * n), b(n * n);
+
+    for (int i = 0; i < n * n; i++)
+    {
+        a[i] = (i % 7) * 0.5;
+        b[i] = (i % 5) * 0.25;
+    }
+
+    return [a, b, c = vector<double>(n * n)]() mutable
+    {
+        for (int i = 0; i < n; i++)
+        {
+            for (int j = 0; j < n; j++)
+            {
+                double sum = 0;
+                for (int k = 0; k < n; k++)
+                {
+                    sum += a[i * n + k] * b[k * n + j];
+                }
+                c[i * n + j] = sum;
+            }
+        }
+
+        a.swap(c);
+        g_payloadSink.fetch_add((unsigned long long)a[0], memory_order_relaxed);
+    };
+}
+
+//******************************************************************************************
+// @name                    : runKernel
+//
+// @description             : Repeats a unit of work till it has taken the specified CPU
+//                            time.
+//
+// @param cpuTime           : CPU time (ns) to keep busy for
+// @param unit              : Unit of work
+//
+// @returns                 : Nothing
+//******************************************************************************************
+template<typename UNIT>
+static void runKernel(long long cpuTime, UNIT unit)
+{
+    long long tsEnd = getThreadCpuTimeInNanoseconds() + cpuTime;
+
+    do
+    {
+        unit();
+    } while (getThreadCpuTimeInNanoseconds() < tsEnd);
+}
+
+//******************************************************************************************
+// @name                    : runKernelCoroutine
+//
+// @description             : Same as runKernel(), with a checkpoint after every unit of
+//                            work. The CPU time is added up unit by unit, as the coroutine
+//                            can be resumed on a different thread every time.
+//
+// @param cpuTime           : CPU time (ns) to keep busy for
+// @param unit              : Unit of work, copied into the coroutine frame
+//
+// @returns                 : Coroutine
+//******************************************************************************************
+template<typename UNIT>
+static JobCoroutine runKernelCoroutine(long long cpuTime, UNIT unit)
+{
+    long long timeUsed = 0;
+
+    do
+    {
+        long long tsStart = getThreadCpuTimeInNanoseconds();
+        unit();
+        timeUsed += getThreadCpuTimeInNanoseconds() - tsStart;
+
+        co_await JOB_CHECKPOINT;
+    } while (timeUsed < cpuTime);
+}
+
+//******************************************************************************************
+// @name                    : createPayload
+//
+// @description             : Creates a payload that runs one of the built-in CPU bound
+//                            kernels for about the specified CPU time.
+//
+// @param kernel            : Kernel to run
+// @param cpuTime           : CPU time (ns) the payload should take
+//
+// @returns                 : Payload, empty for PAYLOAD_KERNEL_NONE
+//******************************************************************************************
+jobPayload_fn WorkerPool::createPayload(payloadKernel_en kernel, long long cpuTime)
+{
+    switch (kernel)
+    {
+    case PAYLOAD_KERNEL_SPIN:       return [cpuTime] { runKernel(cpuTime, createSpinUnit()); };
+    case PAYLOAD_KERNEL_SORT:       return [cpuTime] { runKernel(cpuTime, createSortUnit()); };
+    case PAYLOAD_KERNEL_MATMUL:     return [cpuTime] { runKernel(cpuTime, createMatmulUnit()); };
+    default:                        return jobPayload_fn();
+    }
+}
+
+//******************************************************************************************
+// @name                    : createCoroutine
+//
+// @description             : Same as createPayload(), for a kernel that can be preempted
+//                            after every unit of its work.
+//
+// @param kernel            : Kernel to run
+// @param cpuTime           : CPU time (ns) the coroutine should take
+//
+// @returns                 : Coroutine, not valid for PAYLOAD_KERNEL_NONE
+//******************************************************************************************
+JobCoroutine WorkerPool::createCoroutine(payloadKernel_en kernel, long long cpuTime)
+{
+    switch (kernel)
+    {
+    case PAYLOAD_KERNEL_SPIN:       return runKernelCoroutine(cpuTime, createSpinUnit());
+    case PAYLOAD_KERNEL_SORT:       return runKernelCoroutine(cpuTime, createSortUnit());
+    case PAYLOAD_KERNEL_MATMUL:     return runKernelCoroutine(cpuTime, createMatmulUnit());
+    default:                        return JobCoroutine();
+    }
+}
+
+//******************************************************************************************
+// @name                    : parseKernel
+//
+// @description             : Converts the name of a kernel (none, spin, sort or matmul) to
+//                            the kernel.
+//
+// @param name              : Name of the kernel
+// @param kernel            : Kernel
+//
+// @returns                 : true if the name is valid,
+//                            false otherwise
+//******************************************************************************************
+bool WorkerPool::parseKernel(const string & name, payloadKernel_en & kernel)
+{
+    if (name == "none")             kernel = PAYLOAD_KERNEL_NONE;
+    else if (name == "spin")        kernel = PAYLOAD_KERNEL_SPIN;
+    else if (name == "sort")        kernel = PAYLOAD_KERNEL_SORT;
+    else if (name == "matmul")      kernel = PAYLOAD_KERNEL_MATMUL;
+    else
+        return false;
+
+    return true;
+}
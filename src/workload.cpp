@@ -0,0 +1,410 @@
+#include "workload.h"
+#include "process_scheduler.h"
+#include<limits.h>
+
+//******************************************************************************************
+// @name                    : Workload
+//
+// @description             : Constructor
+//
+// @returns                 : Nothing
+//******************************************************************************************
+Workload::Workload()
+{
+    m_ioProfile.jobRatio = 0;                                        // Pure CPU jobs
+    m_ioProfile.maxBursts = 0;
+    m_ioProfile.maxBurstTime = 0;
+    m_ioProfile.devices = 1;
+    m_parallelProfile.jobRatio = 0;                                  // Single thread jobs
+    m_parallelProfile.maxWidth = 1;
+}
+
+//******************************************************************************************
+// @name                    : ~Workload
+//
+// @description             : Destructor
+//
+// @returns                 : Nothing
+//******************************************************************************************
+Workload::~Workload()
+{
+
+}
+
+//******************************************************************************************
+// @name                    : generate
+//
+// @description             : Generates the job specifications using a randomly seeded RNG.
+//
+// @param jobCount          : Number of jobs to generate.
+// @param creationSleepMax  : Max time duration (ms) between two job arrivals.
+//
+// @returns                 : Nothing
+//******************************************************************************************
+void Workload::generate(long int jobCount, int creationSleepMax)
+{
+    RandomGenerator rng;
+    generate(jobCount, creationSleepMax, rng);
+}
+
+//******************************************************************************************
+// @name                    : generate
+//
+// @description             : Generates the job specifications. Each job gets a random
+//                            priority and time required, and arrives after a random
+//                            duration of 0 to creationSleepMax-1 ms from the previous job,
+//                            just like the jobs made by the job creation thread.
+//                            The same seeded RNG always generates the same workload.
+//
+// @param jobCount          : Number of jobs to generate.
+// @param creationSleepMax  : Max time duration (ms) between two job arrivals.
+// @param rng               : Random generator to use.
+//
+// @returns                 : Nothing
+//******************************************************************************************
+void Workload::generate(long int jobCount, int creationSleepMax, RandomGenerator & rng)
+{
+    long long arrivalTime = 0;
+
+    m_jobs.clear();
+    m_jobs.reserve(jobCount);
+
+    for (long int i = 0; i < jobCount; i++)
+    {
+        jobSpec_st spec;
+        spec.jobId = i + 1;
+        spec.priority = rng.generateRandomNumber(JOB_PRIORITY_LOWEST);
+        spec.timeRequired = rng.generateRandomNumber(MAX_TIME_REQUIRED) * NANOSECONDS_PER_MILLISECOND;
+        spec.arrivalTime = arrivalTime;
+        spec.ioBursts = 0;
+        spec.ioBurstTime = 0;
+        spec.ioDevice = 0;
+        spec.width = 1;
+        spec.tenantGroup = 0;
+        m_jobs.push_back(spec);
+
+        if (creationSleepMax > 0)
+        {
+            arrivalTime += rng.generateRandomNumber(creationSleepMax) * NANOSECONDS_PER_MILLISECOND;
+        }
+    }
+
+    if (m_ioProfile.jobRatio > 0)
+    {
+        RandomGenerator ioRng(rng.generateRandomNumber(UINT_MAX));
+        for (auto it = m_jobs.begin(); it != m_jobs.end(); it++)
+        {
+            generateIoBursts(*it, m_ioProfile, ioRng);
+        }
+    }
+
+    if (m_parallelProfile.jobRatio > 0)
+    {
+        RandomGenerator widthRng(rng.generateRandomNumber(UINT_MAX));
+        for (auto it = m_jobs.begin(); it != m_jobs.end(); it++)
+        {
+            generateWidth(*it, m_parallelProfile, widthRng);
+        }
+    }
+
+    if (m_tenantProfile.jobShares.size())
+    {
+        RandomGenerator tenantRng(rng.generateRandomNumber(UINT_MAX));
+        for (auto it = m_jobs.begin(); it != m_jobs.end(); it++)
+        {
+            generateTenantGroup(*it, m_tenantProfile, tenantRng);
+        }
+    }
+}
+
+//******************************************************************************************
+// @name                    : generateIoBursts
+//
+// @description             : Draws whether a job does I/O as per a profile and, if it
+//                            does, its number of I/O bursts (1 to maxBursts), the service
+//                            time of each (1 ms to maxBurstTime) and its device.
+//
+// @param spec              : Job specification to update
+// @param profile           : I/O profile
+// @param rng               : Random generator to use.
+//
+// @returns                 : Nothing
+//******************************************************************************************
+void Workload::generateIoBursts(jobSpec_st & spec, const ioProfile_st & profile, RandomGenerator & rng)
+{
+    const unsigned int RATIO_RESOLUTION = 1000000;
+
+    spec.ioBursts = 0;
+    spec.ioBurstTime = 0;
+    spec.ioDevice = 0;
+
+    if (rng.generateRandomNumber(RATIO_RESOLUTION) >= profile.jobRatio * RATIO_RESOLUTION || profile.maxBursts == 0)
+    {
+        return;
+    }
+
+    long long maxBurstTime = profile.maxBurstTime / NANOSECONDS_PER_MILLISECOND;
+    spec.ioBursts = 1 + rng.generateRandomNumber(profile.maxBursts);
+    spec.ioBurstTime = (1 + rng.generateRandomNumber((unsigned int)((maxBurstTime > 1) ? maxBurstTime : 1))) * NANOSECONDS_PER_MILLISECOND;
+    spec.ioDevice = rng.generateRandomNumber((profile.devices > 0) ? profile.devices : 1);
+}
+
+//******************************************************************************************
+// @name                    : generateWidth
+//
+// @description             : Draws whether a job is parallel as per a profile and, if it
+//                            is, the CPUs it runs on at once (2 to maxWidth).
+//
+// @param spec              : Job specification to update
+// @param profile           : Parallel profile
+// @param rng               : Random generator to use.
+//
+// @returns                 : Nothing
+//******************************************************************************************
+void Workload::generateWidth(jobSpec_st & spec, const parallelProfile_st & profile, RandomGenerator & rng)
+{
+    const unsigned int RATIO_RESOLUTION = 1000000;
+
+    spec.width = 1;
+
+    if (rng.generateRandomNumber(RATIO_RESOLUTION) >= profile.jobRatio * RATIO_RESOLUTION || profile.maxWidth < 2)
+    {
+        return;
+    }
+
+    spec.width = 2 + rng.generateRandomNumber(profile.maxWidth - 1);
+}
+
+//******************************************************************************************
+// @name                    : generateTenantGroup
+//
+// @description             : Draws the tenant group a job is submitted to, each group in
+//                            proportion of its share of the jobs as per a profile.
+//
+// @param spec              : Job specification to update
+// @param profile           : Tenant profile
+// @param rng               : Random generator to use.
+//
+// @returns                 : Nothing
+//******************************************************************************************
+void Workload::generateTenantGroup(jobSpec_st & spec, const tenantProfile_st & profile, RandomGenerator & rng)
+{
+    const unsigned int RATIO_RESOLUTION = 1000000;
+
+    double totalShare = 0;
+    for (double share : profile.jobShares)
+    {
+        totalShare += share;
+    }
+
+    spec.tenantGroup = 0;
+    if (totalShare <= 0)
+    {
+        return;
+    }
+
+    double draw = rng.generateRandomNumber(RATIO_RESOLUTION) * totalShare / RATIO_RESOLUTION;
+    for (unsigned int group = 0; group < profile.jobShares.size(); group++)
+    {
+        if (profile.jobShares[group] <= 0)
+        {
+            continue;
+        }
+
+        // The last group with jobs takes what is left, whatever the rounding
+        spec.tenantGroup = group;
+        draw -= profile.jobShares[group];
+        if (draw < 0)
+        {
+            return;
+        }
+    }
+}
+
+//******************************************************************************************
+// @name                    : getSignature
+//
+// @description             : Computes a signature (FNV-1a hash) of the job specifications,
+//                            to tell whether two workloads are the same, e.g. the one a
+//                            checkpoint was taken on and the one it is restored on.
+//
+// @returns                 : Signature
+//******************************************************************************************
+unsigned long long Workload::getSignature() const
+{
+    const unsigned long long FNV_OFFSET_BASIS = 14695981039346656037ULL;
+    const unsigned long long FNV_PRIME = 1099511628211ULL;
+
+    unsigned long long signature = FNV_OFFSET_BASIS;
+    auto mix = [&signature, FNV_PRIME](unsigned long long value)
+    {
+        for (int byte = 0; byte < 8; byte++)
+        {
+            signature ^= (value >> (byte * 8)) & 0xFF;
+            signature *= FNV_PRIME;
+        }
+    };
+
+    // Hash the fields one by one, as the padding of a specification is not initialized
+    for (const jobSpec_st & spec : m_jobs)
+    {
+        mix(spec.jobId);
+        mix(spec.priority);
+        mix((unsigned long long)spec.timeRequired);
+        mix((unsigned long long)spec.arrivalTime);
+        mix(spec.ioBursts);
+        mix((unsigned long long)spec.ioBurstTime);
+        mix(spec.ioDevice);
+        mix(spec.width);
+        mix(spec.tenantGroup);
+    }
+
+    return signature;
+}
+
+//******************************************************************************************
+// @name                    : WorkloadFeeder
+//
+// @description             : Constructor
+//
+// @param workload          : Jobs to be released. Must outlive the feeder.
+// @param showJobStatus     : Show details of job running status
+// @param responseTimeThreshold : Threshold for job response time
+// @param clock             : Clock of the scheduler being fed. Arrival times of the workload
+//                            are relative to the time at which the feeder is created.
+//
+// @returns                 : Nothing
+//******************************************************************************************
+WorkloadFeeder::WorkloadFeeder(const Workload & workload, bool showJobStatus, int responseTimeThreshold, SimulationClock *clock)
+    : m_workload(workload)
+{
+    m_nextJob = 0;
+    m_showJobStatus = showJobStatus;
+    m_responseTimeThreshold = responseTimeThreshold;
+    m_clock = clock;
+    m_tsStart = clock->now();
+}
+
+//******************************************************************************************
+// @name                    : ~WorkloadFeeder
+//
+// @description             : Destructor
+//
+// @returns                 : Nothing
+//******************************************************************************************
+WorkloadFeeder::~WorkloadFeeder()
+{
+
+}
+
+//******************************************************************************************
+// @name                    : getNextArrivalTime
+//
+// @description             : Fetches the timestamp at which the next job arrives.
+//
+// @returns                 : Timestamp of the next arrival, -1 if all the jobs have been
+//                            released.
+//******************************************************************************************
+long long WorkloadFeeder::getNextArrivalTime()
+{
+    if (isExhausted())
+    {
+        return -1;
+    }
+
+    return m_tsStart + m_workload.at(m_nextJob).arrivalTime;
+}
+
+//******************************************************************************************
+// @name                    : releaseDueJobs
+//
+// @description             : Creates all the jobs that have arrived by now and adds them
+//                            to the ready queue of the scheduler. The scheduler only asks
+//                            for its jobs in between other jobs, so a job may be released
+//                            a bit after its arrival. Its creation time is set back to its
+//                            arrival time so that waiting times are still accurate.
+//                            The jobs are added as a single batch.
+//
+// @param scheduler         : scheduler object
+//
+// @returns                 : Nothing
+//******************************************************************************************
+void WorkloadFeeder::releaseDueJobs(ProcessScheduler *scheduler)
+{
+    long long currentTimestamp = m_clock->now();
+
+    while (!isExhausted() && getNextArrivalTime() <= currentTimestamp)
+    {
+        Job *job = new Job(m_showJobStatus, m_workload.at(m_nextJob), m_responseTimeThreshold, m_clock);
+        job->setJobTimeCreated(getNextArrivalTime());
+        m_dueJobs.push_back(job);
+        m_nextJob++;
+    }
+
+    if (m_dueJobs.empty())
+    {
+        return;
+    }
+
+    scheduler->addToReadyQueue(m_dueJobs, m_shedJobs);
+    for (Job *job : m_shedJobs)
+    {
+        delete job;
+    }
+
+    m_dueJobs.clear();
+    m_shedJobs.clear();
+}
+
+//******************************************************************************************
+// @name                    : saveCheckpoint
+//
+// @description             : Saves how far the workload has been released, along with the
+//                            signature of the workload.
+//
+// @param writer            : Checkpoint
+//
+// @returns                 : Nothing
+//******************************************************************************************
+void WorkloadFeeder::saveCheckpoint(CheckpointWriter & writer)
+{
+    writer.write(m_workload.getSignature());
+    writer.write((unsigned long long)m_workload.size());
+    writer.write((unsigned long long)m_nextJob);
+    writer.write(m_tsStart);
+}
+
+//******************************************************************************************
+// @name                    : restoreCheckpoint
+//
+// @description             : Resumes releasing the workload from where a checkpoint was
+//                            taken. The workload must be the one the checkpoint was taken
+//                            on, i.e. generated with the same seed and options.
+//
+// @param reader            : Checkpoint
+//
+// @returns                 : true if the feeder was restored,
+//                            false otherwise
+//******************************************************************************************
+bool WorkloadFeeder::restoreCheckpoint(CheckpointReader & reader)
+{
+    unsigned long long signature = reader.read<unsigned long long>();
+    unsigned long long jobCount = reader.read<unsigned long long>();
+    unsigned long long nextJob = reader.read<unsigned long long>();
+    long long tsStart = reader.read<long long>();
+
+    if (reader.hasFailed())
+    {
+        return false;
+    }
+
+    if (signature != m_workload.getSignature() || jobCount != m_workload.size() || nextJob > jobCount)
+    {
+        printf("ERROR: The checkpoint was taken on another workload. Use the same seed and workload options.\n");
+        return false;
+    }
+
+    m_nextJob = (size_t)nextJob;
+    m_tsStart = tsStart;
+    return true;
+}